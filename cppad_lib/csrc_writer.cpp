@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cpp_csrc_writer dev}
@@ -26,6 +26,8 @@ Prototype
 os
 **
 The C source code corresponding to the function is written to *os* .
+This includes the zero order forward mode function and
+the derivative functions; see :ref:`to_csrc@Derivative Functions` .
 
 graph
 *****
@@ -37,6 +39,14 @@ this specifies the type corresponding to the C source code and must
 be one of the following:
 ``float`` , ``double`` , or ``long_double`` .
 
+Node Vectors
+************
+The C source uses the vector ``v`` for the value of each node in the graph.
+The derivative functions also use the vector ``dv`` (``pv`` )
+for the forward (reverse) mode derivative of each node.
+The zero order forward mode calculations are in a static function
+that is used by all the functions for the graph.
+
 {xrst_end cpp_csrc_writer}
 */
 
@@ -55,6 +65,9 @@ be one of the following:
 
 
 namespace {
+   //
+   // graph_op_enum
+   using CppAD::graph::graph_op_enum;
    //
    // element
    std::string element(const std::string& array_name, size_t array_index)
@@ -152,215 +165,35 @@ namespace {
       os << complete_name + "( " + element("v", arg_node) + " );\n";
       os << "\t}\n";
    }
-
-}
-
-// BEGIN_PROTOTYPE
-void CppAD::local::graph::csrc_writer(
-   std::ostream&                             os                     ,
-   const cpp_graph&                          graph_obj              ,
-   const std::string&                        c_type                 )
-// END_PROTOTYPE
-{  using std::string;
-   using CppAD::to_string;
-   //
-   // --------------------------------------------------------------------
-   string function_name  = graph_obj.function_name_get();
-   size_t n_dynamic_ind  = graph_obj.n_dynamic_ind_get();
-   size_t n_variable_ind = graph_obj.n_variable_ind_get();
-   size_t n_constant     = graph_obj.constant_vec_size();
-   size_t n_dependent    = graph_obj.dependent_vec_size();
-   size_t n_usage        = graph_obj.operator_vec_size();
-   // --------------------------------------------------------------------
-   CPPAD_ASSERT_KNOWN( function_name != "" ,
-      "to_csrc: Cannot convert a function with no name"
-   );
-   //
-   // graph_itr
-   // defined here because not using as loop index
-   cpp_graph::const_iterator graph_itr;
-   //
-   // first_result_node
-   size_t first_result_node = 1 + n_dynamic_ind + n_variable_ind + n_constant;
-   //
-   // n_node
-   size_t n_node = first_result_node;
-   for(size_t op_index = 0; op_index < n_usage; ++op_index)
-   {  // graph_itr
-      if( op_index == 0 )
-         graph_itr = graph_obj.begin();
-      else
-         ++graph_itr;
-      //
-      // nv
-      cpp_graph::const_iterator::value_type itr_value = *graph_itr;
-      n_node += itr_value.n_result;
-   }
-   //
-   // includes
-   os <<
-      "// includes\n"
-      "# include <stddef.h>\n"
-      "# include <math.h>\n"
-      "\n"
-   ;
-   //
-   // typedefs
-   string tmp_type = c_type;
-   if( c_type == "long_double" )
-      tmp_type = "long double";
-   os <<
-      "// typedefs\n"
-      "typedef " + tmp_type + " float_point_t;\n"
-      "\n"
-   ;
-   //
-   // externals
-   os << "// externals\n";
-   size_t n_atomic = graph_obj.atomic_name_vec_size();
-   for(size_t i_atomic = 0; i_atomic < n_atomic; ++i_atomic)
-   {  string atomic_name = graph_obj.atomic_name_vec_get(i_atomic);
-      os << "extern int cppad_atomic_" + atomic_name + "(\n";
-      os <<
-         "\tsize_t               call_id           ,\n"
-         "\tsize_t               nx                ,\n"
-         "\tconst float_point_t* x                 ,\n"
-         "\tsize_t               ny                ,\n"
-         "\tfloat_point_t*       y                 ,\n"
-         "\tsize_t*              compare_change\n"
-         ");\n"
-      ;
-   }
-   size_t n_discrete = graph_obj.discrete_name_vec_size();
-   for(size_t i_discrete = 0; i_discrete < n_discrete; ++i_discrete)
-   {  string discrete_name = graph_obj.discrete_name_vec_get(i_discrete);
-      os << "extern float_point_t cppad_discrete_" + discrete_name;
-      os << "( float_point_t x );\n";
-   }
-   //
-   // azmul
-   os <<
-      "// azmul\n"
-      "static float_point_t azmul(float_point_t x, float_point_t y)\n"
-      "{\tif( x == 0.0 ) return 0.0;\n"
-      "\treturn x * y;\n"
-      "}\n\n"
-   ;
-   //
-   // sign
-   os <<
-      "// sign\n"
-      "static float_point_t sign(float_point_t x)\n"
-      "{\tif( x > 0.0 ) return 1.0;\n"
-      "\tif( x == 0.0 ) return 0.0;\n"
-      "\treturn -1.0;\n"
-      "}\n\n"
-   ;
-   //
-   // This JIT function
-   os <<
-      "// This JIT function\n"
-# ifdef _MSC_VER
-      "__declspec(dllexport) int __cdecl "
-# else
-      "int "
-# endif
-      "cppad_jit_" + function_name + "(\n"
-      "\tsize_t               nx              ,\n"
-      "\tconst float_point_t* x               ,\n"
-      "\tsize_t               ny              ,\n"
-      "\tfloat_point_t*       y               ,\n"
-      "\tsize_t*              compare_change  )\n"
-   ;
-   //
-   // begin function body
-   os <<
-      "{\t// begin function body \n"
-      "\n"
-   ;
-   //
-   // declare variables
-   // v, i, nan
-   os <<
-      "\t// declare variables\n"
-      "\tfloat_point_t v[" + to_string(n_node) + "];\n"
-      "\tsize_t i;\n"
-      "\n"
-      "\t// check nx, ny\n"
-   ;
-   //
-   // nx
-   size_t nx = n_dynamic_ind + n_variable_ind;
-   os << "\tif( nx != " + to_string(nx) + ") return 1;\n";
-   //
-   // ny
-   size_t ny = n_dependent;
-   os << "\tif( ny != " + to_string(ny) + ") return 2;\n";
-   //
-   // initialize
-   // compare_change, v[0]
-   os <<
-      "\n"
-      "\t// initialize\n"
-      "\t*compare_change = 0;\n"
-      "\tv[0]            = NAN; // const \n"
-   ;
-   //
-   // independent variables
-   // set v[1+i] for i = 0, ..., nx-1"
-   os <<
-      "\n"
-      "\t// independent variables\n"
-      "\t// set v[1+i] for i = 0, ..., nx-1\n"
-      "\tfor(i = 0; i < nx; ++i)\n"
-      "\t\tv[1+i] = x[i];\n"
-   ;
-   //
-   // cosntants
-   // set v[1+nx+i] for i = 0, ..., nc-1
-   size_t nc = n_constant;
-   os <<
-      "\n"
-      "\t// constants\n"
-      "\t// set v[1+nx+i] for i = 0, ..., nc-1\n"
-      "\t// nc = " + to_string(nc) + "\n"
-   ;
-   for(size_t i = 0; i < nc; ++i)
-   {  double c_i = graph_obj.constant_vec_get(i);
-      os <<
-         "\tv[1+nx+" + to_string(i) + "] = " + to_string(c_i) + ";\n"
-      ;
-   }
-   //
-   // result nodes
-   // set v[1+nx+nc+i] for i = 0, ..., n_result_node-1
-   size_t n_result_node = n_node - first_result_node;
-   os <<
-      "\n"
-      "\t// result nodes\n"
-      "\t// set v[1+nx+nc+i] for i = 0, ..., n_result_node-1\n"
-      "\t//n_result_node = " + to_string(n_result_node) + "\n"
-   ;
    //
-   // result_node
-   size_t result_node = first_result_node;
+   // graph_op_info
+   // information for one operator in the graph
+   struct graph_op_info {
+      graph_op_enum          op_enum;
+      size_t                 call_id;
+      size_t                 n_result;
+      size_t                 result_node;
+      CppAD::vector<size_t>  str_index;
+      CppAD::vector<size_t>  arg_node;
+   };
    //
-   // op_index
-   for(size_t op_index = 0; op_index < n_usage; ++op_index)
-   {  //
-      // graph_itr
-      if( op_index == 0 )
-         graph_itr = graph_obj.begin();
-      else
-         ++graph_itr;
+   // zero_order_op
+   // C source that computes the results for one operator
+   void zero_order_op(
+      std::ostream&                   os         ,
+      const CppAD::cpp_graph&         graph_obj  ,
+      const graph_op_info&            info       )
+   {  using std::string;
+      using namespace CppAD::graph;
+      using CppAD::local::graph::op_enum2name;
       //
       // str_index, op_enum, call_id, n_result, arg_node
-      cpp_graph::const_iterator::value_type itr_value = *graph_itr;
-      const vector<size_t>& str_index( *itr_value.str_index_ptr );
-      const vector<size_t>& arg_node(  *itr_value.arg_node_ptr  );
-      graph_op_enum op_enum    = itr_value.op_enum;
-      size_t        call_id    = itr_value.call_id;
-      size_t        n_result   = itr_value.n_result;
+      const CppAD::vector<size_t>& str_index( info.str_index );
+      const CppAD::vector<size_t>& arg_node(  info.arg_node  );
+      graph_op_enum op_enum     = info.op_enum;
+      size_t        call_id     = info.call_id;
+      size_t        n_result    = info.n_result;
+      size_t        result_node = info.result_node;
       CPPAD_ASSERT_UNKNOWN( arg_node.size() > 0 );
       //
       // op_csrc
@@ -527,9 +360,9 @@ void CppAD::local::graph::csrc_writer(
          break;
          //
          // discrete
+         case discrete_graph_op:
          CPPAD_ASSERT_UNKNOWN( arg_node.size() == 1 );
          CPPAD_ASSERT_UNKNOWN( n_result == 1 );
-         case discrete_graph_op:
          {  size_t index         = str_index[0];
             string discrete_name = graph_obj.discrete_name_vec_get(index);
             discrete_function(os,
@@ -542,26 +375,716 @@ void CppAD::local::graph::csrc_writer(
          CPPAD_ASSERT_UNKNOWN(false);
          break;
       }
-      //
-      // result_node
-      result_node += n_result;
-   }
-   // ----------------------------------------------------------------------
-   // dependent
-   os <<
-      "\n"
-      "\t// dependent variables\n"
-      "\t// set y[i] for i = 0, ny-1\n"
-   ;
-   for(size_t i = 0; i < ny; ++i)
-   {  size_t node = graph_obj.dependent_vec_get(i);
-      os << "\t" + element("y", i) + " = " + element("v", node) + ";\n";
    }
-   // ----------------------------------------------------------------------
-   // end function body
-   os << "\n";
-   os << "\treturn 0;\n";
-   os << "}\n";
+   //
+   // unary_partial
+   // C source for the derivative of a unary function where a is the
+   // argument and z is the result
+   std::string unary_partial(
+      graph_op_enum      op_enum ,
+      const std::string& a       ,
+      const std::string& z       )
+   {  using namespace CppAD::graph;
+      //
+      // two_over_sqrt_pi
+      const char* two_over_sqrt_pi = "1.12837916709551257389615890312154517";
+      //
+      std::string result;
+      switch( op_enum )
+      {
+         case abs_graph_op:
+         result = "sign( " + a + " )";
+         break;
+
+         case acos_graph_op:
+         result = "- 1.0 / sqrt( 1.0 - " + a + " * " + a + " )";
+         break;
+
+         case acosh_graph_op:
+         result = "1.0 / sqrt( " + a + " * " + a + " - 1.0 )";
+         break;
+
+         case asin_graph_op:
+         result = "1.0 / sqrt( 1.0 - " + a + " * " + a + " )";
+         break;
+
+         case asinh_graph_op:
+         result = "1.0 / sqrt( " + a + " * " + a + " + 1.0 )";
+         break;
+
+         case atan_graph_op:
+         result = "1.0 / ( 1.0 + " + a + " * " + a + " )";
+         break;
+
+         case atanh_graph_op:
+         result = "1.0 / ( 1.0 - " + a + " * " + a + " )";
+         break;
+
+         case cos_graph_op:
+         result = "- sin( " + a + " )";
+         break;
+
+         case cosh_graph_op:
+         result = "sinh( " + a + " )";
+         break;
+
+         case erf_graph_op:
+         result = std::string(two_over_sqrt_pi);
+         result += " * exp( - " + a + " * " + a + " )";
+         break;
+
+         case erfc_graph_op:
+         result = "- " + std::string(two_over_sqrt_pi);
+         result += " * exp( - " + a + " * " + a + " )";
+         break;
+
+         case exp_graph_op:
+         result = z;
+         break;
+
+         case expm1_graph_op:
+         result = z + " + 1.0";
+         break;
+
+         case log1p_graph_op:
+         result = "1.0 / ( 1.0 + " + a + " )";
+         break;
+
+         case log_graph_op:
+         result = "1.0 / " + a;
+         break;
+
+         case sign_graph_op:
+         result = "0.0";
+         break;
+
+         case sin_graph_op:
+         result = "cos( " + a + " )";
+         break;
+
+         case sinh_graph_op:
+         result = "cosh( " + a + " )";
+         break;
+
+         case sqrt_graph_op:
+         result = "0.5 / " + z;
+         break;
+
+         case tan_graph_op:
+         result = "1.0 + " + z + " * " + z;
+         break;
+
+         case tanh_graph_op:
+         result = "1.0 - " + z + " * " + z;
+         break;
+
+         default:
+         CPPAD_ASSERT_UNKNOWN(false);
+         break;
+      }
+      return result;
+   }
+   //
+   // forward_one_op
+   // C source that computes the directional derivative of the results
+   // for one operator (atomic functions are not included)
+   void forward_one_op(
+      std::ostream&         os    ,
+      const graph_op_info&  info  )
+   {  using std::string;
+      using namespace CppAD::graph;
+      //
+      const CppAD::vector<size_t>& arg_node( info.arg_node );
+      graph_op_enum op_enum = info.op_enum;
+      //
+      // compare operators do not have results
+      if( info.n_result == 0 )
+         return;
+      CPPAD_ASSERT_UNKNOWN( info.n_result == 1 );
+      //
+      // z, dz, a, da
+      string z  = element("v",  info.result_node);
+      string dz = element("dv", info.result_node);
+      string a  = element("v",  arg_node[0]);
+      string da = element("dv", arg_node[0]);
+      //
+      // b, db
+      string b, db;
+      if( arg_node.size() > 1 )
+      {  b  = element("v",  arg_node[1]);
+         db = element("dv", arg_node[1]);
+      }
+      //
+      os << "\t" + dz + " = ";
+      switch( op_enum )
+      {
+         case add_graph_op:
+         os << da + " + " + db;
+         break;
+
+         case sub_graph_op:
+         os << da + " - " + db;
+         break;
+
+         case mul_graph_op:
+         os << da + " * " + b + " + " + a + " * " + db;
+         break;
+
+         case div_graph_op:
+         os << "( " + da + " - " + z + " * " + db + " ) / " + b;
+         break;
+
+         case azmul_graph_op:
+         os << "azmul( " + da + ", " + b + " ) + azmul( " + a + ", " + db + " )";
+         break;
+
+         case pow_graph_op:
+         os << "azmul( " + da + ", " + b + " * pow( " + a + ", " + b;
+         os << " - 1.0 ) ) + azmul( " + db + ", " + z + " * log( " + a;
+         os << " ) )";
+         break;
+
+         // discrete functions are piecewise constant
+         case discrete_graph_op:
+         os << "0.0";
+         break;
+
+         default:
+         CPPAD_ASSERT_UNKNOWN( arg_node.size() == 1 );
+         os << "azmul( " + da + ", " + unary_partial(op_enum, a, z) + " )";
+         break;
+      }
+      os << ";\n";
+   }
+   //
+   // reverse_one_op
+   // C source that adds the partials for the arguments of one operator
+   // (atomic functions are not included)
+   void reverse_one_op(
+      std::ostream&         os      ,
+      const std::string&    indent  ,
+      const graph_op_info&  info    )
+   {  using std::string;
+      using namespace CppAD::graph;
+      //
+      const CppAD::vector<size_t>& arg_node( info.arg_node );
+      graph_op_enum op_enum = info.op_enum;
+      //
+      // compare operators do not have results and
+      // discrete functions are piecewise constant
+      if( info.n_result == 0 || op_enum == discrete_graph_op )
+         return;
+      CPPAD_ASSERT_UNKNOWN( info.n_result == 1 );
+      //
+      // z, pz, a, pa
+      string z  = element("v",  info.result_node);
+      string pz = element("pv", info.result_node);
+      string a  = element("v",  arg_node[0]);
+      string pa = element("pv", arg_node[0]);
+      //
+      // b, pb
+      string b, pb;
+      if( arg_node.size() > 1 )
+      {  b  = element("v",  arg_node[1]);
+         pb = element("pv", arg_node[1]);
+      }
+      //
+      switch( op_enum )
+      {
+         case add_graph_op:
+         os << indent + pa + " += " + pz + ";\n";
+         os << indent + pb + " += " + pz + ";\n";
+         break;
+
+         case sub_graph_op:
+         os << indent + pa + " += " + pz + ";\n";
+         os << indent + pb + " -= " + pz + ";\n";
+         break;
+
+         case mul_graph_op:
+         case azmul_graph_op:
+         os << indent + pa + " += azmul( " + pz + ", " + b + " );\n";
+         os << indent + pb + " += azmul( " + a + ", " + pz + " );\n";
+         break;
+
+         case div_graph_op:
+         os << indent + pa + " += azmul( " + pz + ", 1.0 / " + b + " );\n";
+         os << indent + pb + " -= azmul( " + pz + ", " + z + " / " + b;
+         os << " );\n";
+         break;
+
+         case pow_graph_op:
+         os << indent + pa + " += azmul( " + pz + ", " + b + " * pow( ";
+         os << a + ", " + b + " - 1.0 ) );\n";
+         os << indent + pb + " += azmul( " + pz + ", " + z + " * log( ";
+         os << a + " ) );\n";
+         break;
+
+         default:
+         CPPAD_ASSERT_UNKNOWN( arg_node.size() == 1 );
+         os << indent + pa + " += azmul( " + pz + ", ";
+         os << unary_partial(op_enum, a, z) + " );\n";
+         break;
+      }
+   }
+   //
+   // jit_function_begin
+   // C source for the start of a function with the jit calling convention
+   void jit_function_begin(
+      std::ostream&       os            ,
+      const std::string&  comment       ,
+      const std::string&  complete_name ,
+      const std::string&  nu            ,
+      const std::string&  u             ,
+      const std::string&  ny            ,
+      const std::string&  y             )
+   {  // pad
+      // names are padded to the same width as in the zero order function
+      std::string pad_nu( 20 - nu.size(), ' ');
+      std::string pad_u(  20 - u.size(),  ' ');
+      std::string pad_ny( 20 - ny.size(), ' ');
+      std::string pad_y(  20 - y.size(),  ' ');
+      os <<
+         "// " + comment + "\n"
+# ifdef _MSC_VER
+         "__declspec(dllexport) int __cdecl "
+# else
+         "int "
+# endif
+         + complete_name + "(\n"
+         "\tsize_t               " + nu + pad_nu + ",\n"
+         "\tconst float_point_t* " + u  + pad_u  + ",\n"
+         "\tsize_t               " + ny + pad_ny + ",\n"
+         "\tfloat_point_t*       " + y  + pad_y  + ",\n"
+         "\tsize_t*              compare_change  )\n"
+      ;
+   }
+}
+
+// BEGIN_PROTOTYPE
+void CppAD::local::graph::csrc_writer(
+   std::ostream&                             os                     ,
+   const cpp_graph&                          graph_obj              ,
+   const std::string&                        c_type                 )
+// END_PROTOTYPE
+{  using std::string;
+   using CppAD::to_string;
+   //
+   // --------------------------------------------------------------------
+   string function_name  = graph_obj.function_name_get();
+   size_t n_dynamic_ind  = graph_obj.n_dynamic_ind_get();
+   size_t n_variable_ind = graph_obj.n_variable_ind_get();
+   size_t n_constant     = graph_obj.constant_vec_size();
+   size_t n_dependent    = graph_obj.dependent_vec_size();
+   size_t n_usage        = graph_obj.operator_vec_size();
+   // --------------------------------------------------------------------
+   CPPAD_ASSERT_KNOWN( function_name != "" ,
+      "to_csrc: Cannot convert a function with no name"
+   );
+   //
+   // graph_itr
+   // defined here because not using as loop index
+   cpp_graph::const_iterator graph_itr;
+   //
+   // first_result_node
+   size_t first_result_node = 1 + n_dynamic_ind + n_variable_ind + n_constant;
+   //
+   // n_node, op_info, has_atomic
+   size_t n_node = first_result_node;
+   CppAD::vector<graph_op_info> op_info(n_usage);
+   bool has_atomic = false;
+   for(size_t op_index = 0; op_index < n_usage; ++op_index)
+   {  // graph_itr
+      if( op_index == 0 )
+         graph_itr = graph_obj.begin();
+      else
+         ++graph_itr;
+      //
+      // op_info
+      cpp_graph::const_iterator::value_type itr_value = *graph_itr;
+      op_info[op_index].op_enum     = itr_value.op_enum;
+      op_info[op_index].call_id     = itr_value.call_id;
+      op_info[op_index].n_result    = itr_value.n_result;
+      op_info[op_index].result_node = n_node;
+      op_info[op_index].str_index   = *itr_value.str_index_ptr;
+      op_info[op_index].arg_node    = *itr_value.arg_node_ptr;
+      has_atomic |= itr_value.op_enum == atom4_graph_op;
+      //
+      // nv
+      n_node += itr_value.n_result;
+   }
+   //
+   // includes
+   os <<
+      "// includes\n"
+      "# include <stddef.h>\n"
+      "# include <math.h>\n"
+      "\n"
+   ;
+   //
+   // typedefs
+   string tmp_type = c_type;
+   if( c_type == "long_double" )
+      tmp_type = "long double";
+   os <<
+      "// typedefs\n"
+      "typedef " + tmp_type + " float_point_t;\n"
+      "\n"
+   ;
+   //
+   // externals
+   os << "// externals\n";
+   size_t n_atomic = graph_obj.atomic_name_vec_size();
+   for(size_t i_atomic = 0; i_atomic < n_atomic; ++i_atomic)
+   {  string atomic_name = graph_obj.atomic_name_vec_get(i_atomic);
+      os << "extern int cppad_atomic_" + atomic_name + "(\n";
+      os <<
+         "\tsize_t               call_id           ,\n"
+         "\tsize_t               nx                ,\n"
+         "\tconst float_point_t* x                 ,\n"
+         "\tsize_t               ny                ,\n"
+         "\tfloat_point_t*       y                 ,\n"
+         "\tsize_t*              compare_change\n"
+         ");\n"
+      ;
+   }
+   size_t n_discrete = graph_obj.discrete_name_vec_size();
+   for(size_t i_discrete = 0; i_discrete < n_discrete; ++i_discrete)
+   {  string discrete_name = graph_obj.discrete_name_vec_get(i_discrete);
+      os << "extern float_point_t cppad_discrete_" + discrete_name;
+      os << "( float_point_t x );\n";
+   }
+   //
+   // azmul
+   os <<
+      "// azmul\n"
+      "static float_point_t azmul(float_point_t x, float_point_t y)\n"
+      "{\tif( x == 0.0 ) return 0.0;\n"
+      "\treturn x * y;\n"
+      "}\n\n"
+   ;
+   //
+   // sign
+   os <<
+      "// sign\n"
+      "static float_point_t sign(float_point_t x)\n"
+      "{\tif( x > 0.0 ) return 1.0;\n"
+      "\tif( x == 0.0 ) return 0.0;\n"
+      "\treturn -1.0;\n"
+      "}\n\n"
+   ;
+   //
+   // nx, ny, nc
+   size_t nx = n_dynamic_ind + n_variable_ind;
+   size_t ny = n_dependent;
+   size_t nc = n_constant;
+   //
+   // zero_name
+   string zero_name = "cppad_zero_" + function_name;
+   // ----------------------------------------------------------------------
+   // Zero order forward mode
+   // ----------------------------------------------------------------------
+   os <<
+      "// Zero order forward mode\n"
+      "// v[1+i], i = 0, ..., nx-1 are set by the calling routine\n"
+      "static int " + zero_name + "(\n"
+      "\tfloat_point_t*       v               ,\n"
+      "\tsize_t*              compare_change  )\n"
+      "{\n"
+      "\t// initialize\n"
+      "\t*compare_change = 0;\n"
+      "\tv[0]            = NAN; // const \n"
+   ;
+   //
+   // cosntants
+   // set v[1+nx+i] for i = 0, ..., nc-1
+   os <<
+      "\n"
+      "\t// constants\n"
+      "\t// set v[1+nx+i] for i = 0, ..., nc-1\n"
+      "\t// nc = " + to_string(nc) + "\n"
+   ;
+   for(size_t i = 0; i < nc; ++i)
+   {  double c_i = graph_obj.constant_vec_get(i);
+      os << "\t" + element("v", 1 + nx + i) + " = " + to_string(c_i) + ";\n";
+   }
+   //
+   // result nodes
+   // set v[1+nx+nc+i] for i = 0, ..., n_result_node-1
+   size_t n_result_node = n_node - first_result_node;
+   os <<
+      "\n"
+      "\t// result nodes\n"
+      "\t// set v[1+nx+nc+i] for i = 0, ..., n_result_node-1\n"
+      "\t//n_result_node = " + to_string(n_result_node) + "\n"
+   ;
+   for(size_t op_index = 0; op_index < n_usage; ++op_index)
+      zero_order_op(os, graph_obj, op_info[op_index]);
+   os << "\n";
+   os << "\treturn 0;\n";
+   os << "}\n\n";
+   // ----------------------------------------------------------------------
+   // This JIT function
+   // ----------------------------------------------------------------------
+   jit_function_begin(os, "This JIT function",
+      "cppad_jit_" + function_name, "nx", "x", "ny", "y"
+   );
+   //
+   // begin function body
+   os <<
+      "{\t// begin function body \n"
+      "\n"
+   ;
+   //
+   // declare variables
+   // v, i, flag
+   os <<
+      "\t// declare variables\n"
+      "\tfloat_point_t v[" + to_string(n_node) + "];\n"
+      "\tsize_t i;\n"
+      "\tint flag;\n"
+      "\n"
+      "\t// check nx, ny\n"
+   ;
+   //
+   // nx
+   os << "\tif( nx != " + to_string(nx) + ") return 1;\n";
+   //
+   // ny
+   os << "\tif( ny != " + to_string(ny) + ") return 2;\n";
+   //
+   // independent variables
+   // set v[1+i] for i = 0, ..., nx-1"
+   os <<
+      "\n"
+      "\t// independent variables\n"
+      "\t// set v[1+i] for i = 0, ..., nx-1\n"
+      "\tfor(i = 0; i < nx; ++i)\n"
+      "\t\tv[1+i] = x[i];\n"
+   ;
+   //
+   // zero order forward mode
+   os <<
+      "\n"
+      "\t// zero order forward mode\n"
+      "\tflag = " + zero_name + "(v, compare_change);\n"
+      "\tif( flag != 0 ) return flag;\n"
+   ;
+   // ----------------------------------------------------------------------
+   // dependent
+   os <<
+      "\n"
+      "\t// dependent variables\n"
+      "\t// set y[i] for i = 0, ny-1\n"
+   ;
+   for(size_t i = 0; i < ny; ++i)
+   {  size_t node = graph_obj.dependent_vec_get(i);
+      os << "\t" + element("y", i) + " = " + element("v", node) + ";\n";
+   }
+   // ----------------------------------------------------------------------
+   // end function body
+   os << "\n";
+   os << "\treturn 0;\n";
+   os << "}\n\n";
+   // ----------------------------------------------------------------------
+   // First order forward mode
+   // ----------------------------------------------------------------------
+   jit_function_begin(os, "First order forward mode",
+      "cppad_jit_" + function_name + "_forward_one", "nu", "u", "nz", "z"
+   );
+   os <<
+      "{\t// begin function body \n"
+      "\n"
+   ;
+   if( has_atomic )
+   {  os <<
+         "\t// derivatives of atomic functions are not available\n"
+         "\treturn 4;\n"
+         "}\n\n"
+      ;
+   }
+   else
+   {  os <<
+         "\t// declare variables\n"
+         "\tfloat_point_t v[" + to_string(n_node) + "];\n"
+         "\tfloat_point_t dv[" + to_string(n_node) + "];\n"
+         "\tsize_t i;\n"
+         "\tint flag;\n"
+         "\n"
+         "\t// check nu, nz\n"
+         "\tif( nu != " + to_string(2 * nx) + ") return 1;\n"
+         "\tif( nz != " + to_string(2 * ny) + ") return 2;\n"
+         "\n"
+         "\t// independent variables and their directions\n"
+         "\tfor(i = 0; i < " + to_string(nx) + "; ++i)\n"
+         "\t{\tv[1+i]  = u[i];\n"
+         "\t\tdv[1+i] = u[" + to_string(nx) + "+i];\n"
+         "\t}\n"
+         "\n"
+         "\t// zero order forward mode\n"
+         "\tflag = " + zero_name + "(v, compare_change);\n"
+         "\tif( flag != 0 ) return flag;\n"
+         "\n"
+         "\t// constants\n"
+         "\tdv[0] = 0.0;\n"
+         "\tfor(i = 0; i < " + to_string(nc) + "; ++i)\n"
+         "\t\tdv[" + to_string(1 + nx) + "+i] = 0.0;\n"
+         "\n"
+         "\t// result nodes\n"
+      ;
+      for(size_t op_index = 0; op_index < n_usage; ++op_index)
+         forward_one_op(os, op_info[op_index]);
+      //
+      os <<
+         "\n"
+         "\t// dependent variables and their directional derivatives\n"
+      ;
+      for(size_t i = 0; i < ny; ++i)
+      {  size_t node = graph_obj.dependent_vec_get(i);
+         os << "\t" + element("z", i) + " = " + element("v", node) + ";\n";
+         os << "\t" + element("z", ny + i) + " = ";
+         os << element("dv", node) + ";\n";
+      }
+      os << "\n";
+      os << "\treturn 0;\n";
+      os << "}\n\n";
+   }
+   // ----------------------------------------------------------------------
+   // First order reverse mode
+   // ----------------------------------------------------------------------
+   jit_function_begin(os, "First order reverse mode",
+      "cppad_jit_" + function_name + "_reverse_one", "nu", "u", "nz", "z"
+   );
+   os <<
+      "{\t// begin function body \n"
+      "\n"
+   ;
+   if( has_atomic )
+   {  os <<
+         "\t// derivatives of atomic functions are not available\n"
+         "\treturn 4;\n"
+         "}\n\n"
+      ;
+   }
+   else
+   {  os <<
+         "\t// declare variables\n"
+         "\tfloat_point_t v[" + to_string(n_node) + "];\n"
+         "\tfloat_point_t pv[" + to_string(n_node) + "];\n"
+         "\tsize_t i;\n"
+         "\tint flag;\n"
+         "\n"
+         "\t// check nu, nz\n"
+         "\tif( nu != " + to_string(nx + ny) + ") return 1;\n"
+         "\tif( nz != " + to_string(nx) + ") return 2;\n"
+         "\n"
+         "\t// independent variables\n"
+         "\tfor(i = 0; i < " + to_string(nx) + "; ++i)\n"
+         "\t\tv[1+i] = u[i];\n"
+         "\n"
+         "\t// zero order forward mode\n"
+         "\tflag = " + zero_name + "(v, compare_change);\n"
+         "\tif( flag != 0 ) return flag;\n"
+         "\n"
+         "\t// partials for the dependent variables\n"
+         "\tfor(i = 0; i < " + to_string(n_node) + "; ++i)\n"
+         "\t\tpv[i] = 0.0;\n"
+      ;
+      for(size_t i = 0; i < ny; ++i)
+      {  size_t node = graph_obj.dependent_vec_get(i);
+         os << "\t" + element("pv", node) + " += ";
+         os << element("u", nx + i) + ";\n";
+      }
+      os <<
+         "\n"
+         "\t// result nodes in reverse order\n"
+      ;
+      for(size_t op_index = n_usage; op_index > 0; --op_index)
+         reverse_one_op(os, "\t", op_info[op_index - 1]);
+      //
+      os <<
+         "\n"
+         "\t// partials for the independent variables\n"
+         "\tfor(i = 0; i < " + to_string(nx) + "; ++i)\n"
+         "\t\tz[i] = pv[1+i];\n"
+         "\n"
+         "\treturn 0;\n"
+         "}\n\n"
+      ;
+   }
+   // ----------------------------------------------------------------------
+   // Jacobian
+   // ----------------------------------------------------------------------
+   jit_function_begin(os, "Jacobian",
+      "cppad_jit_" + function_name + "_jacobian", "nx", "x", "nz", "z"
+   );
+   os <<
+      "{\t// begin function body \n"
+      "\n"
+   ;
+   if( has_atomic )
+   {  os <<
+         "\t// derivatives of atomic functions are not available\n"
+         "\treturn 4;\n"
+         "}\n"
+      ;
+   }
+   else
+   {  os <<
+         "\t// declare variables\n"
+         "\tfloat_point_t v[" + to_string(n_node) + "];\n"
+         "\tfloat_point_t pv[" + to_string(n_node) + "];\n"
+         "\tsize_t i, k;\n"
+         "\tint flag;\n"
+      ;
+      if( ny > 0 )
+      {  os << "\tstatic const size_t dep_node[" + to_string(ny) + "] = {";
+         for(size_t i = 0; i < ny; ++i)
+         {  if( i > 0 )
+               os << ",";
+            if( i % 10 == 0 )
+               os << "\n\t\t";
+            else
+               os << " ";
+            os << to_string( graph_obj.dependent_vec_get(i) );
+         }
+         os << "\n\t};\n";
+      }
+      os <<
+         "\n"
+         "\t// check nx, nz\n"
+         "\tif( nx != " + to_string(nx) + ") return 1;\n"
+         "\tif( nz != " + to_string(ny * nx) + ") return 2;\n"
+         "\n"
+         "\t// independent variables\n"
+         "\tfor(i = 0; i < nx; ++i)\n"
+         "\t\tv[1+i] = x[i];\n"
+         "\n"
+         "\t// zero order forward mode\n"
+         "\tflag = " + zero_name + "(v, compare_change);\n"
+         "\tif( flag != 0 ) return flag;\n"
+         "\n"
+         "\t// z[k*nx+i] = partial of k-th dependent w.r.t. i-th independent\n"
+         "\tfor(k = 0; k < " + to_string(ny) + "; ++k)\n"
+         "\t{\tfor(i = 0; i < " + to_string(n_node) + "; ++i)\n"
+         "\t\t\tpv[i] = 0.0;\n"
+      ;
+      if( ny > 0 )
+         os << "\t\tpv[ dep_node[k] ] = 1.0;\n";
+      os << "\n";
+      for(size_t op_index = n_usage; op_index > 0; --op_index)
+         reverse_one_op(os, "\t\t", op_info[op_index - 1]);
+      //
+      os <<
+         "\n"
+         "\t\tfor(i = 0; i < nx; ++i)\n"
+         "\t\t\tz[k*nx+i] = pv[1+i];\n"
+         "\t}\n"
+         "\n"
+         "\treturn 0;\n"
+         "}\n"
+      ;
+   }
    //
    return;
 }
@@ -1,8 +1,9 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cctype>
+# include <algorithm>
 # include <cppad/local/graph/json_lexer.hpp>
 # include <cppad/local/graph/cpp_graph_op.hpp>
 # include <cppad/utility/error_handler.hpp>
@@ -19,11 +20,14 @@ void json_lexer::report_error(
    const std::string& found    )
 {  size_t pos = index_;
    size_t count_newline = 0;
-   while(0 < pos && count_newline < 2 )
+   while(data_begin_ < pos && count_newline < 2 )
    {  --pos;
-      count_newline += json_[pos] == '\n';
+      count_newline += at(pos) == '\n';
    }
-   std::string recent_input = json_.substr( pos, index_ - pos + 1);
+   size_t end = std::min(index_ + 1, data_end_);
+   std::string recent_input = "";
+   if( pos < end )
+      recent_input = std::string( data_ + (pos - data_begin_), end - pos );
 
    std::string msg = "Error occurred while parsing Json AD graph";
    if( function_name_ != "" )
@@ -46,10 +50,41 @@ void json_lexer::report_error(
    ErrorHandler::Call(known, line, file, exp, msg.c_str());
 }
 
+// more
+bool json_lexer::more(size_t index)
+{  if( index < data_end_ )
+      return true;
+   if( is_ == nullptr )
+      return false;
+   //
+   // keep: index of first character that is kept in memory
+   // (some characters before index_ are kept for error reporting)
+   size_t keep = data_begin_;
+   if( keep + 2 * chunk_size < index_ )
+      keep = index_ - chunk_size;
+   CPPAD_ASSERT_UNKNOWN( keep <= index_ );
+   //
+   // buffer_
+   buffer_.erase(0, keep - data_begin_);
+   while( keep + buffer_.size() <= index && is_->good() )
+   {  size_t n_old = buffer_.size();
+      buffer_.resize(n_old + chunk_size);
+      is_->read(&buffer_[n_old], std::streamsize(chunk_size) );
+      buffer_.resize( n_old + size_t( is_->gcount() ) );
+   }
+   //
+   // data_, data_begin_, data_end_
+   data_       = buffer_.data();
+   data_begin_ = keep;
+   data_end_   = keep + buffer_.size();
+   //
+   return index < data_end_;
+}
+
 // next_index
 void json_lexer::next_index(void)
-{  CPPAD_ASSERT_UNKNOWN( index_ < json_.size() );
-   if( json_[index_] == '\n' )
+{  CPPAD_ASSERT_UNKNOWN( index_ < data_end_ );
+   if( at(index_) == '\n' )
    {  ++line_number_;
       char_number_ = 0;
    }
@@ -59,34 +94,56 @@ void json_lexer::next_index(void)
 
 // skip_white_space
 void json_lexer::skip_white_space(void)
-{  while( index_ < json_.size() && isspace( json_[index_] ) )
+{  while( more(index_) && isspace( at(index_) ) )
       next_index();
 }
 
-// constructor
-json_lexer::json_lexer(const std::string& json)
-:
-json_(json),
-index_(0),
-line_number_(1),
-char_number_(1),
-token_(""),
-function_name_("")
-{
-   skip_white_space();
-   if( index_ < json_.size() )
-      token_ = json_[index_];
+// check_first_char
+void json_lexer::check_first_char(void)
+{  skip_white_space();
+   if( more(index_) )
+      token_ = at(index_);
    if( token_ != "{" )
    {  std::string expected = "'{'";
       std::string found    = "'";
-      if( index_ < json_.size() )
-         found += json_[index_];
+      if( more(index_) )
+         found += at(index_);
       found += "'";
       report_error(expected, found);
    }
    return;
 }
 
+// constructor
+json_lexer::json_lexer(const std::string& json)
+:
+is_(nullptr),
+buffer_(""),
+data_( json.data() ),
+data_begin_(0),
+data_end_( json.size() ),
+index_(0),
+line_number_(1),
+char_number_(1),
+token_(""),
+function_name_("")
+{  check_first_char(); }
+
+// constructor
+json_lexer::json_lexer(std::istream& is)
+:
+is_(&is),
+buffer_(""),
+data_( buffer_.data() ),
+data_begin_(0),
+data_end_(0),
+index_(0),
+line_number_(1),
+char_number_(1),
+token_(""),
+function_name_("")
+{  check_first_char(); }
+
 
 // token
 const std::string& json_lexer::token(void) const
@@ -115,14 +172,14 @@ double json_lexer::token2double(void) const
 // check_next_char
 void json_lexer::check_next_char(char ch)
 {  // advance to next character
-   if( index_ < json_.size() )
+   if( more(index_) )
       next_index();
    skip_white_space();
    //
    bool ok = false;
-   if( index_ < json_.size() )
+   if( more(index_) )
    {  token_.resize(1);
-      token_[0] = json_[index_];
+      token_[0] = at(index_);
       ok = (token_[0] == ch) | (ch == '\0');
    }
    if( ! ok )
@@ -134,8 +191,8 @@ void json_lexer::check_next_char(char ch)
       }
       //
       std::string found = "'";
-      if( index_ < json_.size() )
-         found += json_[index_];;
+      if( more(index_) )
+         found += at(index_);
       found += "'";
       report_error(expected, found);
    }
@@ -144,29 +201,29 @@ void json_lexer::check_next_char(char ch)
 // check_next_string
 void json_lexer::check_next_string(const std::string& expected)
 {  // advance to next character
-   bool found_first_quote = index_ < json_.size();
+   bool found_first_quote = more(index_);
    if( found_first_quote )
    {  next_index();
       skip_white_space();
-      found_first_quote = index_ < json_.size();
+      found_first_quote = more(index_);
    }
    // check for "
    if( found_first_quote )
-      found_first_quote = json_[index_] == '"';
+      found_first_quote = at(index_) == '"';
    //
    // set value of token
    token_.resize(0);
    if( found_first_quote )
    {  next_index();
-      while( index_ < json_.size() && json_[index_] != '"' )
-      {  token_.push_back( json_[index_] );
+      while( more(index_) && at(index_) != '"' )
+      {  token_.push_back( at(index_) );
          next_index();
       }
    }
    // check for "
    bool found_second_quote = false;
-   if( found_first_quote && index_ < json_.size() )
-      found_second_quote = json_[index_] == '"';
+   if( found_first_quote && more(index_) )
+      found_second_quote = at(index_) == '"';
    //
    bool ok = found_first_quote & found_second_quote;
    if( ok & (expected != "" ) )
@@ -184,8 +241,8 @@ void json_lexer::check_next_string(const std::string& expected)
       std::string found;
       if( ! found_first_quote )
       {  found = "'";
-         if( index_ < json_.size() )
-            found += json_[index_];
+         if( more(index_) )
+            found += at(index_);
          found += "'";
       }
       else
@@ -201,29 +258,29 @@ void json_lexer::check_next_string(const std::string& expected)
 // next_non_neg_int
 void json_lexer::next_non_neg_int(void)
 {  // advance to next character
-   bool ok = index_ < json_.size();
+   bool ok = more(index_);
    if( ok )
    {  next_index();
       skip_white_space();
-      ok = index_ < json_.size();
+      ok = more(index_);
    }
    if( ok )
-      ok = std::isdigit( json_[index_] );
+      ok = std::isdigit( at(index_) );
    if( ! ok )
    {  std::string expected_token = "non-negative integer";
       std::string found = "'";
-      if( index_ < json_.size() )
-         found += json_[index_];
+      if( more(index_) )
+         found += at(index_);
       found += "'";
       report_error(expected_token, found);
    }
    //
    token_.resize(0);
    while( ok )
-   {  token_.push_back( json_[index_] );
-      ok = index_ + 1 < json_.size();
+   {  token_.push_back( at(index_) );
+      ok = more(index_ + 1);
       if( ok )
-         ok = isdigit( json_[index_ + 1] );
+         ok = isdigit( at(index_ + 1) );
       if( ok )
          next_index();
    }
@@ -232,14 +289,14 @@ void json_lexer::next_non_neg_int(void)
 // next_float
 void json_lexer::next_float(void)
 {  // advance to next character
-   bool ok = index_ < json_.size();
+   bool ok = more(index_);
    if( ok )
    {  next_index();
       skip_white_space();
-      ok = index_ < json_.size();
+      ok = more(index_);
    }
    if( ok )
-   {  char ch = json_[index_];
+   {  char ch = at(index_);
       ok = std::isdigit(ch);
       ok |= (ch == '.') | (ch == '+') | (ch == '-');
       ok |= (ch == 'e') | (ch == 'E');
@@ -247,18 +304,18 @@ void json_lexer::next_float(void)
    if( ! ok )
    {  std::string expected_token = "floating point number";
       std::string found = "'";
-      if( index_ < json_.size() )
-         found += json_[index_];
+      if( more(index_) )
+         found += at(index_);
       found += "'";
       report_error(expected_token, found);
    }
    //
    token_.resize(0);
    while( ok )
-   {  token_.push_back( json_[index_] );
-      ok = index_ + 1 < json_.size();
+   {  token_.push_back( at(index_) );
+      ok = more(index_ + 1);
       if( ok )
-      {  char ch  = json_[index_ + 1];
+      {  char ch  = at(index_ + 1);
          ok  = isdigit(ch);
          ok |= (ch == '.') | (ch == '+') | (ch == '-');
          ok |= (ch == 'e') | (ch == 'E');
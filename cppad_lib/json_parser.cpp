@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 
@@ -13,10 +13,13 @@
 // documentation for this routine is in the file below
 # include <cppad/local/graph/json_parser.hpp>
 
-void CppAD::local::graph::json_parser(
-   const std::string& json      ,
-   cpp_graph&         graph_obj )
+namespace {
+// parse a Json AD graph using the specified lexer
+void parse_graph(
+   CppAD::local::graph::json_lexer& json_lexer ,
+   CppAD::cpp_graph&                graph_obj  )
 {  using std::string;
+   using namespace CppAD::local::graph;
    //
    //
    // match_any_string
@@ -30,8 +33,7 @@ void CppAD::local::graph::json_parser(
    CppAD::vector<graph_op_enum> op_code2enum(1);
    //
    // -----------------------------------------------------------------------
-   // json_lexer constructor checks for { at beginning
-   CppAD::local::graph::json_lexer json_lexer(json);
+   // json_lexer constructor has checked for { at beginning
    //
    // "function_name" : function_name
    json_lexer.check_next_string("function_name");
@@ -328,3 +330,20 @@ void CppAD::local::graph::json_parser(
    //
    return;
 }
+}
+
+void CppAD::local::graph::json_parser(
+   const std::string& json      ,
+   cpp_graph&         graph_obj )
+{  // json_lexer constructor checks for { at beginning
+   CppAD::local::graph::json_lexer json_lexer(json);
+   parse_graph(json_lexer, graph_obj);
+}
+
+void CppAD::local::graph::json_parser(
+   std::istream&      is        ,
+   cpp_graph&         graph_obj )
+{  // json_lexer constructor checks for { at beginning
+   CppAD::local::graph::json_lexer json_lexer(is);
+   parse_graph(json_lexer, graph_obj);
+}
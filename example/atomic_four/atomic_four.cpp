@@ -19,8 +19,10 @@
 # include <cppad/utility/test_boolofvoid.hpp>
 
 // BEGIN_SORT_THIS_LINE_PLUS_1
+extern bool batch(void);
 extern bool dynamic(void);
 extern bool forward(void);
+extern bool forward_ptr(void);
 extern bool get_started(void);
 extern bool norm_sq(void);
 // END_SORT_THIS_LINE_MINUS_1
@@ -34,8 +36,10 @@ int main(void)
    // This line is used by test_one.sh
 
    // BEGIN_SORT_THIS_LINE_PLUS_1
+   Run( batch,               "batch"          );
    Run( dynamic,             "dynamic"        );
    Run( forward,             "forward"        );
+   Run( forward_ptr,         "forward_ptr"    );
    Run( get_started,         "get_started"    );
    Run( norm_sq,             "norm_sq"        );
    // END_SORT_THIS_LINE_MINUS_1
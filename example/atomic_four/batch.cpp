@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_four_batch.cpp}
+
+Atomic Functions Batched Forward and Reverse: Example and Test
+##############################################################
+
+Purpose
+*******
+This example demonstrates the
+:ref:`atomic_four_batch-name` callbacks.
+
+Atomic Function
+***************
+For this example, the atomic function
+:math:`g : \B{R}^2 \rightarrow \B{R}` is defined by
+:math:`g(x) = x_0 * x_1` .
+
+f(u)
+****
+The function :math:`f : \B{R}^4 \rightarrow \B{R}^5` is defined by
+:math:`f_i (u) = g( u_i , u_{i+1} )` for :math:`i = 0 , \ldots , 3`
+(where :math:`u_4 = u_0` ) and
+:math:`f_4 (u) = f_0 (u) + \cdots + f_3 (u)` .
+All the arguments to the atomic function calls are computed
+before the first call, so the calls are evaluated together at the first call.
+
+h(u)
+****
+The function :math:`h : \B{R}^4 \rightarrow \B{R}^4` is defined by
+:math:`h_i (u) = g( \sin( u_i ) , u_i )` .
+The results of the atomic function calls are not used
+before the last call, so the calls are evaluated together at the last call.
+
+Define Atomic Function
+**********************
+{xrst_literal
+   // BEGIN_DEFINE_ATOMIC_FUNCTION
+   // END_DEFINE_ATOMIC_FUNCTION
+}
+
+Use Atomic Function
+*******************
+{xrst_literal
+   // BEGIN_USE_ATOMIC_FUNCTION
+   // END_USE_ATOMIC_FUNCTION
+}
+
+{xrst_end atomic_four_batch.cpp}
+*/
+# include <cppad/cppad.hpp>
+
+// BEGIN_DEFINE_ATOMIC_FUNCTION
+// empty namespace
+namespace {
+   //
+   class atomic_batch : public CppAD::atomic_four<double> {
+   public:
+      // number of times each of the callbacks was used
+      size_t count_forward;
+      size_t count_reverse;
+      size_t count_forward_batch;
+      size_t count_reverse_batch;
+      //
+      atomic_batch(const std::string& name) :
+      CppAD::atomic_four<double>(name)
+      {  zero_counts(); }
+      //
+      void zero_counts(void)
+      {  count_forward       = 0;
+         count_reverse       = 0;
+         count_forward_batch = 0;
+         count_reverse_batch = 0;
+      }
+   private:
+      // for_type
+      bool for_type(
+         size_t                                     call_id     ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         CppAD::vector<CppAD::ad_type_enum>&        type_y      ) override
+      {  assert( type_x.size() == 2 );
+         assert( type_y.size() == 1 );
+         type_y[0] = std::max(type_x[0], type_x[1]);
+         return true;
+      }
+      // forward
+      bool forward(
+         size_t                                    call_id      ,
+         const CppAD::vector<bool>&                select_y     ,
+         size_t                                    order_low    ,
+         size_t                                    order_up     ,
+         const CppAD::vector<double>&              tx           ,
+         CppAD::vector<double>&                    ty           ) override
+      {  // this example only implements zero and first order forward mode
+         size_t q = order_up + 1;
+         if( order_up > 1 )
+            return false;
+         ++count_forward;
+         if( order_low == 0 )
+            ty[0] = tx[0 * q + 0] * tx[1 * q + 0];
+         if( order_up == 1 )
+         {  ty[1]  = tx[0 * q + 1] * tx[1 * q + 0];
+            ty[1] += tx[0 * q + 0] * tx[1 * q + 1];
+         }
+         return true;
+      }
+      // reverse
+      bool reverse(
+         size_t                                    call_id      ,
+         const CppAD::vector<bool>&                select_x     ,
+         size_t                                    order_up     ,
+         const CppAD::vector<double>&              tx           ,
+         const CppAD::vector<double>&              ty           ,
+         CppAD::vector<double>&                    px           ,
+         const CppAD::vector<double>&              py           ) override
+      {  // this example only implements zero order reverse mode
+         if( order_up > 0 )
+            return false;
+         ++count_reverse;
+         px[0] = py[0] * tx[1];
+         px[1] = py[0] * tx[0];
+         return true;
+      }
+      // forward_batch
+      bool forward_batch(
+         const CppAD::vector<size_t>&              call_id      ,
+         const CppAD::vector<bool>&                select_y     ,
+         size_t                                    order_low    ,
+         size_t                                    order_up     ,
+         const CppAD::vector<double>&              tx           ,
+         CppAD::vector<double>&                    ty           ) override
+      {  // this example only implements the zero order batch case
+         if( order_up > 0 )
+            return false;
+         ++count_forward_batch;
+         size_t n_call = call_id.size();
+         for(size_t k = 0; k < n_call; ++k)
+            ty[k] = tx[2 * k + 0] * tx[2 * k + 1];
+         return true;
+      }
+      // reverse_batch
+      bool reverse_batch(
+         const CppAD::vector<size_t>&              call_id      ,
+         const CppAD::vector<bool>&                select_x     ,
+         size_t                                    order_up     ,
+         const CppAD::vector<double>&              tx           ,
+         const CppAD::vector<double>&              ty           ,
+         CppAD::vector<double>&                    px           ,
+         const CppAD::vector<double>&              py           ) override
+      {  // this example only implements the zero order batch case
+         if( order_up > 0 )
+            return false;
+         ++count_reverse_batch;
+         size_t n_call = call_id.size();
+         for(size_t k = 0; k < n_call; ++k)
+         {  px[2 * k + 0] = py[k] * tx[2 * k + 1];
+            px[2 * k + 1] = py[k] * tx[2 * k + 0];
+         }
+         return true;
+      }
+   };
+}
+// END_DEFINE_ATOMIC_FUNCTION
+
+// BEGIN_USE_ATOMIC_FUNCTION
+bool batch(void)
+{  // ok, eps
+   bool ok = true;
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // AD, NearEqual
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   //
+   // afun
+   atomic_batch afun("atomic_batch");
+   //
+   // n, u, au, ax, ag
+   size_t n = 4;
+   CPPAD_TESTVECTOR(double)       u(n), w(n + 1);
+   CPPAD_TESTVECTOR( AD<double> ) au(n), ax(2), ag(1);
+   for(size_t j = 0; j < n; ++j)
+      au[j] = u[j] = double(j + 1);
+   // -----------------------------------------------------------------------
+   // f
+   CppAD::Independent(au);
+   CPPAD_TESTVECTOR( AD<double> ) ay(n + 1);
+   ay[n] = 0.0;
+   for(size_t i = 0; i < n; ++i)
+   {  ax[0] = au[i];
+      ax[1] = au[(i + 1) % n];
+      afun(ax, ag);
+      ay[i]  = ag[0];
+      ay[n] += ag[0];
+   }
+   CppAD::ADFun<double> f(au, ay);
+   //
+   // check f(u) using one forward_batch call
+   for(size_t j = 0; j < n; ++j)
+      u[j] = double(j + 2);
+   afun.zero_counts();
+   CPPAD_TESTVECTOR(double) y = f.Forward(0, u);
+   ok &= afun.count_forward_batch == 1;
+   ok &= afun.count_forward       == 0;
+   double sum = 0.0;
+   for(size_t i = 0; i < n; ++i)
+   {  double check = u[i] * u[(i + 1) % n];
+      ok  &= NearEqual(y[i], check, eps, eps);
+      sum += check;
+   }
+   ok &= NearEqual(y[n], sum, eps, eps);
+   //
+   // check the derivative of f_4 (u) using one reverse_batch call
+   for(size_t i = 0; i < n; ++i)
+      w[i] = 0.0;
+   w[n] = 1.0;
+   CPPAD_TESTVECTOR(double) dw = f.Reverse(1, w);
+   ok &= afun.count_reverse_batch == 1;
+   ok &= afun.count_reverse       == 0;
+   for(size_t j = 0; j < n; ++j)
+   {  double check = u[(j + 1) % n] + u[(j + n - 1) % n];
+      ok &= NearEqual(dw[j], check, eps, eps);
+   }
+   //
+   // first order forward mode uses the forward callback for each call
+   CPPAD_TESTVECTOR(double) du(n), dy(n + 1);
+   for(size_t j = 0; j < n; ++j)
+      du[j] = 1.0;
+   dy = f.Forward(1, du);
+   ok &= afun.count_forward == n;
+   for(size_t i = 0; i < n; ++i)
+   {  double check = u[i] + u[(i + 1) % n];
+      ok &= NearEqual(dy[i], check, eps, eps);
+   }
+   // -----------------------------------------------------------------------
+   // h
+   CppAD::Independent(au);
+   CPPAD_TESTVECTOR( AD<double> ) az(n);
+   for(size_t i = 0; i < n; ++i)
+   {  ax[0] = sin( au[i] );
+      ax[1] = au[i];
+      afun(ax, ag);
+      az[i] = ag[0];
+   }
+   CppAD::ADFun<double> h(au, az);
+   //
+   // check h(u) using one forward_batch call
+   afun.zero_counts();
+   CPPAD_TESTVECTOR(double) z = h.Forward(0, u);
+   ok &= afun.count_forward_batch == 1;
+   ok &= afun.count_forward       == 0;
+   for(size_t i = 0; i < n; ++i)
+   {  double check = sin( u[i] ) * u[i];
+      ok &= NearEqual(z[i], check, eps, eps);
+   }
+   //
+   // check the derivative of sum_i h_i (u) using one reverse_batch call
+   for(size_t i = 0; i < n; ++i)
+      w[i] = 1.0;
+   w.resize(n);
+   dw = h.Reverse(1, w);
+   ok &= afun.count_reverse_batch == 1;
+   ok &= afun.count_reverse       == 0;
+   for(size_t j = 0; j < n; ++j)
+   {  double check = cos( u[j] ) * u[j] + sin( u[j] );
+      ok &= NearEqual(dw[j], check, eps, eps);
+   }
+   //
+   return ok;
+}
+// END_USE_ATOMIC_FUNCTION
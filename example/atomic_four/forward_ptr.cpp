@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_four_forward_ptr.cpp}
+
+Atomic Zero Order Forward Using Pointers: Example and Test
+##########################################################
+
+Purpose
+*******
+This example demonstrates the
+:ref:`atomic_four_forward_ptr-name` callback.
+
+Function
+********
+For this example, the atomic function
+:math:`g : \B{R}^3 \rightarrow \B{R}^2` is defined by
+
+.. math::
+
+   g(x) = \left( \begin{array}{c}
+      x_0 * x_1 \\
+      x_1 * x_2
+   \end{array} \right)
+
+call_id
+*******
+The ``forward_ptr`` callback in this example returns false
+when *call_id* is one.
+This demonstrates that the ``forward`` callback is used in this case.
+
+Define Atomic Function
+**********************
+{xrst_literal
+   // BEGIN_DEFINE_ATOMIC_FUNCTION
+   // END_DEFINE_ATOMIC_FUNCTION
+}
+
+Use Atomic Function
+*******************
+{xrst_literal
+   // BEGIN_USE_ATOMIC_FUNCTION
+   // END_USE_ATOMIC_FUNCTION
+}
+
+{xrst_end atomic_four_forward_ptr.cpp}
+*/
+# include <cppad/cppad.hpp>
+
+// BEGIN_DEFINE_ATOMIC_FUNCTION
+// empty namespace
+namespace {
+   //
+   class atomic_forward_ptr : public CppAD::atomic_four<double> {
+   public:
+      // number of times each of the forward callbacks was used
+      size_t count_forward;
+      size_t count_forward_ptr;
+      //
+      atomic_forward_ptr(const std::string& name) :
+      CppAD::atomic_four<double>(name) ,
+      count_forward(0)                 ,
+      count_forward_ptr(0)
+      { }
+   private:
+      // for_type
+      bool for_type(
+         size_t                                     call_id     ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         CppAD::vector<CppAD::ad_type_enum>&        type_y      ) override
+      {
+         bool ok = type_x.size() == 3; // n
+         ok     &= type_y.size() == 2; // m
+         if( ! ok )
+            return false;
+         type_y[0] = std::max(type_x[0], type_x[1]);
+         type_y[1] = std::max(type_x[1], type_x[2]);
+         return true;
+      }
+      // forward
+      bool forward(
+         size_t                                    call_id      ,
+         const CppAD::vector<bool>&                select_y     ,
+         size_t                                    order_low    ,
+         size_t                                    order_up     ,
+         const CppAD::vector<double>&              tx           ,
+         CppAD::vector<double>&                    ty           ) override
+      {  // this example only implements zero order forward mode
+         if( order_up != 0 )
+            return false;
+         ++count_forward;
+         ty[0] = tx[0] * tx[1];
+         ty[1] = tx[1] * tx[2];
+         return true;
+      }
+      // forward_ptr
+      bool forward_ptr(
+         size_t                                    call_id      ,
+         const CppAD::vector<bool>&                select_y     ,
+         size_t                                    n            ,
+         size_t                                    m            ,
+         const double*                             tx           ,
+         double*                                   ty           ) override
+      {  assert( n == 3 );
+         assert( m == 2 );
+         //
+         // use the forward callback when call_id is one
+         if( call_id == 1 )
+            return false;
+         ++count_forward_ptr;
+         //
+         // only set the selected components of ty
+         if( select_y[0] )
+            ty[0] = tx[0] * tx[1];
+         if( select_y[1] )
+            ty[1] = tx[1] * tx[2];
+         return true;
+      }
+   };
+}
+// END_DEFINE_ATOMIC_FUNCTION
+
+// BEGIN_USE_ATOMIC_FUNCTION
+bool forward_ptr(void)
+{  // ok, eps
+   bool ok = true;
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // AD, NearEqual
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   //
+   // afun
+   atomic_forward_ptr afun("atomic_forward_ptr");
+   //
+   // n, u, au
+   size_t n  = 3;
+   CPPAD_TESTVECTOR(double)       u(n);
+   CPPAD_TESTVECTOR( AD<double> ) au(n);
+   for(size_t j = 0; j < n; ++j)
+      au[j] = u[j] = double(j + 1);
+   CppAD::Independent(au);
+   //
+   // ay
+   // The first call has the independent variables as its arguments.
+   // The second call has a parameter as one of its arguments.
+   // The third call uses call_id equal to one.
+   size_t m = 6;
+   CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m), ag(2);
+   afun(au, ag);
+   ay[0] = ag[0];
+   ay[1] = ag[1];
+   ax[0] = au[0];
+   ax[1] = 5.0;
+   ax[2] = au[2];
+   afun(ax, ag);
+   ay[2] = ag[0];
+   ay[3] = ag[1];
+   size_t call_id = 1;
+   afun(call_id, au, ag);
+   ay[4] = ag[0];
+   ay[5] = ag[1];
+   //
+   // f
+   CppAD::ADFun<double> f(au, ay);
+   //
+   // v
+   // Change the argument value and compute the corresponding function value.
+   for(size_t j = 0; j < n; ++j)
+      u[j] = double(j + 2);
+   afun.count_forward     = 0;
+   afun.count_forward_ptr = 0;
+   CPPAD_TESTVECTOR(double) v = f.Forward(0, u);
+   //
+   // check counts
+   ok &= afun.count_forward     == 1;
+   ok &= afun.count_forward_ptr == 2;
+   //
+   // check values
+   ok &= NearEqual(v[0], u[0] * u[1], eps, eps);
+   ok &= NearEqual(v[1], u[1] * u[2], eps, eps);
+   ok &= NearEqual(v[2], u[0] * 5.0,  eps, eps);
+   ok &= NearEqual(v[3], 5.0 * u[2],  eps, eps);
+   ok &= NearEqual(v[4], u[0] * u[1], eps, eps);
+   ok &= NearEqual(v[5], u[1] * u[2], eps, eps);
+   //
+   return ok;
+}
+// END_USE_ATOMIC_FUNCTION
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin base_simd_pack.cpp}
+{xrst_spell
+   simd
+}
+
+Using simd_pack as an AD Base Type: Example and Test
+####################################################
+
+Purpose
+*******
+The type ``simd_pack`` < ``double`` , 4 > ,
+defined in :ref:`base_simd_pack.hpp-name` ,
+meets the requirements specified by :ref:`base_require-name`
+for *Base* in ``AD`` < *Base* > .
+The program below evaluates a function and its derivative
+at four points using one zero order forward sweep
+and one first order reverse sweep.
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end base_simd_pack.cpp}
+*/
+// BEGIN C++
+# include <cppad/example/base_simd_pack.hpp>
+# include <cppad/cppad.hpp>
+
+bool base_simd_pack(void)
+{  bool ok = true;
+   using CppAD::NearEqual;
+   //
+   // pack, a_pack
+   const size_t n_lane = 4;
+   typedef CppAD::simd_pack<double, n_lane> pack;
+   typedef CppAD::AD<pack>                  a_pack;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // f(x) = [ x_0 * sin(x_1) , CondExpLt(x_0, x_1, x_0, x_1) ]
+   size_t n = 2, m = 2;
+   CPPAD_TESTVECTOR(a_pack) ax(n), ay(m);
+   ax[0] = pack(1.0);
+   ax[1] = pack(2.0);
+   CppAD::Independent(ax);
+   ay[0] = ax[0] * sin( ax[1] );
+   ay[1] = CppAD::CondExpLt(ax[0], ax[1], ax[0], ax[1]);
+   CppAD::ADFun<pack> f(ax, ay);
+   //
+   // x: lane k corresponds to the point ( k , 1.5 )
+   CPPAD_TESTVECTOR(pack) x(n), y(m);
+   for(size_t k = 0; k < n_lane; ++k)
+   {  x[0][k] = double(k);
+      x[1][k] = 1.5;
+   }
+   //
+   // y: evaluate f at all the points
+   y = f.Forward(0, x);
+   for(size_t k = 0; k < n_lane; ++k)
+   {  double x0 = x[0][k];
+      double x1 = x[1][k];
+      ok &= NearEqual(y[0][k], x0 * std::sin(x1), eps99, eps99);
+      // the conditional expression is evaluated for each lane
+      ok &= y[1][k] == std::min(x0, x1);
+   }
+   //
+   // dw: derivative of first component of f at all the points
+   CPPAD_TESTVECTOR(pack) w(m), dw(n);
+   w[0] = pack(1.0);
+   w[1] = pack(0.0);
+   dw   = f.Reverse(1, w);
+   for(size_t k = 0; k < n_lane; ++k)
+   {  double x0 = x[0][k];
+      double x1 = x[1][k];
+      ok &= NearEqual(dw[0][k], std::sin(x1), eps99, eps99);
+      ok &= NearEqual(dw[1][k], x0 * std::cos(x1), eps99, eps99);
+   }
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin binary_tape.cpp}
+
+Binary Tape Format: Example and Test
+####################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end binary_tape.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <sstream>
+
+bool binary_tape(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // f(x; p) = [ p_0 * sin(x_0) , v[x_1] , 3.0 ]
+   // where v = [ x_0 , x_0 * x_0 ] is a VecAD vector.
+   size_t n = 2, m = 3;
+   CPPAD_TESTVECTOR( AD<double> ) ax(n), ap(1), ay(m);
+   ax[0] = 0.5;
+   ax[1] = 0.0;
+   ap[0] = 2.0;
+   CppAD::Independent(ax, ap);
+   CppAD::VecAD<double> av(2);
+   av[ AD<double>(0) ] = ax[0];
+   av[ AD<double>(1) ] = ax[0] * ax[0];
+   ay[0] = ap[0] * sin( ax[0] );
+   ay[1] = av[ ax[1] ];
+   ay[2] = 3.0;
+   CppAD::ADFun<double> f(ax, ay);
+   f.function_name_set("binary_tape_f");
+   //
+   // ss: write f to a binary stream
+   std::stringstream ss(
+      std::ios::in | std::ios::out | std::ios::binary
+   );
+   f.to_binary(ss);
+   //
+   // g: read g from the binary stream
+   CppAD::ADFun<double> g;
+   g.from_binary(ss);
+   //
+   // the function properties are the same
+   ok &= g.function_name_get() == "binary_tape_f";
+   ok &= g.Domain()      == f.Domain();
+   ok &= g.Range()       == f.Range();
+   ok &= g.size_dyn_ind() == f.size_dyn_ind();
+   ok &= g.size_var()    == f.size_var();
+   ok &= g.size_op()     == f.size_op();
+   ok &= g.size_order()  == 0;
+   //
+   // h: write f using the compact encoding and read it back into h
+   std::stringstream ss_compact(
+      std::ios::in | std::ios::out | std::ios::binary
+   );
+   f.to_binary(ss_compact, true);
+   ok &= ss_compact.str().size() < ss.str().size();
+   CppAD::ADFun<double> h;
+   h.from_binary(ss_compact);
+   ok &= h.size_var()    == f.size_var();
+   ok &= h.size_op()     == f.size_op();
+   ok &= h.size_op_arg() == f.size_op_arg();
+   //
+   // change the dynamic parameter in f and g
+   CPPAD_TESTVECTOR(double) p(1);
+   p[0] = 3.0;
+   f.new_dynamic(p);
+   g.new_dynamic(p);
+   h.new_dynamic(p);
+   //
+   // zero order forward
+   CPPAD_TESTVECTOR(double) x(n), yf(m), yg(m), yh(m);
+   x[0] = 1.5;
+   x[1] = 1.0;
+   yf = f.Forward(0, x);
+   yg = g.Forward(0, x);
+   yh = h.Forward(0, x);
+   ok &= NearEqual(yg[0], p[0] * std::sin(x[0]), eps99, eps99);
+   ok &= NearEqual(yg[1], x[0] * x[0], eps99, eps99);
+   ok &= yg[2] == 3.0;
+   for(size_t i = 0; i < m; ++i)
+   {  ok &= yf[i] == yg[i];
+      ok &= yf[i] == yh[i];
+   }
+   //
+   // first order reverse
+   CPPAD_TESTVECTOR(double) w(m), dwf(n), dwg(n);
+   w[0] = 1.0;
+   w[1] = 2.0;
+   w[2] = 3.0;
+   dwf = f.Reverse(1, w);
+   dwg = g.Reverse(1, w);
+   ok &= NearEqual(dwg[0],
+      w[0] * p[0] * std::cos(x[0]) + w[1] * 2.0 * x[0], eps99, eps99
+   );
+   for(size_t j = 0; j < n; ++j)
+      ok &= dwf[j] == dwg[j];
+   //
+   return ok;
+}
+// END C++
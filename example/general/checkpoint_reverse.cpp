@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin checkpoint_reverse.cpp}
+
+Reverse Mode Using Binomial Checkpointing: Example and Test
+###########################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end checkpoint_reverse.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   // one Euler step for the pendulum ODE  x_0' = x_1 , x_1' = - sin(x_0)
+   template <class Vector>
+   Vector pendulum_step(const Vector& x)
+   {  typedef typename Vector::value_type scalar;
+      scalar h = scalar(0.01);
+      Vector y(2);
+      y[0] = x[0] + h * x[1];
+      y[1] = x[1] - h * sin( x[0] );
+      return y;
+   }
+}
+
+bool checkpoint_reverse(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   typedef CPPAD_TESTVECTOR(double)      d_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>) ad_vector;
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+   //
+   // number of steps
+   size_t n_step = 100;
+   //
+   // f: one step
+   size_t n = 2;
+   ad_vector ax(n), ay(n);
+   ax[0] = 1.0;
+   ax[1] = 0.0;
+   CppAD::Independent(ax);
+   ay = pendulum_step(ax);
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // g: all the steps
+   CppAD::Independent(ax);
+   ay = ax;
+   for(size_t k = 0; k < n_step; ++k)
+      ay = pendulum_step(ay);
+   CppAD::ADFun<double> g(ax, ay);
+   //
+   // the operation sequence for one step is much smaller
+   ok &= 10 * f.size_var() < g.size_var();
+   //
+   // y, dw: use g
+   d_vector x(n), w(n), y(n), dw(n);
+   x[0] = 0.5;
+   x[1] = 0.1;
+   w[0] = 1.0;
+   w[1] = 2.0;
+   y  = g.Forward(0, x);
+   dw = g.Reverse(1, w);
+   //
+   // check using f and at most n_store stored states
+   size_t n_store = 3;
+   d_vector y_check(n), dw_check(n);
+   size_t n_forward = f.checkpoint_reverse(
+      n_step, n_store, x, w, y_check, dw_check
+   );
+   for(size_t i = 0; i < n; ++i)
+   {  ok &= NearEqual(y[i],  y_check[i],  eps99, eps99);
+      ok &= NearEqual(dw[i], dw_check[i], eps99, eps99);
+   }
+   //
+   // t = 7 is the smallest integer with 100 <= (3 + t)! / (3! t!)
+   ok &= n_forward <= 7 * n_step;
+   //
+   return ok;
+}
+
+// END C++
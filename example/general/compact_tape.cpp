@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin compact_tape.cpp}
+
+Compact Operation Sequence Storage: Example and Test
+####################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end compact_tape.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool compact_tape(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // f(x) = [ sum_k x_0 * x_1^k , cos( x_1 ) ]
+   size_t n = 2, m = 2, n_term = 100;
+   CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+   ax[0] = 1.0;
+   ax[1] = 0.5;
+   CppAD::Independent(ax);
+   AD<double> aterm = ax[0];
+   ay[0] = aterm;
+   for(size_t k = 1; k < n_term; ++k)
+   {  aterm = aterm * ax[1];
+      ay[0] += aterm;
+   }
+   ay[1] = cos( ax[1] );
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // the default is normal storage
+   ok &= ! f.compact_tape();
+   size_t size_normal = f.size_op_seq();
+   //
+   // store f using the compact encoding
+   f.compact_tape(true);
+   ok &= f.compact_tape();
+   ok &= f.size_op_seq() < size_normal;
+   //
+   // zero order forward mode can use the compact storage
+   CPPAD_TESTVECTOR(double) x(n), y(m);
+   x[0] = 2.0;
+   x[1] = 0.25;
+   y    = f.Forward(0, x);
+   double check = 0.0, term = x[0];
+   for(size_t k = 0; k < n_term; ++k)
+   {  check += term;
+      term  *= x[1];
+   }
+   ok &= NearEqual(y[0], check, eps99, eps99);
+   ok &= NearEqual(y[1], cos( x[1] ), eps99, eps99);
+   //
+   // other operations require normal storage
+   // (the Taylor coefficients computed above are not changed)
+   f.compact_tape(false);
+   ok &= ! f.compact_tape();
+   ok &= f.size_op_seq() == size_normal;
+   CPPAD_TESTVECTOR(double) w(m), dw(n);
+   w[0] = 1.0;
+   w[1] = 0.0;
+   dw   = f.Reverse(1, w);
+   ok  &= NearEqual(dw[0], check / x[0], eps99, eps99);
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin forward_batch.cpp}
+
+Zero Order Forward Mode at Multiple Points: Example and Test
+############################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end forward_batch.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool forward_batch(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+
+   // domain space vector
+   size_t n = 2;
+   CPPAD_TESTVECTOR(AD<double>) ax(n);
+   ax[0] = 0.5;
+   ax[1] = 1.0;
+
+   // declare independent variables and starting recording
+   CppAD::Independent(ax);
+
+   // range space vector
+   size_t m = 2;
+   CPPAD_TESTVECTOR(AD<double>) ay(m);
+   ay[0] = ax[0] * ax[0] * ax[1];
+   ay[1] = CppAD::CondExpLt(ax[0], ax[1], exp(ax[0]), sin(ax[1]) );
+
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(ax, ay);
+
+   // x[ j * n_point + k ] is j-th component of k-th point
+   size_t n_point = 4;
+   CPPAD_TESTVECTOR(double) x(n * n_point), y;
+   for(size_t k = 0; k < n_point; ++k)
+   {  x[0 * n_point + k] = double(k);
+      x[1 * n_point + k] = 1.5;
+   }
+
+   // evaluate f at all the points
+   f.forward_batch(n_point, x, y);
+   ok &= size_t( y.size() ) == m * n_point;
+
+   // y[ i * n_point + k ] is i-th component of f at k-th point
+   for(size_t k = 0; k < n_point; ++k)
+   {  double x0    = x[0 * n_point + k];
+      double x1    = x[1 * n_point + k];
+      double check = x0 * x0 * x1;
+      ok &= NearEqual(y[0 * n_point + k], check, eps99, eps99);
+      if( x0 < x1 )
+         check = std::exp(x0);
+      else
+         check = std::sin(x1);
+      ok &= NearEqual(y[1 * n_point + k], check, eps99, eps99);
+   }
+
+   // the Taylor coefficients in f are not changed by forward_batch
+   ok &= f.size_order() == 1;
+   CPPAD_TESTVECTOR(double) dx(n), dy(m);
+   dx[0] = 1.0;
+   dx[1] = 0.0;
+   dy    = f.Forward(1, dx);
+   ok &= NearEqual(dy[0], 2.0 * 0.5 * 1.0, eps99, eps99);
+   ok &= NearEqual(dy[1], std::exp(0.5), eps99, eps99);
+
+   return ok;
+}
+
+// END C++
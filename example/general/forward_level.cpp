@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin forward_level.cpp}
+
+Zero Order Forward Mode Using Multiple Threads: Example and Test
+################################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end forward_level.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool forward_level(void)
+{  bool ok = true;
+   using CppAD::AD;
+
+   // domain space vector
+   size_t n = 5000;
+   CPPAD_TESTVECTOR(AD<double>) ax(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1) / double(n);
+
+   // declare independent variables and starting recording
+   CppAD::Independent(ax);
+
+   // range space vector: many independent residuals
+   size_t m = n - 1;
+   CPPAD_TESTVECTOR(AD<double>) ay(m);
+   for(size_t i = 0; i < m; ++i)
+      ay[i] = exp( ax[i] ) * sin( ax[i+1] ) - ax[i] * ax[i+1];
+
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(ax, ay);
+
+   // argument value
+   CPPAD_TESTVECTOR(double) x(n), y, check;
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(n - j) / double(n);
+
+   // evaluate f using 4 threads
+   size_t n_thread = 4;
+   y = f.forward_level(n_thread, x);
+
+   // the values are the same as for zero order forward mode
+   check = f.Forward(0, x);
+   for(size_t i = 0; i < m; ++i)
+      ok &= y[i] == check[i];
+
+   // the zero order Taylor coefficients are stored in f
+   y = f.forward_level(n_thread, x);
+   ok &= f.size_order() == 1;
+   CPPAD_TESTVECTOR(double) w(m), dw(n);
+   for(size_t i = 0; i < m; ++i)
+      w[i] = 0.0;
+   w[0] = 1.0;
+   dw   = f.Reverse(1, w);
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+   double d0    = std::exp(x[0]) * std::sin(x[1]) - x[1];
+   double d1    = std::exp(x[0]) * std::cos(x[1]) - x[0];
+   ok &= CppAD::NearEqual(dw[0], d0, eps99, eps99);
+   ok &= CppAD::NearEqual(dw[1], d1, eps99, eps99);
+
+   return ok;
+}
+
+// END C++
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin fun_context.cpp}
+
+Evaluating One Function Using Separate Contexts: Example and Test
+#################################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end fun_context.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool fun_context(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // f(x) = [ x_0 * x_1 , CondExpLt(x_0, x_1, sin(x_0), x_1) ]
+   size_t n = 2, m = 2;
+   CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+   ax[0] = 1.0;
+   ax[1] = 2.0;
+   CppAD::Independent(ax);
+   ay[0] = ax[0] * ax[1];
+   ay[1] = CppAD::CondExpLt(ax[0], ax[1], sin(ax[0]), ax[1]);
+   // the ADFun object is const, so it can be shared by several threads
+   const CppAD::ADFun<double> f(ax, ay);
+   //
+   // the constructor for f computed one order of Taylor coefficients
+   ok &= f.size_order() == 1;
+   //
+   // context_a, context_b
+   CppAD::fun_context<double> context_a, context_b;
+   //
+   // zero order forward at two different points
+   CPPAD_TESTVECTOR(double) xa(n), xb(n), ya(m), yb(m);
+   xa[0] = 0.5; xa[1] = 2.0;
+   xb[0] = 3.0; xb[1] = 1.5;
+   ya = f.Forward(0, xa, context_a);
+   yb = f.Forward(0, xb, context_b);
+   ok &= NearEqual(ya[0], xa[0] * xa[1], eps99, eps99);
+   ok &= NearEqual(ya[1], std::sin(xa[0]), eps99, eps99);
+   ok &= NearEqual(yb[0], xb[0] * xb[1], eps99, eps99);
+   ok &= NearEqual(yb[1], xb[1], eps99, eps99);
+   //
+   // the Taylor coefficients in f are not affected
+   ok &= f.size_order() == 1;
+   ok &= context_a.size_order() == 1;
+   ok &= context_b.size_order() == 1;
+   //
+   // first order forward in the direction of the first component of x
+   CPPAD_TESTVECTOR(double) dx(n), dya(m);
+   dx[0] = 1.0;
+   dx[1] = 0.0;
+   dya = f.Forward(1, dx, context_a);
+   ok &= NearEqual(dya[0], xa[1], eps99, eps99);
+   ok &= NearEqual(dya[1], std::cos(xa[0]), eps99, eps99);
+   //
+   // derivative of the second component of f at xb
+   CPPAD_TESTVECTOR(double) w(m), dwb(n);
+   w[0] = 0.0;
+   w[1] = 1.0;
+   dwb  = f.Reverse(1, w, context_b);
+   ok &= NearEqual(dwb[0], 0.0, eps99, eps99);
+   ok &= NearEqual(dwb[1], 1.0, eps99, eps99);
+   //
+   // second order reverse at xa using the first order results
+   CPPAD_TESTVECTOR(double) dwa(n * 2);
+   dwa = f.Reverse(2, w, context_a);
+   ok &= NearEqual(dwa[0 * 2 + 0], std::cos(xa[0]), eps99, eps99);
+   ok &= NearEqual(dwa[0 * 2 + 1], - std::sin(xa[0]), eps99, eps99);
+   ok &= NearEqual(dwa[1 * 2 + 0], 0.0, eps99, eps99);
+   ok &= NearEqual(dwa[1 * 2 + 1], 0.0, eps99, eps99);
+   //
+   // free the memory for the contexts
+   context_a.clear();
+   context_b.clear();
+   ok &= context_a.size_order() == 0;
+   //
+   return ok;
+}
+// END C++
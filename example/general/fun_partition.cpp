@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin fun_partition.cpp}
+
+Partition an ADFun Object by Dependent Variable: Example and Test
+#################################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end fun_partition.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool fun_partition(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+
+   // domain space vector
+   size_t n = 6;
+   CPPAD_TESTVECTOR(AD<double>) ax(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1);
+
+   // declare independent variables and starting recording
+   CppAD::Independent(ax);
+
+   // range space vector: each component depends on two arguments
+   size_t m = n / 2;
+   CPPAD_TESTVECTOR(AD<double>) ay(m);
+   for(size_t i = 0; i < m; ++i)
+      ay[i] = exp( ax[2*i] ) * sin( ax[2*i+1] );
+
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(ax, ay);
+
+   // split the dependent variables into two partitions
+   size_t n_part = 2;
+   CppAD::fun_partition<double> part = f.partition(n_part);
+   ok &= part.size() == n_part;
+
+   // each dependent variable is in one of the partitions
+   size_t count = 0;
+   for(size_t k = 0; k < n_part; ++k)
+   {  ok    &= part.fun(k).Domain() == n;
+      ok    &= part.fun(k).Range()  == part.dep_index(k).size();
+      count += part.dep_index(k).size();
+      // each partition has fewer operations than f
+      ok    &= part.fun(k).size_op() < f.size_op();
+   }
+   ok &= count == m;
+
+   // zero order forward mode using two threads
+   size_t n_thread = 2;
+   CPPAD_TESTVECTOR(double) x(n), y(m);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j) / double(n);
+   y = part.Forward(0, x, n_thread);
+   for(size_t i = 0; i < m; ++i)
+   {  double check = std::exp( x[2*i] ) * std::sin( x[2*i+1] );
+      ok &= NearEqual(y[i], check, eps99, eps99);
+   }
+
+   // first order forward mode in the direction of x_0
+   CPPAD_TESTVECTOR(double) dx(n), dy(m);
+   for(size_t j = 0; j < n; ++j)
+      dx[j] = 0.0;
+   dx[0] = 1.0;
+   dy = part.Forward(1, dx, n_thread);
+   ok &= NearEqual(dy[0], y[0], eps99, eps99);
+   for(size_t i = 1; i < m; ++i)
+      ok &= dy[i] == 0.0;
+
+   // gradient of the sum of the components of f
+   CPPAD_TESTVECTOR(double) w(m), dw(n);
+   for(size_t i = 0; i < m; ++i)
+      w[i] = 1.0;
+   dw = part.Reverse(1, w, n_thread);
+   for(size_t i = 0; i < m; ++i)
+   {  double check = std::exp( x[2*i] ) * std::sin( x[2*i+1] );
+      ok &= NearEqual(dw[2*i], check, eps99, eps99);
+      check = std::exp( x[2*i] ) * std::cos( x[2*i+1] );
+      ok &= NearEqual(dw[2*i+1], check, eps99, eps99);
+   }
+
+   // the results are the same as for f
+   y  = f.Forward(0, x);
+   dw = f.Reverse(1, w);
+   CPPAD_TESTVECTOR(double) check = part.Reverse(1, w, n_thread);
+   for(size_t j = 0; j < n; ++j)
+      ok &= NearEqual(dw[j], check[j], eps99, eps99);
+
+   return ok;
+}
+
+// END C++
@@ -103,9 +103,13 @@ extern bool azmul(void);
 extern bool base2ad(void);
 extern bool base2vec_ad(void);
 extern bool base_require(void);
+extern bool base_simd_pack(void);
+extern bool binary_tape(void);
 extern bool capacity_order(void);
 extern bool change_param(void);
 extern bool check_for_nan(void);
+extern bool checkpoint_reverse(void);
+extern bool compact_tape(void);
 extern bool compare_change(void);
 extern bool complex_poly(void);
 extern bool con_dyn_var(void);
@@ -116,17 +120,23 @@ extern bool erfc(void);
 extern bool exp(void);
 extern bool expm1(void);
 extern bool fabs(void);
+extern bool forward_batch(void);
 extern bool forward_dir(void);
+extern bool forward_level(void);
 extern bool forward_order(void);
 extern bool fun_assign(void);
+extern bool fun_context(void);
+extern bool fun_partition(void);
 extern bool fun_property(void);
 extern bool function_name(void);
+extern bool gradient(void);
 extern bool interp_onetape(void);
 extern bool interp_retape(void);
 extern bool log(void);
 extern bool log10(void);
 extern bool log1p(void);
 extern bool lu_vec_ad_ok(void);
+extern bool mul_add_vec(void);
 extern bool mul_level(void);
 extern bool mul_level_adolc(void);
 extern bool mul_level_adolc_ode(void);
@@ -144,6 +154,7 @@ extern bool reverse_one(void);
 extern bool reverse_three(void);
 extern bool reverse_two(void);
 extern bool sign(void);
+extern bool tape_reserve(void);
 extern bool taylor_ode(void);
 extern bool unary_minus(void);
 extern bool unary_plus(void);
@@ -221,8 +232,12 @@ int main(void)
    Run( base2ad,           "base2ad"          );
    Run( base2vec_ad,       "base2vec_ad"      );
    Run( base_require,      "base_require"     );
+   Run( base_simd_pack,    "base_simd_pack"   );
+   Run( binary_tape,       "binary_tape"      );
    Run( capacity_order,    "capacity_order"   );
    Run( change_param,      "change_param"     );
+   Run( checkpoint_reverse, "checkpoint_reverse");
+   Run( compact_tape,      "compact_tape"     );
    Run( compare_change,    "compare_change"   );
    Run( complex_poly,      "complex_poly"     );
    Run( con_dyn_var,       "con_dyn_var"      );
@@ -231,17 +246,23 @@ int main(void)
    Run( exp,               "exp"              );
    Run( expm1,             "expm1"            );
    Run( fabs,              "fabs"             );
+   Run( forward_batch,     "forward_batch"    );
    Run( forward_dir,       "forward_dir"      );
+   Run( forward_level,     "forward_level"    );
    Run( forward_order,     "forward_order"    );
    Run( fun_assign,        "fun_assign"       );
+   Run( fun_context,       "fun_context"      );
+   Run( fun_partition,     "fun_partition"    );
    Run( fun_property,      "fun_property"     );
    Run( function_name,     "function_name"    );
+   Run( gradient,          "gradient"         );
    Run( interp_onetape,    "interp_onetape"   );
    Run( interp_retape,     "interp_retape"    );
    Run( log,               "log"              );
    Run( log10,             "log10"            );
    Run( log1p,             "log1p"            );
    Run( lu_vec_ad_ok,      "lu_vec_ad_ok"     );
+   Run( mul_add_vec,       "mul_add_vec"      );
    Run( mul_level,         "mul_level"        );
    Run( mul_level_ode,     "mul_level_ode"    );
    Run( near_equal_ext,    "near_equal_ext"   );
@@ -256,6 +277,7 @@ int main(void)
    Run( reverse_three,     "reverse_three"    );
    Run( reverse_two,       "reverse_two"      );
    Run( sign,              "sign"             );
+   Run( tape_reserve,      "tape_reserve"     );
    Run( taylor_ode,        "ode_taylor"       );
    Run( unary_minus,       "unary_minus"      );
    Run( unary_plus,        "unary_plus"       );
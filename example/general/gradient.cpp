@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin gradient.cpp}
+
+Function Value and Gradient Driver: Example and Test
+####################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end gradient.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool gradient(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+
+   // domain space vector
+   size_t n = 2;
+   CPPAD_TESTVECTOR(AD<double>) ax(n);
+   ax[0] = 1.0;
+   ax[1] = 2.0;
+
+   // declare independent variables and start tape recording
+   CppAD::Independent(ax);
+
+   // range space vector
+   size_t m = 2;
+   CPPAD_TESTVECTOR(AD<double>) ay(m);
+   ay[0] = ax[0] * exp( ax[1] );
+   ay[1] = sin( ax[0] ) + ax[1];
+
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(ax, ay);
+
+   // evaluate the function and the derivative of w^T f(x)
+   CPPAD_TESTVECTOR(double) x(n), w(m), y(m), dw(n);
+   x[0] = 0.5;
+   x[1] = 1.5;
+   w[0] = 2.0;
+   w[1] = 3.0;
+   f.gradient(x, w, y, dw);
+
+   // check the function value
+   ok &= NearEqual(y[0], x[0] * std::exp(x[1]), eps99, eps99);
+   ok &= NearEqual(y[1], std::sin(x[0]) + x[1], eps99, eps99);
+
+   // check the derivative
+   double check = w[0] * std::exp(x[1]) + w[1] * std::cos(x[0]);
+   ok &= NearEqual(dw[0], check, eps99, eps99);
+   check = w[0] * x[0] * std::exp(x[1]) + w[1];
+   ok &= NearEqual(dw[1], check, eps99, eps99);
+
+   // the zero order Taylor coefficients correspond to x
+   ok &= f.size_order() == 1;
+   CPPAD_TESTVECTOR(double) dy(m), dx(n);
+   dx[0] = 1.0;
+   dx[1] = 0.0;
+   dy = f.Forward(1, dx);
+   ok &= NearEqual(dy[0], std::exp(x[1]), eps99, eps99);
+   ok &= NearEqual(dy[1], std::cos(x[0]), eps99, eps99);
+
+   return ok;
+}
+
+// END C++
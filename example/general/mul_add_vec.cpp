@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin mul_add_vec.cpp}
+
+Record an Elementwise Multiply and Add: Example and Test
+#######################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end mul_add_vec.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool mul_add_vec(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+
+   // domain space vector
+   size_t n = 4;
+   CPPAD_TESTVECTOR(AD<double>) ax(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1);
+
+   // declare independent variables and start tape recording
+   CppAD::Independent(ax);
+
+   // a and b are constants
+   CPPAD_TESTVECTOR(double) a(n), b(n);
+   a[0] = 2.0;   b[0] = 3.0;
+   a[1] = 1.0;   b[1] = 4.0;  // multiply by one is not recorded
+   a[2] = 5.0;   b[2] = 0.0;  // add zero is not recorded
+   a[3] = 0.0;   b[3] = 6.0;  // ay[3] is a constant parameter
+
+   // ay[i] = a[i] * ax[i] + b[i]
+   CPPAD_TESTVECTOR(AD<double>) ay(n);
+   CppAD::mul_add_vec(a, ax, b, ay);
+
+   // only ay[3] is a parameter
+   for(size_t i = 0; i < n; ++i)
+      ok &= CppAD::Variable(ay[i]) == (i != 3);
+
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(ax, ay);
+
+   // operators: BeginOp, n * InvOp, one multiply and add for ay[0],
+   // one add for ay[1], one multiply for ay[2], ParOp for ay[3], EndOp
+   ok &= f.size_op() == 1 + n + 2 + 1 + 1 + 1 + 1;
+
+   // check zero order forward
+   CPPAD_TESTVECTOR(double) x(n), y(n);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = 0.5 * double(j);
+   y = f.Forward(0, x);
+   for(size_t i = 0; i < n; ++i)
+      ok &= NearEqual(y[i], a[i] * x[i] + b[i], eps99, eps99);
+
+   // check first order forward
+   CPPAD_TESTVECTOR(double) dx(n), dy(n);
+   for(size_t j = 0; j < n; ++j)
+      dx[j] = 1.0;
+   dy = f.Forward(1, dx);
+   for(size_t i = 0; i < n; ++i)
+      ok &= NearEqual(dy[i], a[i], eps99, eps99);
+
+   return ok;
+}
+
+// END C++
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin tape_reserve.cpp}
+
+Reserve Memory for a Recording: Example and Test
+################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end tape_reserve.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   // record f(x) = x_0 * x_1 * ... * x_{n-1}
+   void record(
+      CppAD::ADFun<double>& f, size_t n_op, size_t n_arg, size_t n_par)
+   {  using CppAD::AD;
+      size_t n = 5;
+      CPPAD_TESTVECTOR(AD<double>) ax(n), ay(1);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1);
+      CppAD::Independent(ax);
+      //
+      // reserve memory for the rest of this recording
+      AD<double>::tape_reserve(n_op, n_arg, n_par);
+      //
+      ay[0] = ax[0];
+      for(size_t j = 1; j < n; ++j)
+         ay[0] *= ax[j];
+      f.Dependent(ax, ay);
+   }
+}
+
+bool tape_reserve(void)
+{  bool ok = true;
+   using CppAD::AD;
+
+   // no recording in progress so this has no effect
+   AD<double>::tape_reserve(100, 100, 100);
+
+   // first recording, no hints for the size of the recording
+   CppAD::ADFun<double> f;
+   record(f, 0, 0, 0);
+
+   // second recording, use the size of the first recording as the hints
+   CppAD::ADFun<double> g;
+   record(g, f.size_op(), f.size_op_arg(), f.size_par());
+
+   // the hints do not change the recording
+   ok &= g.size_op()     == f.size_op();
+   ok &= g.size_op_arg() == f.size_op_arg();
+   ok &= g.size_par()    == f.size_par();
+   ok &= g.size_var()    == f.size_var();
+
+   // check zero order forward
+   CPPAD_TESTVECTOR(double) x(5), y(1);
+   for(size_t j = 0; j < 5; ++j)
+      x[j] = double(j) + 0.5;
+   y = g.Forward(0, x);
+   double check = 1.0;
+   for(size_t j = 0; j < 5; ++j)
+      check *= x[j];
+   ok &= CppAD::NearEqual(y[0], check, 1e-10, 1e-10);
+
+   return ok;
+}
+
+// END C++
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin jit_derivative.cpp}
+{xrst_spell
+   csrc
+}
+
+C Source Code for the Derivatives of a Function: Example and Test
+#################################################################
+
+Purpose
+*******
+This example uses the :ref:`to_csrc@Derivative Functions`
+to compute one Newton step for solving :math:`f(x) = 0`
+where the function values and the Jacobian are both computed by
+compiled C source code.
+
+Function
+********
+For this example :math:`f : \B{R}^2 \rightarrow \B{R}^2` is defined by
+
+.. math::
+
+   f(x) = \left( \begin{array}{c}
+      x_0 x_0 + x_1 x_1 - 2
+      \\
+      \exp( x_0 - x_1 ) - 1
+   \end{array} \right)
+
+which has a zero at :math:`x = (1, 1)`.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end jit_derivative.cpp}
+-------------------------------------------------------------------------------
+*/
+// BEGIN C++
+
+# include <cstddef>
+# include <iostream>
+# include <fstream>
+# include <map>
+
+// DLL_EXT
+# ifdef _WIN32
+# define DLL_EXT ".dll"
+# else
+# define DLL_EXT ".so"
+# endif
+
+# include <cppad/cppad.hpp>
+bool derivative(void)
+{  bool ok = true;
+   //
+   using CppAD::AD;
+   using CppAD::ADFun;
+   using CppAD::Independent;
+   using CppAD::NearEqual;
+   //
+   // nx, ny
+   size_t nx = 2, ny = 2;
+   //
+   // f
+   CPPAD_TESTVECTOR( AD<double> ) ax(nx), ay(ny);
+   ax[0] = 0.0;
+   ax[1] = 0.0;
+   Independent(ax);
+   ay[0] = ax[0] * ax[0] + ax[1] * ax[1] - 2.0;
+   ay[1] = exp( ax[0] - ax[1] ) - 1.0;
+   ADFun<double> f(ax, ay);
+   f.function_name_set("f");
+   //
+   // csrc_file
+   // created in std::filesystem::current_path
+   std::string c_type    = "double";
+   std::string csrc_file = "derivative.c";
+   std::ofstream ofs;
+   ofs.open(csrc_file , std::ofstream::out);
+   f.to_csrc(ofs, c_type);
+   ofs.close();
+   //
+   // dll_file
+   // created in std::filesystem::current_path
+   std::string dll_file = "jit_derivative" DLL_EXT;
+   CPPAD_TESTVECTOR( std::string) csrc_files(1);
+   csrc_files[0] = csrc_file;
+   std::map< std::string, std::string > options;
+   std::string err_msg = CppAD::create_dll_lib(dll_file, csrc_files, options);
+   if( err_msg != "" )
+   {  std::cerr << "jit_derivative: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   // dll_linker
+   CppAD::link_dll_lib dll_linker(dll_file, err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_derivative: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   //
+   // jit_double
+   using CppAD::jit_double;
+   //
+   // f_ptr, jac_ptr
+   void* void_ptr = dll_linker("cppad_jit_f", err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_derivative: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   jit_double f_ptr = reinterpret_cast<jit_double>(void_ptr);
+   void_ptr = dll_linker("cppad_jit_f_jacobian", err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_derivative: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   jit_double jac_ptr = reinterpret_cast<jit_double>(void_ptr);
+   //
+   // x, y, jac
+   // y = f(x), jac = f'(x)
+   size_t compare_change = 0;
+   std::vector<double> x(nx), y(ny), jac(ny * nx);
+   x[0] = 1.2;
+   x[1] = 0.9;
+   int flag = f_ptr(nx, x.data(), ny, y.data(), &compare_change);
+   ok &= flag == 0;
+   flag = jac_ptr(nx, x.data(), ny * nx, jac.data(), &compare_change);
+   ok &= flag == 0;
+   //
+   // ok
+   // check the Jacobian, stored in row major order
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   double exp_x = std::exp( x[0] - x[1] );
+   ok &= NearEqual(jac[0 * nx + 0],  2.0 * x[0], eps99, eps99);
+   ok &= NearEqual(jac[0 * nx + 1],  2.0 * x[1], eps99, eps99);
+   ok &= NearEqual(jac[1 * nx + 0],  exp_x,      eps99, eps99);
+   ok &= NearEqual(jac[1 * nx + 1], -exp_x,      eps99, eps99);
+   //
+   // x
+   // one Newton step: x = x - f'(x)^{-1} f(x)
+   double det = jac[0] * jac[3] - jac[1] * jac[2];
+   double dx0 = (   jac[3] * y[0] - jac[1] * y[1] ) / det;
+   double dx1 = ( - jac[2] * y[0] + jac[0] * y[1] ) / det;
+   double err_before = std::fabs(x[0] - 1.0) + std::fabs(x[1] - 1.0);
+   x[0] -= dx0;
+   x[1] -= dx1;
+   //
+   // ok
+   // Newton's method converges quadratically near the solution
+   double err_after = std::fabs(x[0] - 1.0) + std::fabs(x[1] - 1.0);
+   ok &= err_after < err_before * err_before;
+   //
+   return ok;
+}
+// END C++
@@ -21,6 +21,7 @@
 // BEGIN_SORT_THIS_LINE_PLUS_1
 extern bool atomic(void);
 extern bool compile(void);
+extern bool derivative(void);
 extern bool dynamic(void);
 extern bool get_started(void);
 extern bool to_csrc(void);
@@ -40,6 +41,7 @@ int main(void)
    // BEGIN_SORT_THIS_LINE_PLUS_1
    Run( atomic,              "atomic"                );
    Run( compile,             "compile"               );
+   Run( derivative,          "derivative"            );
    Run( dynamic,             "dynamic"               );
    Run( get_started,         "get_started"           );
    Run( to_csrc,             "to_csrc"               );
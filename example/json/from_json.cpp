@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin from_json.cpp}
@@ -19,6 +19,7 @@ Source Code
 */
 // BEGIN C++
 # include <cppad/cppad.hpp>
+# include <sstream>
 
 bool from_json(void)
 {  bool ok = true;
@@ -71,6 +72,15 @@ bool from_json(void)
    ok &= jac[0] == 2.0 * (p[0] + x[0] + x[1]);
    ok &= jac[1] == 2.0 * (p[0] + x[0] + x[1]);
    //
+   // The graph can also be read from a stream; e.g., a std::ifstream.
+   // In this case, the entire graph does not need to be in memory.
+   std::istringstream is(json);
+   CppAD::ADFun<double> fun_is;
+   fun_is.from_json(is);
+   fun_is.new_dynamic(p);
+   y = fun_is.Forward(0, x);
+   ok  &= y[0] ==  (p[0] + x[0] + x[1]) * (p[0] + x[0] + x[1]);
+   //
    return ok;
 }
 // END C++
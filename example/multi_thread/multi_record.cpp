@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin multi_record.cpp}
+
+Timing Test of Multi-Threaded Recording
+#######################################
+
+Syntax
+******
+
+| *ok* = ``multi_record_time`` (
+| |tab| *time_out* , *test_time* , *num_threads* , *mega_op*
+| )
+
+Purpose
+*******
+Runs a correctness and timing test for recording AD operations
+using a team of threads.
+Each thread records its own function
+
+.. math::
+
+   f(x) = x + x + \cdots + x
+
+where the number of additions is its share of the total number of operations.
+Most of the time is spent finding the tape for the current thread and
+putting the operator and its arguments in the recording; see
+:ref:`multi_thread@CPPAD_TAPE_THREAD_LOCAL` .
+
+Thread
+******
+It is assumed that this function is called by thread zero in sequential
+mode; i.e., not :ref:`in_parallel<ta_in_parallel-name>` .
+
+ok
+**
+This return value has prototype
+
+   ``bool`` *ok*
+
+If it is true,
+``multi_record_time`` passed the correctness test.
+Otherwise it is false.
+
+time_out
+********
+This argument has prototype
+
+   ``double&`` *time_out*
+
+The input value of the argument does not matter.
+Upon return it is the number of wall clock seconds required for
+all the threads to record their functions.
+
+test_time
+*********
+Is the minimum amount of wall clock time that the test should take.
+The number of repeats for the test will be increased until this time
+is reached.
+The reported *time_out* is the total wall clock time divided by the
+number of repeats.
+
+num_threads
+***********
+This argument has prototype
+
+   ``size_t`` *num_threads*
+
+It specifies the number of threads that are available for this test.
+If it is zero, the test is run without the multi-threading environment and
+
+   1 == ``thread_alloc::num_threads`` ()
+
+when ``multi_record_time`` is called.
+If it is non-zero, the test is run with the multi-threading and
+
+   *num_threads* = ``thread_alloc::num_threads`` ()
+
+when ``multi_record_time`` is called.
+
+mega_op
+*******
+This argument has prototype
+
+   ``size_t`` *mega_op*
+
+and is greater than zero.
+The total number of additions, for all the threads,
+is equal to :math:`10^6` times *mega_op* .
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end multi_record.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <cppad/utility/time_test.hpp>
+# include "multi_record.hpp"
+# include "team_thread.hpp"
+# define MAX_NUMBER_THREADS 48
+
+namespace {
+   using CppAD::thread_alloc;
+   using CppAD::AD;
+
+   // Number of threads, set by previous call to multi_record_time
+   // (zero means one thread with no multi-threading setup)
+   size_t num_threads_ = 0;
+
+   // value of mega_op, set by previous call to multi_record_time
+   size_t mega_op_ = 0;
+
+   // structure with information for one thread
+   typedef struct {
+      // number of additions to record (worker input)
+      size_t num_op;
+      // false if an error occurs, true otherwise (worker output)
+      bool   ok;
+   } work_one_t;
+
+   // vector with information for all threads
+   // (use pointers instead of values to avoid false sharing)
+   work_one_t* work_all_[MAX_NUMBER_THREADS];
+   // -------------------------------------------------------------------
+   // setup
+   bool multi_record_setup(size_t num_op)
+   {  size_t num_threads  = std::max(num_threads_, size_t(1));
+      bool ok             = num_threads == thread_alloc::num_threads();
+      ok                 &= thread_alloc::thread_num() == 0;
+      ok                 &= num_op >= num_threads;
+      //
+      for(size_t thread_num = 0; thread_num < num_threads; thread_num++)
+      {  // allocate separate memory for this thread to avoid false sharing
+         size_t min_bytes(sizeof(work_one_t)), cap_bytes;
+         void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+         work_all_[thread_num] = static_cast<work_one_t*>(v_ptr);
+         //
+         // in case this thread's worker does not get called
+         work_all_[thread_num]->ok = false;
+         //
+         // number of additions for this thread
+         size_t start = (num_op * thread_num) / num_threads;
+         size_t stop  = (num_op * (thread_num + 1)) / num_threads;
+         work_all_[thread_num]->num_op = stop - start;
+      }
+      return ok;
+   }
+   // -------------------------------------------------------------------
+   // worker
+   void multi_record_worker(void)
+   {  size_t thread_num  = thread_alloc::thread_num();
+      size_t num_threads = std::max(num_threads_, size_t(1));
+      bool   ok          = thread_num < num_threads;
+      size_t num_op      = work_all_[thread_num]->num_op;
+      //
+      // record f(x) = x + x + ... + x
+      CPPAD_TESTVECTOR( AD<double> ) ax(1), ay(1);
+      ax[0] = 1.0;
+      CppAD::Independent(ax);
+      AD<double> asum = ax[0];
+      for(size_t i = 0; i < num_op; ++i)
+         asum = asum + ax[0];
+      ay[0] = asum;
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // check the recording
+      // (the extra variables are the phantom variable and x)
+      ok &= f.size_var() == num_op + 2;
+      ok &= f.Domain() == 1 && f.Range() == 1;
+      //
+      work_all_[thread_num]->ok = ok;
+   }
+   // -------------------------------------------------------------------
+   // takedown
+   bool multi_record_takedown(void)
+   {  bool ok            = true;
+      ok                &= thread_alloc::thread_num() == 0;
+      size_t num_threads = std::max(num_threads_, size_t(1));
+      //
+      // go down so that free memory for other threads before memory for master
+      size_t thread_num = num_threads;
+      while(thread_num--)
+      {  // check that this tread was ok with the work it did
+         ok  &= work_all_[thread_num]->ok;
+         //
+         // delete problem specific information
+         void* v_ptr = static_cast<void*>( work_all_[thread_num] );
+         thread_alloc::return_memory( v_ptr );
+         //
+         // check that there is no longer any memory inuse by this thread
+         ok &= thread_alloc::inuse(thread_num) == 0;
+         //
+         // return all memory being held for future use by this thread
+         thread_alloc::free_available(thread_num);
+      }
+      return ok;
+   }
+   // -------------------------------------------------------------------
+   // test_once
+   void test_once(void)
+   {  if( mega_op_ < 1 )
+      {  std::cerr << "multi_record_time: mega_op < 1" << std::endl;
+         exit(1);
+      }
+      size_t num_op = mega_op_ * 1000000;
+      //
+      bool ok = multi_record_setup(num_op);
+      if( num_threads_ > 0 )
+         team_work( multi_record_worker );
+      else
+         multi_record_worker();
+      ok &= multi_record_takedown();
+      if( ! ok )
+      {  std::cerr << "multi_record: error" << std::endl;
+         exit(1);
+      }
+      return;
+   }
+   //
+   void test_repeat(size_t repeat)
+   {  for(size_t i = 0; i < repeat; i++)
+         test_once();
+      return;
+   }
+}
+
+// This is the only routine that is accessible outside of this file
+bool multi_record_time(
+   double& time_out, double test_time, size_t num_threads, size_t mega_op)
+{  bool ok  = true;
+   ok      &= thread_alloc::thread_num() == 0;
+
+   // arguments passed to test_once
+   num_threads_ = num_threads;
+   mega_op_     = mega_op;
+
+   // create team of threads
+   ok &= thread_alloc::in_parallel() == false;
+   if( num_threads > 0 )
+   {  team_create(num_threads);
+      ok &= num_threads == thread_alloc::num_threads();
+   }
+   else
+   {  ok &= 1 == thread_alloc::num_threads();
+   }
+
+   // run the test case and set the time return value
+   // (test_once checks for correctness)
+   time_out = CppAD::time_test(test_repeat, test_time);
+
+   // destroy team of threads
+   if( num_threads > 0 )
+      team_destroy();
+   ok &= thread_alloc::in_parallel() == false;
+
+   return ok;
+}
+
+// END C++
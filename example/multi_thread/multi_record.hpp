@@ -0,0 +1,12 @@
+# ifndef CPPAD_EXAMPLE_MULTI_THREAD_MULTI_RECORD_HPP
+# define CPPAD_EXAMPLE_MULTI_THREAD_MULTI_RECORD_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+bool multi_record_time(
+   double& time_out, double test_time, size_t num_threads, size_t mega_op
+);
+
+# endif
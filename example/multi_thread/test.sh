@@ -57,6 +57,10 @@ next_program
 echo_eval ./$program harmonic 1 4 1
 next_program
 echo
+# test_time=1 max_thread=4, mega_op=1
+echo_eval ./$program multi_record 1 4 1
+next_program
+echo
 # test_time=1 max_thread=4, num_solve=100
 echo_eval ./$program atomic_two 1 4 100
 next_program
@@ -55,6 +55,7 @@ you can execute the following commands:
 | ./ *program* ``simple_ad``
 | ./ *program* ``team_example``
 | ./ *program* ``harmonic`` *test_time* *max_threads* *mega_sum*
+| ./ *program* ``multi_record`` *test_time* *max_threads* *mega_op*
 | ./ *program* ``atomic_two`` *test_time* *max_threads* *num_solve*
 | ./ *program* ``atomic_three`` *test_time* *max_threads* *num_solve*
 | ./ *program* ``chkpoint_one`` *test_time* *max_threads* *num_solve*
@@ -73,6 +74,7 @@ as the *test_case* below.
    example/multi_thread/pthread/simple_ad_pthread.cpp
    example/multi_thread/team_example.cpp
    example/multi_thread/harmonic.xrst
+   example/multi_thread/multi_record.cpp
    example/multi_thread/multi_atomic_three.xrst
    example/multi_thread/multi_chkpoint_two.xrst
    example/multi_thread/multi_newton.xrst
@@ -144,6 +146,22 @@ is an integer greater than or equal one and has the same meaning as in
 
 {xrst_comment -------------------------------------------------------------- }
 
+multi_record
+************
+The *test_case* ``multi_record`` runs the
+:ref:`multi_record.cpp-name` example.
+This is a timing test for recording AD operations using a team of threads.
+It can be used to compare the two choices for
+:ref:`multi_thread@CPPAD_TAPE_THREAD_LOCAL` .
+
+mega_op
+=======
+The command line argument *mega_op*
+is an integer greater than or equal one and has the same meaning as in
+:ref:`multi_record.cpp<multi_record.cpp@mega_op>` .
+
+{xrst_comment -------------------------------------------------------------- }
+
 Atomic and Checkpoint
 *********************
 The *test_case* values
@@ -235,6 +253,7 @@ Source
 # include "team_thread.hpp"
 # include "team_example.hpp"
 # include "harmonic.hpp"
+# include "multi_record.hpp"
 # include "multi_atomic_two.hpp"
 # include "multi_atomic_three.hpp"
 # include "multi_chkpoint_one.hpp"
@@ -281,6 +300,7 @@ int main(int argc, char *argv[])
    "./<program> simple_ad\n"
    "./<program> team_example\n"
    "./<program> harmonic     test_time max_threads mega_sum\n"
+   "./<program> multi_record test_time max_threads mega_op\n"
    "./<program> atomic_two   test_time max_threads num_solve\n"
    "./<program> atomic_three test_time max_threads num_solve\n"
    "./<program> chkpoint_one test_time max_threads num_solve\n"
@@ -324,6 +344,7 @@ int main(int argc, char *argv[])
    bool run_simple_ad    = std::strcmp(test_name, "simple_ad")        == 0;
    bool run_team_example = std::strcmp(test_name, "team_example")     == 0;
    bool run_harmonic     = std::strcmp(test_name, "harmonic")         == 0;
+   bool run_multi_record = std::strcmp(test_name, "multi_record")     == 0;
    bool run_atomic_two   = std::strcmp(test_name, "atomic_two")       == 0;
    bool run_atomic_three = std::strcmp(test_name, "atomic_three")     == 0;
    bool run_chkpoint_one = std::strcmp(test_name, "chkpoint_one")     == 0;
@@ -332,6 +353,7 @@ int main(int argc, char *argv[])
    if( run_a11c || run_simple_ad || run_team_example )
       ok = (argc == 2);
    else if( run_harmonic
+   || run_multi_record
    || run_atomic_two
    || run_atomic_three
    || run_chkpoint_one
@@ -375,6 +397,7 @@ int main(int argc, char *argv[])
    );
 
    size_t mega_sum  = 0; // assignment to avoid compiler warning
+   size_t mega_op   = 0;
    size_t num_solve = 0;
    if( run_harmonic )
    {  // mega_sum
@@ -382,6 +405,12 @@ int main(int argc, char *argv[])
          "run: mega_sum is less than one"
       );
    }
+   else if( run_multi_record )
+   {  // mega_op
+      mega_op = arg2size_t( *++argv, 1,
+         "run: mega_op is less than one"
+      );
+   }
    else if( run_atomic_two
    || run_atomic_three
    || run_chkpoint_one
@@ -436,6 +465,9 @@ int main(int argc, char *argv[])
       if( run_harmonic ) this_ok = harmonic_time(
          time_out, test_time, num_threads, mega_sum
       );
+      else if( run_multi_record ) this_ok = multi_record_time(
+         time_out, test_time, num_threads, mega_op
+      );
       else if( run_atomic_two ) this_ok = multi_atomic_two_time(
          time_out, test_time, num_threads, num_solve
       );
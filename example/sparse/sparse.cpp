@@ -36,6 +36,7 @@ extern bool rev_hes_sparsity(void);
 extern bool rev_jac_sparsity(void);
 extern bool rev_sparse_hes(void);
 extern bool sparse2eigen(void);
+extern bool sparse_cache(void);
 extern bool sparse_hes(void);
 extern bool sparse_hessian(void);
 extern bool sparse_jac_for(void);
@@ -71,6 +72,7 @@ int main(void)
    Run( rev_hes_sparsity,          "rev_hes_sparsity" );
    Run( rev_jac_sparsity,          "rev_jac_sparsity" );
    Run( rev_sparse_hes,            "rev_sparse_hes" );
+   Run( sparse_cache,              "sparse_cache" );
    Run( sparse_hes,                "sparse_hes" );
    Run( sparse_hessian,            "sparse_hessian" );
    Run( sparse_jac_for,            "sparse_jac_for" );
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_cache.cpp}
+
+Sparse Derivatives With a Cache of Sparsity and Coloring: Example and Test
+##########################################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end sparse_cache.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(AD<double>) a_vector;
+   typedef CPPAD_TESTVECTOR(double)     d_vector;
+   typedef CPPAD_TESTVECTOR(size_t)     s_vector;
+   //
+   // record the function at x (the recording depends on the sign of x[0])
+   CppAD::ADFun<double> record(const d_vector& x)
+   {  size_t n = 3, m = 3;
+      a_vector a_x(n), a_y(m);
+      for(size_t j = 0; j < n; ++j)
+         a_x[j] = x[j];
+      CppAD::Independent(a_x);
+      a_y[0] = a_x[0] * a_x[1];
+      if( x[0] > 0.0 )
+         a_y[1] = sin( a_x[2] );
+      else
+         a_y[1] = cos( a_x[2] ) * a_x[0];
+      a_y[2] = a_x[1] * a_x[2];
+      return CppAD::ADFun<double>(a_x, a_y);
+   }
+   //
+   // the Jacobian at x
+   d_vector jacobian(const d_vector& x)
+   {  size_t n = 3;
+      d_vector J(n * n);
+      for(size_t k = 0; k < n * n; ++k)
+         J[k] = 0.0;
+      J[0 * n + 0] = x[1];
+      J[0 * n + 1] = x[0];
+      if( x[0] > 0.0 )
+         J[1 * n + 2] = cos( x[2] );
+      else
+      {  J[1 * n + 0] = cos( x[2] );
+         J[1 * n + 2] = - sin( x[2] ) * x[0];
+      }
+      J[2 * n + 1] = x[2];
+      J[2 * n + 2] = x[1];
+      return J;
+   }
+}
+bool sparse_cache(void)
+{  bool ok = true;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   size_t n = 3;
+   //
+   // start with an empty cache
+   CppAD::sparse_cache_clear();
+   ok &= CppAD::sparse_cache_size() == 0;
+   //
+   // x_list: three argument values, the last one has a different recording
+   d_vector x_list[3];
+   for(size_t ell = 0; ell < 3; ++ell)
+   {  x_list[ell].resize(n);
+      for(size_t j = 0; j < n; ++j)
+         x_list[ell][j] = double(ell + j + 1);
+   }
+   x_list[2][0] = -1.0;
+   //
+   size_t hash_0 = 0;
+   std::string coloring = "cppad";
+   CppAD::sparse_rcv<s_vector, d_vector> jac;
+   for(size_t ell = 0; ell < 3; ++ell)
+   {  const d_vector& x = x_list[ell];
+      //
+      // retape the function for this argument value
+      CppAD::ADFun<double> f = record(x);
+      if( ell == 0 )
+         hash_0 = f.structure_hash();
+      //
+      // the first two recordings have the same structure
+      ok &= (f.structure_hash() == hash_0) == (ell < 2);
+      //
+      // Jacobian
+      size_t n_sweep = f.sparse_jac_cache(x, jac, coloring);
+      if( x[0] > 0.0 )
+         ok &= n_sweep == 2;
+      else
+         ok &= n_sweep == 3;
+      //
+      // the first two recordings use the same cache entry
+      if( ell < 2 )
+         ok &= CppAD::sparse_cache_size() == 1;
+      else
+         ok &= CppAD::sparse_cache_size() == 2;
+      //
+      // check the Jacobian values
+      d_vector J = jacobian(x);
+      size_t nnz = 5;
+      if( x[0] < 0.0 )
+         nnz = 6;
+      ok &= jac.nnz() == nnz;
+      for(size_t k = 0; k < jac.nnz(); ++k)
+      {  double check = J[ jac.row()[k] * n + jac.col()[k] ];
+         ok &= NearEqual(jac.val()[k], check, eps99, eps99);
+      }
+   }
+   //
+   // Hessian of w^T F(x)
+   d_vector x = x_list[0], w(n);
+   for(size_t i = 0; i < n; ++i)
+      w[i] = double(i + 1);
+   CppAD::ADFun<double> f = record(x);
+   CppAD::sparse_rcv<s_vector, d_vector> hes;
+   f.sparse_hes_cache(x, w, hes, "cppad.symmetric");
+   ok &= CppAD::sparse_cache_size() == 3;
+   //
+   // check the Hessian values
+   ok &= hes.nnz() == 5;
+   for(size_t k = 0; k < hes.nnz(); ++k)
+   {  size_t r = hes.row()[k];
+      size_t c = hes.col()[k];
+      double check = 0.0;
+      if( r + c == 1 )
+         check = w[0];
+      if( r == 2 && c == 2 )
+         check = - w[1] * sin( x[2] );
+      if( r + c == 3 )
+         check = w[2];
+      ok &= NearEqual(hes.val()[k], check, eps99, eps99);
+   }
+   //
+   // free the memory used by the cache
+   CppAD::sparse_cache_clear();
+   ok &= CppAD::sparse_cache_size() == 0;
+   //
+   return ok;
+}
+// END C++
@@ -57,6 +57,13 @@ private :
       bool       record_compare ,
       ADVector&  dynamic
    );
+   template <class BaseVector, class ADVector>
+   friend void mul_add_vec(
+      const BaseVector& a ,
+      const ADVector&   x ,
+      const BaseVector& b ,
+      ADVector&         y
+   );
 
    // one argument functions
    friend bool Constant  <Base> (const AD<Base>    &u);
@@ -252,6 +259,9 @@ public:
    // abort current AD<Base> recording
    static void        abort_recording(void);
 
+   // reserve memory for the current AD<Base> recording
+   static void        tape_reserve(size_t n_op, size_t n_arg, size_t n_par);
+
    // set the maximum number of OpenMP threads (deprecated)
    static void        omp_max_thread(size_t number);
 
@@ -291,6 +301,9 @@ private:
    static local::ADTape<Base>*         tape_manage(tape_manage_enum job);
    static local::ADTape<Base>*  tape_ptr(void);
    static local::ADTape<Base>*  tape_ptr(tape_id_t tape_id);
+# if CPPAD_TAPE_THREAD_LOCAL
+   static local::ADTape<Base>** tape_thread_local(void);
+# endif
 };
 // ---------------------------------------------------------------------------
 
@@ -25,6 +25,7 @@ Contents
    include/cppad/core/optimize.hpp
    include/cppad/core/fun_check.hpp
    include/cppad/core/check_for_nan.hpp
+   include/cppad/core/compact_tape.hpp
    include/cppad/core/to_csrc.hpp
 }
 
@@ -53,6 +54,8 @@ template <class Base, class RecBase>
 class ADFun {
    // ADFun<Base> must be a friend of ADFun< AD<Base> > for base2ad to work.
    template <class Base2, class RecBase2> friend class ADFun;
+   // fun_partition uses the Taylor coefficients for its functions
+   template <class Base2, class RecBase2> friend class fun_partition;
 private:
    // ------------------------------------------------------------
    // Private member variables
@@ -121,6 +124,14 @@ private:
    /// Not in subgraph_info_ because it depends on Base.
    local::pod_vector_maybe<Base> subgraph_partial_;
 
+   /// used for reverse mode calculations.
+   /// Declared here to avoid reallocation for each call to Reverse.
+   local::pod_vector_maybe<Base> reverse_partial_;
+
+   /// are all the elements of reverse_partial_ zero
+   /// (false while a reverse sweep is using it)
+   bool reverse_partial_zero_;
+
    /// the operation sequence corresponding to this object
    local::player<Base> play_;
 
@@ -134,7 +145,7 @@ private:
 
    /// Set results of the forward mode Jacobian sparsity calculations
    /// for_jac_sparse_set_.n_set() != 0  implies for_sparse_pack_ is empty.
-   local::sparse::list_setvec for_jac_sparse_set_;
+   local::sparse::hybrid_setvec for_jac_sparse_set_;
 
 
    // ------------------------------------------------------------
@@ -169,6 +180,62 @@ private:
       SetVector&               s
    );
 
+   // setup a context for use with this function
+   // (doxygen in cppad/core/fun_context.hpp)
+   void setup_context(
+      size_t q, size_t num_keep, fun_context<Base>& context
+   ) const;
+
+   // setup reverse_partial_ and the subgraph used by reverse_sweep
+   // (doxygen in cppad/core/reverse.hpp)
+   void reverse_setup(size_t q);
+
+   // reverse mode sweep for Reverse(q, w) and Reverse(q, w, context)
+   // (doxygen in cppad/core/reverse.hpp)
+   void reverse_sweep(
+      size_t                           q           ,
+      size_t                           cap_order   ,
+      const Base*                      taylor      ,
+      Base*                            partial     ,
+      bool*                            cskip_op    ,
+      const local::pod_vector<addr_t>& load_op2var
+   ) const;
+   template <class Addr>
+   void reverse_sweep_subgraph(
+      size_t                           q           ,
+      size_t                           cap_order   ,
+      const Base*                      taylor      ,
+      Base*                            partial     ,
+      bool*                            cskip_op    ,
+      const local::pod_vector<addr_t>& load_op2var
+   ) const;
+
+   // zero the partials written by reverse_sweep
+   // (doxygen in cppad/core/reverse.hpp)
+   void reverse_clear(size_t q, Base* partial) const;
+
+   // second hash code for the structure of the operation sequence
+   // (doxygen in cppad/core/sparse_cache.hpp)
+   size_t structure_check(void) const;
+
+   // number of operators used by each dependent variable
+   // (doxygen in cppad/core/fun_partition.hpp)
+   template <class Addr>
+   void partition_weight(local::pod_vector<size_t>& weight);
+
+   // reverse sweeps done by one thread during sparse_jac_rev
+   // (doxygen in cppad/core/sparse_jac.hpp)
+   template <class SizeVector, class BaseVector>
+   void sparse_jac_rev_thread(
+      size_t                               thread      ,
+      size_t                               n_thread    ,
+      const vector<size_t>&                color       ,
+      const vector<size_t>&                order       ,
+      const vector<size_t>&                color_begin ,
+      Base*                                partial     ,
+      sparse_rcv<SizeVector, BaseVector>*  subset
+   );
+
    // vector of bool version of RevSparseJac
    // (doxygen in cppad/core/rev_sparse_jac.hpp)
    template <class SetVector>
@@ -294,6 +361,7 @@ public:
 
    // create from Json or C++ AD graph
    void from_json(const std::string& json);
+   void from_json(std::istream& is);
    void from_graph(const cpp_graph& graph_obj);
    void from_graph(
       const cpp_graph&    graph_obj  ,
@@ -306,6 +374,17 @@ public:
    std::string to_json(void);
    void to_csrc(std::ostream& os, const std::string& type);
 
+   // write and read the binary tape format
+   // (doxygen in cppad/core/binary_tape.hpp)
+   void to_binary(std::ostream& os) const;
+   void to_binary(std::ostream& os, bool compact) const;
+   void from_binary(std::istream& is);
+
+   // store the operation sequence using a compact encoding
+   // (doxygen in cppad/core/compact_tape.hpp)
+   void compact_tape(bool compact);
+   bool compact_tape(void) const;
+
    // create ADFun< AD<Base> > from this ADFun<Base>
    // (doxygen in cppad/core/base2ad.hpp)
    ADFun< AD<Base>, RecBase > base2ad(void) const;
@@ -341,10 +420,39 @@ public:
       size_t q, const BaseVector& xq, std::ostream& s = std::cout
    );
 
+   /// zero order forward mode at multiple points
+   /// (doxygen in cppad/core/forward/forward_batch.hpp)
+   template <class BaseVector>
+   void forward_batch(
+      size_t n_point, const BaseVector& x, BaseVector& y
+   );
+
+   /// zero order forward mode using multiple threads
+   /// (doxygen in cppad/core/forward/forward_level.hpp)
+   template <class BaseVector>
+   BaseVector forward_level(size_t n_thread, const BaseVector& x0);
+
    /// reverse mode sweep
    template <class BaseVector>
    BaseVector Reverse(size_t p, const BaseVector &v);
 
+   /// forward mode using a separate context (doxygen in fun_context.hpp)
+   template <class BaseVector>
+   BaseVector Forward(
+      size_t q, const BaseVector& xq, fun_context<Base>& context
+   ) const;
+
+   /// reverse mode using a separate context (doxygen in fun_context.hpp)
+   template <class BaseVector>
+   BaseVector Reverse(
+      size_t q, const BaseVector& w, fun_context<Base>& context
+   ) const;
+
+   /// partition by dependent variable (doxygen in fun_partition.hpp)
+   fun_partition<Base, RecBase> partition(
+      size_t n_part, const std::string& options = ""
+   );
+
    // forward Jacobian sparsity pattern
    // (doxygen in cppad/core/for_sparse_jac.hpp)
    template <class SetVector>
@@ -416,18 +524,20 @@ public:
       sparse_rcv<SizeVector, BaseVector>&  subset    ,
       const sparse_rc<SizeVector>&         pattern   ,
       const std::string&                   coloring  ,
-      sparse_jac_work&                     work
+      sparse_jac_work&                     work      ,
+      size_t                               n_thread = 1
    );
 
    // compute sparse Jacobian using reverse mode
    // (doxygen in cppad/core/sparse_jac.hpp)
    template <class SizeVector, class BaseVector>
    size_t sparse_jac_rev(
-      const BaseVector&                    x        ,
-      sparse_rcv<SizeVector, BaseVector>&  subset   ,
-      const sparse_rc<SizeVector>&         pattern  ,
-      const std::string&                   coloring ,
-      sparse_jac_work&                     work
+      const BaseVector&                    x            ,
+      sparse_rcv<SizeVector, BaseVector>&  subset       ,
+      const sparse_rc<SizeVector>&         pattern      ,
+      const std::string&                   coloring     ,
+      sparse_jac_work&                     work         ,
+      size_t                               n_thread = 1
    );
 
    // compute sparse Hessian
@@ -439,7 +549,31 @@ public:
       sparse_rcv<SizeVector, BaseVector>&  subset   ,
       const sparse_rc<SizeVector>&         pattern  ,
       const std::string&                   coloring ,
-      sparse_hes_work&                     work
+      sparse_hes_work&                     work     ,
+      size_t                               n_thread = 1
+   );
+
+   // hash code for the structure of the operation sequence
+   // (doxygen in cppad/core/sparse_cache.hpp)
+   size_t structure_hash(void) const;
+
+   // compute sparse Jacobian using the sparse cache
+   // (doxygen in cppad/core/sparse_cache.hpp)
+   template <class SizeVector, class BaseVector>
+   size_t sparse_jac_cache(
+      const BaseVector&                    x        ,
+      sparse_rcv<SizeVector, BaseVector>&  jac      ,
+      const std::string&                   coloring
+   );
+
+   // compute sparse Hessian using the sparse cache
+   // (doxygen in cppad/core/sparse_cache.hpp)
+   template <class SizeVector, class BaseVector>
+   size_t sparse_hes_cache(
+      const BaseVector&                    x        ,
+      const BaseVector&                    w        ,
+      sparse_rcv<SizeVector, BaseVector>&  hes      ,
+      const std::string&                   coloring
    );
 
    // compute sparsity pattern using subgraphs
@@ -461,7 +595,8 @@ public:
       bool                         transpose        ,
       bool                         dependency       ,
       bool                         internal_bool    ,
-      sparse_rc<SizeVector>&       pattern_out
+      sparse_rc<SizeVector>&       pattern_out      ,
+      size_t                       n_thread = 1
    );
 
    // reverse mode Jacobian sparsity pattern
@@ -703,6 +838,24 @@ public:
       const BaseVector   &x ,
       size_t              j );
 
+   /// function value and derivative of a weighted sum of the components
+   template <class BaseVector>
+   void gradient(
+      const BaseVector&  x  ,
+      const BaseVector&  w  ,
+      BaseVector&        y  ,
+      BaseVector&        dw );
+
+   /// reverse mode for a repeated step using binomial checkpointing
+   template <class BaseVector>
+   size_t checkpoint_reverse(
+      size_t             n_step  ,
+      size_t             n_store ,
+      const BaseVector&  x       ,
+      const BaseVector&  w       ,
+      BaseVector&        y       ,
+      BaseVector&        dw      );
+
    /// reverse mode calculation of derivative of one range component
    template <class BaseVector>
    BaseVector RevOne(
@@ -837,6 +990,8 @@ public:
 
 // non-user interfaces
 # include <cppad/local/sweep/forward0.hpp>
+# include <cppad/local/sweep/forward0_batch.hpp>
+# include <cppad/local/sweep/forward0_level.hpp>
 # include <cppad/local/sweep/forward1.hpp>
 # include <cppad/local/sweep/forward2.hpp>
 # include <cppad/local/sweep/reverse.hpp>
@@ -854,6 +1009,8 @@ public:
 # include <cppad/core/fun_construct.hpp>
 # include <cppad/core/base2ad.hpp>
 # include <cppad/core/abort_recording.hpp>
+# include <cppad/core/tape_reserve.hpp>
+# include <cppad/core/mul_add_vec.hpp>
 # include <cppad/core/fun_eval.hpp>
 # include <cppad/core/drivers.hpp>
 # include <cppad/core/fun_check.hpp>
@@ -863,5 +1020,7 @@ public:
 # include <cppad/core/graph/from_json.hpp>
 # include <cppad/core/graph/to_json.hpp>
 # include <cppad/core/to_csrc.hpp>
+# include <cppad/core/binary_tape.hpp>
+# include <cppad/core/compact_tape.hpp>
 
 # endif
@@ -111,6 +111,8 @@ Contents
    include/cppad/core/atomic/four/call.hpp
    include/cppad/core/atomic/four/for_type.hpp
    include/cppad/core/atomic/four/forward.hpp
+   include/cppad/core/atomic/four/forward_ptr.hpp
+   include/cppad/core/atomic/four/batch.hpp
    include/cppad/core/atomic/four/reverse.hpp
    include/cppad/core/atomic/four/jac_sparsity.hpp
    include/cppad/core/atomic/four/hes_sparsity.hpp
@@ -212,6 +214,37 @@ public:
       vector< AD<Base> >&          ataylor_y
    );
    // ------------------------------------------------------------------------
+   // forward_ptr
+   virtual bool forward_ptr(
+      size_t                       call_id     ,
+      const vector<bool>&          select_y    ,
+      size_t                       n           ,
+      size_t                       m           ,
+      const Base*                  taylor_x    ,
+      Base*                        taylor_y
+   );
+   // ------------------------------------------------------------------------
+   // forward_batch
+   virtual bool forward_batch(
+      const vector<size_t>&        call_id     ,
+      const vector<bool>&          select_y    ,
+      size_t                       order_low   ,
+      size_t                       order_up    ,
+      const vector<Base>&          taylor_x    ,
+      vector<Base>&                taylor_y
+   );
+   // ------------------------------------------------------------------------
+   // reverse_batch
+   virtual bool reverse_batch(
+      const vector<size_t>&        call_id     ,
+      const vector<bool>&          select_x    ,
+      size_t                       order_up    ,
+      const vector<Base>&          taylor_x    ,
+      const vector<Base>&          taylor_y    ,
+      vector<Base>&                partial_x   ,
+      const vector<Base>&          partial_y
+   );
+   // ------------------------------------------------------------------------
    // reverse
    virtual bool reverse(
       size_t                       call_id     ,
@@ -414,6 +447,8 @@ public:
 # include <cppad/core/atomic/four/for_type.hpp>
 # include <cppad/core/atomic/four/rev_depend.hpp>
 # include <cppad/core/atomic/four/forward.hpp>
+# include <cppad/core/atomic/four/forward_ptr.hpp>
+# include <cppad/core/atomic/four/batch.hpp>
 # include <cppad/core/atomic/four/reverse.hpp>
 # include <cppad/core/atomic/four/jac_sparsity.hpp>
 # include <cppad/core/atomic/four/hes_sparsity.hpp>
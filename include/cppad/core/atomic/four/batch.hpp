@@ -0,0 +1,194 @@
+# ifndef CPPAD_CORE_ATOMIC_FOUR_BATCH_HPP
+# define CPPAD_CORE_ATOMIC_FOUR_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_four_batch}
+
+Atomic Function Batched Forward and Reverse Mode
+################################################
+
+Syntax
+******
+
+| *ok* = *afun* . ``forward_batch`` (
+| |tab| *call_id* , *select_y* ,
+| |tab| *order_low* , *order_up* , *taylor_x* , *taylor_y*
+| )
+| *ok* = *afun* . ``reverse_batch`` (
+| |tab| *call_id* , *select_x* ,
+| |tab| *order_up* , *taylor_x* , *taylor_y* , *partial_x* , *partial_y*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE_FORWARD
+   // END_PROTOTYPE_FORWARD
+}
+{xrst_literal
+   // BEGIN_PROTOTYPE_REVERSE
+   // END_PROTOTYPE_REVERSE
+}
+
+Purpose
+*******
+The same atomic function is often called at many places in a recording;
+e.g., once for each element of a vector.
+When a zero order :ref:`forward<forward_zero-name>` sweep,
+or a :ref:`reverse<Reverse-name>` sweep, is done for a recording,
+CppAD groups calls to the same atomic function
+that can be evaluated at the same time.
+All the calls in a group are evaluated by one ``forward_batch``
+or ``reverse_batch`` call.
+This enables the atomic function to use vector operations
+(or a library like BLAS) for all the calls in the group.
+
+Groups
+******
+The calls in a group have the same atomic function object *afun*
+and the same number of arguments *n* and results *m* .
+They may have different values of *call_id* .
+None of the arguments for a call in a group depends on the
+results of another call in the same group.
+
+Implementation
+**************
+These callbacks are optional.
+If they are not defined by the
+:ref:`atomic_four_ctor@atomic_user` class,
+or they return *ok* == ``false`` ,
+the corresponding :ref:`atomic_four_forward-name` or
+:ref:`atomic_four_reverse-name` callback is called for each call in
+the group.
+Hence *ok* == ``false`` does not signal an error
+and you only need to implement the cases that
+are important to your application.
+These callbacks are only used with *Base* values; i.e.,
+they are not used by :ref:`base2ad-name` functions.
+
+Base
+****
+See :ref:`atomic_four_call@Base` .
+
+vector
+******
+is the :ref:`CppAD_vector-name` template class.
+
+call_id
+*******
+We use *n_call* to denote the size of this vector; i.e.,
+the number of calls in the group.
+For *k* = 0 , ... , *n_call* ``-1`` ,
+*call_id* [ *k* ] is the :ref:`atomic_four_call@call_id`
+for the *k*-th call in the group.
+
+q
+*
+We use the notation *q* = *order_up*  + 1 below.
+
+select_y
+********
+This argument has size *n_call* * *m* .
+For *k* = 0 , ... , *n_call* ``-1`` ,
+the sub-vector with indices
+*k* * *m* , ... , ( *k* + 1) * *m* ``-1``
+is the :ref:`atomic_four_forward@select_y` for the *k*-th call.
+
+select_x
+********
+This argument has size *n_call* * *n* .
+For *k* = 0 , ... , *n_call* ``-1`` ,
+the sub-vector with indices
+*k* * *n* , ... , ( *k* + 1) * *n* ``-1``
+is the :ref:`atomic_four_reverse@select_x` for the *k*-th call.
+
+order_low
+*********
+This is the :ref:`atomic_four_forward@order_low` for all the calls.
+It is zero for the ``forward_batch`` calls that CppAD makes.
+
+order_up
+********
+This is the :ref:`atomic_four_forward@order_up`
+(:ref:`atomic_four_reverse@order_up` ) for all the calls.
+It is zero for the ``forward_batch`` calls that CppAD makes.
+
+taylor_x
+********
+This argument has size *n_call* * *n* * *q* .
+For *k* = 0 , ... , *n_call* ``-1`` ,
+the sub-vector with indices
+*k* * *n* * *q* , ... , ( *k* + 1) * *n* * *q* ``-1``
+is the *taylor_x* for the *k*-th call.
+
+taylor_y
+********
+This argument has size *n_call* * *m* * *q* .
+For *k* = 0 , ... , *n_call* ``-1`` ,
+the sub-vector with indices
+*k* * *m* * *q* , ... , ( *k* + 1) * *m* * *q* ``-1``
+is the *taylor_y* for the *k*-th call.
+
+partial_x
+*********
+This argument has size *n_call* * *n* * *q* .
+For *k* = 0 , ... , *n_call* ``-1`` ,
+the sub-vector with indices
+*k* * *n* * *q* , ... , ( *k* + 1) * *n* * *q* ``-1``
+is the *partial_x* for the *k*-th call.
+
+partial_y
+*********
+This argument has size *n_call* * *m* * *q* .
+For *k* = 0 , ... , *n_call* ``-1`` ,
+the sub-vector with indices
+*k* * *m* * *q* , ... , ( *k* + 1) * *m* * *q* ``-1``
+is the *partial_y* for the *k*-th call.
+
+ok
+**
+If this calculation was done, *ok* is true.
+Otherwise, it is false and the ``forward`` or ``reverse``
+callback is used for each call in the group.
+
+Example
+*******
+The file :ref:`atomic_four_batch.cpp-name`
+contains an example and test of these callbacks.
+
+{xrst_end atomic_four_batch}
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE_FORWARD
+template <class Base>
+bool atomic_four<Base>::forward_batch(
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_y    ,
+   size_t                       order_low   ,
+   size_t                       order_up    ,
+   const vector<Base>&          taylor_x    ,
+   vector<Base>&                taylor_y    )
+// END_PROTOTYPE_FORWARD
+{  return false; }
+
+// BEGIN_PROTOTYPE_REVERSE
+template <class Base>
+bool atomic_four<Base>::reverse_batch(
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_x    ,
+   size_t                       order_up    ,
+   const vector<Base>&          taylor_x    ,
+   const vector<Base>&          taylor_y    ,
+   vector<Base>&                partial_x   ,
+   const vector<Base>&          partial_y   )
+// END_PROTOTYPE_REVERSE
+{  return false; }
+
+} // END_CPPAD_NAMESPACE
+# endif
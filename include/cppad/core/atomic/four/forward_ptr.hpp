@@ -0,0 +1,133 @@
+# ifndef CPPAD_CORE_ATOMIC_FOUR_FORWARD_PTR_HPP
+# define CPPAD_CORE_ATOMIC_FOUR_FORWARD_PTR_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_four_forward_ptr}
+
+Atomic Function Zero Order Forward Mode Using Pointers
+######################################################
+
+Syntax
+******
+
+| *ok* = *afun* . ``forward_ptr`` (
+| |tab| *call_id* , *select_y* , *n* , *m* , *taylor_x* , *taylor_y*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+During a zero order :ref:`forward<forward_zero-name>` sweep,
+CppAD stores the values for the variables in a recording
+in one contiguous array.
+If the arguments to an atomic function call are
+variables with consecutive indices in that array,
+*taylor_x* points directly into the array (instead of to a copy).
+If all the results of the call are variables,
+*taylor_y* points directly into the array
+(and the results do not need to be copied back).
+This avoids the copies needed to call the
+:ref:`atomic_four_forward-name` callback,
+which is significant when an atomic function that does
+a small amount of work is called many times.
+
+Implementation
+**************
+This callback is optional.
+If it is not defined by the
+:ref:`atomic_four_ctor@atomic_user` class,
+or it returns *ok* == ``false`` ,
+the corresponding ``forward`` callback is used.
+Hence *ok* == ``false`` does not signal an error
+and you only need to implement the cases that
+are important to your application.
+It is only used for zero order forward mode with
+*Base* values; i.e., it is not used by
+:ref:`base2ad-name` functions.
+
+Base
+****
+See :ref:`atomic_four_call@Base` .
+
+vector
+******
+is the :ref:`CppAD_vector-name` template class.
+
+call_id
+*******
+See :ref:`atomic_four_call@call_id` .
+
+select_y
+********
+This argument has size equal to the number of results to this
+atomic function; i.e. the size of :ref:`atomic_four_call@ay` .
+It specifies which components of *y* must be computed.
+If *select_y* [ *i* ] is false, *taylor_y* [ *i* ] may not point
+to valid memory and must not be set.
+
+n
+*
+is the number of arguments to this atomic function; i.e.,
+the size of :ref:`atomic_four_call@ax` .
+
+m
+*
+is the number of results for this atomic function; i.e.,
+the size of :ref:`atomic_four_call@ay` .
+
+taylor_x
+********
+For :math:`j = 0 , \ldots , n-1`,
+*taylor_x* [ *j* ] is the value of the *j*-th argument
+to this atomic function.
+
+taylor_y
+********
+Upon return,
+for :math:`i = 0 , \ldots , m-1` ,
+if *select_y* [ *i* ] is true,
+*taylor_y* [ *i* ] is the value of the *i*-th result
+of this atomic function.
+The memory for *taylor_y* does not overlap the memory for *taylor_x* .
+
+ok
+**
+If this calculation was done, *ok* is true.
+Otherwise, it is false and the ``forward`` callback is used instead.
+
+Example
+*******
+The file :ref:`atomic_four_forward_ptr.cpp-name`
+contains an example and test of this callback.
+The :ref:`atomic_four_mat_mul_forward.hpp-name` example
+also defines this callback.
+
+{xrst_end atomic_four_forward_ptr}
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE
+template <class Base>
+bool atomic_four<Base>::forward_ptr(
+   size_t                       call_id     ,
+   const vector<bool>&          select_y    ,
+   size_t                       n           ,
+   size_t                       m           ,
+   const Base*                  taylor_x    ,
+   Base*                        taylor_y    )
+// END_PROTOTYPE
+{  return false; }
+
+} // END_CPPAD_NAMESPACE
+# endif
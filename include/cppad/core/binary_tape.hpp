@@ -0,0 +1,389 @@
+# ifndef CPPAD_CORE_BINARY_TAPE_HPP
+# define CPPAD_CORE_BINARY_TAPE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/core/ad_fun.hpp>
+# include <cppad/local/play/binary_io.hpp>
+# include <cppad/local/play/binary_check.hpp>
+
+/*
+------------------------------------------------------------------------------
+{xrst_begin binary_tape}
+{xrst_spell
+   endian
+}
+
+Binary Tape Format for ADFun Objects
+####################################
+
+Syntax
+******
+| *f* . ``to_binary`` ( *os* )
+| *f* . ``to_binary`` ( *os* , *compact* )
+| *g* . ``from_binary`` ( *is* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_TO_BINARY
+   // END_TO_BINARY
+}
+{xrst_literal
+   // BEGIN_FROM_BINARY
+   // END_FROM_BINARY
+}
+
+Purpose
+*******
+The :ref:`json_ad_graph-name` and :ref:`cpp_ad_graph-name`
+representations of a function are portable, but creating a function
+from them requires parsing and recording the operation sequence.
+The binary format is a direct copy of the vectors that define the
+operation sequence.
+Hence, creating a function from this format does not require any parsing
+or recording; each vector is read using one block read.
+
+f
+*
+is the ``ADFun`` < *Base* > object that is written to *os* .
+
+os
+**
+is the stream that *f* is written to.
+It should be opened in binary mode; e.g.,
+``std::ios::out | std::ios::binary`` .
+
+compact
+*******
+If this argument is not present, it is false.
+If it is true, the operators and their arguments are written using a
+variable length encoding where each value usually requires one or two bytes.
+In addition, variable arguments are encoded relative to the
+result of the operator that uses them; i.e., the closer a variable is to
+where it is used, the smaller its encoding.
+This makes the operation sequence part of the file much smaller,
+but reading it requires decoding each operator and argument.
+Otherwise, the operators and arguments are written using the same
+vectors as in memory.
+The stream *is* read by ``from_binary`` can use either encoding.
+For both encodings, *g* stores its operation sequence using
+normal storage; see :ref:`compact_tape-name` for using the
+compact encoding in memory.
+
+g
+*
+is the ``ADFun`` < *Base* > object that is read from *is* .
+Upon return it has the same
+:ref:`independent variables<glossary@Tape@Independent Variable>` ,
+:ref:`dependent variables<glossary@Tape@Dependent Variables>` ,
+:ref:`dynamic parameters<glossary@Parameter@Dynamic>` ,
+:ref:`operation sequence<glossary@Operation@Sequence>` ,
+and :ref:`function_name-name` as *f* .
+There are no Taylor coefficients stored in *g* ; i.e.,
+*g* . ``size_order`` () is zero.
+
+is
+**
+is the stream that *g* is read from.
+It should be opened in binary mode; e.g.,
+``std::ios::in | std::ios::binary`` .
+If there is an error reading *is* , or it does not contain a function
+written by ``to_binary`` that is compatible with this version of CppAD,
+the :ref:`ErrorHandler-name` is called and *g* is not changed.
+Every operator, argument index, and dynamic parameter in *is*
+is checked against the sizes in *is* before it is used.
+Hence a truncated or corrupted stream results in a call to the
+error handler and not an out of bounds memory access.
+
+Format
+******
+The format begins with a header that identifies the version of the format,
+the size of the types that are used for the vectors,
+and the endian order of the system that wrote the file.
+The file can only be read by a system where these are the same.
+Every value and vector in the format is padded to a multiple of 8 bytes.
+Hence, if the format starts on an 8 byte boundary,
+so does every vector in the format.
+
+Restrictions
+************
+
+Base
+====
+The type *Base* must be plain old data; e.g., ``float`` or ``double`` .
+The size of *Base* is stored in the header and checked when reading,
+but the type itself is not; i.e., the same *Base* must be used
+for *f* and *g* .
+
+Atomic and Discrete Functions
+=============================
+The operation sequence for *f* cannot contain
+:ref:`atomic-name` or :ref:`discrete-name` function calls
+because the identifiers for these functions
+are not the same in different programs.
+Use :ref:`to_json-name` for such functions.
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/binary_tape.cpp
+}
+The file :ref:`binary_tape.cpp-name`
+contains an example and test of these operations.
+
+{xrst_end binary_tape}
+*/
+
+/// version number for the binary tape format
+# define CPPAD_BINARY_TAPE_VERSION 2
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file binary_tape.hpp
+Write and read an ADFun object using the binary tape format.
+*/
+
+namespace local { namespace play {
+/*!
+Values in the header for the binary tape format (after the magic string).
+This must be the same when reading as when writing.
+
+\tparam Base
+is the base type for the ADFun object.
+
+\param header
+The input size does not matter. Upon return it contains the header values.
+*/
+template <class Base>
+inline void binary_tape_header(pod_vector<size_t>& header)
+{  header.resize(9);
+   header[0] = CPPAD_BINARY_TAPE_VERSION;
+   // a value with distinct bytes is used to check the endian order
+   header[1] = size_t( 0x01020304 );
+   header[2] = sizeof(Base);
+   header[3] = sizeof(addr_t);
+   header[4] = sizeof(opcode_t);
+   header[5] = sizeof(size_t);
+   header[6] = sizeof(bool);
+   header[7] = size_t( NumberOp );
+   header[8] = size_t( number_dyn );
+}
+/// magic string at the beginning of the binary tape format
+inline const char* binary_tape_magic(void)
+{  return "CppADbin"; }
+} }
+
+// BEGIN_TO_BINARY
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::to_binary(std::ostream& os, bool compact) const
+// END_TO_BINARY
+{  CPPAD_ASSERT_KNOWN( local::is_pod<Base>(),
+      "f.to_binary(os): Base is not plain old data"
+   );
+   //
+   // check for operators that cannot be written
+   // (decode the operators if they are stored using the compact encoding)
+   bool atom_or_dis = false;
+   if( play_.compact_tape() )
+   {  local::play::const_compact_iterator itr(
+         play_.num_var_rec(), play_.compact_vec()
+      );
+      local::OpCode op;
+      const addr_t* arg;
+      size_t        i_var;
+      for(size_t i_op = 0; i_op < play_.num_op_rec(); ++i_op)
+      {  if( i_op > 0 )
+            ++itr;
+         itr.op_info(op, arg, i_var);
+         atom_or_dis |= op == local::AFunOp || op == local::DisOp;
+      }
+   }
+   else
+   {  for(size_t i_op = 0; i_op < play_.num_op_rec(); ++i_op)
+      {  local::OpCode op = play_.GetOp(i_op);
+         atom_or_dis |= op == local::AFunOp || op == local::DisOp;
+      }
+   }
+   if( atom_or_dis )
+   {  std::string msg = "f.to_binary(os): ";
+      msg += "f contains an atomic or discrete function call";
+      //
+      // use this source code as point of detection
+      bool known       = true;
+      int  line        = __LINE__;
+      const char* file = __FILE__;
+      const char* exp  = "op != AFunOp && op != DisOp";
+      //
+      // CppAD error handler
+      ErrorHandler::Call( known, line, file, exp, msg.c_str() );
+   }
+   const local::pod_vector<local::opcode_t>& dyn_par_op( play_.dyn_par_op() );
+   for(size_t i_dyn = 0; i_dyn < dyn_par_op.size(); ++i_dyn)
+   {  local::op_code_dyn op = local::op_code_dyn( dyn_par_op[i_dyn] );
+      if( op == local::atom_dyn || op == local::dis_dyn )
+      {  std::string msg = "f.to_binary(os): ";
+         msg += "f contains an atomic or discrete function call";
+         //
+         // use this source code as point of detection
+         bool known       = true;
+         int  line        = __LINE__;
+         const char* file = __FILE__;
+         const char* exp  = "op != atom_dyn && op != dis_dyn";
+         //
+         // CppAD error handler
+         ErrorHandler::Call( known, line, file, exp, msg.c_str() );
+      }
+   }
+   //
+   // header
+   os.write( local::play::binary_tape_magic(), local::play::binary_align );
+   local::pod_vector<size_t> header;
+   local::play::binary_tape_header<Base>(header);
+   local::play::binary_write_vec(os, header.data(), header.size() );
+   //
+   // function_name_
+   local::play::binary_write_vec(os,
+      function_name_.data(), function_name_.size()
+   );
+   //
+   // ind_taddr_, dep_taddr_, dep_parameter_
+   local::play::binary_write_vec(os, ind_taddr_.data(), ind_taddr_.size() );
+   local::play::binary_write_vec(os, dep_taddr_.data(), dep_taddr_.size() );
+   local::play::binary_write_vec(os,
+      dep_parameter_.data(), dep_parameter_.size()
+   );
+   //
+   // play_
+   play_.write_binary(os, compact);
+}
+/// write using the binary tape format without the compact encoding
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::to_binary(std::ostream& os) const
+{  to_binary(os, false); }
+
+// BEGIN_FROM_BINARY
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::from_binary(std::istream& is)
+// END_FROM_BINARY
+{  CPPAD_ASSERT_KNOWN( local::is_pod<Base>(),
+      "f.from_binary(is): Base is not plain old data"
+   );
+   // msg
+   std::string msg = "";
+   //
+   // magic
+   char magic[local::play::binary_align];
+   is.read(magic, local::play::binary_align);
+   const char* check = local::play::binary_tape_magic();
+   if( ! is.good() || ! std::equal(magic, magic + 8, check) )
+      msg = "is does not begin with the binary tape magic string";
+   //
+   // header
+   if( msg == "" )
+   {  local::pod_vector<size_t> header, check_header;
+      local::play::binary_tape_header<Base>(check_header);
+      bool ok = local::play::binary_read_vec(is, header);
+      ok = ok && header.size() == check_header.size();
+      if( ok && header[0] != check_header[0] )
+         msg = "binary tape format version is different";
+      for(size_t i = 1; ok && i < header.size(); ++i)
+         ok = header[i] == check_header[i];
+      if( msg == "" && ! ok )
+         msg = "binary tape header is not compatible with this system";
+   }
+   //
+   // function_name, ind_taddr, dep_taddr, dep_parameter
+   local::pod_vector<char>   function_name;
+   local::pod_vector<size_t> ind_taddr, dep_taddr;
+   local::pod_vector<bool>   dep_parameter;
+   if( msg == "" )
+   {  bool ok = true;
+      ok = ok && local::play::binary_read_vec(is, function_name);
+      ok = ok && local::play::binary_read_vec(is, ind_taddr);
+      ok = ok && local::play::binary_read_vec(is, dep_taddr);
+      ok = ok && local::play::binary_read_vec(is, dep_parameter);
+      ok = ok && 0 < dep_taddr.size();
+      ok = ok && dep_taddr.size() == dep_parameter.size();
+      ok = ok && local::play::binary_check_bool(dep_parameter);
+      if( ! ok )
+         msg = "error reading binary tape function information";
+   }
+   //
+   // play
+   local::player<Base> play;
+   if( msg == "" )
+   {  bool ok = play.read_binary(is, ind_taddr.size() );
+      for(size_t j = 0; ok && j < ind_taddr.size(); ++j)
+         ok = ind_taddr[j] == j + 1;
+      for(size_t i = 0; ok && i < dep_taddr.size(); ++i)
+         ok = 0 < dep_taddr[i] && dep_taddr[i] < play.num_var_rec();
+      if( ! ok )
+         msg = "error reading binary tape operation sequence";
+   }
+   if( msg != "" )
+   {  msg = "f.from_binary(is): " + msg;
+      //
+      // use this source code as point of detection
+      bool known       = true;
+      int  line        = __LINE__;
+      const char* file = __FILE__;
+      const char* exp  = "msg == \"\"";
+      //
+      // CppAD error handler
+      ErrorHandler::Call( known, line, file, exp, msg.c_str() );
+      return;
+   }
+   // ---------------------------------------------------------------------
+   // set ad_fun.hpp private member data; see Dependent
+   // ---------------------------------------------------------------------
+   function_name_ = std::string( function_name.data(), function_name.size() );
+   //
+   // bool values in this object except check_for_nan_
+   exceed_collision_limit_    = false;
+   has_been_optimized_        = false;
+   //
+   // size_t values in this object
+   compare_change_count_      = 1;
+   compare_change_number_     = 0;
+   compare_change_op_index_   = 0;
+   num_order_taylor_          = 0;
+   cap_order_taylor_          = 0;
+   num_direction_taylor_      = 0;
+   num_var_tape_              = play.num_var_rec();
+   //
+   // ind_taddr_, dep_taddr_, dep_parameter_
+   ind_taddr_.swap(ind_taddr);
+   dep_taddr_.swap(dep_taddr);
+   dep_parameter_.swap(dep_parameter);
+   //
+   // taylor_, subgraph_partial_
+   taylor_.resize(0);
+   subgraph_partial_.resize(0);
+   //
+   // cskip_op_
+   cskip_op_.resize( play.num_op_rec() );
+   //
+   // load_op2var_
+   load_op2var_.resize( play.num_var_load_rec() );
+   //
+   // play_
+   play_.swap(play);
+   //
+   // for_jac_sparse_pack_, for_jac_sparse_set_
+   for_jac_sparse_pack_.resize(0, 0);
+   for_jac_sparse_set_.resize(0,0);
+   //
+   // subgraph_info_
+   subgraph_info_.resize(
+      ind_taddr_.size(),   // n_dep
+      dep_taddr_.size(),   // n_ind
+      play_.num_op_rec(),  // n_op
+      play_.num_var_rec()  // n_var
+   );
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
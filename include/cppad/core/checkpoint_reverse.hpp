@@ -0,0 +1,333 @@
+# ifndef CPPAD_CORE_CHECKPOINT_REVERSE_HPP
+# define CPPAD_CORE_CHECKPOINT_REVERSE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin checkpoint_reverse}
+{xrst_spell
+   dw
+   griewank
+   revolve
+   walther
+}
+
+Reverse Mode for a Repeated Step Using Binomial Checkpointing
+#############################################################
+
+Syntax
+******
+| *n_forward* = *f* . ``checkpoint_reverse`` (
+| |tab| *n_step* , *n_store* , *x* , *w* , *y* , *dw*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^n` to denote the
+:ref:`glossary@AD Function` corresponding to *f* .
+It is one step of a time stepping method; i.e.,
+the state at step *k+1* is
+:math:`x^{k+1} = F( x^k )` .
+This routine computes the final state :math:`y = x^N` where
+:math:`x^0 = x` and *N* is *n_step* .
+It also computes the derivative of :math:`w^\R{T} y`
+with respect to :math:`x` .
+
+Memory
+======
+Recording all the steps in one ``ADFun`` object requires memory
+proportional to *N* times the number of variables in one step,
+for the operation sequence and for the
+:ref:`Taylor coefficients<glossary@Taylor Coefficient>` .
+This routine only uses the operation sequence and Taylor coefficients
+for one step, and at most *n_store* states :math:`x^k` .
+The states that are not stored are recomputed using the
+binomial checkpointing schedule (revolve) of Griewank and Walther.
+
+f
+*
+Note that the :ref:`ADFun-name` object *f* is not ``const``
+(see :ref:`checkpoint_reverse@checkpoint_reverse Uses Forward` below).
+Its domain and range dimensions must be equal.
+The current value of the :ref:`dynamic parameters<new_dynamic-name>`
+for *f* are used for every step.
+
+n_step
+******
+This is the number of steps *N* ; it must be greater than zero.
+
+n_store
+*******
+This is the maximum number of states, in addition to the
+initial state *x* , that are stored at the same time.
+If *n_store* is zero, each state is recomputed from *x* .
+
+x
+*
+The size of *x* is *n* and it is the initial state :math:`x^0` .
+
+w
+*
+The size of *w* is *n* and it is the weighting for the final state.
+
+y
+*
+The input size and value of *y* do not matter.
+Upon return, its size is *n* and it is equal to the final state
+:math:`x^N` .
+
+dw
+**
+The input size and value of *dw* do not matter.
+Upon return, its size is *n* and
+for :math:`j = 0 , \ldots , n-1`
+
+.. math::
+
+   dw[j] = \sum_{i=0}^{n-1} w_i \D{ x_i^N }{ x_j^0 }
+
+n_forward
+*********
+This is the number of zero order forward evaluations of *f* that were
+used to compute the states :math:`x^k` that were not stored.
+It does not include the *N* evaluations that are part of computing
+the derivative for each step.
+Suppose *t* is the smallest integer such that
+:math:`N \leq ( s + t )! / ( s! t! )` where *s* is *n_store* .
+Then each step is evaluated at most *t* times
+(not counting the derivative evaluation)
+and *n_forward* is less than or equal :math:`t N` .
+If *s* is zero, *n_forward* is :math:`N (N - 1) / 2` .
+
+BaseVector
+**********
+The type *BaseVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+checkpoint_reverse Uses Forward
+*******************************
+After a call to ``checkpoint_reverse`` ,
+the zero order Taylor coefficients correspond to
+*f* . ``Forward`` (0, *x* )
+and the other coefficients are unspecified.
+
+See Also
+********
+:ref:`chkpoint_two-name` , :ref:`rev_checkpoint.cpp-name`
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/checkpoint_reverse.cpp
+}
+The file
+:ref:`checkpoint_reverse.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end checkpoint_reverse}
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file checkpoint_reverse.hpp
+Reverse mode for a repeated step using binomial checkpointing.
+*/
+
+/*!
+Number of steps that can be reversed using s stored states and t forward
+evaluations of each step; i.e., the binomial coefficient (s+t)! / (s! t!).
+
+\param s
+number of stored states.
+
+\param t
+number of forward evaluations of each step.
+
+\param limit
+if the binomial coefficient is greater than limit, the return value is
+limit + 1 (this avoids overflow).
+*/
+inline size_t checkpoint_beta(size_t s, size_t t, size_t limit)
+{  size_t max_size = std::numeric_limits<size_t>::max();
+   size_t beta     = 1;
+   for(size_t i = 1; i <= s; ++i)
+   {  // (t+i)! / (i! t!) = (t+i-1)! / ( (i-1)! t! ) * (t+i) / i
+      if( beta > max_size / (t + i) )
+         return limit + 1;
+      beta = beta * (t + i) / i;
+      if( beta > limit )
+         return limit + 1;
+   }
+   return beta;
+}
+
+/*!
+Reverse a sequence of steps using binomial checkpointing.
+
+\param f
+is the function corresponding to one step.
+
+\param n_step
+is the total number of steps.
+
+\param first
+is the index of the first step in this sequence.
+
+\param last
+is one greater than the index of the last step in this sequence.
+
+\param n_store
+is the number of states that can be stored at the same time
+for this sequence.
+
+\param x_first
+is the state at the beginning of step first.
+
+\param lambda
+On input it is the partial of the weighted final state with respect to
+the state at the beginning of step last.
+Upon return it is the partial with respect to the state at the beginning of
+step first.
+
+\param y
+If last is n_step, upon return it is the state at the end of step last-1.
+
+\param n_forward
+is incremented by the number of forward evaluations of f
+used to compute states that were not stored.
+*/
+template <class Base, class RecBase, class BaseVector>
+void checkpoint_reverse_rec(
+   ADFun<Base, RecBase>& f         ,
+   size_t                n_step    ,
+   size_t                first     ,
+   size_t                last      ,
+   size_t                n_store   ,
+   const BaseVector&     x_first   ,
+   BaseVector&           lambda    ,
+   BaseVector&           y         ,
+   size_t&               n_forward )
+{  CPPAD_ASSERT_UNKNOWN( first < last );
+   size_t n_seq = last - first;
+   size_t n     = size_t( x_first.size() );
+   //
+   if( n_store == 0 || n_seq == 1 )
+   {  // reverse each step in this sequence by recomputing its state
+      // from x_first
+      BaseVector x_k(n), x_next(n), lambda_k(n);
+      for(size_t k = last; k > first; --k)
+      {  x_k = x_first;
+         for(size_t ell = first; ell + 1 < k; ++ell)
+         {  x_k = f.Forward(0, x_k);
+            ++n_forward;
+         }
+         f.gradient(x_k, lambda, x_next, lambda_k);
+         if( k == n_step )
+            y = x_next;
+         lambda = lambda_k;
+      }
+      return;
+   }
+   //
+   // t: smallest number of forward evaluations such that
+   // beta(n_store, t) >= n_seq
+   size_t t = 1;
+   while( checkpoint_beta(n_store, t, n_seq) < n_seq )
+      ++t;
+   //
+   // n_advance: number of steps before the next stored state
+   // beta(n_store, t) = beta(n_store, t-1) + beta(n_store-1, t)
+   size_t beta_left  = checkpoint_beta(n_store, t - 1, n_seq);
+   size_t beta_right = checkpoint_beta(n_store - 1, t, n_seq);
+   size_t n_advance  = 1;
+   if( beta_right < n_seq )
+      n_advance = n_seq - beta_right;
+   CPPAD_ASSERT_UNKNOWN( n_advance <= beta_left );
+   CPPAD_ASSERT_UNKNOWN( n_advance < n_seq );
+   //
+   // x_middle: stored state at the beginning of step middle
+   // (it is not needed after the steps that follow it are reversed)
+   size_t middle = first + n_advance;
+   {  BaseVector x_middle(n);
+      x_middle = x_first;
+      for(size_t ell = 0; ell < n_advance; ++ell)
+      {  x_middle = f.Forward(0, x_middle);
+         ++n_forward;
+      }
+      //
+      // reverse the steps after the stored state using one less stored state
+      checkpoint_reverse_rec(
+         f, n_step, middle, last, n_store - 1, x_middle, lambda, y, n_forward
+      );
+   }
+   //
+   // reverse the steps before the stored state
+   checkpoint_reverse_rec(
+      f, n_step, first, middle, n_store, x_first, lambda, y, n_forward
+   );
+   return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+size_t ADFun<Base,RecBase>::checkpoint_reverse(
+   size_t            n_step  ,
+   size_t            n_store ,
+   const BaseVector& x       ,
+   const BaseVector& w       ,
+   BaseVector&       y       ,
+   BaseVector&       dw      )
+// END_PROTOTYPE
+{  size_t n = Domain();
+   //
+   // check BaseVector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   CPPAD_ASSERT_KNOWN(
+      Range() == n,
+      "f.checkpoint_reverse: f.Range() is not equal to f.Domain()"
+   );
+   CPPAD_ASSERT_KNOWN(
+      0 < n_step,
+      "f.checkpoint_reverse: n_step is zero"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( x.size() ) == n,
+      "f.checkpoint_reverse: x.size() is not equal to f.Domain()"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( w.size() ) == n,
+      "f.checkpoint_reverse: w.size() is not equal to f.Domain()"
+   );
+   //
+   // y, dw
+   size_t n_forward = 0;
+   y.resize(n);
+   dw.resize(n);
+   for(size_t i = 0; i < n; ++i)
+      dw[i] = w[i];
+   local::checkpoint_reverse_rec(
+      *this, n_step, 0, n_step, n_store, x, dw, y, n_forward
+   );
+   //
+   return n_forward;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,137 @@
+# ifndef CPPAD_CORE_COMPACT_TAPE_HPP
+# define CPPAD_CORE_COMPACT_TAPE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+------------------------------------------------------------------------------
+{xrst_begin compact_tape}
+
+Store an Operation Sequence Using a Compact Encoding
+####################################################
+
+Syntax
+******
+| *f* . ``compact_tape`` ( *compact* )
+| *compact* = *f* . ``compact_tape`` ()
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_COMPACT_TAPE_SET
+   // END_COMPACT_TAPE_SET
+}
+{xrst_literal
+   // BEGIN_COMPACT_TAPE_GET
+   // END_COMPACT_TAPE_GET
+}
+
+Purpose
+*******
+Each operator in an operation sequence uses one byte and each of its
+arguments uses ``sizeof`` ( ``addr_t`` ) bytes; see
+:ref:`cmake@cppad_tape_addr_type` .
+The compact encoding stores each operator and argument using a
+variable number of bytes.
+Variable arguments are stored relative to the result of the operator
+that uses them, so most values require one or two bytes.
+This makes the memory used to store the operation sequence much smaller;
+see :ref:`fun_property@size_op_seq` .
+This can improve the cache hit rate when evaluating functions
+with very large operation sequences.
+
+Set
+***
+If *compact* is true (false),
+the operators and arguments in *f* are stored using the
+compact encoding (normal storage).
+The operation sequence, Taylor coefficients, and other values in *f*
+are not affected.
+If *f* is sharing its operation sequence with another ``ADFun`` object,
+e.g., it was created using the
+:ref:`assignment operator<fun_construct@Assignment Operator>` ,
+the other object is not affected.
+
+Get
+***
+The return value *compact* is true (false) if the operators and arguments
+in *f* are stored using the compact encoding (normal storage).
+The default value after a :ref:`fun_construct-name` or
+:ref:`Dependent-name` is false.
+
+Restrictions
+************
+While *f* . ``compact_tape`` () is true, the only operations that can
+use the operation sequence in *f* are:
+
+#. Zero order :ref:`forward<forward_zero-name>` mode; i.e.,
+   *f* . ``Forward`` (0, *x* ) and *f* . ``Forward`` (0, *x* , *s* ) .
+   This decodes each operator and its arguments as it is evaluated.
+#. :ref:`new_dynamic-name` .
+#. :ref:`to_binary<binary_tape-name>` .
+#. Assigning *f* to another ``ADFun`` object, including
+   :ref:`base2ad-name` .
+   The copy also uses the compact encoding.
+
+Any other operation that uses the operation sequence
+(for example, :ref:`Reverse-name` , higher order forward mode,
+sparsity patterns, or :ref:`optimize-name` )
+results in an error message when ``NDEBUG`` is not defined.
+Use *f* . ``compact_tape`` ( ``false`` ) before such operations.
+
+Execution Time
+**************
+Changing the storage takes time proportional to the size of the
+operation sequence.
+Zero order forward mode does not use the pre-decoded plan for the
+operation sequence while the storage is compact; i.e., it decodes each
+operator and argument during each evaluation.
+
+{xrst_toc_hidden
+   example/general/compact_tape.cpp
+}
+Example
+*******
+The file :ref:`compact_tape.cpp-name`
+contains an example and test of these operations.
+
+{xrst_end compact_tape}
+------------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file core/compact_tape.hpp
+Store an operation sequence using the compact encoding.
+*/
+
+/*!
+Set the storage used for the operators and arguments in this function.
+
+\param compact
+If true (false), the operators and arguments are stored using the
+compact encoding (normal storage); see player::compact_tape.
+*/
+// BEGIN_COMPACT_TAPE_SET
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::compact_tape(bool compact)
+// END_COMPACT_TAPE_SET
+{  play_.compact_tape(compact); }
+
+/*!
+Get the storage used for the operators and arguments in this function.
+
+\return
+is true (false) if the operators and arguments are stored using the
+compact encoding (normal storage).
+*/
+// BEGIN_COMPACT_TAPE_GET
+template <class Base, class RecBase>
+bool ADFun<Base,RecBase>::compact_tape(void) const
+// END_COMPACT_TAPE_GET
+{  return play_.compact_tape(); }
+
+} // END_CPPAD_NAMESPACE
+
+# endif
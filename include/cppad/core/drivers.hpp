@@ -11,5 +11,6 @@
 # include <cppad/core/rev_one.hpp>
 # include <cppad/core/for_two.hpp>
 # include <cppad/core/rev_two.hpp>
+# include <cppad/core/gradient.hpp>
 
 # endif
@@ -14,7 +14,8 @@ Syntax
 ******
 
 | *f* . ``for_jac_sparsity`` (
-| |tab| *pattern_in* , *transpose* , *dependency* , *internal_bool* , *pattern_out*
+| |tab| *pattern_in* , *transpose* , *dependency* , *internal_bool* ,
+| |tab| *pattern_out* [, *n_thread* ]
 | )
 
 Purpose
@@ -147,6 +148,29 @@ If *dependency* is true, *pattern_out* is a
 :ref:`dependency.cpp@Dependency Pattern`
 instead of sparsity pattern.
 
+n_thread
+********
+This argument is optional and has prototype
+
+   ``size_t`` *n_thread*
+
+Its default value is one.
+If it is greater than one and *internal_bool* is true,
+the columns of :math:`R` are split into *n_thread* blocks
+and ``for_jac_sparsity`` uses *n_thread* threads
+(including the current thread) to compute the patterns.
+Each thread propagates the sparsity pattern for one block of columns
+through the operation sequence, independent of the other blocks.
+The result is the same as when *n_thread* is one.
+
+See :ref:`multi_thread@Internal Threads` for how the threads are created
+and why :ref:`ta_parallel_setup-name` is not required.
+Only one thread is used if *internal_bool* is false,
+if the operation sequence contains an atomic function call
+or a :ref:`VecAD-name` operation.
+The number of threads is also limited so that each block has at least
+``std::numeric_limits<size_t>::digits`` columns.
+
 Sparsity for Entire Jacobian
 ****************************
 Suppose that
@@ -167,6 +191,8 @@ contains an example and test of this operation.
 {xrst_end for_jac_sparsity}
 -----------------------------------------------------------------------------
 */
+# include <thread>
+# include <functional>
 # include <cppad/core/ad_fun.hpp>
 # include <cppad/local/sparse/internal.hpp>
 
@@ -208,6 +234,9 @@ the return value is a sparsity pattern for J(x) ( J(x)^T ) where
 \f]
 Here F is the function corresponding to the operation sequence
 and x is any argument value.
+
+\param n_thread
+is the number of threads to use when internal_bool is true.
 */
 template <class Base, class RecBase>
 template <class SizeVector>
@@ -216,7 +245,8 @@ void ADFun<Base,RecBase>::for_jac_sparsity(
    bool                         transpose        ,
    bool                         dependency       ,
    bool                         internal_bool    ,
-   sparse_rc<SizeVector>&       pattern_out      )
+   sparse_rc<SizeVector>&       pattern_out      ,
+   size_t                       n_thread         )
 {
    // used to identify the RecBase type in calls to sweeps
    RecBase not_used_rec_base(0.0);
@@ -235,6 +265,10 @@ void ADFun<Base,RecBase>::for_jac_sparsity(
       "for_jac_sparsity: number rows in R "
       "is not equal number of independent variables."
    );
+   CPPAD_ASSERT_KNOWN(
+      n_thread > 0,
+      "for_jac_sparsity: n_thread is zero"
+   );
    bool zero_empty  = true;
    bool input_empty = true;
    if( internal_bool )
@@ -253,16 +287,85 @@ void ADFun<Base,RecBase>::for_jac_sparsity(
          pattern_in
       );
 
-      // compute sparsity for other variables
-      local::sweep::for_jac<addr_t>(
-         &play_,
-         dependency,
-         n,
-         num_var_tape_,
-         for_jac_sparse_pack_,
-         not_used_rec_base
-
-      );
+      // n_thread
+      // each block of columns has at least one Pack value
+      size_t n_bit  = std::numeric_limits<size_t>::digits;
+      size_t n_pack = 0;
+      if( ell > 0 )
+         n_pack = 1 + (ell - 1) / n_bit;
+      n_thread = std::min(n_thread, n_pack);
+      if( play_.num_var_vecad_rec() > 0 )
+         n_thread = 1;
+      if( n_thread > 1 )
+      {  // atomic functions may not be thread safe
+         for(size_t i_op = 0; i_op < play_.num_op_rec(); ++i_op)
+            if( play_.GetOp(i_op) == local::AFunOp )
+               n_thread = 1;
+      }
+      if( n_thread > 1 )
+      {  // block
+         // pattern for the columns of R in each block, allocated by this
+         // thread because the other threads cannot use thread_alloc
+         std::vector<local::sparse::pack_setvec> block(n_thread);
+         std::vector<size_t> pack_begin(n_thread + 1);
+         for(size_t b = 0; b <= n_thread; ++b)
+            pack_begin[b] = (b * n_pack) / n_thread;
+         for(size_t b = 0; b < n_thread; ++b)
+         {  size_t col_begin = pack_begin[b] * n_bit;
+            size_t col_end   = std::min(ell, pack_begin[b+1] * n_bit);
+            size_t n_copy    = pack_begin[b+1] - pack_begin[b];
+            block[b].resize(num_var_tape_, col_end - col_begin);
+            block[b].assign_pack_block(
+               0, for_jac_sparse_pack_, pack_begin[b], n_copy
+            );
+         }
+         //
+         // team: threads other than the current thread
+         std::vector<std::thread> team;
+         for(size_t b = 1; b < n_thread; ++b) team.push_back(
+            std::thread(
+               local::sweep::for_jac<
+                  addr_t, Base, local::sparse::pack_setvec, RecBase
+               >,
+               &play_,
+               dependency,
+               n,
+               num_var_tape_,
+               std::ref( block[b] ),
+               std::cref( not_used_rec_base )
+            )
+         );
+         // current thread computes block zero
+         local::sweep::for_jac<addr_t>(
+            &play_,
+            dependency,
+            n,
+            num_var_tape_,
+            block[0],
+            not_used_rec_base
+         );
+         for(size_t b = 1; b < n_thread; ++b)
+            team[b - 1].join();
+         //
+         // combine the blocks
+         for(size_t b = 0; b < n_thread; ++b)
+         {  size_t n_copy = pack_begin[b+1] - pack_begin[b];
+            for_jac_sparse_pack_.assign_pack_block(
+               pack_begin[b], block[b], 0, n_copy
+            );
+         }
+      }
+      else
+      {  // compute sparsity for other variables
+         local::sweep::for_jac<addr_t>(
+            &play_,
+            dependency,
+            n,
+            num_var_tape_,
+            for_jac_sparse_pack_,
+            not_used_rec_base
+         );
+      }
       // set the output pattern
       local::sparse::get_internal_pattern(
          transpose, dep_taddr_, for_jac_sparse_pack_, pattern_out
@@ -484,7 +484,7 @@ void ADFun<Base,RecBase>::ForSparseJacCase(
       // extract results from for_jac_sparse_set_
       // and add corresponding elements to sets in s
       CPPAD_ASSERT_UNKNOWN( for_jac_sparse_set_.end() == q );
-      local::sparse::list_setvec::const_iterator
+      local::sparse::hybrid_setvec::const_iterator
          itr_2(for_jac_sparse_set_, dep_taddr_[i] );
       size_t j = *itr_2;
       while( j < q )
@@ -744,7 +744,7 @@ void ADFun<Base,RecBase>::ForSparseJacCheckpoint(
 
       // extract the result from for_jac_sparse_set_
       CPPAD_ASSERT_UNKNOWN( for_jac_sparse_set_.end() == q );
-      local::sparse::list_setvec::const_iterator
+      local::sparse::hybrid_setvec::const_iterator
          itr(for_jac_sparse_set_, dep_taddr_[i] );
       size_t j = *itr;
       while( j < q )
@@ -171,7 +171,9 @@ BaseVector ADFun<Base,RecBase>::Forward(
    {  CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
 
       // ind_taddr_[j] is operator taddr for j-th independent variable
-      CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+      CPPAD_ASSERT_UNKNOWN(
+         play_.compact_tape() || play_.GetOp( ind_taddr_[j] ) == local::InvOp
+      );
 
       if( p == q )
          taylor_[ C * ind_taddr_[j] + q] = xq[j];
@@ -185,7 +187,10 @@ BaseVector ADFun<Base,RecBase>::Forward(
    CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
    CPPAD_ASSERT_UNKNOWN( load_op2var_.size()  == play_.num_var_load_rec() );
    if( q == 0 )
-   {
+   {  // no work if the zero order forward plan is already built
+      local::sweep::setup_forward0_plan(&play_);
+      local::sweep::setup_atom_batch(&play_, not_used_rec_base);
+      //
       local::sweep::forward0(&play_, s, true,
          n, num_var_tape_, C,
          taylor_.data(), cskip_op_.data(), load_op2var_,
@@ -0,0 +1,175 @@
+# ifndef CPPAD_CORE_FORWARD_FORWARD_BATCH_HPP
+# define CPPAD_CORE_FORWARD_FORWARD_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin forward_batch}
+
+Zero Order Forward Mode at Multiple Points
+##########################################
+
+Syntax
+******
+| *f* . ``forward_batch`` ( *n_point* , *x* , *y* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+:ref:`glossary@AD Function` corresponding to *f* .
+This routine evaluates :math:`F(x)` at *n_point* independent points
+using one pass through the operation sequence.
+Each operator is decoded once and then applied to a contiguous
+array of values, one for each point.
+This amortizes the cost of decoding the operation sequence and
+enables the compiler to vectorize the calculations for each operator.
+The points are processed in blocks so that the values for all the
+variables, at the points in a block, stay in the processor cache.
+
+f
+*
+The Taylor coefficients stored in *f* are not affected by this operation;
+e.g., :ref:`size_order-name` is the same before and after this call.
+It must not be empty; e.g., the result of the
+:ref:`fun_construct@Default Constructor` .
+
+n_point
+*******
+is the number of points at which to evaluate the function.
+It must be greater than zero.
+
+x
+*
+The size of *x* must be *n* * *n_point* .
+For *j* = 0 , ... , *n* ``-1`` and *k* = 0 , ... , *n_point* ``-1``
+*x* [ *j* * *n_point* + *k* ]
+is the value of the *j*-th independent variable at the *k*-th point.
+
+y
+*
+The input size and value of *y* do not matter.
+Upon return, it has size *m* * *n_point* and
+for *i* = 0 , ... , *m* ``-1`` and *k* = 0 , ... , *n_point* ``-1``
+*y* [ *i* * *n_point* + *k* ]
+is the value of the *i*-th dependent variable at the *k*-th point.
+
+BaseVector
+**********
+The type *BaseVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+Restrictions
+************
+This is not the same as calling :ref:`forward_zero-name`
+once for each point:
+
+#. :ref:`PrintFor-name` operations do not generate output.
+#. Comparison operators are not checked; i.e., there is no
+   :ref:`compare_change-name` information for this operation.
+#. All the operators are evaluated for every point; i.e.,
+   conditional expression skipping (see :ref:`number_skip-name` )
+   is not used.
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/forward_batch.cpp
+}
+The file :ref:`forward_batch.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end forward_batch}
+*/
+/*!
+\file forward_batch.hpp
+Zero order forward mode at multiple points.
+*/
+/// Target number of bytes used for the values of all the variables
+/// at the points that are evaluated during one sweep.
+# define CPPAD_FORWARD_BATCH_CACHE (1 << 20)
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+void ADFun<Base,RecBase>::forward_batch(
+   size_t            n_point ,
+   const BaseVector& x       ,
+   BaseVector&       y       )
+// END_PROTOTYPE
+{  // used to identify the RecBase type in calls to sweeps
+   RecBase not_used_rec_base(0.0);
+   //
+   // number of independent and dependent variables
+   size_t n = ind_taddr_.size();
+   size_t m = dep_taddr_.size();
+   //
+   // check BaseVector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   //
+   CPPAD_ASSERT_KNOWN(
+      n_point > 0,
+      "forward_batch(n_point, x, y): n_point is zero"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( x.size() ) == n * n_point,
+      "forward_batch(n_point, x, y): x.size() is not equal n * n_point"
+   );
+   CPPAD_ASSERT_KNOWN(
+      num_var_tape_ > 0,
+      "forward_batch(n_point, x, y): f is empty; e.g., default constructor"
+   );
+   //
+   // n_block: number of points in each sweep. This keeps the values for
+   // all the variables, at the points in a block, near the cache size.
+   size_t n_byte  = num_var_tape_ * sizeof(Base);
+   size_t n_block = CPPAD_FORWARD_BATCH_CACHE / n_byte;
+   n_block        = std::max<size_t>(n_block, 4);
+   n_block        = std::min<size_t>(n_block, 64);
+   n_block        = std::min<size_t>(n_block, n_point);
+   //
+   // batch: values for all the variables at the points in a block
+   local::pod_vector_maybe<Base> batch(num_var_tape_ * n_block);
+   //
+   y.resize(m * n_point);
+   for(size_t k_start = 0; k_start < n_point; k_start += n_block)
+   {  // number of points in this block
+      size_t n_lane = std::min(n_block, n_point - k_start);
+      //
+      // set values for the independent variables
+      for(size_t j = 0; j < n; ++j)
+      {  CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+         CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+         for(size_t k = 0; k < n_lane; ++k)
+            batch[ ind_taddr_[j] * n_lane + k ] =
+               x[ j * n_point + k_start + k ];
+      }
+      //
+      // values for the other variables
+      local::sweep::forward0_batch(
+         &play_, n_lane, num_var_tape_, batch.data(), not_used_rec_base
+      );
+      //
+      // values for the dependent variables
+      for(size_t i = 0; i < m; ++i)
+      {  CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+         for(size_t k = 0; k < n_lane; ++k)
+            y[ i * n_point + k_start + k ] =
+               batch[ dep_taddr_[i] * n_lane + k ];
+      }
+   }
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -0,0 +1,202 @@
+# ifndef CPPAD_CORE_FORWARD_FORWARD_LEVEL_HPP
+# define CPPAD_CORE_FORWARD_FORWARD_LEVEL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin forward_level}
+
+Zero Order Forward Mode Using Multiple Threads
+##############################################
+
+Syntax
+******
+| *y0* = *f* . ``forward_level`` ( *n_thread* , *x0* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+:ref:`glossary@AD Function` corresponding to *f* .
+This routine computes :math:`y0 = F(x0)` using *n_thread* threads.
+It has the same effect as the call
+
+   *y0* = *f* . ``Forward`` (0, *x0* )
+
+and the values it computes are identical to the values computed by
+:ref:`forward_zero-name` .
+
+Levels
+******
+The level of an operation in the recording is one plus the maximum
+level of the operations that compute its arguments
+(the independent variables have level zero).
+The operations at the same level do not depend on each other.
+They are split into *n_thread* blocks and each block is evaluated by
+a different thread.
+The threads wait for each other at the end of each level.
+This gives a speed up for recordings that are wide and shallow; e.g.,
+a large number of independent residuals.
+A level that has less than ``CPPAD_FORWARD0_LEVEL_MIN`` operations
+for each thread uses fewer threads.
+The levels are computed once for each recording
+(the first time this routine is used).
+
+f
+*
+The object *f* is not ``const`` .
+After this call, :ref:`size_order-name` is equal to one and the
+:ref:`compare_change-name` information is the same as for
+:ref:`forward_zero-name` .
+
+n_thread
+********
+is the number of threads (including the current thread) that are used.
+
+See :ref:`multi_thread@Internal Threads` for how the threads are created
+and why :ref:`ta_parallel_setup-name` is not required.
+If *n_thread* is less than two, *Base* is not plain old data
+(for example, *f* was created by :ref:`base2ad-name` ),
+or the recording contains an atomic function call,
+a :ref:`VecAD-name` operation,
+a :ref:`discrete-name` function, a :ref:`PrintFor-name` operation,
+or conditional expression skipping (see :ref:`number_skip-name` ),
+only the current thread is used; i.e., ``Forward`` (0, *x0* ) is used.
+
+x0
+**
+The size of *x0* must be equal to *n* , the dimension of the
+:ref:`fun_property@Domain` space for *f* .
+It specifies the argument value at which :math:`F` is evaluated.
+
+y0
+**
+The size of *y0* is equal to *m* , the dimension of the
+:ref:`fun_property@Range` space for *f* ,
+and its value is :math:`F(x0)` .
+
+BaseVector
+**********
+The type *BaseVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+check_for_nan
+*************
+The :ref:`check_for_nan-name` test is not done when more than one
+thread is used.
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/forward_level.cpp
+}
+The file :ref:`forward_level.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end forward_level}
+*/
+/*!
+\file forward_level.hpp
+Zero order forward mode using multiple threads.
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+BaseVector ADFun<Base,RecBase>::forward_level(
+   size_t            n_thread ,
+   const BaseVector& x0       )
+// END_PROTOTYPE
+{  //
+   // number of independent and dependent variables
+   size_t n = ind_taddr_.size();
+   size_t m = dep_taddr_.size();
+   //
+   // check BaseVector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   //
+   CPPAD_ASSERT_KNOWN(
+      size_t( x0.size() ) == n,
+      "forward_level(n_thread, x0): x0.size() is not equal n"
+   );
+   //
+   // check using a const player so a shared plan is not copied
+   local::sweep::setup_forward0_plan(&play_);
+   const local::player<Base>& const_play( play_ );
+   bool use_level = n_thread > 1 && local::is_pod<Base>();
+   if( ! use_level || ! const_play.forward0_plan().usable() )
+      return Forward(0, x0);
+   //
+   // plan: with its level schedule built
+   local::sweep::setup_forward0_level(&play_);
+   const local::play::forward0_plan<Base>& plan(
+      const_play.forward0_plan()
+   );
+   //
+   // does taylor_ need more orders or fewer directions
+   if( (cap_order_taylor_ < 1) | (num_direction_taylor_ != 1) )
+   {  num_order_taylor_ = 0;
+      size_t c = std::max<size_t>(1, cap_order_taylor_);
+      size_t r = 1;
+      capacity_order(c, r);
+   }
+   CPPAD_ASSERT_UNKNOWN( cap_order_taylor_ > 0 );
+   CPPAD_ASSERT_UNKNOWN( num_direction_taylor_ == 1 );
+   //
+   // short hand notation for order capacity
+   size_t C = cap_order_taylor_;
+   //
+   // the plan sets all the other variables; see Forward(0, x0)
+   taylor_[0] = CppAD::numeric_limits<Base>::quiet_NaN();
+   //
+   // set Taylor coefficients for independent variables
+   for(size_t j = 0; j < n; ++j)
+   {  CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+      CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+      taylor_[ C * ind_taddr_[j] + 0 ] = x0[j];
+   }
+   //
+   // arg: first argument for the BeginOp
+   local::play::const_sequential_iterator itr = play_.begin();
+   local::OpCode   op;
+   const addr_t*   arg;
+   size_t          i_var;
+   itr.op_info(op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == local::BeginOp );
+   //
+   // evaluate the other variables
+   local::play::forward0_state<Base> state;
+   state.arg                     = arg;
+   state.num_par                 = play_.num_par_rec();
+   state.parameter               = play_.GetPar();
+   state.J                       = C;
+   state.taylor                  = taylor_.data();
+   state.compare_change_count    = compare_change_count_;
+   state.compare_change_number   = 0;
+   state.compare_change_op_index = 0;
+   local::sweep::forward0_level_run(plan, state, n_thread);
+   compare_change_number_   = state.compare_change_number;
+   compare_change_op_index_ = state.compare_change_op_index;
+   num_order_taylor_        = 1;
+   //
+   // values for the dependent variables
+   BaseVector y0(m);
+   for(size_t i = 0; i < m; ++i)
+   {  CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+      y0[i] = taylor_[ C * dep_taddr_[i] + 0 ];
+   }
+   return y0;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
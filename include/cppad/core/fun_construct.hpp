@@ -148,6 +148,21 @@ can be ``const`` .
 All of information (state) stored in *f* is copied to *g*
 and any information originally in *g* is lost.
 
+Operation Sequence
+==================
+The operation sequence is not copied; i.e., *f* and *g* share the
+same operation sequence and the cost of copying it is independent of
+its size. If one of the functions changes its operation sequence
+(e.g., using :ref:`optimize-name` or :ref:`compact_tape-name` ),
+or its dynamic parameters (using :ref:`new_dynamic-name` ),
+it makes its own copy of the information that changes
+and the other function is not affected.
+If the assignment is done in
+:ref:`parallel mode<ta_in_parallel-name>` ,
+the operation sequence is copied so that the memory for *g*
+belongs to the current thread and *f* can be deleted by another thread
+before *g* is deleted.
+
 Move Semantics
 ==============
 In the special case where *f* is a temporary object
@@ -255,13 +270,15 @@ compare_change_op_index_(0),
 num_order_taylor_(0),
 cap_order_taylor_(0),
 num_direction_taylor_(0),
-num_var_tape_(0)
+num_var_tape_(0),
+reverse_partial_zero_(true)
 { }
 //
 // move semantics version of constructor
 // (none of the defualt constructor values matter to the destructor)
 template <class Base, class RecBase>
-ADFun<Base,RecBase>::ADFun(ADFun&& f)
+ADFun<Base,RecBase>::ADFun(ADFun&& f) :
+reverse_partial_zero_(true)
 {  swap(f); }
 //
 // destructor
@@ -320,6 +337,10 @@ void ADFun<Base,RecBase>::operator=(const ADFun& f)
    taylor_                    = f.taylor_;
    subgraph_partial_          = f.subgraph_partial_;
    //
+   // reverse_partial_ is work space (not copied)
+   reverse_partial_.clear();
+   reverse_partial_zero_      = true;
+   //
    // player
    play_                      = f.play_;
    //
@@ -415,7 +436,8 @@ are stored in this ADFun object.
 */
 template <class Base, class RecBase>
 template <class ADVector>
-ADFun<Base,RecBase>::ADFun(const ADVector &x, const ADVector &y)
+ADFun<Base,RecBase>::ADFun(const ADVector &x, const ADVector &y) :
+reverse_partial_zero_(true)
 {
    // used to identify the RecBase type in calls to sweeps
    RecBase not_used_rec_base(0.0);
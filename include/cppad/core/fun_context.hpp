@@ -0,0 +1,557 @@
+# ifndef CPPAD_CORE_FUN_CONTEXT_HPP
+# define CPPAD_CORE_FUN_CONTEXT_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin fun_context}
+{xrst_spell
+   xq
+   yq
+}
+
+Evaluating One ADFun Object Using Separate Contexts
+###################################################
+
+Syntax
+******
+| ``fun_context`` < *Base* > *context*
+| *yq* = *f* . ``Forward`` ( *q* , *xq* , *context* )
+| *dw* = *f* . ``Reverse`` ( *q* , *w* , *context* )
+| *context* . ``clear`` ()
+| *c* = *context* . ``size_order`` ()
+| *context* . ``compare_change_count`` ( *count* )
+| *number* = *context* . ``compare_change_number`` ()
+| *op_index* = *context* . ``compare_change_op_index`` ()
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_FORWARD_PROTOTYPE
+   // END_FORWARD_PROTOTYPE
+}
+{xrst_literal
+   // BEGIN_REVERSE_PROTOTYPE
+   // END_REVERSE_PROTOTYPE
+}
+
+Purpose
+*******
+An :ref:`ADFun-name` object contains the operation sequence
+(which does not change during forward and reverse mode)
+and the results of the previous forward mode calculations.
+The *context* holds the results of the previous forward mode
+calculations separate from the function object.
+The *f* is ``const`` for these versions of ``Forward`` and ``Reverse``.
+Hence, several threads can use the same function object *f*
+at the same time, as long as each thread uses its own *context* .
+
+f
+*
+The object *f* has prototype
+
+   ``const ADFun`` < *Base* > *f*
+
+The Taylor coefficients stored in *f* are not affected by these operations;
+e.g., :ref:`size_order-name` is the same before and after these calls.
+
+context
+*******
+This object holds the Taylor coefficients and other values that change
+during the forward and reverse mode calculations.
+It does not have any information that depends on the operation sequence
+until it is used to call ``Forward`` for a function object *f* .
+After that, it should only be used with *f*
+(or another function with the same operation sequence),
+until the next time that ``clear`` is called.
+
+q
+*
+The meaning of *q* is the same as for
+:ref:`Forward(q, xq)<forward_order-name>` and
+:ref:`Reverse(q, w)<reverse_any-name>` .
+
+xq
+**
+The size and meaning of *xq* is the same as for
+:ref:`Forward(q, xq)<forward_order-name>`
+where the previous forward mode results are stored in *context*
+(instead of in *f* ).
+
+yq
+**
+The size and meaning of *yq* is the same as for
+:ref:`Forward(q, xq)<forward_order-name>` .
+Output corresponding to :ref:`PrintFor-name` operations is written to
+``std::cout`` .
+
+w
+*
+The size and meaning of *w* is the same as for
+:ref:`Reverse(q, w)<reverse_any-name>`
+where the previous forward mode results are stored in *context* .
+
+dw
+**
+The size and meaning of *dw* is the same as for
+:ref:`Reverse(q, w)<reverse_any-name>` .
+
+clear
+*****
+This frees all the memory corresponding to *context* and returns it to
+the state it had directly after its constructor.
+
+size_order
+**********
+The return value *c* has type ``size_t`` .
+It is the number of Taylor coefficient orders, per variable,
+currently stored in *context* ; see :ref:`size_order-name` .
+
+compare_change
+**************
+The functions ``compare_change_count`` ,
+``compare_change_number`` , and ``compare_change_op_index`` ,
+have the same meaning as for the corresponding
+:ref:`compare_change-name` functions with *f* replaced by *context* .
+As with *f* , the default value for *count* is one.
+
+Parallel Mode
+*************
+The memory used by *context* is allocated using :ref:`thread_alloc-name` .
+Hence, if more than one thread is using these routines at the same time,
+:ref:`thread_alloc::parallel_setup<ta_parallel_setup-name>` must be used
+to inform CppAD of the current thread number.
+In addition, :ref:`parallel_ad-name` must be called before
+using *f* in parallel mode and
+the :ref:`atomic functions<atomic-name>` in *f* ,
+if any, must support being used in parallel.
+
+Restrictions
+************
+Only one direction is supported; i.e.,
+there is no version of :ref:`Forward(q, r, xq)<forward_dir-name>`
+that uses *context* .
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/fun_context.cpp
+}
+The file :ref:`fun_context.cpp-name`
+contains an example and test of these operations.
+
+{xrst_end fun_context}
+*/
+# include <cppad/local/pod_vector.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_context.hpp
+Results of forward and reverse mode that are stored separate from ADFun.
+*/
+
+/*!
+Class used to hold the values that change during forward and reverse mode,
+so that one ADFun object can be used by several threads at the same time.
+
+\tparam Base
+is the base type for the corresponding ADFun object.
+*/
+template <class Base>
+class fun_context {
+   // ADFun uses the private member variables
+   template <class Base2, class RecBase2> friend class ADFun;
+private:
+   /// number of variables in the recording this context was setup for
+   size_t num_var_tape_;
+
+   /// number of orders stored in taylor_
+   size_t num_order_taylor_;
+
+   /// maximum number of orders that will fit in taylor_
+   size_t cap_order_taylor_;
+
+   /// If zero, ignoring comparison operators. Otherwise is the
+   /// compare change count at which to store the operator index.
+   size_t compare_change_count_;
+
+   /// number of comparison operations that had a different result
+   /// during the previous zero order forward.
+   size_t compare_change_number_;
+
+   /// operator index for the comparison operator that corresponded to
+   /// the number changing from count-1 to count.
+   size_t compare_change_op_index_;
+
+   /// which operations can be conditionally skipped
+   local::pod_vector<bool> cskip_op_;
+
+   /// Variable on the tape corresponding to each vecad load operation
+   local::pod_vector<addr_t> load_op2var_;
+
+   /// results of the forward mode calculations
+   local::pod_vector_maybe<Base> taylor_;
+
+   /// partial derivatives used by reverse mode calculations.
+   /// Declared here to avoid reallocation for each call to Reverse.
+   local::pod_vector_maybe<Base> partial_;
+
+   /// are all the elements of partial_ zero
+   /// (false while a reverse sweep is using it)
+   bool partial_zero_;
+public:
+   /// default constructor
+   fun_context(void)
+   : num_var_tape_(0)
+   , num_order_taylor_(0)
+   , cap_order_taylor_(0)
+   , compare_change_count_(1)
+   , compare_change_number_(0)
+   , compare_change_op_index_(0)
+   , partial_zero_(true)
+   { }
+
+   /// free all the memory for this context
+   void clear(void)
+   {  num_var_tape_            = 0;
+      num_order_taylor_        = 0;
+      cap_order_taylor_        = 0;
+      compare_change_number_   = 0;
+      compare_change_op_index_ = 0;
+      cskip_op_.clear();
+      load_op2var_.clear();
+      taylor_.clear();
+      partial_.clear();
+      partial_zero_            = true;
+   }
+
+   /// number of Taylor coefficient orders stored in this context
+   size_t size_order(void) const
+   {  return num_order_taylor_; }
+
+   /// set the compare change count
+   void compare_change_count(size_t count)
+   {  compare_change_count_    = count;
+      compare_change_number_   = 0;
+      compare_change_op_index_ = 0;
+   }
+
+   /// number of comparison operators that changed
+   size_t compare_change_number(void) const
+   {  return compare_change_number_; }
+
+   /// operator index for the count-th comparison change
+   size_t compare_change_op_index(void) const
+   {  return compare_change_op_index_; }
+};
+
+/*!
+Setup a context for use with this function and make sure it has
+enough capacity for q + 1 Taylor coefficient orders.
+
+\param q
+is the highest order that will be computed.
+
+\param num_keep
+is the number of Taylor coefficient orders that must be preserved
+(if the capacity of the context is increased).
+
+\param context
+is the context that is being setup.
+*/
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::setup_context(
+   size_t              q        ,
+   size_t              num_keep ,
+   fun_context<Base>&  context  ) const
+{  //
+   // context is setup for a different recording
+   if(   context.num_var_tape_       != num_var_tape_               ||
+         context.cskip_op_.size()    != play_.num_op_rec()          ||
+         context.load_op2var_.size() != play_.num_var_load_rec()    )
+   {  CPPAD_ASSERT_KNOWN( num_keep == 0,
+         "f.Forward(q, xq, context): context has not been used with f"
+         "\nand xq.size() != n*(q+1)."
+      );
+      context.num_var_tape_     = num_var_tape_;
+      context.num_order_taylor_ = 0;
+      context.cap_order_taylor_ = 0;
+      context.taylor_.clear();
+      context.cskip_op_.resize( play_.num_op_rec() );
+      context.load_op2var_.resize( play_.num_var_load_rec() );
+      for(size_t i = 0; i < context.cskip_op_.size(); ++i)
+         context.cskip_op_[i] = false;
+      for(size_t i = 0; i < context.load_op2var_.size(); ++i)
+         context.load_op2var_[i] = 0;
+   }
+   if( context.cap_order_taylor_ > q )
+      return;
+   //
+   // new_taylor
+   size_t C = context.cap_order_taylor_;
+   size_t c = q + 1;
+   local::pod_vector_maybe<Base> new_taylor( num_var_tape_ * c );
+   //
+   // copy the orders that are kept
+   CPPAD_ASSERT_UNKNOWN( num_keep <= context.num_order_taylor_ );
+   for(size_t i = 0; i < num_var_tape_; ++i)
+   {  for(size_t k = 0; k < num_keep; ++k)
+         new_taylor[c * i + k] = context.taylor_[C * i + k];
+   }
+   //
+   context.taylor_.swap(new_taylor);
+   context.cap_order_taylor_ = c;
+   context.num_order_taylor_ = num_keep;
+}
+
+/*!
+Forward mode using a context for the Taylor coefficients.
+
+\param q
+is the highest order for this forward mode computation.
+
+\param xq
+contains Taylor coefficients for the independent variables;
+see devel_forward_order.
+
+\param context
+contains the Taylor coefficients up to order p-1
+(where p is q if xq.size() == n and zero otherwise).
+Upon return it contains the coefficients up to order q.
+
+\return
+contains Taylor coefficients for the dependent variables;
+see devel_forward_order.
+*/
+// BEGIN_FORWARD_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+BaseVector ADFun<Base,RecBase>::Forward(
+   size_t              q       ,
+   const BaseVector&   xq      ,
+   fun_context<Base>&  context ) const
+// END_FORWARD_PROTOTYPE
+{  // used to identify the RecBase type in calls to sweeps
+   RecBase not_used_rec_base(0.0);
+   //
+   // n, m
+   size_t n = ind_taddr_.size();
+   size_t m = dep_taddr_.size();
+   //
+   // check Vector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   //
+   // check size of xq
+   CPPAD_ASSERT_KNOWN(
+      size_t(xq.size()) == n || size_t(xq.size()) == n*(q+1),
+      "Forward(q, xq, context): xq.size() is not equal n or n*(q+1)"
+   );
+   //
+   // p = lowest order we are computing
+   size_t p = q + 1 - size_t(xq.size()) / n;
+   CPPAD_ASSERT_UNKNOWN( p == 0 || p == q );
+   //
+   // check one order case
+   CPPAD_ASSERT_KNOWN(
+      q <= context.num_order_taylor_ || p == 0,
+      "Forward(q, xq, context): Number of Taylor coefficient orders stored"
+      " in context\nis less than q and xq.size() != n*(q+1)."
+   );
+   //
+   // context
+   setup_context(q, p, context);
+   CPPAD_ASSERT_UNKNOWN( context.cap_order_taylor_ > q );
+   //
+   // C, taylor
+   size_t C     = context.cap_order_taylor_;
+   Base*  taylor = context.taylor_.data();
+   //
+   // initialize the orders that are computed; see Forward(q, xq)
+   for(size_t j = 0; j < num_var_tape_; ++j)
+   {  for(size_t k = p; k <= q; ++k)
+         taylor[C * j + k] = CppAD::numeric_limits<Base>::quiet_NaN();
+   }
+   //
+   // set Taylor coefficients for independent variables
+   for(size_t j = 0; j < n; ++j)
+   {  CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+      CPPAD_ASSERT_UNKNOWN(
+         play_.compact_tape() || play_.GetOp( ind_taddr_[j] ) == local::InvOp
+      );
+      if( p == q )
+         taylor[ C * ind_taddr_[j] + q] = xq[j];
+      else
+      {  for(size_t k = 0; k <= q; ++k)
+            taylor[ C * ind_taddr_[j] + k] = xq[ (q+1)*j + k];
+      }
+   }
+   //
+   // evaluate the derivatives
+   // (the zero order forward plan is used if f has already built it)
+   if( q == 0 )
+   {  local::sweep::forward0(&play_, std::cout, true,
+         n, num_var_tape_, C,
+         taylor, context.cskip_op_.data(), context.load_op2var_,
+         context.compare_change_count_,
+         context.compare_change_number_,
+         context.compare_change_op_index_,
+         not_used_rec_base
+      );
+   }
+   else
+   {  local::sweep::forward1(&play_, std::cout, true, p, q,
+         n, num_var_tape_, C,
+         taylor, context.cskip_op_.data(), context.load_op2var_,
+         context.compare_change_count_,
+         context.compare_change_number_,
+         context.compare_change_op_index_,
+         not_used_rec_base
+      );
+   }
+   //
+   // yq
+   BaseVector yq;
+   if( p == q )
+   {  yq.resize(m);
+      for(size_t i = 0; i < m; ++i)
+         yq[i] = taylor[ C * dep_taddr_[i] + q];
+   }
+   else
+   {  yq.resize(m * (q+1) );
+      for(size_t i = 0; i < m; ++i)
+      {  for(size_t k = 0; k <= q; ++k)
+            yq[ (q+1) * i + k] = taylor[ C * dep_taddr_[i] + k ];
+      }
+   }
+   CPPAD_ASSERT_KNOWN( ! ( hasnan(yq) && check_for_nan_ ) ,
+      "yq = f.Forward(q, xq, context): has a nan."
+   );
+   //
+   // now we have q + 1  taylor coefficient orders per variable
+   context.num_order_taylor_ = q + 1;
+   //
+   return yq;
+}
+
+/*!
+Reverse mode using a context for the Taylor coefficients.
+
+\param q
+is the number of Taylor coefficients that are being
+differentiated (per variable).
+
+\param w
+is the weighting for each of the Taylor coefficients corresponding
+to dependent variables; see Reverse(q, w).
+
+\param context
+contains the Taylor coefficients computed by previous calls to
+f.Forward(q, xq, context).
+
+\return
+is the derivative of the weighted Taylor coefficients; see Reverse(q, w).
+*/
+// BEGIN_REVERSE_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+BaseVector ADFun<Base,RecBase>::Reverse(
+   size_t              q       ,
+   const BaseVector&   w       ,
+   fun_context<Base>&  context ) const
+// END_REVERSE_PROTOTYPE
+{  // n, m
+   size_t n = ind_taddr_.size();
+   size_t m = dep_taddr_.size();
+   //
+   // check BaseVector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   //
+   CPPAD_ASSERT_KNOWN(
+      size_t(w.size()) == m || size_t(w.size()) == (m * q),
+      "Reverse(q, w, context): w.size() is not equal m or m*q."
+   );
+   CPPAD_ASSERT_KNOWN(
+      q > 0,
+      "Reverse(q, w, context): q is zero."
+   );
+   CPPAD_ASSERT_KNOWN(
+      context.num_var_tape_ == num_var_tape_ &&
+      context.num_order_taylor_ >= q,
+      "Reverse(q, w, context): Less than q Taylor coefficients are"
+      " currently stored in context."
+   );
+   //
+   // partial
+   // Memory is only allocated when the size changes. The partials are
+   // zero, except while a sweep is using them, so they only need to be
+   // zeroed here when the size changes or a previous sweep did not complete.
+   local::pod_vector_maybe<Base>& partial( context.partial_ );
+   size_t n_partial = num_var_tape_ * q;
+   if( partial.size() != n_partial || ! context.partial_zero_ )
+   {  partial.resize(n_partial);
+      for(size_t i = 0; i < n_partial; ++i)
+         partial[i] = Base(0);
+   }
+   context.partial_zero_ = false;
+   //
+   // set the dependent variable direction
+   // (use += because two dependent variables can point to same location)
+   for(size_t i = 0; i < m; ++i)
+   {  CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+      if( size_t(w.size()) == m )
+         partial[dep_taddr_[i] * q + q - 1] += w[i];
+      else
+      {  for(size_t k = 0; k < q; ++k)
+            partial[ dep_taddr_[i] * q + k ] += w[i * q + k ];
+      }
+   }
+   //
+   // evaluate the derivatives
+   // (the subgraph for the dependent variables is used if f.Reverse has
+   // already determined it)
+   reverse_sweep(
+      q, context.cap_order_taylor_, context.taylor_.data(), partial.data(),
+      context.cskip_op_.data(), context.load_op2var_
+   );
+   //
+   // dw: by the Reverse Identity Theorem; see Reverse(q, w)
+   BaseVector dw(n * q);
+   for(size_t j = 0; j < n; ++j)
+   {  CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+      if( size_t(w.size()) == m )
+      {  for(size_t k = 0; k < q; ++k)
+            dw[j * q + k ] = partial[ind_taddr_[j] * q + q - 1 - k];
+      }
+      else
+      {  for(size_t k = 0; k < q; ++k)
+            dw[j * q + k ] = partial[ind_taddr_[j] * q + k];
+      }
+   }
+   //
+   // zero the partials written by the sweep
+   reverse_clear(q, partial.data());
+   context.partial_zero_ = true;
+   //
+# ifndef NDEBUG
+   if( check_for_nan_ && hasnan(dw) )
+   {  // a nan in a Taylor coefficient that was used can result in a nan
+      // in dw (variable index zero does not correspond to a real variable)
+      size_t C        = context.cap_order_taylor_;
+      bool taylor_nan = false;
+      for(size_t i_var = 1; i_var < num_var_tape_; ++i_var)
+      {  for(size_t k = 0; k < q; ++k)
+            taylor_nan |= CppAD::isnan( context.taylor_[i_var * C + k] );
+      }
+      CPPAD_ASSERT_KNOWN( taylor_nan,
+         "dw = f.Reverse(q, w, context): has a nan,\n"
+         "but none of its Taylor coefficients are nan."
+      );
+   }
+# endif
+   //
+   return dw;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
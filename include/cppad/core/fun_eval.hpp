@@ -7,7 +7,12 @@
 
 # include <cppad/core/new_dynamic.hpp>
 # include <cppad/core/forward/forward.hpp>
+# include <cppad/core/forward/forward_batch.hpp>
+# include <cppad/core/forward/forward_level.hpp>
 # include <cppad/core/reverse.hpp>
+# include <cppad/core/checkpoint_reverse.hpp>
+# include <cppad/core/fun_context.hpp>
+# include <cppad/core/fun_partition.hpp>
 # include <cppad/core/sparse.hpp>
 
 # endif
@@ -0,0 +1,669 @@
+# ifndef CPPAD_CORE_FUN_PARTITION_HPP
+# define CPPAD_CORE_FUN_PARTITION_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin fun_partition}
+{xrst_spell
+   xq
+   yq
+}
+
+Partition an ADFun Object by Dependent Variable
+###############################################
+
+Syntax
+******
+| *part* = *f* . ``partition`` ( *n_part* )
+| *part* = *f* . ``partition`` ( *n_part* , *options* )
+| *n_part* = *part* . ``size`` ()
+| *g* = *part* . ``fun`` ( *k* )
+| *index* = *part* . ``dep_index`` ( *k* )
+| *part* . ``new_dynamic`` ( *dynamic* )
+| *yq* = *part* . ``Forward`` ( *q* , *xq* , *n_thread* )
+| *dw* = *part* . ``Reverse`` ( *q* , *w* , *n_thread* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PARTITION_PROTOTYPE
+   // END_PARTITION_PROTOTYPE
+}
+{xrst_literal
+   // BEGIN_FORWARD_PROTOTYPE
+   // END_FORWARD_PROTOTYPE
+}
+{xrst_literal
+   // BEGIN_REVERSE_PROTOTYPE
+   // END_REVERSE_PROTOTYPE
+}
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+:ref:`glossary@AD Function` corresponding to *f* .
+The dependent variables are split into *n_part* sets and for each set
+an ``ADFun`` object is created that only computes the dependent variables
+in the set.
+Each of these functions only contains the operations
+that its dependent variables depend on;
+i.e., it is a compacted version of the recording for *f* .
+The functions do not share any information that changes during
+forward and reverse mode, so they can be evaluated
+and differentiated at the same time using different threads.
+This gives data parallel evaluation of a separable function;
+e.g., a sum of terms where each term only depends on some of the
+independent variables.
+
+f
+*
+The object *f* is not ``const`` because the
+:ref:`subgraph_reverse-name` information for *f* is used
+to determine the size of the recording for each dependent variable.
+The previous forward mode results stored in *f* are not changed.
+
+n_part
+******
+is the number of partitions.
+It must be greater than zero and less than or equal *m* .
+
+options
+*******
+These are the :ref:`optimize@options` used to optimize the
+recording for each partition.
+
+part
+****
+The return value *part* has prototype
+
+   ``fun_partition`` < *Base* , *RecBase* > *part*
+
+The number of operations needed to compute each dependent variable
+is used to split the dependent variables into *n_part*
+contiguous sets with about the same number of operations in each set.
+
+fun
+***
+The return value *g* has prototype
+
+   ``const ADFun`` < *Base* , *RecBase* >& *g*
+
+It is the function corresponding to the *k*-th partition.
+It has the same independent variables and
+:ref:`independent dynamic parameters<new_dynamic@dynamic>` as *f* .
+
+dep_index
+*********
+The return value *index* has prototype
+
+   ``const CppAD::vector<size_t>&`` *index*
+
+For each *i* less than *index* . ``size`` () ,
+the *i*-th dependent variable for *g* is the
+dependent variable with index *index* [ *i* ] for *f* .
+
+new_dynamic
+***********
+This sets the value of the independent dynamic parameters
+for all the partitions; see :ref:`new_dynamic-name` .
+
+Forward
+*******
+This has the same effect as
+:ref:`Forward(q, xq)<forward_order-name>` for *f* ,
+except that the Taylor coefficients are stored in the partitions
+(not in *f* ).
+The *i*-th dependent variable results for *g* are placed in *yq*
+using the index *index* [ *i* ] .
+
+Reverse
+*******
+This has the same effect as
+:ref:`Reverse(q, w)<reverse_any-name>` for *f* ,
+except that the Taylor coefficients used are the ones stored in the
+partitions by the previous calls to ``Forward`` .
+The result *dw* is the sum of the results for the partitions
+(summed in the order of the partitions).
+
+n_thread
+********
+is the number of threads (including the current thread) that are used
+for forward or reverse mode.
+Each thread evaluates a subset of the partitions.
+
+See :ref:`multi_thread@Internal Threads` for how the threads are created
+and why :ref:`ta_parallel_setup-name` is not required.
+Only one thread is used if *Base* is not a plain old data type,
+or the recording for *f* contains an atomic function call,
+a :ref:`discrete-name` function, or a :ref:`VecAD-name` operation.
+
+BaseVector
+**********
+The type *BaseVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/fun_partition.cpp
+}
+The file :ref:`fun_partition.cpp-name`
+contains an example and test of these operations.
+
+{xrst_end fun_partition}
+*/
+# include <thread>
+# include <vector>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_partition.hpp
+Split an ADFun object into functions for subsets of the dependent variables.
+*/
+
+/*!
+Class used to hold the functions corresponding to a partition of the
+dependent variables for an ADFun object.
+
+\tparam Base
+is the base type for the corresponding ADFun object.
+
+\tparam RecBase
+is the base type used when recording the corresponding ADFun object.
+*/
+template <class Base, class RecBase>
+class fun_partition {
+   // ADFun::partition creates the partition
+   template <class Base2, class RecBase2> friend class ADFun;
+private:
+   /// number of independent variables for the original function
+   size_t n_ind_;
+
+   /// number of dependent variables for the original function
+   size_t n_dep_;
+
+   /// can more than one thread be used for these functions
+   bool parallel_ok_;
+
+   /// function corresponding to each partition
+   std::vector< ADFun<Base, RecBase> > fun_;
+
+   /// original dependent variable index for each partition
+   std::vector< vector<size_t> > dep_index_;
+
+   // ------------------------------------------------------------------------
+   /*!
+   Forward mode for a subset of the partitions.
+
+   \param thread
+   is the index of this thread. It evaluates the partitions with index
+   k such that k % n_thread == thread.
+
+   \param n_thread
+   is the number of threads.
+
+   \param q
+   is the highest order for the forward mode computation.
+
+   \param xq
+   is the Taylor coefficients for the independent variables.
+
+   \param yq
+   yq[k] is set to the Taylor coefficients for the dependent variables
+   in the k-th partition.
+   */
+   void forward_thread(
+      size_t                               thread   ,
+      size_t                               n_thread ,
+      size_t                               q        ,
+      const std::vector<Base>&             xq       ,
+      std::vector< std::vector<Base> >*    yq       )
+   {  for(size_t k = thread; k < fun_.size(); k += n_thread)
+         (*yq)[k] = fun_[k].Forward(q, xq);
+   }
+   // ------------------------------------------------------------------------
+   /*!
+   Reverse mode for a subset of the partitions.
+
+   \param thread
+   is the index of this thread. It evaluates the partitions with index
+   k such that k % n_thread == thread.
+
+   \param n_thread
+   is the number of threads.
+
+   \param q
+   is the number of Taylor coefficient orders being differentiated.
+
+   \param w
+   w[k] is the weighting vector for the k-th partition.
+
+   \param dw
+   dw[k] is set to the derivative for the k-th partition.
+   */
+   void reverse_thread(
+      size_t                                  thread   ,
+      size_t                                  n_thread ,
+      size_t                                  q        ,
+      const std::vector< std::vector<Base> >& w        ,
+      std::vector< std::vector<Base> >*       dw       )
+   {  for(size_t k = thread; k < fun_.size(); k += n_thread)
+         (*dw)[k] = fun_[k].Reverse(q, w[k]);
+   }
+public:
+   /// default constructor (no partitions)
+   fun_partition(void)
+   : n_ind_(0), n_dep_(0), parallel_ok_(false)
+   { }
+
+   /// number of partitions
+   size_t size(void) const
+   {  return fun_.size(); }
+
+   /// function corresponding to the k-th partition
+   const ADFun<Base, RecBase>& fun(size_t k) const
+   {  CPPAD_ASSERT_KNOWN( k < fun_.size(),
+         "part.fun(k): k is greater than or equal part.size()"
+      );
+      return fun_[k];
+   }
+
+   /// original dependent variable index for the k-th partition
+   const vector<size_t>& dep_index(size_t k) const
+   {  CPPAD_ASSERT_KNOWN( k < dep_index_.size(),
+         "part.dep_index(k): k is greater than or equal part.size()"
+      );
+      return dep_index_[k];
+   }
+
+   /// set the independent dynamic parameters for all the partitions
+   template <class BaseVector>
+   void new_dynamic(const BaseVector& dynamic)
+   {  for(size_t k = 0; k < fun_.size(); ++k)
+         fun_[k].new_dynamic(dynamic);
+   }
+
+   // forward mode for all the partitions (doxygen below)
+   template <class BaseVector>
+   BaseVector Forward(size_t q, const BaseVector& xq, size_t n_thread);
+
+   // reverse mode for all the partitions (doxygen below)
+   template <class BaseVector>
+   BaseVector Reverse(size_t q, const BaseVector& w, size_t n_thread);
+};
+
+/*!
+Number of operators in the subgraph for each dependent variable.
+
+\tparam Addr
+type used for indices in the random iterator for the recording.
+
+\param weight
+the input size and contents do not matter.
+Upon return it has size equal to the number of dependent variables
+and weight[i] is one plus the number of operators that the
+i-th dependent variable depends on.
+*/
+template <class Base, class RecBase>
+template <class Addr>
+void ADFun<Base,RecBase>::partition_weight(local::pod_vector<size_t>& weight)
+{  using local::pod_vector;
+   //
+   size_t n = ind_taddr_.size();
+   size_t m = dep_taddr_.size();
+   //
+   // subgraph_info_: select all the independent variables
+   vector<bool> select_domain(n);
+   for(size_t j = 0; j < n; ++j)
+      select_domain[j] = true;
+   subgraph_reverse(select_domain);
+   //
+   // random_itr
+   play_.template setup_random<Addr>();
+   typename local::play::const_random_iterator<Addr> random_itr =
+      play_.template get_random<Addr>();
+   //
+   // weight
+   weight.resize(m);
+   pod_vector<addr_t> subgraph;
+   for(size_t i = 0; i < m; ++i)
+   {  subgraph_info_.get_rev(random_itr, dep_taddr_, addr_t(i), subgraph);
+      weight[i] = subgraph.size() + 1;
+   }
+}
+
+/*!
+Split this function into functions for subsets of the dependent variables.
+
+\param n_part
+is the number of partitions.
+
+\param options
+are the options used to optimize the function for each partition.
+
+\return
+is the partition of this function.
+*/
+// BEGIN_PARTITION_PROTOTYPE
+template <class Base, class RecBase>
+fun_partition<Base, RecBase> ADFun<Base,RecBase>::partition(
+   size_t             n_part  ,
+   const std::string& options )
+// END_PARTITION_PROTOTYPE
+{  //
+   // n, m
+   size_t n = ind_taddr_.size();
+   size_t m = dep_taddr_.size();
+   CPPAD_ASSERT_KNOWN( 0 < n_part && n_part <= m,
+      "f.partition(n_part): n_part is zero or greater than f.Range()"
+   );
+   //
+   // weight
+   local::pod_vector<size_t> weight;
+   switch( play_.address_type() )
+   {
+      case local::play::unsigned_short_enum:
+      partition_weight<unsigned short>(weight);
+      break;
+
+      case local::play::unsigned_int_enum:
+      partition_weight<unsigned int>(weight);
+      break;
+
+      case local::play::size_t_enum:
+      partition_weight<size_t>(weight);
+      break;
+
+      default:
+      CPPAD_ASSERT_UNKNOWN(false);
+   }
+   size_t total = 0;
+   for(size_t i = 0; i < m; ++i)
+      total += weight[i];
+   //
+   // part
+   fun_partition<Base, RecBase> part;
+   part.n_ind_ = n;
+   part.n_dep_ = m;
+   part.fun_.resize(n_part);
+   part.dep_index_.resize(n_part);
+   //
+   // part.parallel_ok_
+   part.parallel_ok_ = local::is_pod<Base>();
+   for(size_t i_op = 0; i_op < play_.num_op_rec(); ++i_op)
+   {  local::OpCode op = play_.GetOp(i_op);
+      if( op == local::AFunOp || op == local::DisOp )
+         part.parallel_ok_ = false;
+   }
+   if( play_.num_var_vecad_ind_rec() > 0 )
+      part.parallel_ok_ = false;
+   //
+   // part.fun_, part.dep_index_
+   size_t i_dep = 0;
+   size_t sum   = 0;
+   for(size_t k = 0; k < n_part; ++k)
+   {  //
+      // index: at least one dependent for this and each later partition
+      vector<size_t>& index( part.dep_index_[k] );
+      size_t target = ( (k + 1) * total ) / n_part;
+      size_t i_max  = m - (n_part - k - 1);
+      do
+      {  index.push_back(i_dep);
+         sum += weight[i_dep];
+         ++i_dep;
+      }
+      while( i_dep < i_max && sum < target );
+      CPPAD_ASSERT_UNKNOWN( k + 1 < n_part || i_dep == m );
+      //
+      // g: only the dependent variables in this partition
+      ADFun<Base, RecBase>& g( part.fun_[k] );
+      g = *this;
+      size_t m_k = index.size();
+      g.dep_taddr_.resize(m_k);
+      g.dep_parameter_.resize(m_k);
+      for(size_t i = 0; i < m_k; ++i)
+      {  g.dep_taddr_[i]     = dep_taddr_[ index[i] ];
+         g.dep_parameter_[i] = dep_parameter_[ index[i] ];
+      }
+      //
+      // g: remove the operations that its dependents do not use
+      g.optimize(options);
+   }
+   return part;
+}
+
+/*!
+Forward mode for all the partitions.
+
+\param q
+is the highest order for this forward mode computation.
+
+\param xq
+contains Taylor coefficients for the independent variables;
+see devel_forward_order.
+
+\param n_thread
+is the number of threads used.
+
+\return
+contains Taylor coefficients for the dependent variables;
+see devel_forward_order.
+*/
+// BEGIN_FORWARD_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+BaseVector fun_partition<Base,RecBase>::Forward(
+   size_t              q         ,
+   const BaseVector&   xq        ,
+   size_t              n_thread  )
+// END_FORWARD_PROTOTYPE
+{  // used to identify the RecBase type in calls to sweeps
+   RecBase not_used_rec_base(0.0);
+   //
+   // n_part, n, m
+   size_t n_part = fun_.size();
+   size_t n      = n_ind_;
+   size_t m      = n_dep_;
+   //
+   // check BaseVector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   CheckSimpleVector<Base, std::vector<Base> >();
+   //
+   CPPAD_ASSERT_KNOWN( 0 < n_part,
+      "part.Forward(q, xq, n_thread): part.size() is zero"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t(xq.size()) == n || size_t(xq.size()) == n*(q+1),
+      "part.Forward(q, xq, n_thread): xq.size() is not equal n or n*(q+1)"
+   );
+   CPPAD_ASSERT_KNOWN( n_thread > 0,
+      "part.Forward(q, xq, n_thread): n_thread is zero"
+   );
+   //
+   // p = lowest order we are computing
+   size_t p = q + 1 - size_t(xq.size()) / n;
+   CPPAD_ASSERT_UNKNOWN( p == 0 || p == q );
+   //
+   // fun_: the memory used by Forward(q, xq) is allocated by this thread
+   for(size_t k = 0; k < n_part; ++k)
+   {  ADFun<Base, RecBase>& g( fun_[k] );
+      CPPAD_ASSERT_KNOWN(
+         q <= g.num_order_taylor_ || p == 0,
+         "part.Forward(q, xq, n_thread): Number of Taylor coefficient"
+         " orders stored\nis less than q and xq.size() != n*(q+1)."
+      );
+      if( (g.cap_order_taylor_ <= q) | (g.num_direction_taylor_ != 1) )
+      {  if( p == 0 )
+            g.num_order_taylor_ = 0;
+         else
+            g.num_order_taylor_ = q;
+         size_t c = std::max<size_t>(q + 1, g.cap_order_taylor_);
+         size_t r = 1;
+         g.capacity_order(c, r);
+      }
+      if( q == 0 )
+      {  local::sweep::setup_forward0_plan(&g.play_);
+         local::sweep::setup_atom_batch(&g.play_, not_used_rec_base);
+      }
+   }
+   //
+   // x, y
+   std::vector<Base> x( xq.size() );
+   for(size_t j = 0; j < x.size(); ++j)
+      x[j] = xq[j];
+   std::vector< std::vector<Base> > y(n_part);
+   //
+   // n_thread
+   if( ! parallel_ok_ )
+      n_thread = 1;
+   n_thread = std::min(n_thread, n_part);
+   //
+   // team: threads other than the current thread
+   std::vector<std::thread> team;
+   for(size_t thread = 1; thread < n_thread; ++thread) team.push_back(
+      std::thread(
+         &fun_partition::forward_thread,
+         this,
+         thread,
+         n_thread,
+         q,
+         std::cref(x),
+         &y
+      )
+   );
+   // current thread is thread zero
+   forward_thread(0, n_thread, q, x, &y);
+   for(size_t thread = 1; thread < n_thread; ++thread)
+      team[thread - 1].join();
+   //
+   // yq
+   size_t n_order = q + 1 - p;
+   BaseVector yq(m * n_order);
+   for(size_t k = 0; k < n_part; ++k)
+   {  const vector<size_t>& index( dep_index_[k] );
+      for(size_t i = 0; i < index.size(); ++i)
+      {  for(size_t ell = 0; ell < n_order; ++ell)
+            yq[ index[i] * n_order + ell ] = y[k][ i * n_order + ell ];
+      }
+   }
+   return yq;
+}
+
+/*!
+Reverse mode for all the partitions.
+
+\param q
+is the number of Taylor coefficient orders being differentiated.
+
+\param w
+is the weighting vector for the dependent variables;
+see reverse_any.
+
+\param n_thread
+is the number of threads used.
+
+\return
+is the derivative of the weighted sum; see reverse_any.
+*/
+// BEGIN_REVERSE_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+BaseVector fun_partition<Base,RecBase>::Reverse(
+   size_t              q         ,
+   const BaseVector&   w         ,
+   size_t              n_thread  )
+// END_REVERSE_PROTOTYPE
+{  //
+   // n_part, n, m
+   size_t n_part = fun_.size();
+   size_t n      = n_ind_;
+   size_t m      = n_dep_;
+   //
+   // check BaseVector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   CheckSimpleVector<Base, std::vector<Base> >();
+   //
+   CPPAD_ASSERT_KNOWN( 0 < n_part,
+      "part.Reverse(q, w, n_thread): part.size() is zero"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t(w.size()) == m || size_t(w.size()) == (m * q),
+      "part.Reverse(q, w, n_thread): w.size() is not equal m or m*q"
+   );
+   CPPAD_ASSERT_KNOWN( q > 0,
+      "part.Reverse(q, w, n_thread): q is zero"
+   );
+   CPPAD_ASSERT_KNOWN( n_thread > 0,
+      "part.Reverse(q, w, n_thread): n_thread is zero"
+   );
+   //
+   // n_order: number of orders in w for each dependent variable
+   size_t n_order = size_t(w.size()) / m;
+   //
+   // fun_: the memory used by Reverse(q, w) is allocated by this thread
+   for(size_t k = 0; k < n_part; ++k)
+   {  ADFun<Base, RecBase>& g( fun_[k] );
+      CPPAD_ASSERT_KNOWN(
+         g.num_order_taylor_ >= q,
+         "part.Reverse(q, w, n_thread): Less than q Taylor coefficients"
+         " are currently stored in the partitions."
+      );
+      if( (q == 1) & (g.num_direction_taylor_ > 1) )
+      {  g.num_order_taylor_ = 1;
+         size_t c = g.cap_order_taylor_;
+         size_t r = 1;
+         g.capacity_order(c, r);
+      }
+      g.reverse_setup(q);
+   }
+   //
+   // wk, dw
+   std::vector< std::vector<Base> > wk(n_part), dw(n_part);
+   for(size_t k = 0; k < n_part; ++k)
+   {  const vector<size_t>& index( dep_index_[k] );
+      wk[k].resize( index.size() * n_order );
+      for(size_t i = 0; i < index.size(); ++i)
+      {  for(size_t ell = 0; ell < n_order; ++ell)
+            wk[k][ i * n_order + ell ] = w[ index[i] * n_order + ell ];
+      }
+   }
+   //
+   // n_thread
+   if( ! parallel_ok_ )
+      n_thread = 1;
+   n_thread = std::min(n_thread, n_part);
+   //
+   // team: threads other than the current thread
+   std::vector<std::thread> team;
+   for(size_t thread = 1; thread < n_thread; ++thread) team.push_back(
+      std::thread(
+         &fun_partition::reverse_thread,
+         this,
+         thread,
+         n_thread,
+         q,
+         std::cref(wk),
+         &dw
+      )
+   );
+   // current thread is thread zero
+   reverse_thread(0, n_thread, q, wk, &dw);
+   for(size_t thread = 1; thread < n_thread; ++thread)
+      team[thread - 1].join();
+   //
+   // value: sum of the partition results in partition order
+   BaseVector value(n * q);
+   for(size_t j = 0; j < n * q; ++j)
+      value[j] = Base(0.0);
+   for(size_t k = 0; k < n_part; ++k)
+   {  for(size_t j = 0; j < n * q; ++j)
+         value[j] += dw[k][j];
+   }
+   return value;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -0,0 +1,231 @@
+# ifndef CPPAD_CORE_GRADIENT_HPP
+# define CPPAD_CORE_GRADIENT_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin gradient}
+{xrst_spell
+   dw
+}
+
+Function Value and Gradient of a Weighted Sum: Driver Routine
+##############################################################
+
+Syntax
+******
+*f* . ``gradient`` ( *x* , *w* , *y* , *dw* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+:ref:`glossary@AD Function` corresponding to *f* .
+The syntax above sets *y* to the value of :math:`F(x)` and *dw* to the
+derivative of :math:`W(x) = w^\R{T} F(x)` ; i.e.,
+
+.. math::
+
+   dw = w^\R{T} F^{(1)} (x)
+
+This is the same as
+
+| |tab| *y* = *f* . ``Forward`` (0, *x* )
+| |tab| *dw* = *f* . ``Reverse`` (1, *w* )
+
+but the zero order forward and first order reverse sweeps are done
+back to back and the partial derivatives are stored next to the
+function values for each variable.
+This avoids a separate work space for the partials
+and improves memory locality during the reverse sweep.
+
+f
+*
+Note that the :ref:`ADFun-name` object *f* is not ``const``
+(see :ref:`gradient@gradient Uses Forward` below).
+
+x
+*
+The size of *x* is *n* , the dimension of the
+:ref:`fun_property@Domain` space for *f* .
+It specifies the point at which to evaluate the function and derivative.
+
+w
+*
+The size of *w* is *m* , the dimension of the
+:ref:`fun_property@Range` space for *f* .
+It specifies the weighting for the components of :math:`F` .
+
+y
+*
+The input size and value of *y* do not matter.
+Upon return, its size is *m* and it is equal to :math:`F(x)` .
+
+dw
+**
+The input size and value of *dw* do not matter.
+Upon return, its size is *n* and
+for :math:`j = 0 , \ldots , n - 1`
+
+.. math::
+
+   dw[ j ] = \sum_{i=0}^{m-1} w_i \D{ F_i }{ x_j } ( x )
+
+BaseVector
+**********
+The type *BaseVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+gradient Uses Forward
+*********************
+After each call to :ref:`Forward-name` ,
+the object *f* contains the corresponding
+:ref:`Taylor coefficients<glossary@Taylor Coefficient>` .
+After a call to ``gradient`` ,
+the zero order Taylor coefficients correspond to
+*f* . ``Forward`` (0, *x* )
+and the other coefficients are unspecified.
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/gradient.cpp
+}
+The routine
+:ref:`gradient<gradient.cpp-name>` is both an example and test.
+It returns ``true`` , if it succeeds and ``false`` otherwise.
+
+{xrst_end gradient}
+-----------------------------------------------------------------------------
+*/
+
+//  BEGIN CppAD namespace
+namespace CppAD {
+
+// BEGIN_PROTOTYPE
+template <class Base, class RecBase>
+template <class BaseVector>
+void ADFun<Base,RecBase>::gradient(
+   const BaseVector& x  ,
+   const BaseVector& w  ,
+   BaseVector&       y  ,
+   BaseVector&       dw )
+// END_PROTOTYPE
+{  // used to identify the RecBase type in calls to sweeps
+   RecBase not_used_rec_base(0.0);
+   //
+   // n, m
+   size_t n = ind_taddr_.size();
+   size_t m = dep_taddr_.size();
+   //
+   // check BaseVector is Simple Vector class with Base type elements
+   CheckSimpleVector<Base, BaseVector>();
+   CPPAD_ASSERT_KNOWN(
+      size_t( x.size() ) == n,
+      "f.gradient(x, w, y, dw): x.size() is not equal to f.Domain()"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( w.size() ) == m,
+      "f.gradient(x, w, y, dw): w.size() is not equal to f.Range()"
+   );
+   //
+   // taylor_
+   // The zero order coefficients are the function values and the
+   // first order coefficients are used for the partial derivatives.
+   if( (cap_order_taylor_ < 2) | (num_direction_taylor_ != 1) )
+   {  // no need to copy old values during capacity_order
+      num_order_taylor_ = 0;
+      size_t c = 2;
+      size_t r = 1;
+      capacity_order(c, r);
+   }
+   size_t C = cap_order_taylor_;
+   //
+   // Set the values to nan (see Forward) and the partials to zero.
+   Base nan  = CppAD::numeric_limits<Base>::quiet_NaN();
+   Base zero = Base(0);
+   for(size_t i_var = 0; i_var < num_var_tape_; ++i_var)
+   {  taylor_[C * i_var + 0] = nan;
+      taylor_[C * i_var + 1] = zero;
+   }
+   //
+   // values for the independent variables
+   for(size_t j = 0; j < n; ++j)
+   {  CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+      CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+      taylor_[C * ind_taddr_[j] + 0] = x[j];
+   }
+   //
+   // zero order forward sweep
+   CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
+   CPPAD_ASSERT_UNKNOWN( load_op2var_.size()  == play_.num_var_load_rec() );
+   local::sweep::setup_forward0_plan(&play_);
+   local::sweep::setup_atom_batch(&play_, not_used_rec_base);
+   local::sweep::forward0(&play_, std::cout, true,
+      n, num_var_tape_, C,
+      taylor_.data(), cskip_op_.data(), load_op2var_,
+      compare_change_count_,
+      compare_change_number_,
+      compare_change_op_index_,
+      not_used_rec_base
+   );
+   num_order_taylor_ = 1;
+   //
+   // y
+   y.resize(m);
+   for(size_t i = 0; i < m; ++i)
+   {  CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+      y[i] = taylor_[C * dep_taddr_[i] + 0];
+   }
+   //
+   // Partial
+   // The partial for variable i_var is Partial[C * i_var].
+   // (use += because two dependent variables can point to same location)
+   Base* Partial = taylor_.data() + 1;
+   for(size_t i = 0; i < m; ++i)
+      Partial[C * dep_taddr_[i]] += w[i];
+   //
+   // first order reverse sweep
+   local::play::const_sequential_iterator play_itr = play_.end();
+   local::sweep::reverse(
+      0,
+      n,
+      num_var_tape_,
+      &play_,
+      C,
+      taylor_.data(),
+      C,
+      Partial,
+      cskip_op_.data(),
+      load_op2var_,
+      play_itr,
+      not_used_rec_base
+   );
+   //
+   // dw
+   dw.resize(n);
+   for(size_t j = 0; j < n; ++j)
+      dw[j] = Partial[C * ind_taddr_[j]];
+   //
+   CPPAD_ASSERT_KNOWN( ! ( hasnan(y) && check_for_nan_ ) ,
+      "f.gradient(x, w, y, dw): y has a nan."
+   );
+   CPPAD_ASSERT_KNOWN( ! ( hasnan(dw) && check_for_nan_ ) ,
+      "f.gradient(x, w, y, dw): dw has a nan,\n"
+      "but none of the values in y are nan."
+   );
+   return;
+}
+
+} // END CppAD namespace
+
+# endif
@@ -20,6 +20,7 @@ Syntax
 
 | |tab| ``ADFun`` < *Base* > *fun*
 | |tab| *fun* . ``from_json`` ( *json* )
+| |tab| *fun* . ``from_json`` ( *is* )
 
 Prototype
 *********
@@ -27,11 +28,22 @@ Prototype
    // BEGIN_PROTOTYPE
    // END_PROTOTYPE
 }
+{xrst_literal
+   // BEGIN_STREAM_PROTOTYPE
+   // END_STREAM_PROTOTYPE
+}
 
 json
 ****
 is a :ref:`json_ad_graph-name` .
 
+is
+**
+The :ref:`json_ad_graph-name` is read from this stream.
+Only a small part of the graph is in memory at any one time,
+so this requires much less memory than reading the graph into
+a string and then using *json* .
+
 Base
 ****
 is the type corresponding to this :ref:`adfun-name` object;
@@ -69,4 +81,21 @@ void CppAD::ADFun<Base,RecBase>::from_json(const std::string& json)
    return;
 }
 
+// BEGIN_STREAM_PROTOTYPE
+template <class Base, class RecBase>
+void CppAD::ADFun<Base,RecBase>::from_json(std::istream& is)
+// END_STREAM_PROTOTYPE
+{  //
+   // C++ graph object
+   cpp_graph graph_obj;
+   //
+   // convert json to graph representation
+   local::graph::json_parser(is, graph_obj);
+   //
+   // convert the graph representation to a function
+   from_graph(graph_obj);
+   //
+   return;
+}
+
 # endif
@@ -0,0 +1,127 @@
+# ifndef CPPAD_CORE_MUL_ADD_VEC_HPP
+# define CPPAD_CORE_MUL_ADD_VEC_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/mul_add_vec.hpp>
+/*
+{xrst_begin mul_add_vec}
+
+Record an Elementwise Multiply and Add in One Call
+##################################################
+
+Syntax
+******
+| ``mul_add_vec`` ( *a* , *x* , *b* , *y* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+For *i* = 0 , ... , *n* ``-1`` , this sets
+
+   *y* [ *i* ] = *a* [ *i* ] * *x* [ *i* ] + *b* [ *i* ]
+
+where *n* is the size of *x* .
+The result is the same as if each element of *y* was computed
+using the AD multiply and add operators.
+The difference is that, when the elements of *x* are
+:ref:`glossary@Variable` s ,
+the tape for the current thread is found once
+and the memory for the recording is reserved once
+(instead of once per operation).
+
+a
+*
+This vector has size *n* and contains the multipliers.
+These are constants; i.e., they are not variables or
+:ref:`glossary@Parameter@Dynamic` parameters.
+
+x
+*
+This vector has size *n* and contains the values that are multiplied.
+The elements of *x* may be variables, dynamic parameters,
+or constant parameters.
+
+b
+*
+This vector has size *n* and contains the constant values that are added.
+
+y
+*
+This vector has size *n* .
+The input value of its elements do not matter.
+Upon return, it contains the results.
+It may be the same vector as *x* .
+
+BaseVector
+**********
+The type *BaseVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+ADVector
+********
+The type *ADVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``AD`` < *Base* > .
+
+Operation Count
+***************
+If *a* [ *i* ] is one, or *b* [ *i* ] is zero,
+the corresponding operation is not recorded (the same as for
+the AD multiply and add operators).
+If *a* [ *i* ] is zero, *y* [ *i* ] is a constant parameter.
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/mul_add_vec.cpp
+}
+The file :ref:`mul_add_vec.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end mul_add_vec}
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE
+template <class BaseVector, class ADVector>
+void mul_add_vec(
+   const BaseVector& a ,
+   const ADVector&   x ,
+   const BaseVector& b ,
+   ADVector&         y )
+// END_PROTOTYPE
+{  typedef typename ADVector::value_type ADBase;
+   typedef typename ADBase::value_type   Base;
+   //
+   // check the vector types
+   CheckSimpleVector<Base, BaseVector>();
+   CheckSimpleVector<ADBase, ADVector>();
+   //
+   size_t n = x.size();
+   CPPAD_ASSERT_KNOWN(
+      a.size() == n && b.size() == n && y.size() == n,
+      "mul_add_vec: size of a, b, or y is not equal size of x"
+   );
+   //
+   // no recording in progress
+   local::ADTape<Base>* tape = ADBase::tape_ptr();
+   if( tape == nullptr )
+   {  for(size_t i = 0; i < n; ++i)
+         y[i] = ADBase( a[i] ) * x[i] + ADBase( b[i] );
+      return;
+   }
+   tape->mul_add_vec(a, x, b, y);
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -90,11 +90,49 @@ collision_limit=value
 If this substring appears,
 where *value* is a sequence of decimal digits,
 the optimizer's hash code collision limit will be set to *value* .
-When the collision limit is reached, the expressions with that hash code
-are removed and a new lists of expressions with that has code is started.
-The larger *value* , the more identical expressions the optimizer
-can recognize, but the slower the optimizer may run.
-The default for *value* is ``10`` .
+The optimizer uses a hash table to find expressions that are identical.
+The collision limit is the maximum number of hash table entries
+that are checked while searching for a match for one expression.
+If the limit is reached, the search stops and no match is found
+for that expression.
+The hash table grows with the operation sequence,
+so the expected number of entries checked is small
+and does not depend on the size of the operation sequence.
+The default for *value* is ``std::numeric_limits<size_t>::max()`` ;
+i.e., there is no limit.
+
+Previous Meaning
+----------------
+In previous versions of CppAD, *value* was the maximum number of
+expressions with the same hash code.
+When this number was reached, the expressions with that hash code
+were removed and a new list of expressions with that hash code was started.
+The previous default for *value* was ``10`` .
+A *value* that was chosen for the previous meaning can be used with
+the current meaning, but it will usually result in fewer searches
+being stopped; see :ref:`optimize@exceed_collision_limit` .
+
+print_timing
+============
+If this sub-string appears,
+the elapsed time (in seconds) for each phase of the optimizer
+is printed on standard output.
+This can be used to determine which phase is the most expensive
+for a particular operation sequence.
+
+n_thread=value
+==============
+If this substring appears,
+where *value* is a sequence of decimal digits,
+the optimizer uses *value* threads (including the current thread)
+to compute the hash codes used to find expressions that are identical.
+The search for identical expressions is then done by the current thread,
+so the optimized function does not depend on *value* .
+See :ref:`multi_thread@Internal Threads` for how the threads are created
+and why :ref:`ta_parallel_setup-name` is not required.
+Fewer threads are used when the operation sequence is small
+(less than 1024 operators per thread).
+The default for *value* is one.
 
 Re-Optimize
 ***********
@@ -330,6 +368,10 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
    // (must use player size because it now has the recoreder information)
    cskip_op_.resize( play_.num_op_rec() );
 
+   // resize the map from load operators to variables
+   // (optimization may remove load operators)
+   load_op2var_.resize( play_.num_var_load_rec() );
+
    // resize subgraph_info_
    subgraph_info_.resize(
       ind_taddr_.size(),    // n_ind
@@ -228,7 +228,7 @@ void ADFun<Base,RecBase>::rev_hes_sparsity(
       //
       // allocate memory for bool sparsity calculation
       // (sparsity pattern is emtpy after a resize)
-      local::sparse::list_setvec internal_hes;
+      local::sparse::hybrid_setvec internal_hes;
       internal_hes.resize(num_var_tape_, ell);
       //
       // compute the Hessian sparsity pattern
@@ -410,7 +410,7 @@ void ADFun<Base,RecBase>::RevSparseHesCase(
 
 
    // vector of sets that will hold reverse Hessain values
-   local::sparse::list_setvec rev_hes_pattern;
+   local::sparse::hybrid_setvec rev_hes_pattern;
    rev_hes_pattern.resize(num_var_tape_, q);
 
    // compute the Hessian sparsity patterns
@@ -437,7 +437,7 @@ void ADFun<Base,RecBase>::RevSparseHesCase(
       // extract the result from rev_hes_pattern
       // and add corresponding elements to result sets in h
       CPPAD_ASSERT_UNKNOWN( rev_hes_pattern.end() == q );
-      local::sparse::list_setvec::const_iterator itr_2(rev_hes_pattern, j+1);
+      local::sparse::hybrid_setvec::const_iterator itr_2(rev_hes_pattern, j+1);
       i = *itr_2;
       while( i < q )
       {  if( transpose )
@@ -592,7 +592,7 @@ void ADFun<Base,RecBase>::RevSparseHesCheckpoint(
    }
 
    // holds reverse Hessian sparsity pattern for all variables
-   local::sparse::list_setvec rev_hes_pattern;
+   local::sparse::hybrid_setvec rev_hes_pattern;
    rev_hes_pattern.resize(num_var_tape_, q);
 
    // compute Hessian sparsity pattern for all variables
@@ -623,7 +623,7 @@ void ADFun<Base,RecBase>::RevSparseHesCheckpoint(
 
       // extract the result from rev_hes_pattern
       CPPAD_ASSERT_UNKNOWN( rev_hes_pattern.end() == q );
-      local::sparse::list_setvec::const_iterator itr(rev_hes_pattern, j + 1);
+      local::sparse::hybrid_setvec::const_iterator itr(rev_hes_pattern, j + 1);
       size_t i = *itr;
       while( i < q )
       {  if( transpose )
@@ -16,6 +16,220 @@ Compute derivatives using reverse mode.
 */
 
 
+/*!
+Setup for a reverse mode sweep using reverse_partial_.
+
+\param q
+is the number of Taylor coefficient orders, per variable,
+that are being differentiated.
+
+\par reverse_partial_
+Upon return, it has size num_var_tape_ * q and all its elements are zero.
+Memory is only allocated when its size changes.
+It is only zeroed here when its size changes or a previous sweep
+did not complete; otherwise, the previous call to reverse_clear zeroed
+the partials that were written by the previous sweep.
+
+\par subgraph_info_
+If subgraph_info_.rev_all_set() is false, set_rev_all is used to determine
+the subgraph for all the dependent variables. If this subgraph is used,
+the random access tables for play_ are also setup.
+
+\par Parallel Mode
+All the memory allocation for reverse_sweep is done by this routine.
+*/
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::reverse_setup(size_t q)
+{  //
+   // reverse_partial_
+   size_t n_partial = num_var_tape_ * q;
+   if( reverse_partial_.size() != n_partial || ! reverse_partial_zero_ )
+   {  reverse_partial_.resize(n_partial);
+      for(size_t i = 0; i < n_partial; ++i)
+         reverse_partial_[i] = Base(0);
+      reverse_partial_zero_ = true;
+   }
+   //
+   // subgraph_info_
+   if( ! subgraph_info_.rev_all_set() )
+   {  subgraph_info_.set_rev_all(&play_, dep_taddr_);
+      if( subgraph_info_.rev_all_op().size() > 0 )
+      switch( play_.address_type() )
+      {
+         case local::play::unsigned_short_enum:
+         play_.template setup_random<unsigned short>();
+         break;
+
+         case local::play::unsigned_int_enum:
+         play_.template setup_random<unsigned int>();
+         break;
+
+         case local::play::size_t_enum:
+         play_.template setup_random<size_t>();
+         break;
+
+         default:
+         CPPAD_ASSERT_UNKNOWN(false);
+      }
+   }
+}
+/*!
+Reverse mode sweep over the subgraph for all the dependent variables.
+
+\tparam Addr
+is the type used for indices in the random access tables for play_.
+
+\par
+The other arguments are the same as for reverse_sweep and
+subgraph_info_.rev_all_op() must have non-zero size.
+*/
+template <class Base, class RecBase>
+template <class Addr>
+void ADFun<Base,RecBase>::reverse_sweep_subgraph(
+   size_t                           q           ,
+   size_t                           cap_order   ,
+   const Base*                      taylor      ,
+   Base*                            partial     ,
+   bool*                            cskip_op    ,
+   const local::pod_vector<addr_t>& load_op2var ) const
+{  // used to identify the RecBase type in calls to sweeps
+   RecBase not_used_rec_base(0.0);
+   //
+   const local::pod_vector<addr_t>& subgraph( subgraph_info_.rev_all_op() );
+   CPPAD_ASSERT_UNKNOWN( subgraph.size() > 0 );
+   local::play::const_random_iterator<Addr> random_itr =
+      play_.template get_random<Addr>();
+   local::play::const_subgraph_iterator<Addr> play_itr =
+      play_.end_subgraph(random_itr, &subgraph);
+   local::sweep::reverse(
+      q - 1,
+      ind_taddr_.size(),
+      num_var_tape_,
+      &play_,
+      cap_order,
+      taylor,
+      q,
+      partial,
+      cskip_op,
+      load_op2var,
+      play_itr,
+      not_used_rec_base
+   );
+}
+/*!
+Reverse mode sweep for Reverse(q, w) and Reverse(q, w, context).
+
+\param q
+is the number of Taylor coefficient orders, per variable,
+that are being differentiated.
+
+\param cap_order
+is the maximum number of orders, per variable, in taylor.
+
+\param taylor
+is the Taylor coefficients for all the variables.
+
+\param partial
+On input, it is zero except for the partials of the dependent variables.
+Upon return, it contains the partials for the independent variables.
+The partials written by this sweep are zeroed by reverse_clear.
+
+\param cskip_op
+the operators that are skipped.
+
+\param load_op2var
+the variable corresponding to each VecAD load operation.
+
+\par subgraph_info_
+If subgraph_info_.rev_all_op() has non-zero size, only the operators
+in this subgraph are used; otherwise, the entire operation sequence is used.
+This routine does not allocate memory, except for atomic function calls,
+and does not change this ADFun object.
+*/
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::reverse_sweep(
+   size_t                           q           ,
+   size_t                           cap_order   ,
+   const Base*                      taylor      ,
+   Base*                            partial     ,
+   bool*                            cskip_op    ,
+   const local::pod_vector<addr_t>& load_op2var ) const
+{  // used to identify the RecBase type in calls to sweeps
+   RecBase not_used_rec_base(0.0);
+   //
+   CPPAD_ASSERT_UNKNOWN( q > 0 );
+   if( subgraph_info_.rev_all_op().size() == 0 )
+   {  local::play::const_sequential_iterator play_itr = play_.end();
+      local::sweep::reverse(
+         q - 1,
+         ind_taddr_.size(),
+         num_var_tape_,
+         &play_,
+         cap_order,
+         taylor,
+         q,
+         partial,
+         cskip_op,
+         load_op2var,
+         play_itr,
+         not_used_rec_base
+      );
+      return;
+   }
+   switch( play_.address_type() )
+   {
+      case local::play::unsigned_short_enum:
+      reverse_sweep_subgraph<unsigned short>(
+         q, cap_order, taylor, partial, cskip_op, load_op2var
+      );
+      break;
+
+      case local::play::unsigned_int_enum:
+      reverse_sweep_subgraph<unsigned int>(
+         q, cap_order, taylor, partial, cskip_op, load_op2var
+      );
+      break;
+
+      case local::play::size_t_enum:
+      reverse_sweep_subgraph<size_t>(
+         q, cap_order, taylor, partial, cskip_op, load_op2var
+      );
+      break;
+
+      default:
+      CPPAD_ASSERT_UNKNOWN(false);
+   }
+}
+/*!
+Zero the partials written by reverse_sweep.
+
+\param q
+is the number of Taylor coefficient orders, per variable,
+that were differentiated.
+
+\param partial
+is the partials after a call to reverse_sweep.
+Upon return, all its elements are zero.
+If the subgraph was used for the sweep, this only zeroes the partials
+for the result variables in the subgraph (the dirty list
+subgraph_info_.rev_all_var()); otherwise, all the partials are zeroed.
+*/
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::reverse_clear(size_t q, Base* partial) const
+{  const Base zero(0);
+   if( subgraph_info_.rev_all_op().size() == 0 )
+   {  for(size_t i = 0; i < num_var_tape_ * q; ++i)
+         partial[i] = zero;
+      return;
+   }
+   const local::pod_vector<addr_t>& dirty( subgraph_info_.rev_all_var() );
+   for(size_t k = 0; k < dirty.size(); ++k)
+   {  size_t i_var = size_t( dirty[k] );
+      for(size_t ell = 0; ell < q; ++ell)
+         partial[i_var * q + ell] = zero;
+   }
+}
+
 /*!
 Use reverse mode to compute derivative of forward mode Taylor coefficients.
 
@@ -83,13 +297,7 @@ for the independent variables as specified by previous calls to Forward.
 template <class Base, class RecBase>
 template <class BaseVector>
 BaseVector ADFun<Base,RecBase>::Reverse(size_t q, const BaseVector &w)
-{  // used to identify the RecBase type in calls to sweeps
-   RecBase not_used_rec_base(0.0);
-
-   // constants
-   const Base zero(0);
-
-   // temporary indices
+{  // temporary indices
    size_t i, j, k;
 
    // number of independent variables
@@ -129,11 +337,10 @@ BaseVector ADFun<Base,RecBase>::Reverse(size_t q, const BaseVector &w)
       "\n(r > 1) is not yet supported for q > 1."
    );
 
-   // initialize entire Partial matrix to zero
-   local::pod_vector_maybe<Base> Partial(num_var_tape_ * q);
-   for(i = 0; i < num_var_tape_; i++)
-      for(j = 0; j < q; j++)
-         Partial[i * q + j] = zero;
+   // Partial: the entire Partial matrix is zero
+   reverse_setup(q);
+   Base* Partial = reverse_partial_.data();
+   reverse_partial_zero_ = false;
 
    // set the dependent variable direction
    // (use += because two dependent variables can point to same location)
@@ -150,20 +357,9 @@ BaseVector ADFun<Base,RecBase>::Reverse(size_t q, const BaseVector &w)
    // evaluate the derivatives
    CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
    CPPAD_ASSERT_UNKNOWN( load_op2var_.size()  == play_.num_var_load_rec() );
-   local::play::const_sequential_iterator play_itr = play_.end();
-   local::sweep::reverse(
-      q - 1,
-      n,
-      num_var_tape_,
-      &play_,
-      cap_order_taylor_,
-      taylor_.data(),
-      q,
-      Partial.data(),
-      cskip_op_.data(),
-      load_op2var_,
-      play_itr,
-      not_used_rec_base
+   reverse_sweep(
+      q, cap_order_taylor_, taylor_.data(), Partial, cskip_op_.data(),
+      load_op2var_
    );
 
    // return the derivative values
@@ -188,6 +384,10 @@ BaseVector ADFun<Base,RecBase>::Reverse(size_t q, const BaseVector &w)
                Partial[ind_taddr_[j] * q + k];
       }
    }
+   // zero the partials written by the sweep
+   reverse_clear(q, Partial);
+   reverse_partial_zero_ = true;
+   //
    CPPAD_ASSERT_KNOWN( ! ( hasnan(value) && check_for_nan_ ) ,
       "dw = f.Reverse(q, w): has a nan,\n"
       "but none of its Taylor coefficents are nan."
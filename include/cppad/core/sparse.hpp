@@ -20,6 +20,7 @@
 //
 # include <cppad/core/sparse_jac.hpp>
 # include <cppad/core/sparse_hes.hpp>
+# include <cppad/core/sparse_cache.hpp>
 //
 # include <cppad/core/sparse_jacobian.hpp>
 # include <cppad/core/sparse_hessian.hpp>
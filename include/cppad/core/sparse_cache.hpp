@@ -0,0 +1,754 @@
+# ifndef CPPAD_CORE_SPARSE_CACHE_HPP
+# define CPPAD_CORE_SPARSE_CACHE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_cache}
+{xrst_spell
+   retaped
+   retaping
+}
+
+Sparse Derivatives With Process Wide Cache of Sparsity and Coloring
+###################################################################
+
+Syntax
+******
+| *hash* = *f* . ``structure_hash`` ()
+| *n_sweep* = *f* . ``sparse_jac_cache`` ( *x* , *jac* , *coloring* )
+| *n_sweep* = *f* . ``sparse_hes_cache`` ( *x* , *w* , *hes* , *coloring* )
+| ``sparse_cache_clear`` ()
+| *n_entry* = ``sparse_cache_size`` ()
+| *n_hit* = ``sparse_cache_hit`` ()
+| ``sparse_cache_max`` ( *n_max* )
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+function corresponding to *f* .
+When the operation sequence is recorded again for each new argument value
+(retaping), the :ref:`sparse_jac@work` and :ref:`sparse_hes@work`
+structures do not know if the new *f* has the same sparsity pattern.
+The routines above store the sparsity pattern and coloring
+in a process wide cache.
+The cache is indexed by the structure of the operation sequence,
+so retaped functions with the same structure skip computing the
+sparsity pattern and coloring.
+
+structure_hash
+**************
+The return value *hash* has prototype
+
+   ``size_t`` *hash*
+
+It is a hash code for the structure of the operation sequence in *f* ;
+i.e., the operators, their arguments, the independent variables,
+and the dependent variables.
+It does not depend on the value of the parameters.
+Functions with the same structure have the same sparsity pattern
+for their derivatives.
+
+f
+*
+The object *f* has prototype
+
+   ``ADFun`` < *Base* > *f*
+
+Note that the Taylor coefficients stored in *f* are affected
+by this operation; see
+:ref:`sparse_cache@Uses Forward` below.
+
+x
+*
+This argument has prototype
+
+   ``const`` *BaseVector* & *x*
+
+and its size is *n* .
+It specifies the point at which to evaluate the derivative.
+
+w
+*
+This argument has prototype
+
+   ``const`` *BaseVector* & *w*
+
+and size *m* .
+It specifies the weight for each of the components of :math:`F(x)`;
+i.e. the Hessian is for :math:`w^\R{T} F(x)` .
+
+jac
+***
+This argument has prototype
+
+   ``sparse_rcv`` < *SizeVector* , *BaseVector* >& *jac*
+
+Its input value does not matter.
+Upon return, its sparsity pattern is the
+:ref:`for_jac_sparsity-name` sparsity pattern for the Jacobian of
+:math:`F(x)` in row major order
+and its values are the corresponding Jacobian values.
+If the input sparsity pattern for *jac* is the same as this pattern,
+it is not changed.
+Forward mode is used if :math:`n \leq m` and reverse mode is used
+otherwise; see :ref:`sparse_jac-name` .
+
+hes
+***
+This argument has prototype
+
+   ``sparse_rcv`` < *SizeVector* , *BaseVector* >& *hes*
+
+Its input value does not matter.
+Upon return, its sparsity pattern is a sparsity pattern for
+the Hessian of every component of :math:`F(x)` in row major order
+and its values are the corresponding values of the Hessian of
+:math:`w^\R{T} F(x)` .
+If the input sparsity pattern for *hes* is the same as this pattern,
+it is not changed.
+
+coloring
+********
+This argument has prototype
+
+   ``const std::string&`` *coloring*
+
+It is the coloring method passed to
+:ref:`sparse_jac<sparse_jac@coloring>` or
+:ref:`sparse_hes<sparse_hes@coloring>` .
+The same structure with a different coloring
+corresponds to a different cache entry.
+
+n_sweep
+*******
+The return value *n_sweep* has prototype
+
+   ``size_t`` *n_sweep*
+
+It is the return value for the corresponding call to
+``sparse_jac_for`` , ``sparse_jac_rev`` or ``sparse_hes`` .
+
+Cache
+*****
+The first time a structure, coloring, and Jacobian (Hessian) is used,
+the sparsity pattern is computed and stored in the cache.
+The first call to ``sparse_jac_for`` , ``sparse_jac_rev`` , or
+``sparse_hes`` stores its coloring in the cache.
+After that, every call with a function that has the same
+:ref:`sparse_cache@structure_hash` ,
+domain size, and range size uses the values in the cache.
+
+Collisions
+==========
+Each entry also stores the number of variables, operators,
+and operator arguments for its structure,
+and a second hash code for the structure that is computed using a
+different method than *hash* .
+If these values are not the same for *f* , the entry is not used;
+i.e., the sparsity pattern and coloring for *f* are computed and
+replace the values in the entry.
+
+Atomic Functions
+================
+The sparsity pattern for an :ref:`atomic function<atomic-name>` call
+can depend on the value of its parameter arguments; e.g., see
+:ref:`atomic_three_jac_sparsity@parameter_x` and
+:ref:`atomic_four_jac_sparsity@ident_zero_x` .
+The parameter values are not part of the structure of *f* .
+Hence, if *f* contains an atomic function call, the cache is not used;
+i.e., the sparsity pattern and coloring are computed for each call
+and nothing is stored in the cache.
+
+sparse_cache_clear
+==================
+This routine frees all the memory used by the cache.
+It should be called before checking for memory leaks using
+:ref:`ta_free_all-name` .
+
+n_entry
+=======
+The return value *n_entry* has prototype
+
+   ``size_t`` *n_entry*
+
+It is the number of entries in the cache.
+
+n_hit
+=====
+The return value *n_hit* has prototype
+
+   ``size_t`` *n_hit*
+
+It is the number of calls to ``sparse_jac_cache`` and
+``sparse_hes_cache`` , since the previous call to ``sparse_cache_clear`` ,
+that used an entry in the cache (instead of computing a new entry).
+
+n_max
+=====
+The argument *n_max* has prototype
+
+   ``size_t`` *n_max*
+
+It is the maximum number of entries in the cache
+and must be greater than zero.
+If a new entry is needed and there are *n_max* entries in the cache,
+the entry that was least recently used is removed from the cache.
+If there are more than *n_max* entries in the cache when
+``sparse_cache_max`` is called, the least recently used entries are removed.
+The default value for *n_max* is 100 and
+``sparse_cache_clear`` does not change its value.
+
+Parallel Mode
+=============
+The cache is not thread safe.
+These routines must not be called in
+:ref:`parallel mode<ta_in_parallel-name>` .
+
+SizeVector
+**********
+The type *SizeVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``size_t`` .
+
+BaseVector
+**********
+The type *BaseVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+Uses Forward
+************
+After a call to ``sparse_jac_cache`` or ``sparse_hes_cache`` ,
+the zero order coefficients correspond to
+
+   *f* . ``Forward`` (0, *x* )
+
+All the other forward mode coefficients are unspecified.
+
+Example
+*******
+{xrst_toc_hidden
+   example/sparse/sparse_cache.cpp
+}
+The file :ref:`sparse_cache.cpp-name`
+is an example and test of these routines.
+It returns ``true`` , if it succeeds, and ``false`` otherwise.
+
+{xrst_end sparse_cache}
+*/
+# include <map>
+# include <utility>
+# include <tuple>
+# include <string>
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/local/hash_code.hpp>
+# include <cppad/utility/thread_alloc.hpp>
+# include <cppad/core/sparse_jac.hpp>
+# include <cppad/core/sparse_hes.hpp>
+
+/*!
+\file sparse_cache.hpp
+Process wide cache of sparsity patterns and colorings.
+*/
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+Information stored in the sparse cache for one structure.
+*/
+struct sparse_cache_entry {
+   /// number of rows in the sparsity pattern
+   size_t                nr;
+   /// number of columns in the sparsity pattern
+   size_t                nc;
+   /// row indices for the sparsity pattern in row major order
+   CppAD::vector<size_t> row;
+   /// column indices for the sparsity pattern in row major order
+   CppAD::vector<size_t> col;
+   /// coloring information for a Jacobian
+   sparse_jac_work       jac_work;
+   /// coloring information for a Hessian
+   sparse_hes_work       hes_work;
+   /// number of variables in the structure
+   size_t                num_var;
+   /// number of operators in the structure
+   size_t                num_op;
+   /// number of operator arguments in the structure
+   size_t                num_op_arg;
+   /// second hash code for the structure (see ADFun::structure_check)
+   size_t                check;
+   /// value of sparse_cache_count().n_use when this entry was last used
+   size_t                last_use;
+};
+/*!
+Index in the sparse cache:
+jacobian (zero) or hessian (one), structure hash, domain size, range size,
+and coloring method.
+*/
+typedef std::tuple<size_t, size_t, size_t, size_t, std::string>
+   sparse_cache_key;
+/// type of the sparse cache
+typedef std::map<sparse_cache_key, sparse_cache_entry> sparse_cache_map;
+/// The process wide sparse cache.
+inline sparse_cache_map& sparse_cache(void)
+{  CPPAD_ASSERT_KNOWN(
+      ! thread_alloc::in_parallel(),
+      "sparse_cache: cannot be used in parallel mode"
+   );
+   static sparse_cache_map cache;
+   return cache;
+}
+/// Counters for the process wide sparse cache.
+struct sparse_cache_counter {
+   /// number of times an entry has been used (or created)
+   size_t n_use;
+   /// number of times an entry has been used (not created)
+   size_t n_hit;
+   /// maximum number of entries in the cache
+   size_t n_max;
+};
+/// The counters for the process wide sparse cache.
+inline sparse_cache_counter& sparse_cache_count(void)
+{  CPPAD_ASSERT_KNOWN(
+      ! thread_alloc::in_parallel(),
+      "sparse_cache: cannot be used in parallel mode"
+   );
+   static sparse_cache_counter count = { 0, 0, 100 };
+   return count;
+}
+/*!
+Remove the least recently used entries from the sparse cache.
+
+\param n_keep
+upon return, the number of entries in the cache is less than or equal
+n_keep.
+*/
+inline void sparse_cache_evict(size_t n_keep)
+{  sparse_cache_map& cache = sparse_cache();
+   while( n_keep < cache.size() )
+   {  sparse_cache_map::iterator oldest = cache.begin();
+      sparse_cache_map::iterator itr    = cache.begin();
+      for(++itr; itr != cache.end(); ++itr)
+      {  if( itr->second.last_use < oldest->second.last_use )
+            oldest = itr;
+      }
+      cache.erase(oldest);
+   }
+}
+/*!
+Find or create the sparse cache entry for a structure.
+
+\param key
+is the index in the sparse cache for this structure.
+
+\param num_var
+is the number of variables in this structure.
+
+\param num_op
+is the number of operators in this structure.
+
+\param num_op_arg
+is the number of operator arguments in this structure.
+
+\param check
+is the second hash code for this structure.
+
+\param itr
+upon return, itr->first is key and itr->second is the entry
+for this structure.
+
+\return
+is true if the entry has a sparsity pattern for this structure.
+Otherwise, the entry is new or it was for a different structure
+with the same key (a hash code collision), and the caller must set its
+sparsity pattern.
+*/
+inline bool sparse_cache_find(
+   const sparse_cache_key&      key        ,
+   size_t                       num_var    ,
+   size_t                       num_op     ,
+   size_t                       num_op_arg ,
+   size_t                       check      ,
+   sparse_cache_map::iterator&  itr        )
+{  sparse_cache_map&     cache = sparse_cache();
+   sparse_cache_counter& count = sparse_cache_count();
+   ++count.n_use;
+   //
+   itr = cache.find(key);
+   if( itr != cache.end() )
+   {  sparse_cache_entry& entry = itr->second;
+      entry.last_use = count.n_use;
+      bool same = entry.num_var == num_var;
+      same     &= entry.num_op == num_op;
+      same     &= entry.num_op_arg == num_op_arg;
+      same     &= entry.check == check;
+      if( same )
+      {  ++count.n_hit;
+         return true;
+      }
+      // a different structure with the same key
+      cache.erase(itr);
+   }
+   // make room for the new entry
+   CPPAD_ASSERT_UNKNOWN( 0 < count.n_max );
+   sparse_cache_evict(count.n_max - 1);
+   itr = cache.insert( std::make_pair(key, sparse_cache_entry()) ).first;
+   sparse_cache_entry& entry = itr->second;
+   entry.num_var    = num_var;
+   entry.num_op     = num_op;
+   entry.num_op_arg = num_op_arg;
+   entry.check      = check;
+   entry.last_use   = count.n_use;
+   return false;
+}
+/*!
+Can the sparse cache be used for a recording.
+
+\param play
+is the player for the recording.
+
+\return
+is false if the recording contains an atomic function call.
+The sparsity pattern for an atomic function call can depend on the
+value of its parameter arguments, which are not part of the structure hash.
+*/
+template <class Base>
+bool sparse_cache_usable(const player<Base>& play)
+{  for(size_t i_op = 0; i_op < play.num_op_rec(); ++i_op)
+      if( play.GetOp(i_op) == AFunOp )
+         return false;
+   return true;
+}
+/*!
+Convert a sparsity pattern to row major order and store it in an entry.
+
+\param pattern
+is the sparsity pattern.
+
+\param entry
+Upon return, entry.nr, entry.nc, entry.row, entry.col
+are the sparsity pattern in row major order.
+*/
+template <class SizeVector>
+void sparse_cache_set_pattern(
+   const sparse_rc<SizeVector>& pattern ,
+   sparse_cache_entry&          entry   )
+{  size_t nnz              = pattern.nnz();
+   SizeVector row_major    = pattern.row_major();
+   entry.nr = pattern.nr();
+   entry.nc = pattern.nc();
+   entry.row.resize(nnz);
+   entry.col.resize(nnz);
+   for(size_t k = 0; k < nnz; ++k)
+   {  entry.row[k] = pattern.row()[ row_major[k] ];
+      entry.col[k] = pattern.col()[ row_major[k] ];
+   }
+}
+/*!
+Set the sparsity pattern for a matrix to the pattern in a cache entry.
+
+\param entry
+is the cache entry.
+
+\param matrix
+If the sparsity pattern for matrix is the same as for entry,
+it is not modified. Otherwise, it is set to a matrix with the
+pattern in entry (and unspecified values).
+
+\param pattern
+If matrix is modified, pattern is the corresponding sparsity pattern.
+Otherwise it is not modified.
+
+\return
+is true if matrix was modified.
+*/
+template <class SizeVector, class BaseVector>
+bool sparse_cache_get_pattern(
+   const sparse_cache_entry&            entry   ,
+   sparse_rcv<SizeVector, BaseVector>&  matrix  ,
+   sparse_rc<SizeVector>&               pattern )
+{  size_t nnz = entry.row.size();
+   bool same  = matrix.nr() == entry.nr;
+   same      &= matrix.nc() == entry.nc;
+   same      &= matrix.nnz() == nnz;
+   for(size_t k = 0; k < nnz && same; ++k)
+   {  same &= matrix.row()[k] == entry.row[k];
+      same &= matrix.col()[k] == entry.col[k];
+   }
+   if( same )
+      return false;
+   pattern.resize(entry.nr, entry.nc, nnz);
+   for(size_t k = 0; k < nnz; ++k)
+      pattern.set(k, entry.row[k], entry.col[k]);
+   matrix = sparse_rcv<SizeVector, BaseVector>(pattern);
+   return true;
+}
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+namespace CppAD { // BEGIN CPPAD_NAMESPACE
+/*!
+Free all the memory in the sparse cache.
+*/
+inline void sparse_cache_clear(void)
+{  local::sparse_cache().clear();
+   local::sparse_cache_count().n_use = 0;
+   local::sparse_cache_count().n_hit = 0;
+}
+/*!
+Number of entries in the sparse cache.
+*/
+inline size_t sparse_cache_size(void)
+{  return local::sparse_cache().size(); }
+/*!
+Number of times an entry in the sparse cache was used
+since the previous sparse_cache_clear.
+*/
+inline size_t sparse_cache_hit(void)
+{  return local::sparse_cache_count().n_hit; }
+/*!
+Set the maximum number of entries in the sparse cache.
+
+\param n_max
+is the maximum number of entries. If there are more entries,
+the least recently used entries are removed.
+*/
+inline void sparse_cache_max(size_t n_max)
+{  CPPAD_ASSERT_KNOWN(
+      0 < n_max,
+      "sparse_cache_max: n_max is zero"
+   );
+   local::sparse_cache_count().n_max = n_max;
+   local::sparse_cache_evict(n_max);
+}
+// ---------------------------------------------------------------------------
+/*!
+Hash code for the structure of the operation sequence.
+
+\return
+is a hash code for the operators, their arguments,
+the independent variables, and the dependent variables.
+It does not depend on the parameter values.
+*/
+template <class Base, class RecBase>
+size_t ADFun<Base,RecBase>::structure_hash(void) const
+{  size_t code = play_.structure_hash();
+   code = local::local_hash_combine(code, ind_taddr_.size() );
+   for(size_t j = 0; j < ind_taddr_.size(); ++j)
+      code = local::local_hash_combine(code, ind_taddr_[j] );
+   code = local::local_hash_combine(code, dep_taddr_.size() );
+   for(size_t i = 0; i < dep_taddr_.size(); ++i)
+   {  code = local::local_hash_combine(code, dep_taddr_[i] );
+      code = local::local_hash_combine(code, size_t( dep_parameter_[i] ) );
+   }
+   return code;
+}
+/*!
+Second hash code for the structure of the operation sequence.
+
+\return
+is a hash code for the same values as structure_hash,
+computed using local_hash_mix instead of local_hash_combine.
+It is used to check for collisions of structure_hash codes.
+*/
+template <class Base, class RecBase>
+size_t ADFun<Base,RecBase>::structure_check(void) const
+{  size_t code = play_.structure_check();
+   code = local::local_hash_mix(code, ind_taddr_.size() );
+   for(size_t j = 0; j < ind_taddr_.size(); ++j)
+      code = local::local_hash_mix(code, ind_taddr_[j] );
+   code = local::local_hash_mix(code, dep_taddr_.size() );
+   for(size_t i = 0; i < dep_taddr_.size(); ++i)
+   {  code = local::local_hash_mix(code, dep_taddr_[i] );
+      code = local::local_hash_mix(code, size_t( dep_parameter_[i] ) );
+   }
+   return code;
+}
+// ---------------------------------------------------------------------------
+/*!
+Sparse Jacobian using the process wide sparse cache.
+
+\tparam SizeVector
+is a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+is a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param jac
+Upon return, this is the Jacobian of f at x with its dependency
+sparsity pattern in row major order.
+
+\param coloring
+is the coloring method passed to sparse_jac_for or sparse_jac_rev.
+
+\return
+is the return value of sparse_jac_for or sparse_jac_rev.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_cache(
+   const BaseVector&                    x        ,
+   sparse_rcv<SizeVector, BaseVector>&  jac      ,
+   const std::string&                   coloring )
+{  size_t m = Range();
+   size_t n = Domain();
+   CPPAD_ASSERT_KNOWN(
+      size_t( x.size() ) == n,
+      "sparse_jac_cache: x.size() not equal domain dimension for f"
+   );
+   //
+   // reverse
+   bool reverse = m < n;
+   //
+   // entry_ptr
+   // (an entry that is not in the cache is used when it is not usable)
+   local::sparse_cache_entry  not_cached;
+   local::sparse_cache_entry* entry_ptr = &not_cached;
+   bool found = false;
+   if( local::sparse_cache_usable(play_) )
+   {  local::sparse_cache_key  key(0, structure_hash(), n, m, coloring);
+      local::sparse_cache_map::iterator itr;
+      found = local::sparse_cache_find(
+         key, size_var(), size_op(), size_op_arg(), structure_check(), itr
+      );
+      entry_ptr = &(itr->second);
+   }
+   if( ! found )
+   {  // compute the sparsity pattern for this structure
+      bool transpose     = false;
+      bool dependency    = false;
+      bool internal_bool = false;
+      size_t ell         = n;
+      if( reverse )
+         ell = m;
+      sparse_rc<SizeVector> pattern_in(ell, ell, ell), pattern_out;
+      for(size_t k = 0; k < ell; ++k)
+         pattern_in.set(k, k, k);
+      if( reverse ) rev_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_out
+      );
+      else for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_out
+      );
+      local::sparse_cache_set_pattern(pattern_out, *entry_ptr);
+   }
+   local::sparse_cache_entry& entry = *entry_ptr;
+   //
+   // jac, pattern
+   // (pattern is only used the first time for this entry)
+   sparse_rc<SizeVector> pattern;
+   if( ! local::sparse_cache_get_pattern(entry, jac, pattern) )
+   {  if( entry.jac_work.color.size() == 0 )
+      {  pattern.resize(entry.nr, entry.nc, entry.row.size());
+         for(size_t k = 0; k < entry.row.size(); ++k)
+            pattern.set(k, entry.row[k], entry.col[k]);
+      }
+   }
+   //
+   // n_sweep
+   size_t n_sweep;
+   if( reverse )
+      n_sweep = sparse_jac_rev(x, jac, pattern, coloring, entry.jac_work);
+   else
+   {  size_t group_max = 1;
+      n_sweep = sparse_jac_for(
+         group_max, x, jac, pattern, coloring, entry.jac_work
+      );
+   }
+   return n_sweep;
+}
+// ---------------------------------------------------------------------------
+/*!
+Sparse Hessian using the process wide sparse cache.
+
+\tparam SizeVector
+is a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+is a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param w
+a vector of length m, the number of dependent variables in f
+(this ADFun object).
+
+\param hes
+Upon return, this is the Hessian of w^T f(x) with its sparsity
+pattern in row major order.
+
+\param coloring
+is the coloring method passed to sparse_hes.
+
+\return
+is the return value of sparse_hes.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_hes_cache(
+   const BaseVector&                    x        ,
+   const BaseVector&                    w        ,
+   sparse_rcv<SizeVector, BaseVector>&  hes      ,
+   const std::string&                   coloring )
+{  size_t m = Range();
+   size_t n = Domain();
+   CPPAD_ASSERT_KNOWN(
+      size_t( x.size() ) == n,
+      "sparse_hes_cache: x.size() not equal domain dimension for f"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( w.size() ) == m,
+      "sparse_hes_cache: w.size() not equal range dimension for f"
+   );
+   //
+   // entry_ptr
+   // (an entry that is not in the cache is used when it is not usable)
+   local::sparse_cache_entry  not_cached;
+   local::sparse_cache_entry* entry_ptr = &not_cached;
+   bool found = false;
+   if( local::sparse_cache_usable(play_) )
+   {  local::sparse_cache_key  key(1, structure_hash(), n, m, coloring);
+      local::sparse_cache_map::iterator itr;
+      found = local::sparse_cache_find(
+         key, size_var(), size_op(), size_op_arg(), structure_check(), itr
+      );
+      entry_ptr = &(itr->second);
+   }
+   if( ! found )
+   {  // compute the sparsity pattern for this structure
+      CppAD::vector<bool> select_domain(n), select_range(m);
+      for(size_t j = 0; j < n; ++j)
+         select_domain[j] = true;
+      for(size_t i = 0; i < m; ++i)
+         select_range[i] = true;
+      bool internal_bool = false;
+      sparse_rc<SizeVector> pattern_out;
+      for_hes_sparsity(
+         select_domain, select_range, internal_bool, pattern_out
+      );
+      local::sparse_cache_set_pattern(pattern_out, *entry_ptr);
+   }
+   local::sparse_cache_entry& entry = *entry_ptr;
+   //
+   // hes, pattern
+   // (pattern is only used the first time for this entry)
+   sparse_rc<SizeVector> pattern;
+   if( ! local::sparse_cache_get_pattern(entry, hes, pattern) )
+   {  if( entry.hes_work.color.size() == 0 )
+      {  pattern.resize(entry.nr, entry.nc, entry.row.size());
+         for(size_t k = 0; k < entry.row.size(); ++k)
+            pattern.set(k, entry.row[k], entry.col[k]);
+      }
+   }
+   //
+   return sparse_hes(x, w, hes, pattern, coloring, entry.hes_work);
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -18,7 +18,7 @@ Syntax
 ******
 
 | *n_sweep* = *f* . ``sparse_hes`` (
-| |tab| *x* , *w* , *subset* , *pattern* , *coloring* , *work*
+| |tab| *x* , *w* , *subset* , *pattern* , *coloring* , *work* [, *n_thread* ]
 | )
 
 Purpose
@@ -149,6 +149,17 @@ This is the same as the sparse Jacobian
 :ref:`sparse_jac@coloring@cppad` method
 which does not take advantage of symmetry.
 
+cppad.parallel
+==============
+This is the same as the sparse Jacobian
+:ref:`sparse_jac@coloring@cppad.parallel` methods
+which do not take advantage of symmetry.
+The values ``cppad.parallel.largest_first`` ,
+``cppad.parallel.smallest_last`` and
+``cppad.parallel.incidence_degree`` are also allowed
+and select the order in which the rows are colored.
+These methods use *n_thread* threads to compute the coloring.
+
 colpack.symmetric
 =================
 If :ref:`colpack_prefix-name` was specified on the
@@ -189,6 +200,18 @@ for *f* and the sparsity pattern in *subset* are the same.
 If either of these values change, use *work* . ``clear`` () to
 empty this structure.
 
+n_thread
+********
+This argument is optional and has prototype
+
+   ``size_t`` *n_thread*
+
+Its default value is one.
+It is the number of threads (including the current thread) used by the
+:ref:`sparse_hes@coloring@cppad.parallel` coloring methods.
+The threads are created using ``std::thread`` and do not use
+:ref:`thread_alloc-name` .
+
 n_sweep
 *******
 The return value *n_sweep* has prototype
@@ -239,6 +262,7 @@ It returns ``true`` , for success, and ``false`` otherwise.
 # include <cppad/local/sparse/internal.hpp>
 # include <cppad/local/color_general.hpp>
 # include <cppad/local/color_symmetric.hpp>
+# include <cppad/local/color_parallel.hpp>
 
 /*!
 \file sparse_hes.hpp
@@ -308,7 +332,7 @@ where m is number of dependent variables in f.
 \param coloring
 determines which coloring algorithm is used.
 This must be cppad.symmetric, cppad.general, colpack.symmetic,
-or colpack.star.
+colpack.star, or one of the cppad.parallel methods.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -316,6 +340,9 @@ by a previous call to sparse_hes.
 The previous call must be for the same ADFun object f
 and the same subset.
 
+\param n_thread
+is the number of threads used by the cppad.parallel coloring methods.
+
 \return
 This is the number of first order forward
 (and second order reverse) sweeps used to compute thhe Hessian.
@@ -328,7 +355,8 @@ size_t ADFun<Base,RecBase>::sparse_hes(
    sparse_rcv<SizeVector , BaseVector>& subset   ,
    const sparse_rc<SizeVector>&         pattern  ,
    const std::string&                   coloring ,
-   sparse_hes_work&                     work     )
+   sparse_hes_work&                     work     ,
+   size_t                               n_thread )
 {  size_t n = Domain();
    //
    CPPAD_ASSERT_KNOWN(
@@ -424,7 +452,7 @@ size_t ADFun<Base,RecBase>::sparse_hes(
       bool transpose   = true;
       bool zero_empty  = false;
       bool input_empty = true;
-      local::sparse::list_setvec internal_pattern;
+      local::sparse::hybrid_setvec internal_pattern;
       internal_pattern.resize(n, n);
       local::sparse::set_internal_pattern(zero_empty, input_empty,
          transpose, internal_index, internal_pattern, pattern
@@ -433,8 +461,18 @@ size_t ADFun<Base,RecBase>::sparse_hes(
       // execute coloring algorithm
       // (we are using transpose becasue coloring groups rows, not columns)
       color.resize(n);
+      local::color_order_enum order_type;
       if( coloring == "cppad.general" )
          local::color_general_cppad(internal_pattern, col, row, color);
+      else if( local::color_parallel_order(coloring, order_type) )
+      {  CPPAD_ASSERT_KNOWN(
+            n_thread > 0,
+            "sparse_hes: n_thread is zero"
+         );
+         local::color_general_parallel(
+            internal_pattern, col, row, color, order_type, n_thread
+         );
+      }
       else if( coloring == "cppad.symmetric" )
          local::color_symmetric_cppad(internal_pattern, col, row, color);
       else if( coloring == "colpack.general" )
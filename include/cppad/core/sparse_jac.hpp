@@ -18,10 +18,10 @@ Syntax
 ******
 
 | *n_color* = *f* . ``sparse_jac_for`` (
-| |tab| *group_max* , *x* , *subset* , *pattern* , *coloring* , *work*
+| |tab| *group_max* , *x* , *subset* , *pattern* , *coloring* , *work* [, *n_thread* ]
 | )
 | *n_color* = *f* . ``sparse_jac_rev`` (
-| |tab| *x* , *subset* , *pattern* , *coloring* , *work*
+| |tab| *x* , *subset* , *pattern* , *coloring* , *work* [, *n_thread* ]
 | )
 
 Purpose
@@ -151,6 +151,38 @@ If :ref:`colpack_prefix-name` is specified on the
 you can set *coloring* to ``colpack`` .
 This uses a general purpose coloring algorithm that is part of Colpack.
 
+cppad.parallel
+==============
+This uses the same conditions on the colors as the
+:ref:`sparse_jac@coloring@cppad` method.
+The rows (reverse) or columns (forward) are colored in rounds
+using *n_thread* threads.
+During each round, the rows that still need a color are split into blocks
+and each thread colors its block without waiting for the other threads.
+A row that ends up with the same color as a neighbor,
+that comes before it in the order, is colored again during the next round.
+If *n_thread* is one, this is the greedy coloring algorithm
+using the specified order.
+The result may depend on the timing of the threads when *n_thread*
+is greater than one.
+The order in which the rows are colored is specified as follows:
+
+.. csv-table::
+   :widths: auto
+   :header-rows: 1
+
+   *coloring*,Order
+   ``cppad.parallel``,same as ``cppad.parallel.largest_first``
+   ``cppad.parallel.largest_first``,decreasing number of neighbors
+   ``cppad.parallel.smallest_last``,"reverse of the order in which
+   rows with the fewest remaining neighbors are removed"
+   ``cppad.parallel.incidence_degree``,"next row has the most neighbors
+   that are already ordered"
+
+Here two rows are neighbors if they cannot have the same color.
+These orderings often result in fewer colors than the
+:ref:`sparse_jac@coloring@cppad` method.
+
 work
 ****
 This argument has prototype
@@ -170,6 +202,29 @@ for *f* and the sparsity pattern in *subset* are the same.
 If any of these values change, use *work* . ``clear`` () to
 empty this structure.
 
+n_thread
+********
+This argument is optional and has prototype
+
+   ``size_t`` *n_thread*
+
+Its default value is one.
+It is the number of threads (including the current thread) used by the
+:ref:`sparse_jac@coloring@cppad.parallel` coloring methods.
+If it is greater than one, ``sparse_jac_rev`` also uses *n_thread* threads
+to compute the reverse sweeps.
+Each thread computes the rows for a subset of the colors
+and has its own partial derivative buffer.
+The zero order Taylor coefficients and the operation sequence
+are shared (read only) by all the threads.
+
+See :ref:`multi_thread@Internal Threads` for how the threads are created
+and why :ref:`ta_parallel_setup-name` is not required.
+Only one thread is used for the reverse sweeps if *Base* is not
+``float`` , ``double`` , or ``long double`` ,
+if the operation sequence contains an atomic function call,
+or if there is only one color.
+
 n_color
 *******
 The return value *n_color* has prototype
@@ -212,9 +267,12 @@ They return ``true`` , if they succeed, and ``false`` otherwise.
 
 {xrst_end sparse_jac}
 */
+# include <thread>
+# include <functional>
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/sparse/internal.hpp>
 # include <cppad/local/color_general.hpp>
+# include <cppad/local/color_parallel.hpp>
 # include <cppad/utility/vector.hpp>
 
 /*!
@@ -277,7 +335,7 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, colpack, or one of the cppad.parallel methods.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -285,6 +343,9 @@ by a previous call to sparse_jac_for.
 The previous call must be for the same ADFun object f
 and the same subset.
 
+\param n_thread
+is the number of threads used by the cppad.parallel coloring methods.
+
 \return
 This is the number of first order forward sweeps used to compute
 the Jacobian.
@@ -297,7 +358,8 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
    sparse_rcv<SizeVector, BaseVector>&  subset     ,
    const sparse_rc<SizeVector>&         pattern    ,
    const std::string&                   coloring   ,
-   sparse_jac_work&                     work       )
+   sparse_jac_work&                     work       ,
+   size_t                               n_thread   )
 {  size_t m = Range();
    size_t n = Domain();
    //
@@ -351,7 +413,7 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
       bool transpose   = true;
       bool zero_empty  = false;
       bool input_empty = true;
-      local::sparse::list_setvec pattern_transpose;
+      local::sparse::hybrid_setvec pattern_transpose;
       pattern_transpose.resize(n, m);
       local::sparse::set_internal_pattern(zero_empty, input_empty,
          transpose, internal_index, pattern_transpose, pattern
@@ -360,8 +422,18 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
       // execute coloring algorithm
       // (we are using transpose because coloring groups rows, not columns).
       color.resize(n);
+      local::color_order_enum order_type;
       if( coloring == "cppad" )
          local::color_general_cppad(pattern_transpose, col, row, color);
+      else if( local::color_parallel_order(coloring, order_type) )
+      {  CPPAD_ASSERT_KNOWN(
+            n_thread > 0,
+            "sparse_jac_for: n_thread is zero"
+         );
+         local::color_general_parallel(
+            pattern_transpose, col, row, color, order_type, n_thread
+         );
+      }
       else if( coloring == "colpack" )
       {
 # if CPPAD_HAS_COLPACK
@@ -471,7 +543,7 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, colpack, or one of the cppad.parallel methods.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -479,6 +551,10 @@ by a previous call to sparse_jac_rev.
 The previous call must be for the same ADFun object f
 and the same subset.
 
+\param n_thread
+is the number of threads to use for the reverse sweeps
+and for the cppad.parallel coloring methods.
+
 \return
 This is the number of first order reverse sweeps used to compute
 the Jacobian.
@@ -490,7 +566,8 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
    sparse_rcv<SizeVector, BaseVector>&  subset   ,
    const sparse_rc<SizeVector>&         pattern  ,
    const std::string&                   coloring ,
-   sparse_jac_work&                     work     )
+   sparse_jac_work&                     work     ,
+   size_t                               n_thread )
 {  size_t m = Range();
    size_t n = Domain();
    //
@@ -544,7 +621,7 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
       bool transpose   = false;
       bool zero_empty  = false;
       bool input_empty = true;
-      local::sparse::list_setvec internal_pattern;
+      local::sparse::hybrid_setvec internal_pattern;
       internal_pattern.resize(m, n);
       local::sparse::set_internal_pattern(zero_empty, input_empty,
          transpose, internal_index, internal_pattern, pattern
@@ -552,8 +629,18 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
       //
       // execute coloring algorithm
       color.resize(m);
+      local::color_order_enum order_type;
       if( coloring == "cppad" )
          local::color_general_cppad(internal_pattern, row, col, color);
+      else if( local::color_parallel_order(coloring, order_type) )
+      {  CPPAD_ASSERT_KNOWN(
+            n_thread > 0,
+            "sparse_jac_rev: n_thread is zero"
+         );
+         local::color_general_parallel(
+            internal_pattern, row, col, color, order_type, n_thread
+         );
+      }
       else if( coloring == "colpack" )
       {
 # if CPPAD_HAS_COLPACK
@@ -590,6 +677,62 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
    for(size_t k = 0; k < K; k++)
       subset.set(k, zero);
    //
+   // n_thread
+   CPPAD_ASSERT_KNOWN(
+      n_thread > 0,
+      "sparse_jac_rev: n_thread is zero"
+   );
+   if( ! local::is_pod<Base>() )
+      n_thread = 1;
+   if( n_thread > 1 )
+   {  // atomic functions may not be thread safe
+      for(size_t i_op = 0; i_op < play_.num_op_rec(); ++i_op)
+         if( play_.GetOp(i_op) == local::AFunOp )
+            n_thread = 1;
+   }
+   if( n_thread > 1 )
+   {  // color_begin
+      // color_begin[c] is the index in order where the c-th color
+      // used by the subset begins and color_begin[n_used] = K
+      vector<size_t> color_begin;
+      for(size_t k = 0; k < K; ++k)
+      {  if( k == 0 )
+            color_begin.push_back(k);
+         else if( color[ row[order[k]] ] != color[ row[order[k-1]] ] )
+            color_begin.push_back(k);
+      }
+      color_begin.push_back(K);
+      size_t n_used = color_begin.size() - 1;
+      n_thread      = std::min(n_thread, n_used);
+      //
+      // partial: a separate partial derivative buffer for each thread
+      local::pod_vector_maybe<Base> partial(n_thread * num_var_tape_);
+      //
+      // team: threads other than the current thread
+      std::vector<std::thread> team;
+      for(size_t thread = 1; thread < n_thread; ++thread) team.push_back(
+         std::thread(
+            &ADFun::template sparse_jac_rev_thread<SizeVector, BaseVector>,
+            this,
+            thread,
+            n_thread,
+            std::cref(color),
+            std::cref(order),
+            std::cref(color_begin),
+            partial.data() + thread * num_var_tape_,
+            &subset
+         )
+      );
+      // current thread is thread zero
+      sparse_jac_rev_thread(
+         0, n_thread, color, order, color_begin, partial.data(), &subset
+      );
+      for(size_t thread = 1; thread < n_thread; ++thread)
+         team[thread - 1].join();
+      //
+      return n_color;
+   }
+   //
    // weighting vector and return values for calls to Reverse
    BaseVector w(m), dw(n);
    //
@@ -626,6 +769,108 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
    }
    return n_color;
 }
+// ----------------------------------------------------------------------------
+/*!
+Reverse sweeps for one thread during sparse_jac_rev
+
+\tparam Base
+the base type for the recording that is stored in the ADFun object.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param thread
+is the index of this thread (between zero and n_thread - 1).
+
+\param n_thread
+is the number of threads. This thread computes the colors with index
+c in color_begin such that c % n_thread == thread.
+
+\param color
+is the color for each row of the Jacobian.
+
+\param order
+is the indices that sort the subset row and col vectors by color.
+
+\param color_begin
+color_begin[c] is the index in order where the c-th color used by the subset
+begins. The last element of color_begin is the number of elements in subset.
+
+\param partial
+is a vector of length num_var_tape_ that is only used by this thread.
+The zero order Taylor coefficients in this ADFun object are used,
+but this ADFun object is not modified.
+
+\param subset
+On input, row and col specify the subset of the Jacobian.
+On output, the values corresponding to the colors for this thread are set.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+void ADFun<Base,RecBase>::sparse_jac_rev_thread(
+   size_t                               thread      ,
+   size_t                               n_thread    ,
+   const vector<size_t>&                color       ,
+   const vector<size_t>&                order       ,
+   const vector<size_t>&                color_begin ,
+   Base*                                partial     ,
+   sparse_rcv<SizeVector, BaseVector>*  subset      )
+{  // used to identify the RecBase type in calls to sweeps
+   RecBase not_used_rec_base(0.0);
+   //
+   // Base versions of zero and one
+   Base one(1.0);
+   Base zero(0.0);
+   //
+   size_t m = dep_taddr_.size();
+   size_t n = ind_taddr_.size();
+   //
+   // row and column vectors in subset
+   const SizeVector& row( subset->row() );
+   const SizeVector& col( subset->col() );
+   //
+   // loop over the colors for this thread
+   size_t n_used = color_begin.size() - 1;
+   for(size_t c = thread; c < n_used; c += n_thread)
+   {  size_t ell = color[ row[ order[ color_begin[c] ] ] ];
+      //
+      // combine all rows with this color
+      for(size_t i = 0; i < num_var_tape_; ++i)
+         partial[i] = zero;
+      for(size_t i = 0; i < m; ++i)
+      {  CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+         if( color[i] == ell )
+            partial[ dep_taddr_[i] ] += one;
+      }
+      //
+      // first order reverse sweep for all these rows at once
+      local::play::const_sequential_iterator play_itr = play_.end();
+      local::sweep::reverse(
+         0,
+         n,
+         num_var_tape_,
+         &play_,
+         cap_order_taylor_,
+         taylor_.data(),
+         1,
+         partial,
+         cskip_op_.data(),
+         load_op2var_,
+         play_itr,
+         not_used_rec_base
+      );
+      //
+      // set the corresponding components of the result
+      for(size_t k = color_begin[c]; k < color_begin[c+1]; ++k)
+      {  size_t j = col[ order[k] ];
+         subset->set( order[k], partial[ ind_taddr_[j] ] );
+      }
+   }
+   return;
+}
 
 } // END_CPPAD_NAMESPACE
 # endif
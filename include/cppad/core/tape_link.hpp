@@ -72,6 +72,31 @@ local::ADTape<Base>** AD<Base>::tape_handle(size_t thread)
    return tape_table + thread;
 }
 
+# if CPPAD_TAPE_THREAD_LOCAL
+/*!
+Handle for the tape for this AD<Base> class and the current
+operating system thread.
+
+\tparam Base
+is the base type for this AD<Base> class.
+
+\return
+is a handle for a thread_local copy of
+<tt>*tape_handle(thread)</tt> where
+\code
+   thread == thread_alloc::thread_num()
+\endcode
+The copy is set by tape_manage; i.e., when a tape is created or deleted.
+Hence each CppAD thread number must correspond to the same operating system
+thread from the start to the end of a recording.
+*/
+template <class Base>
+local::ADTape<Base>** AD<Base>::tape_thread_local(void)
+{  static thread_local local::ADTape<Base>* tape = nullptr;
+   return &tape;
+}
+# endif
+
 /*!
 Pointer for the tape for this AD<Base> class and the current thread.
 
@@ -87,11 +112,27 @@ is a pointer to the tape that is currently recording AD<Base> operations
 for the current thread.
 If this value is nullptr, there is no tape currently
 recording AD<Base> operations for this thread.
+
+\par CPPAD_TAPE_THREAD_LOCAL
+If this preprocessor symbol is true, the pointer is obtained from
+tape_thread_local instead of calling thread_alloc::thread_num.
 */
 template <class Base>
 local::ADTape<Base>* AD<Base>::tape_ptr(void)
-{  size_t thread = thread_alloc::thread_num();
+{
+# if CPPAD_TAPE_THREAD_LOCAL
+   // fast path: no call to thread_alloc::thread_num
+   local::ADTape<Base>* tape = *tape_thread_local();
+   CPPAD_ASSERT_KNOWN(
+      tape == *tape_handle( thread_alloc::thread_num() ),
+      "CPPAD_TAPE_THREAD_LOCAL is true and the thread_alloc::thread_num "
+      "value for this operating system thread changed during a recording"
+   );
+   return tape;
+# else
+   size_t thread = thread_alloc::thread_num();
    return *tape_handle(thread);
+# endif
 }
 
 /*!
@@ -223,6 +264,10 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_enum job)
       *tape_id_p  += CPPAD_MAX_NUM_THREADS;
    }
    // -----------------------------------------------------------------------
+# if CPPAD_TAPE_THREAD_LOCAL
+   // copy used by tape_ptr(void) for this operating system thread
+   *tape_thread_local() = *tape_h;
+# endif
    return *tape_h;
 }
 
@@ -0,0 +1,93 @@
+# ifndef CPPAD_CORE_TAPE_RESERVE_HPP
+# define CPPAD_CORE_TAPE_RESERVE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin tape_reserve}
+
+Reserve Memory for the Current Recording
+########################################
+
+Syntax
+******
+| ``AD`` < *Base* >:: ``tape_reserve`` ( *n_op* , *n_arg* , *n_par* )
+
+Purpose
+*******
+The operators, operator arguments, and parameters in a recording
+are stored in vectors that grow as the operations are recorded.
+If the size of the recording is known ahead of time,
+this routine can be used to allocate the memory once
+instead of repeatedly reallocating and copying it.
+This is useful when the same function is recorded many times;
+e.g., when an optimizer retapes at each iteration.
+
+Recording
+*********
+This must be called after the call to :ref:`Independent-name`
+that starts the recording for the current thread
+and before the recording is stopped.
+If there is no recording in progress for the current thread,
+this routine has no effect.
+
+n_op
+****
+This argument has prototype
+
+   ``size_t`` *n_op*
+
+It is a hint for the number of operators in the recording; see
+:ref:`fun_property@size_op` .
+
+n_arg
+*****
+This argument has prototype
+
+   ``size_t`` *n_arg*
+
+It is a hint for the number of operator arguments in the recording; see
+:ref:`fun_property@size_op_arg` .
+
+n_par
+*****
+This argument has prototype
+
+   ``size_t`` *n_par*
+
+It is a hint for the number of parameters in the recording; see
+:ref:`fun_property@size_par` .
+
+Hints
+*****
+These values do not affect the resulting recording.
+If a value is smaller than the final size, memory will be reallocated
+as necessary. If it is larger, the extra memory is not used
+and stays with the recording when it is transferred to an
+:ref:`ADFun-name` object.
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/tape_reserve.cpp
+}
+The file
+:ref:`tape_reserve.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end tape_reserve}
+----------------------------------------------------------------------------
+*/
+
+
+namespace CppAD {
+   template <class Base>
+   void AD<Base>::tape_reserve(size_t n_op, size_t n_arg, size_t n_par)
+   {  local::ADTape<Base>* tape = AD<Base>::tape_ptr();
+      if( tape != nullptr )
+         tape->Rec_.reserve(n_op, n_arg, n_par);
+   }
+}
+
+# endif
@@ -3,7 +3,7 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/core/ad_fun.hpp>
@@ -79,6 +79,56 @@ In the case of the Visual C++ compiler (``_MSC_VER`` is defined),
 ``__cdecl`` and ``__declspec(dllimport)`` are added to
 the function type definition.
 
+Derivative Functions
+********************
+The following functions are also defined by the C source code.
+They have the same calling sequence and function type as the
+:ref:`to_csrc@JIT Functions` and use the same
+:ref:`to_csrc@nu` independent values.
+Derivatives are with respect to all the components of *u* ; i.e.,
+the independent dynamic parameters as well as the independent variables.
+Discrete functions are treated as piecewise constant
+and their derivatives are zero.
+
+forward_one
+===========
+
+| *flag* = ``cppad_jit_`` *function_name* ``_forward_one`` (
+| |tab| 2 * *nu* , *ud* , 2 * *ny* , *yd* , *compare_change*
+| )
+
+The first *nu* elements of *ud* are the point *u* at which
+the function is evaluated and the next *nu* elements are a direction *du* .
+Upon return, the first *ny* elements of *yd* are
+the function value *y* and the next *ny* elements are the
+directional derivative :math:`f^{(1)} (u) du` .
+
+reverse_one
+===========
+
+| *flag* = ``cppad_jit_`` *function_name* ``_reverse_one`` (
+| |tab| *nu* + *ny* , *uw* , *nu* , *dw* , *compare_change*
+| )
+
+The first *nu* elements of *uw* are the point *u* and the
+next *ny* elements are a range space weighting vector *w* .
+Upon return, *dw* contains the gradient of
+:math:`w^\mathrm{T} f(u)` with respect to *u* .
+
+jacobian
+========
+
+| *flag* = ``cppad_jit_`` *function_name* ``_jacobian`` (
+| |tab| *nu* , *u* , *ny* * *nu* , *jac* , *compare_change*
+| )
+
+Upon return, *jac* contains the Jacobian :math:`f^{(1)} (u)`
+in row major order; i.e., for *i* less than *ny*
+and *j* less than *nu* ,
+*jac* [ *i* * *nu* + *j* ] is the partial of
+*y* [ *i* ] with respect to *u* [ *j* ] .
+This uses one reverse mode sweep for each dependent value.
+
 Atomic Callbacks
 ****************
 
@@ -136,6 +186,11 @@ flag
 ****
 If this is zero, no error was detected.
 If it is one (two), *nu* ( *ny* ) does not have its expected value.
+If it is three, an atomic callback reported that its arguments
+did not have the expected size.
+If it is four, the function *fun* uses an atomic function
+and a :ref:`to_csrc@Derivative Functions` was called
+(derivatives of atomic functions are not yet supported).
 
 Restrictions
 ************
@@ -148,6 +203,8 @@ Example
 *******
 The section :ref:`example_jit-name` contains examples and tests
 that use ``to_csrc`` .
+The example :ref:`jit_derivative.cpp-name` uses the
+derivative functions.
 
 {xrst_end to_csrc}
 */
@@ -15,6 +15,9 @@ Purpose
 The ``forward`` routine overrides the virtual functions
 used by the atomic_four base; see
 :ref:`forward<atomic_four_forward-name>` .
+The ``forward_ptr`` routine overrides the zero order
+pointer version of this virtual function; see
+:ref:`forward_ptr<atomic_four_forward_ptr-name>` .
 
 Source
 ******
@@ -89,6 +92,44 @@ bool atomic_mat_mul<Base>::forward(
    return true;
 }
 //
+// forward_ptr override for Base matrix multiply
+template <class Base>
+bool atomic_mat_mul<Base>::forward_ptr(
+   size_t                                     call_id     ,
+   const CppAD::vector<bool>&                 select_y    ,
+   size_t                                     n           ,
+   size_t                                     m           ,
+   const Base*                                taylor_x    ,
+   Base*                                      taylor_y    )
+{
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   //
+   // check sizes
+   assert( n == n_middle * ( n_left +  n_right ) );
+   assert( m == n_left * n_right );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // C = A * B
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  if( select_y[i * n_right + j] )
+         {  Base sum_ij = Base(0);
+            for(size_t k = 0; k < n_middle; ++k)
+            {  Base left_ik  = taylor_x[i * n_middle + k];
+               Base right_kj = taylor_x[offset + k * n_right + j];
+               sum_ij       += left_ik * right_kj;
+            }
+            taylor_y[i * n_right + j] = sum_ij;
+         }
+      }
+   }
+   return true;
+}
+//
 // forward override for AD<Base> matrix multiply
 template <class Base>
 bool atomic_mat_mul<Base>::forward(
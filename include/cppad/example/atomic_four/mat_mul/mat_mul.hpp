@@ -102,6 +102,16 @@ private:
       CppAD::vector< CppAD::AD<Base> >&                ataylor_y
    ) override;
    //
+   // Base forward_ptr
+   bool forward_ptr(
+      size_t                                           call_id,
+      const CppAD::vector<bool>&                       select_y,
+      size_t                                           n,
+      size_t                                           m,
+      const Base*                                      taylor_x,
+      Base*                                            taylor_y
+   ) override;
+   //
    // Base reverse
    bool reverse(
       size_t                                           call_id,
@@ -0,0 +1,621 @@
+# ifndef CPPAD_EXAMPLE_BASE_SIMD_PACK_HPP
+# define CPPAD_EXAMPLE_BASE_SIMD_PACK_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin base_simd_pack.hpp}
+{xrst_spell
+   avx
+   erfc
+   expm
+   simd
+   sse
+}
+
+Enable use of AD<Base> where Base is a Pack of SIMD Lanes
+#########################################################
+
+Syntax
+******
+| # ``include <cppad/example/base_simd_pack.hpp>``
+| ``CppAD::simd_pack`` < *Scalar* , *W* > *x*
+
+Purpose
+*******
+The type ``simd_pack`` < *Scalar* , *W* >
+holds *W* values of type *Scalar* (called lanes) and every operation
+acts on each lane independently.
+An ``ADFun`` < ``simd_pack`` < *Scalar* , *W* > > object evaluates
+*W* points, one per lane, during each sweep of its operation sequence;
+e.g., with *Scalar* equal to ``double`` ,
+*W* = 2, 4, 8 corresponds to the SSE, AVX2 and AVX-512 vector widths.
+When the compiler supports the GNU vector extensions,
+the arithmetic operators are implemented using them,
+otherwise they are implemented using a loop over the lanes.
+
+Scalar
+======
+This is either ``float`` or ``double`` .
+
+W
+=
+This is the number of lanes; i.e., the number of points evaluated
+during one sweep.
+
+Restrictions
+************
+The operation sequence is recorded once and used for all the lanes.
+Hence it must not depend on the lane:
+
+#. The index of a :ref:`VecAD-name` element must be the same for all
+   the lanes; see :ref:`base_simd_pack.hpp@Integer` below.
+#. Conditional skipping of operations must be turned off when
+   optimizing the function; i.e., the
+   :ref:`optimize@options` must contain ``no_conditional_skip`` .
+#. Conditional expressions (:ref:`CondExp-name` ) are evaluated
+   lane by lane. If the *left* and *right* operands are both constant
+   parameters, the comparison is done when the operation is recorded
+   and it must have the same result for all the lanes.
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/base_simd_pack.cpp
+}
+The file :ref:`base_simd_pack.cpp-name` contains an example and test
+using this type.
+The :ref:`speed_main@Global Options@simd` option of the
+:ref:`speed_cppad-name` program uses this type.
+
+Include Files
+*************
+This file is included before ``<cppad/cppad.hpp>`` ,
+but it needs to include parts of CppAD that are used by this file.
+This is done with the following include commands:
+{xrst_spell_off}
+{xrst_code cpp} */
+# include <ostream>
+# include <type_traits>
+# include <cppad/base_require.hpp>
+/* {xrst_code}
+{xrst_spell_on}
+
+Vector Extensions
+*****************
+The macro ``CPPAD_SIMD_PACK_VECTOR_EXTENSION`` is one (zero)
+if the GNU vector extensions are (are not) used:
+{xrst_spell_off}
+{xrst_code cpp} */
+# if defined(__GNUC__) || defined(__clang__)
+# define CPPAD_SIMD_PACK_VECTOR_EXTENSION 1
+# else
+# define CPPAD_SIMD_PACK_VECTOR_EXTENSION 0
+# endif
+/* {xrst_code}
+{xrst_spell_on}
+The vector type has the same alignment as *Scalar* so that
+arrays of ``simd_pack`` objects can use the CppAD memory allocator
+(which does not guarantee alignment larger than ``double`` ).
+
+Compound Assignment Macro
+*************************
+This macro is used for the ``simd_pack`` compound assignment operators;
+to be specific, used with *op* equal to
+``+=`` ,
+``-=`` ,
+``*=`` ,
+``/=`` .
+{xrst_spell_off}
+{xrst_code cpp} */
+# if CPPAD_SIMD_PACK_VECTOR_EXTENSION
+# define CPPAD_SIMD_PACK_ASSIGN_OPERATOR(op) \
+   simd_pack& operator op (const simd_pack& x) \
+   {  v_ op x.v_; \
+      return *this; \
+   }
+# else
+# define CPPAD_SIMD_PACK_ASSIGN_OPERATOR(op) \
+   simd_pack& operator op (const simd_pack& x) \
+   {  for(size_t k = 0; k < W; ++k) \
+         v_[k] op x.v_[k]; \
+      return *this; \
+   }
+# endif
+/* {xrst_code}
+{xrst_spell_on}
+
+Binary Operator Macro
+*********************
+This macro is used for the ``simd_pack`` binary operators; to be specific,
+used with *op* equal to
+``+`` ,
+``-`` ,
+``*`` ,
+``/`` .
+{xrst_spell_off}
+{xrst_code cpp} */
+# define CPPAD_SIMD_PACK_BINARY_OPERATOR(op) \
+   simd_pack operator op (const simd_pack& x) const \
+   {  simd_pack result(*this); \
+      result op##= x; \
+      return result; \
+   }
+/* {xrst_code}
+{xrst_spell_on}
+
+Boolean Operator Macro
+**********************
+This macro is used for the ``simd_pack`` binary operators that have a
+``bool`` result; to be specific, used with *op* equal to
+``==`` ,
+``<`` ,
+``<=`` ,
+``>=`` ,
+``>`` .
+The result is true if the relation is true for all the lanes.
+{xrst_spell_off}
+{xrst_code cpp} */
+# define CPPAD_SIMD_PACK_BOOL_OPERATOR(op) \
+   bool operator op (const simd_pack& x) const \
+   {  bool result = true; \
+      for(size_t k = 0; k < W; ++k) \
+         result &= (*this)[k] op x[k]; \
+      return result; \
+   }
+/* {xrst_code}
+{xrst_spell_on}
+
+Class Definition
+****************
+The following class defines the necessary :ref:`base_member-name` functions.
+The operator ``!=`` is the negation of ``==`` .
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   class simd_pack {
+   public:
+# if CPPAD_SIMD_PACK_VECTOR_EXTENSION
+      typedef Scalar vector_type __attribute__ ((
+         vector_size( W * sizeof(Scalar) ), aligned( sizeof(Scalar) )
+      ));
+# else
+      typedef Scalar vector_type[W];
+# endif
+   private:
+      vector_type v_;
+   public:
+      // constructors
+      simd_pack(void)
+      { }
+      simd_pack(const Scalar& s)
+      {  for(size_t k = 0; k < W; ++k)
+            v_[k] = s;
+      }
+      template <class Integer> explicit simd_pack(
+         Integer i ,
+         typename std::enable_if<
+            std::is_integral<Integer>::value
+         >::type* = nullptr
+      )
+      {  for(size_t k = 0; k < W; ++k)
+            v_[k] = Scalar(i);
+      }
+      simd_pack(const simd_pack& x)
+      {  *this = x; }
+      // number of lanes
+      static size_t size(void)
+      {  return W; }
+      // access one lane
+      Scalar& operator[](size_t k)
+      {  return reinterpret_cast<Scalar*>(&v_)[k]; }
+      const Scalar& operator[](size_t k) const
+      {  return reinterpret_cast<const Scalar*>(&v_)[k]; }
+      // assignment
+      simd_pack& operator=(const simd_pack& x)
+      {
+# if CPPAD_SIMD_PACK_VECTOR_EXTENSION
+         v_ = x.v_;
+# else
+         for(size_t k = 0; k < W; ++k)
+            v_[k] = x.v_[k];
+# endif
+         return *this;
+      }
+      // unary operators
+      simd_pack operator-(void) const
+      {  simd_pack result;
+         for(size_t k = 0; k < W; ++k)
+            result[k] = - (*this)[k];
+         return result;
+      }
+      simd_pack operator+(void) const
+      {  return *this; }
+      CPPAD_SIMD_PACK_ASSIGN_OPERATOR(+=)
+      CPPAD_SIMD_PACK_ASSIGN_OPERATOR(-=)
+      CPPAD_SIMD_PACK_ASSIGN_OPERATOR(*=)
+      CPPAD_SIMD_PACK_ASSIGN_OPERATOR(/=)
+      CPPAD_SIMD_PACK_BINARY_OPERATOR(+)
+      CPPAD_SIMD_PACK_BINARY_OPERATOR(-)
+      CPPAD_SIMD_PACK_BINARY_OPERATOR(*)
+      CPPAD_SIMD_PACK_BINARY_OPERATOR(/)
+      // bool operators
+      CPPAD_SIMD_PACK_BOOL_OPERATOR(==)
+      bool operator!=(const simd_pack& x) const
+      {  return ! (*this == x); }
+      CPPAD_SIMD_PACK_BOOL_OPERATOR(<)
+      CPPAD_SIMD_PACK_BOOL_OPERATOR(<=)
+      CPPAD_SIMD_PACK_BOOL_OPERATOR(>=)
+      CPPAD_SIMD_PACK_BOOL_OPERATOR(>)
+   };
+}
+# undef CPPAD_SIMD_PACK_ASSIGN_OPERATOR
+# undef CPPAD_SIMD_PACK_BINARY_OPERATOR
+# undef CPPAD_SIMD_PACK_BOOL_OPERATOR
+/* {xrst_code}
+{xrst_spell_on}
+
+Output
+******
+The lanes are written in the form { *x0* , *x1* , ... } :
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   std::ostream& operator<<(std::ostream& os, const simd_pack<Scalar, W>& x)
+   {  os << "{ ";
+      for(size_t k = 0; k < W; ++k)
+      {  if( k > 0 )
+            os << ", ";
+         os << x[k];
+      }
+      os << " }";
+      return os;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+CondExpOp
+*********
+The conditional expression is evaluated lane by lane
+so that each lane can choose a different case:
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   simd_pack<Scalar, W> CondExpOp(
+      enum CompareOp               cop          ,
+      const simd_pack<Scalar, W>&  left         ,
+      const simd_pack<Scalar, W>&  right        ,
+      const simd_pack<Scalar, W>&  exp_if_true  ,
+      const simd_pack<Scalar, W>&  exp_if_false )
+   {  simd_pack<Scalar, W> result;
+      for(size_t k = 0; k < W; ++k) result[k] = CondExpTemplate(
+         cop, left[k], right[k], exp_if_true[k], exp_if_false[k]
+      );
+      return result;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+CondExpRel
+**********
+The :ref:`CPPAD_COND_EXP_REL<base_cond_exp@CondExpRel>` macro
+is for a specific type, so the corresponding templates are defined here:
+{xrst_spell_off}
+{xrst_code cpp} */
+# define CPPAD_SIMD_PACK_COND_EXP_REL(Rel, Op) \
+   template <class Scalar, size_t W> \
+   simd_pack<Scalar, W> CondExp##Rel( \
+      const simd_pack<Scalar, W>& left         , \
+      const simd_pack<Scalar, W>& right        , \
+      const simd_pack<Scalar, W>& exp_if_true  , \
+      const simd_pack<Scalar, W>& exp_if_false ) \
+   {  return CondExpOp(Op, left, right, exp_if_true, exp_if_false); \
+   }
+namespace CppAD {
+   CPPAD_SIMD_PACK_COND_EXP_REL(Lt, CompareLt)
+   CPPAD_SIMD_PACK_COND_EXP_REL(Le, CompareLe)
+   CPPAD_SIMD_PACK_COND_EXP_REL(Eq, CompareEq)
+   CPPAD_SIMD_PACK_COND_EXP_REL(Ge, CompareGe)
+   CPPAD_SIMD_PACK_COND_EXP_REL(Gt, CompareGt)
+}
+# undef CPPAD_SIMD_PACK_COND_EXP_REL
+/* {xrst_code}
+{xrst_spell_on}
+
+EqualOpSeq
+**********
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   bool EqualOpSeq(
+      const simd_pack<Scalar, W>& x, const simd_pack<Scalar, W>& y)
+   {  return x == y; }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+Identical
+*********
+A value is identically zero (one) if all of its lanes are zero (one):
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   bool IdenticalCon(const simd_pack<Scalar, W>&)
+   {  return true; }
+   template <class Scalar, size_t W>
+   bool IdenticalZero(const simd_pack<Scalar, W>& x)
+   {  return x == simd_pack<Scalar, W>( Scalar(0) ); }
+   template <class Scalar, size_t W>
+   bool IdenticalOne(const simd_pack<Scalar, W>& x)
+   {  return x == simd_pack<Scalar, W>( Scalar(1) ); }
+   template <class Scalar, size_t W>
+   bool IdenticalEqualCon(
+      const simd_pack<Scalar, W>& x, const simd_pack<Scalar, W>& y)
+   {  return x == y; }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+Integer
+*******
+The integer value of a pack is the integer value of its first lane.
+It is an error (when ``NDEBUG`` is not defined)
+for the lanes to have different integer values:
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   int Integer(const simd_pack<Scalar, W>& x)
+   {  int result = static_cast<int>( x[0] );
+# ifndef NDEBUG
+      for(size_t k = 1; k < W; ++k) CPPAD_ASSERT_KNOWN(
+         static_cast<int>( x[k] ) == result,
+         "Integer: simd_pack lanes have different integer values"
+      );
+# endif
+      return result;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+azmul
+*****
+The :ref:`CPPAD_AZMUL<base_require@Absolute Zero, azmul>` macro
+is for a specific type, so the lane by lane version is defined here:
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   simd_pack<Scalar, W> azmul(
+      const simd_pack<Scalar, W>& x, const simd_pack<Scalar, W>& y)
+   {  simd_pack<Scalar, W> result;
+      for(size_t k = 0; k < W; ++k)
+         result[k] = x[k] == Scalar(0) ? Scalar(0) : x[k] * y[k];
+      return result;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+Ordered
+*******
+The functions below are true if the corresponding relation is true
+for any of the lanes.
+Hence a :ref:`compare_change-name` is reported if a comparison
+changes for any lane.
+The function ``abs_geq`` is true if it is true for all the lanes:
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   bool GreaterThanZero(const simd_pack<Scalar, W>& x)
+   {  bool result = false;
+      for(size_t k = 0; k < W; ++k)
+         result |= x[k] > Scalar(0);
+      return result;
+   }
+   template <class Scalar, size_t W>
+   bool GreaterThanOrZero(const simd_pack<Scalar, W>& x)
+   {  bool result = false;
+      for(size_t k = 0; k < W; ++k)
+         result |= x[k] >= Scalar(0);
+      return result;
+   }
+   template <class Scalar, size_t W>
+   bool LessThanZero(const simd_pack<Scalar, W>& x)
+   {  bool result = false;
+      for(size_t k = 0; k < W; ++k)
+         result |= x[k] < Scalar(0);
+      return result;
+   }
+   template <class Scalar, size_t W>
+   bool LessThanOrZero(const simd_pack<Scalar, W>& x)
+   {  bool result = false;
+      for(size_t k = 0; k < W; ++k)
+         result |= x[k] <= Scalar(0);
+      return result;
+   }
+   template <class Scalar, size_t W>
+   bool abs_geq(const simd_pack<Scalar, W>& x, const simd_pack<Scalar, W>& y)
+   {  bool result = true;
+      for(size_t k = 0; k < W; ++k)
+         result &= std::fabs(x[k]) >= std::fabs(y[k]);
+      return result;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+Unary Standard Math
+*******************
+The following macro defines a unary standard math function
+that evaluates the corresponding ``std`` function for each lane:
+{xrst_spell_off}
+{xrst_code cpp} */
+# define CPPAD_SIMD_PACK_UNARY(Fun) \
+   template <class Scalar, size_t W> \
+   simd_pack<Scalar, W> Fun(const simd_pack<Scalar, W>& x) \
+   {  simd_pack<Scalar, W> result; \
+      for(size_t k = 0; k < W; ++k) \
+         result[k] = std::Fun( x[k] ); \
+      return result; \
+   }
+namespace CppAD {
+   CPPAD_SIMD_PACK_UNARY(acos)
+   CPPAD_SIMD_PACK_UNARY(acosh)
+   CPPAD_SIMD_PACK_UNARY(asin)
+   CPPAD_SIMD_PACK_UNARY(asinh)
+   CPPAD_SIMD_PACK_UNARY(atan)
+   CPPAD_SIMD_PACK_UNARY(atanh)
+   CPPAD_SIMD_PACK_UNARY(cos)
+   CPPAD_SIMD_PACK_UNARY(cosh)
+   CPPAD_SIMD_PACK_UNARY(erf)
+   CPPAD_SIMD_PACK_UNARY(erfc)
+   CPPAD_SIMD_PACK_UNARY(exp)
+   CPPAD_SIMD_PACK_UNARY(expm1)
+   CPPAD_SIMD_PACK_UNARY(fabs)
+   CPPAD_SIMD_PACK_UNARY(log)
+   CPPAD_SIMD_PACK_UNARY(log1p)
+   CPPAD_SIMD_PACK_UNARY(log10)
+   CPPAD_SIMD_PACK_UNARY(sin)
+   CPPAD_SIMD_PACK_UNARY(sinh)
+   CPPAD_SIMD_PACK_UNARY(sqrt)
+   CPPAD_SIMD_PACK_UNARY(tan)
+   CPPAD_SIMD_PACK_UNARY(tanh)
+}
+# undef CPPAD_SIMD_PACK_UNARY
+/* {xrst_code}
+{xrst_spell_on}
+
+abs
+***
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   simd_pack<Scalar, W> abs(const simd_pack<Scalar, W>& x)
+   {  return fabs(x); }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+sign
+****
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   simd_pack<Scalar, W> sign(const simd_pack<Scalar, W>& x)
+   {  simd_pack<Scalar, W> result;
+      for(size_t k = 0; k < W; ++k)
+      {  if( x[k] > Scalar(0) )
+            result[k] = Scalar(1);
+         else if( x[k] == Scalar(0) )
+            result[k] = Scalar(0);
+         else
+            result[k] = Scalar(-1);
+      }
+      return result;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+pow
+***
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   simd_pack<Scalar, W> pow(
+      const simd_pack<Scalar, W>& x, const simd_pack<Scalar, W>& y)
+   {  simd_pack<Scalar, W> result;
+      for(size_t k = 0; k < W; ++k)
+         result[k] = std::pow(x[k], y[k]);
+      return result;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+isnan
+*****
+A pack is nan if any of its lanes is nan:
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   bool isnan(const simd_pack<Scalar, W>& x)
+   {  bool result = false;
+      for(size_t k = 0; k < W; ++k)
+         result |= x[k] != x[k];
+      return result;
+   }
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+numeric_limits
+**************
+The :ref:`CPPAD_NUMERIC_LIMITS<base_limits-name>` macro
+is for a specific type, so the corresponding template is defined here:
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   class numeric_limits< simd_pack<Scalar, W> > {
+   public:
+      static simd_pack<Scalar, W> min(void)
+      {  return std::numeric_limits<Scalar>::min(); }
+      static simd_pack<Scalar, W> max(void)
+      {  return std::numeric_limits<Scalar>::max(); }
+      static simd_pack<Scalar, W> epsilon(void)
+      {  return std::numeric_limits<Scalar>::epsilon(); }
+      static simd_pack<Scalar, W> quiet_NaN(void)
+      {  return std::numeric_limits<Scalar>::quiet_NaN(); }
+      static simd_pack<Scalar, W> infinity(void)
+      {  return std::numeric_limits<Scalar>::infinity(); }
+      static const int digits10 = std::numeric_limits<Scalar>::digits10;
+   };
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+to_string
+*********
+The :ref:`CPPAD_TO_STRING<base_to_string-name>` macro
+is for a specific type, so the corresponding template is defined here:
+{xrst_spell_off}
+{xrst_code cpp} */
+namespace CppAD {
+   template <class Scalar, size_t W>
+   struct to_string_struct< simd_pack<Scalar, W> >
+   {  std::string operator()(const simd_pack<Scalar, W>& value)
+      {  std::stringstream os;
+         int n_digits = 1 + std::numeric_limits<Scalar>::digits10;
+         os << std::setprecision(n_digits);
+         os << value;
+         return os.str();
+      }
+   };
+}
+/* {xrst_code}
+{xrst_spell_on}
+
+hash_code
+*********
+The :ref:`base_hash@Default` hashing function, which uses the bits
+corresponding to all the lanes, is used for this type.
+
+{xrst_end base_simd_pack.hpp}
+*/
+# endif
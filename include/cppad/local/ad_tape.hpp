@@ -138,6 +138,15 @@ public:
       ADBaseVector&   dynamic
    );
 
+   // public function only used by CppAD::mul_add_vec
+   template <class BaseVector, class ADBaseVector>
+   void mul_add_vec(
+      const BaseVector&     a ,
+      const ADBaseVector&   x ,
+      const BaseVector&     b ,
+      ADBaseVector&         y
+   );
+
 };
 // ---------------------------------------------------------------------------
 // Private functions
@@ -0,0 +1,675 @@
+# ifndef CPPAD_LOCAL_COLOR_PARALLEL_HPP
+# define CPPAD_LOCAL_COLOR_PARALLEL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <atomic>
+# include <thread>
+# include <vector>
+# include <string>
+# include <algorithm>
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/index_sort.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file color_parallel.hpp
+Speculative parallel coloring algorithm for a general sparse matrix.
+*/
+
+/// order in which color_general_parallel colors the rows
+enum color_order_enum {
+   /// decreasing number of neighbors
+   largest_first_enum,
+   /// reverse of the order in which minimum degree rows are removed
+   smallest_last_enum,
+   /// maximum number of neighbors that have already been ordered
+   incidence_degree_enum
+};
+// --------------------------------------------------------------------------
+/*!
+Check for one of the cppad.parallel coloring methods.
+
+\param coloring
+is the coloring argument to sparse_jac_for, sparse_jac_rev, or sparse_hes.
+
+\param order [out]
+If the return value is true, this is the ordering that corresponds to
+coloring. Otherwise, it is not modified.
+
+\return
+is true if coloring is cppad.parallel, cppad.parallel.largest_first,
+cppad.parallel.smallest_last, or cppad.parallel.incidence_degree.
+*/
+inline bool color_parallel_order(
+   const std::string& coloring ,
+   color_order_enum&  order    )
+{  if( coloring == "cppad.parallel" )
+   {  order = largest_first_enum;
+      return true;
+   }
+   if( coloring == "cppad.parallel.largest_first" )
+   {  order = largest_first_enum;
+      return true;
+   }
+   if( coloring == "cppad.parallel.smallest_last" )
+   {  order = smallest_last_enum;
+      return true;
+   }
+   if( coloring == "cppad.parallel.incidence_degree" )
+   {  order = incidence_degree_enum;
+      return true;
+   }
+   return false;
+}
+// --------------------------------------------------------------------------
+/*!
+Distance two graph used by color_general_parallel.
+
+Two rows i != r are neighbors if there is a column j such that
+(i, j) is needed and (r, j) is in the sparsity pattern,
+or (r, j) is needed and (i, j) is in the sparsity pattern.
+Neighbors must have different colors.
+All the information is stored in compressed row and compressed column form
+so that it can be read by multiple threads at the same time.
+*/
+class color_graph {
+public:
+   /// number of rows
+   size_t n_row_;
+   /// number of columns
+   size_t n_col_;
+   /// pattern_row_start_[i] is the start, in pattern_col_, for row i
+   std::vector<size_t> pattern_row_start_;
+   /// column indices for the sparsity pattern in row major order
+   std::vector<size_t> pattern_col_;
+   /// pattern_col_start_[j] is the start, in pattern_row_, for column j
+   std::vector<size_t> pattern_col_start_;
+   /// row indices for the sparsity pattern in column major order
+   std::vector<size_t> pattern_row_;
+   /// need_row_start_[i] is the start, in need_col_, for row i
+   std::vector<size_t> need_row_start_;
+   /// column indices for the needed entries in row major order
+   std::vector<size_t> need_col_;
+   /// need_col_start_[j] is the start, in need_row_, for column j
+   std::vector<size_t> need_col_start_;
+   /// row indices for the needed entries in column major order
+   std::vector<size_t> need_row_;
+   // -----------------------------------------------------------------------
+   /*!
+   Compressed row and column form for a set of (row, column) pairs.
+
+   \param row
+   row indices for the pairs.
+
+   \param col
+   column indices for the pairs (same size as row).
+
+   \param row_start [out]
+   row_start[i] is the start of row i in row_major and
+   row_start[n_row_] is the number of pairs.
+
+   \param row_major [out]
+   column indices for the pairs in row major order.
+
+   \param col_start [out]
+   col_start[j] is the start of column j in col_major and
+   col_start[n_col_] is the number of pairs.
+
+   \param col_major [out]
+   row indices for the pairs in column major order.
+   */
+   template <class SizeVector>
+   void compress(
+      const SizeVector&     row       ,
+      const SizeVector&     col       ,
+      std::vector<size_t>&  row_start ,
+      std::vector<size_t>&  row_major ,
+      std::vector<size_t>&  col_start ,
+      std::vector<size_t>&  col_major )
+   {  size_t K = size_t( row.size() );
+      CPPAD_ASSERT_UNKNOWN( size_t( col.size() ) == K );
+      //
+      // count the number of pairs in each row and column
+      row_start.assign(n_row_ + 1, 0);
+      col_start.assign(n_col_ + 1, 0);
+      for(size_t k = 0; k < K; ++k)
+      {  ++row_start[ row[k] + 1 ];
+         ++col_start[ col[k] + 1 ];
+      }
+      for(size_t i = 0; i < n_row_; ++i)
+         row_start[i + 1] += row_start[i];
+      for(size_t j = 0; j < n_col_; ++j)
+         col_start[j + 1] += col_start[j];
+      //
+      // fill in row_major and col_major
+      std::vector<size_t> row_next(row_start.begin(), row_start.end() - 1);
+      std::vector<size_t> col_next(col_start.begin(), col_start.end() - 1);
+      row_major.resize(K);
+      col_major.resize(K);
+      for(size_t k = 0; k < K; ++k)
+      {  row_major[ row_next[ row[k] ]++ ] = col[k];
+         col_major[ col_next[ col[k] ]++ ] = row[k];
+      }
+   }
+   // -----------------------------------------------------------------------
+   /*!
+   Construct the graph for a sparsity pattern and the requested entries.
+
+   \param pattern
+   is the sparsity pattern for the matrix.
+
+   \param row
+   is the row indices for the entries that are needed.
+
+   \param col
+   is the column indices for the entries that are needed.
+   */
+   template <class SetVector, class SizeVector>
+   color_graph(
+      const SetVector&   pattern ,
+      const SizeVector&  row     ,
+      const SizeVector&  col     )
+   : n_row_( pattern.n_set() ), n_col_( pattern.end() )
+   {  // pattern_row, pattern_col
+      std::vector<size_t> pattern_row, pattern_col;
+      for(size_t i = 0; i < n_row_; ++i)
+      {  typename SetVector::const_iterator itr(pattern, i);
+         size_t j = *itr;
+         while( j != pattern.end() )
+         {  pattern_row.push_back(i);
+            pattern_col.push_back(j);
+            j = *(++itr);
+         }
+      }
+      compress(pattern_row, pattern_col,
+         pattern_row_start_, pattern_col_, pattern_col_start_, pattern_row_
+      );
+      compress(row, col,
+         need_row_start_, need_col_, need_col_start_, need_row_
+      );
+   }
+   // -----------------------------------------------------------------------
+   /// does this row have any needed entries
+   bool appear(size_t i) const
+   {  return need_row_start_[i] < need_row_start_[i + 1]; }
+   // -----------------------------------------------------------------------
+   /*!
+   Visit the neighbors of a row.
+
+   \param i
+   is the row index.
+
+   \param visit
+   is called with argument r for each neighbor r of row i.
+   It may be called more than once for the same neighbor
+   and it may be called with r == i.
+   */
+   template <class Visit>
+   void neighbor(size_t i, Visit& visit) const
+   {  // rows that are non-zero where row i has a needed entry
+      for(size_t k = need_row_start_[i]; k < need_row_start_[i + 1]; ++k)
+      {  size_t j = need_col_[k];
+         size_t end = pattern_col_start_[j + 1];
+         for(size_t ell = pattern_col_start_[j]; ell < end; ++ell)
+            visit( pattern_row_[ell] );
+      }
+      // rows that need an entry where row i is non-zero
+      for(size_t k = pattern_row_start_[i]; k < pattern_row_start_[i + 1]; ++k)
+      {  size_t j = pattern_col_[k];
+         size_t end = need_col_start_[j + 1];
+         for(size_t ell = need_col_start_[j]; ell < end; ++ell)
+            visit( need_row_[ell] );
+      }
+   }
+};
+// --------------------------------------------------------------------------
+/*!
+Doubly linked lists of rows where each list corresponds to a degree.
+*/
+class color_bucket {
+private:
+   /// value used for the end of a list
+   const size_t nil_;
+   /// first_[d] is the first row with degree d
+   std::vector<size_t> first_;
+   /// next_[i] is the row after row i in its list
+   std::vector<size_t> next_;
+   /// previous_[i] is the row before row i in its list
+   std::vector<size_t> previous_;
+   /// degree_[i] is the degree (list) for row i
+   std::vector<size_t> degree_;
+public:
+   /// all lists are initially empty
+   color_bucket(size_t n_row)
+   : nil_(n_row)
+   , first_(n_row + 1, n_row)
+   , next_(n_row, n_row)
+   , previous_(n_row, n_row)
+   , degree_(n_row, n_row)
+   { }
+   /// first row with degree d
+   size_t first(size_t d) const
+   {  return first_[d]; }
+   /// is this the end of a list
+   bool nil(size_t i) const
+   {  return i == nil_; }
+   /// current degree for row i
+   size_t degree(size_t i) const
+   {  return degree_[i]; }
+   /// add row i to the list for degree d
+   void insert(size_t i, size_t d)
+   {  CPPAD_ASSERT_UNKNOWN( d < first_.size() );
+      degree_[i]   = d;
+      previous_[i] = nil_;
+      next_[i]     = first_[d];
+      if( next_[i] != nil_ )
+         previous_[ next_[i] ] = i;
+      first_[d] = i;
+   }
+   /// remove row i from its list
+   void remove(size_t i)
+   {  size_t d = degree_[i];
+      if( previous_[i] == nil_ )
+         first_[d] = next_[i];
+      else
+         next_[ previous_[i] ] = next_[i];
+      if( next_[i] != nil_ )
+         previous_[ next_[i] ] = previous_[i];
+   }
+};
+// --------------------------------------------------------------------------
+/*!
+Determine the order in which color_general_parallel colors the rows.
+
+\param graph
+is the distance two graph for the rows.
+
+\param order_type
+is the type of ordering.
+
+\param row_order [out]
+the input size does not matter. Upon return it contains
+the rows that appear in the order they should be colored.
+*/
+inline void color_parallel_ordering(
+   const color_graph&      graph      ,
+   color_order_enum        order_type ,
+   std::vector<size_t>&    row_order  )
+{  size_t m = graph.n_row_;
+   //
+   // appear_list
+   std::vector<size_t> appear_list;
+   for(size_t i = 0; i < m; ++i)
+      if( graph.appear(i) )
+         appear_list.push_back(i);
+   size_t n_appear = appear_list.size();
+   //
+   // neighbor_list
+   // distinct neighbors, that appear, for the row mark_row
+   size_t mark_row = m;
+   std::vector<size_t> mark(m, m), neighbor_list;
+   auto add_neighbor = [&](size_t r)
+   {  if( r != mark_row && mark[r] != mark_row && graph.appear(r) )
+      {  mark[r] = mark_row;
+         neighbor_list.push_back(r);
+      }
+   };
+   //
+   // degree
+   std::vector<size_t> degree(m, 0);
+   for(size_t i : appear_list)
+   {  mark_row = i;
+      neighbor_list.clear();
+      graph.neighbor(i, add_neighbor);
+      degree[i] = neighbor_list.size();
+   }
+   //
+   row_order.resize(n_appear);
+   switch( order_type )
+   {  // ------------------------------------------------------------------
+      case largest_first_enum:
+      {  CppAD::vector<size_t> key(n_appear), index(n_appear);
+         for(size_t k = 0; k < n_appear; ++k)
+            key[k] = m - degree[ appear_list[k] ];
+         CppAD::index_sort(key, index);
+         for(size_t k = 0; k < n_appear; ++k)
+            row_order[k] = appear_list[ index[k] ];
+      }
+      break;
+      // ------------------------------------------------------------------
+      case smallest_last_enum:
+      {  // remove the row with minimum degree, in the graph of rows that
+         // have not been removed, and place it last in the order
+         color_bucket bucket(m);
+         std::vector<bool> removed(m, false);
+         for(size_t i : appear_list)
+            bucket.insert(i, degree[i]);
+         size_t d_min = 0;
+         for(size_t k = n_appear; k > 0; --k)
+         {  while( bucket.nil( bucket.first(d_min) ) )
+               ++d_min;
+            size_t i = bucket.first(d_min);
+            bucket.remove(i);
+            removed[i]       = true;
+            row_order[k - 1] = i;
+            //
+            mark_row = i;
+            neighbor_list.clear();
+            graph.neighbor(i, add_neighbor);
+            for(size_t r : neighbor_list) if( ! removed[r] )
+            {  size_t d = bucket.degree(r);
+               CPPAD_ASSERT_UNKNOWN( 0 < d );
+               bucket.remove(r);
+               bucket.insert(r, d - 1);
+               d_min = std::min(d_min, d - 1);
+            }
+         }
+      }
+      break;
+      // ------------------------------------------------------------------
+      case incidence_degree_enum:
+      {  // next row is the one with the most neighbors already in the order
+         // (rows are inserted so that ties go to the lower row index)
+         color_bucket bucket(m);
+         std::vector<bool> placed(m, false);
+         for(size_t k = n_appear; k > 0; --k)
+            bucket.insert(appear_list[k - 1], 0);
+         size_t d_max = 0;
+         for(size_t k = 0; k < n_appear; ++k)
+         {  while( bucket.nil( bucket.first(d_max) ) )
+            {  CPPAD_ASSERT_UNKNOWN( 0 < d_max );
+               --d_max;
+            }
+            size_t i = bucket.first(d_max);
+            bucket.remove(i);
+            placed[i]    = true;
+            row_order[k] = i;
+            //
+            mark_row = i;
+            neighbor_list.clear();
+            graph.neighbor(i, add_neighbor);
+            for(size_t r : neighbor_list) if( ! placed[r] )
+            {  size_t d = bucket.degree(r);
+               bucket.remove(r);
+               bucket.insert(r, d + 1);
+               d_max = std::max(d_max, d + 1);
+            }
+         }
+      }
+      break;
+   }
+}
+// --------------------------------------------------------------------------
+/// information used by one thread during color_general_parallel
+struct color_thread_info {
+   /// forbidden[c] == stamp means color c is forbidden for the current row
+   std::vector<size_t> forbidden;
+   /// different value for each row that this thread colors
+   size_t stamp;
+   /// rows that this thread found must be colored again
+   std::vector<size_t> conflict;
+};
+/*!
+Tentative coloring of a block of rows.
+
+\param graph
+is the distance two graph for the rows.
+
+\param work_list
+is the list of rows that are being colored.
+
+\param begin
+is the index in work_list of the first row in this block.
+
+\param end
+is the index in work_list of one past the last row in this block.
+
+\param color
+is the current color for every row, m is used for no color.
+Other threads may read and write the colors for other rows at the same time.
+Upon return, the rows in this block have been given the smallest color
+that was not used by any of its neighbors (when the row was colored).
+
+\param info
+is the information for the thread that is doing this coloring.
+*/
+inline void color_parallel_assign(
+   const color_graph*                   graph     ,
+   const std::vector<size_t>*           work_list ,
+   size_t                               begin     ,
+   size_t                               end       ,
+   std::vector< std::atomic<size_t> >*  color     ,
+   color_thread_info*                   info      )
+{  size_t m                        = graph->n_row_;
+   std::vector<size_t>& forbidden  = info->forbidden;
+   std::vector< std::atomic<size_t> >& color_ref = *color;
+   //
+   size_t i = m;
+   auto forbid = [&](size_t r)
+   {  size_t c = color_ref[r].load(std::memory_order_relaxed);
+      if( r != i && c < m )
+      {  CPPAD_ASSERT_UNKNOWN( c < forbidden.size() );
+         forbidden[c] = info->stamp;
+      }
+   };
+   for(size_t k = begin; k < end; ++k)
+   {  i = (*work_list)[k];
+      ++(info->stamp);
+      graph->neighbor(i, forbid);
+      size_t c = 0;
+      while( forbidden[c] == info->stamp )
+         ++c;
+      color_ref[i].store(c, std::memory_order_relaxed);
+   }
+}
+/*!
+Detect conflicts in a block of rows.
+
+\param graph
+is the distance two graph for the rows.
+
+\param work_list
+is the list of rows that are being colored.
+
+\param begin
+is the index in work_list of the first row in this block.
+
+\param end
+is the index in work_list of one past the last row in this block.
+
+\param rank
+is the position of each row in the coloring order.
+
+\param color
+is the current color for every row (it is not modified by any thread).
+
+\param info
+Upon return, info->conflict is the list of rows in this block that
+have the same color as a neighbor that comes before it in the order.
+*/
+inline void color_parallel_conflict(
+   const color_graph*                         graph     ,
+   const std::vector<size_t>*                 work_list ,
+   size_t                                     begin     ,
+   size_t                                     end       ,
+   const std::vector<size_t>*                 rank      ,
+   const std::vector< std::atomic<size_t> >*  color     ,
+   color_thread_info*                         info      )
+{  const std::vector< std::atomic<size_t> >& color_ref = *color;
+   //
+   size_t i = graph->n_row_, color_i = 0;
+   bool   conflict = false;
+   auto check = [&](size_t r)
+   {  if( r != i && (*rank)[r] < (*rank)[i] )
+         conflict |= color_ref[r].load(std::memory_order_relaxed) == color_i;
+   };
+   info->conflict.clear();
+   for(size_t k = begin; k < end; ++k)
+   {  i        = (*work_list)[k];
+      color_i  = color_ref[i].load(std::memory_order_relaxed);
+      conflict = false;
+      graph->neighbor(i, check);
+      if( conflict )
+         info->conflict.push_back(i);
+   }
+}
+// --------------------------------------------------------------------------
+/*!
+Speculative parallel version of color_general_cppad.
+
+\tparam SetVector
+is a vector_of_sets class.
+
+\tparam SizeVector
+is a simple vector class with elements of type size_t.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix.
+
+\param row [in]
+is a vector specifying which row indices to compute.
+
+\param col [in]
+is a vector, with the same size as row,
+that specifies which column indices to compute.
+
+\param color [out]
+is a vector with size m; see color_general_cppad.
+
+\param order_type [in]
+determines the order in which the rows are colored.
+
+\param n_thread [in]
+is the number of threads (including the current thread)
+used to color the rows.
+The rows are colored in rounds. During each round,
+the rows that still need a color are split into n_thread blocks,
+each thread colors a block without waiting for the other threads,
+and then each thread checks its block for rows that have the same
+color as a neighbor that comes before it in the order.
+Those rows are colored again during the next round.
+If n_thread is one, this is the greedy coloring algorithm
+using the specified order.
+*/
+template <class SetVector, class SizeVector>
+void color_general_parallel(
+   const SetVector&        pattern    ,
+   const SizeVector&       row        ,
+   const SizeVector&       col        ,
+   CppAD::vector<size_t>&  color      ,
+   color_order_enum        order_type ,
+   size_t                  n_thread   )
+{  size_t m = pattern.n_set();
+   CPPAD_ASSERT_UNKNOWN( size_t( row.size() ) == size_t( col.size() ) );
+   CPPAD_ASSERT_UNKNOWN( size_t( color.size() ) == m );
+   CPPAD_ASSERT_UNKNOWN( 0 < n_thread );
+# ifndef NDEBUG
+   for(size_t k = 0; k < size_t( row.size() ); ++k)
+   {  CPPAD_ASSERT_KNOWN( pattern.is_element(row[k], col[k]) ,
+         "color_general_parallel: requesting value for a matrix element\n"
+         "that is not in the matrice's sparsity pattern.\n"
+         "Such a value must be zero."
+      );
+   }
+# endif
+   //
+   // graph
+   color_graph graph(pattern, row, col);
+   //
+   // work_list, rank
+   std::vector<size_t> work_list;
+   color_parallel_ordering(graph, order_type, work_list);
+   size_t n_appear = work_list.size();
+   std::vector<size_t> rank(m, m);
+   for(size_t k = 0; k < n_appear; ++k)
+      rank[ work_list[k] ] = k;
+   //
+   // color_atomic
+   std::vector< std::atomic<size_t> > color_atomic(m);
+   for(size_t i = 0; i < m; ++i)
+      color_atomic[i].store(m, std::memory_order_relaxed);
+   //
+   // info
+   // (all the memory used by the threads is allocated here)
+   std::vector<color_thread_info> info(n_thread);
+   for(size_t thread = 0; thread < n_thread; ++thread)
+   {  info[thread].forbidden.assign(n_appear + 1, 0);
+      info[thread].stamp = 0;
+      info[thread].conflict.reserve(n_appear / n_thread + 1);
+   }
+   //
+   while( 0 < work_list.size() )
+   {  //
+      // block_begin
+      size_t n_use = std::min(n_thread, work_list.size());
+      std::vector<size_t> block_begin(n_use + 1);
+      for(size_t b = 0; b <= n_use; ++b)
+         block_begin[b] = b * work_list.size() / n_use;
+      //
+      // color_atomic: tentative coloring
+      std::vector<std::thread> worker(n_use - 1);
+      for(size_t b = 1; b < n_use; ++b) worker[b-1] = std::thread(
+         color_parallel_assign, &graph, &work_list,
+         block_begin[b], block_begin[b+1], &color_atomic, &info[b]
+      );
+      color_parallel_assign(
+         &graph, &work_list,
+         block_begin[0], block_begin[1], &color_atomic, &info[0]
+      );
+      for(size_t b = 1; b < n_use; ++b)
+         worker[b-1].join();
+      //
+      // one thread colors the rows in order, so there are no conflicts
+      if( n_use == 1 )
+         break;
+      //
+      // info[b].conflict: rows that must be colored again
+      for(size_t b = 1; b < n_use; ++b) worker[b-1] = std::thread(
+         color_parallel_conflict, &graph, &work_list,
+         block_begin[b], block_begin[b+1], &rank, &color_atomic, &info[b]
+      );
+      color_parallel_conflict(
+         &graph, &work_list,
+         block_begin[0], block_begin[1], &rank, &color_atomic, &info[0]
+      );
+      for(size_t b = 1; b < n_use; ++b)
+         worker[b-1].join();
+      //
+      // work_list
+      // blocks are in order, so the new work_list is also in order
+      work_list.clear();
+      for(size_t b = 0; b < n_use; ++b)
+         work_list.insert(
+            work_list.end(), info[b].conflict.begin(), info[b].conflict.end()
+         );
+   }
+   //
+   // color
+   // renumber so that the colors that are used are 0, 1, ...
+   std::vector<size_t> new_color(n_appear + 1, m);
+   for(size_t i = 0; i < m; ++i)
+   {  size_t c = color_atomic[i].load(std::memory_order_relaxed);
+      if( c < m )
+         new_color[c] = 0;
+   }
+   size_t n_color = 0;
+   for(size_t c = 0; c <= n_appear; ++c)
+      if( new_color[c] == 0 )
+         new_color[c] = n_color++;
+   for(size_t i = 0; i < m; ++i)
+   {  size_t c = color_atomic[i].load(std::memory_order_relaxed);
+      if( c < m )
+         color[i] = new_color[c];
+      else
+         color[i] = m;
+   }
+   return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
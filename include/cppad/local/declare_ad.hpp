@@ -42,6 +42,8 @@ namespace CppAD {
    class sparse_hessian_work;
    template <class Base> class AD;
    template <class Base, class RecBase=Base> class ADFun;
+   template <class Base> class fun_context;
+   template <class Base, class RecBase=Base> class fun_partition;
    template <class Base> class atomic_base;
    template <class Base> class atomic_three;
    template <class Base> class atomic_four;
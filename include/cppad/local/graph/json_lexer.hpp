@@ -2,10 +2,11 @@
 # define CPPAD_LOCAL_GRAPH_JSON_LEXER_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <string>
+# include <istream>
 # include <cppad/core/cppad_assert.hpp>
 
 // BEGIN_NAMESPACE_CPPAD_LOCAL_GRAPH
@@ -28,9 +29,32 @@ json lexer: Private Data
 Member Variables
 ****************
 
-graph\_
-=======
-The :ref:`json_ad_graph-name` .
+is\_
+====
+If this is null, the entire :ref:`json_ad_graph-name` is in memory.
+Otherwise, the graph is read from this stream
+:ref:`json_lexer_next_index@chunk_size` characters at a time.
+
+buffer\_
+========
+If ``is_`` is not null,
+this holds the characters that have been read from the stream
+and are still in use.
+
+data\_
+======
+is a pointer to the character in the graph with index ``data_begin_`` .
+The characters with index less than ``data_end_`` are in memory
+and can be accessed using ``data_[`` *index* ``- data_begin_ ]`` .
+
+data_begin\_
+============
+is the index in the graph corresponding to ``data_[0]`` .
+
+data_end\_
+==========
+is the index in the graph corresponding to the end of the
+characters that are currently in memory.
 
 index\_
 =======
@@ -80,7 +104,11 @@ Source Code
 {xrst_spell_off}
 {xrst_code hpp} */
 private:
-   const std::string& json_;
+   std::istream*      is_;
+   std::string        buffer_;
+   const char*        data_;
+   size_t             data_begin_;
+   size_t             data_end_;
    size_t             index_;
    size_t             line_number_;
    size_t             char_number_;
@@ -151,8 +179,8 @@ is a ``local::graph::json_lexer`` object.
 index\_
 *******
 The input value of ``index_`` is increased by one.
-It is an error to call this routine when the input value
-of ``index_`` is greater than or equal ``json_.size()`` .
+It is an error to call this routine when
+``more`` ( ``index_`` ) is false.
 
 line_number\_
 *************
@@ -165,12 +193,45 @@ If the previous character, before the call, was a new line,
 ``char_number`` is set to one.
 Otherwise, ``char_number_`` is increased by one.
 
+more
+****
+The syntax
+
+   *json_lexer* . ``more`` ( *index* )
+
+returns true if the graph has a character with the specified index;
+i.e., if the index is less than the number of characters in the graph.
+It is an error to call this routine when *index* is less than
+``index_`` (except for the constructor).
+If *index* is not in memory, and ``is_`` is not null,
+more characters are read from the stream and the characters before
+``index_`` , that are not needed for error reporting, are discarded.
+
+chunk_size
+==========
+is the number of characters that are read from the stream at one time.
+
+at
+**
+The syntax
+
+   *ch* = *json_lexer* . ``at`` ( *index* )
+
+returns the character with the specified index in the graph.
+It is an error to call this routine when ``more`` ( *index* ) is false.
+
 Prototype
 *********
 {xrst_spell_off}
 {xrst_code hpp} */
 private:
    void next_index(void);
+   static const size_t chunk_size = 65536;
+   bool more(size_t index);
+   char at(size_t index) const
+   {  CPPAD_ASSERT_UNKNOWN( data_begin_ <= index && index < data_end_ );
+      return data_[index - data_begin_];
+   }
 /* {xrst_code}
 {xrst_spell_on}
 
@@ -193,8 +254,7 @@ is a json lexer object.
 Discussion
 **********
 This member functions is used to increase ``index_`` until either
-a non-white space character is found or ``index_`` is equal
-to ``json_.size()`` .
+a non-white space character is found or ``more`` ( ``index_`` ) is false.
 
 Prototype
 *********
@@ -215,7 +275,8 @@ json lexer: Constructor
 Syntax
 ******
 
-   ``local::graph::lexer`` *json_lexer* ( *json* )
+| |tab| ``local::graph::lexer`` *json_lexer* ( *json* )
+| |tab| ``local::graph::lexer`` *json_lexer* ( *is* )
 
 json
 ****
@@ -223,12 +284,21 @@ The argument *json* is an :ref:`json_ad_graph-name`
 and it is assumed that *json* does not change
 for as long as *json_lexer* exists.
 
+is
+**
+The :ref:`json_ad_graph-name` is read from this stream.
+Only the characters near the current token are kept in memory.
+It is assumed that *is* is not used by any other routine
+for as long as *json_lexer* exists.
+
 Initialization
 **************
 The current token, index, line number, and character number
-are set to the first non white space character in ``json_`` .
+are set to the first non white space character in the graph.
 If this is not a left brace character ``'{'`` ,
 the error is reported and the constructor does not return.
+The private member function ``check_first_char`` is used by both
+constructors to do this initialization.
 
 Prototype
 *********
@@ -236,6 +306,9 @@ Prototype
 {xrst_code hpp} */
 public:
    json_lexer(const std::string& json);
+   json_lexer(std::istream& is);
+private:
+   void check_first_char(void);
 /* {xrst_code}
 {xrst_spell_on}
 
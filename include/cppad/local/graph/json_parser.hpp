@@ -3,10 +3,11 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <string>
+# include <istream>
 # include <cppad/utility/vector.hpp>
 # include <cppad/local/graph/cpp_graph_op.hpp>
 # include <cppad/core/graph/cpp_graph.hpp>
@@ -22,12 +23,18 @@ Json AD Graph Parser
 
 Syntax
 ******
-``json_parser`` ( *json* , *graph_obj* )
+| ``json_parser`` ( *json* , *graph_obj* )
+| ``json_parser`` ( *is* , *graph_obj* )
 
 json
 ****
 The :ref:`json_ad_graph-name` .
 
+is
+**
+The :ref:`json_ad_graph-name` is read from this stream.
+The entire graph is not stored in memory at one time.
+
 graph_obj
 *********
 This is a ``cpp_graph`` object.
@@ -43,6 +50,10 @@ namespace CppAD { namespace local { namespace graph {
       const std::string&  json      ,
       cpp_graph&          graph_obj
    );
+   CPPAD_LIB_EXPORT void json_parser(
+      std::istream&       is        ,
+      cpp_graph&          graph_obj
+   );
 } } }
 /* {xrst_code}
 {xrst_spell_on}
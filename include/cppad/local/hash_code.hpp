@@ -231,6 +231,65 @@ unsigned short local_hash_code(
 
    return code % CPPAD_HASH_TABLE_SIZE;
 }
+/*!
+Combine a hash code with another value.
+
+\param code
+is the hash code for the values before this one.
+
+\param value
+is the next value that is included in the hash code.
+
+\return
+is the hash code that includes value.
+This is a word by word version of the FNV-1a hash, so the result
+depends on the order of the values.
+It is not reduced modulo CPPAD_HASH_TABLE_SIZE and is intended for
+hash codes that index a large number of possible objects;
+e.g., the structure of an operation sequence.
+*/
+inline size_t local_hash_combine(size_t code, size_t value)
+{  // FNV prime corresponding to the number of bits in a size_t
+   const size_t prime = std::numeric_limits<size_t>::digits == 64 ?
+      size_t( 1099511628211ULL ) : size_t( 16777619UL );
+   return (code ^ value) * prime;
+}
+/*!
+Combine a hash code with another value using a different method
+than local_hash_combine.
+
+\param code
+is the hash code for the values before this one.
+
+\param value
+is the next value that is included in the hash code.
+
+\return
+is the hash code that includes value.
+The value is added to the code and the result is mixed using
+multiplications by odd constants and xor shifts
+(the finalizer for the 64 bit or 32 bit MurmurHash3 hash).
+It is used to check for collisions of local_hash_combine hash codes.
+*/
+inline size_t local_hash_mix(size_t code, size_t value)
+{  code += value;
+   if( std::numeric_limits<size_t>::digits == 64 )
+   {  unsigned long long x = code;
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return size_t( x );
+   }
+   unsigned long x = (unsigned long)( code ) & 0xffffffffUL;
+   x ^= x >> 16;
+   x  = (x * 0x85ebca6bUL) & 0xffffffffUL;
+   x ^= x >> 13;
+   x  = (x * 0xc2b2ae35UL) & 0xffffffffUL;
+   x ^= x >> 16;
+   return size_t( x );
+}
 
 } } // END_CPPAD_LOCAL_NAMESPACE
 
@@ -0,0 +1,110 @@
+# ifndef CPPAD_LOCAL_MUL_ADD_VEC_HPP
+# define CPPAD_LOCAL_MUL_ADD_VEC_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { namespace local { //  BEGIN_CPPAD_LOCAL_NAMESPACE
+/*
+\file local/mul_add_vec.hpp
+Record an elementwise multiply and add using one call.
+*/
+
+/*!
+Record y[i] = a[i] * x[i] + b[i]: Implementation in local namespace.
+
+\tparam BaseVector
+This is simple vector type with elements of type Base.
+
+\tparam ADBaseVector
+This is simple vector type with elements of type AD<Base>.
+
+\param a
+Vector of constant multipliers.
+
+\param x
+Vector of AD<Base> values that are multiplied.
+
+\param b
+Vector of constant values that are added.
+
+\param y
+Vector of results. It may be the same vector as x.
+
+\par
+The operators placed in the recording are the same as for the
+corresponding AD<Base> multiply and add operators.
+The difference is that the tape is found once and memory for the
+recording is reserved once for all the elements.
+*/
+template <class Base>
+template <class BaseVector, class ADBaseVector>
+void ADTape<Base>::mul_add_vec(
+   const BaseVector&     a ,
+   const ADBaseVector&   x ,
+   const BaseVector&     b ,
+   ADBaseVector&         y )
+{  size_t n = x.size();
+   CPPAD_ASSERT_UNKNOWN( a.size() == n );
+   CPPAD_ASSERT_UNKNOWN( b.size() == n );
+   CPPAD_ASSERT_UNKNOWN( y.size() == n );
+   CPPAD_ASSERT_NARG_NRES(MulpvOp, 2, 1);
+   CPPAD_ASSERT_NARG_NRES(AddpvOp, 2, 1);
+   //
+   // at most two operators, four arguments, and two constant parameters
+   // are recorded for each element
+   Rec_.reserve(
+      Rec_.num_op_rec()         + 2 * n ,
+      Rec_.num_arg_rec()        + 4 * n ,
+      Rec_.all_par_vec().size() + 2 * n
+   );
+   for(size_t i = 0; i < n; ++i)
+   {  // copy x[i] in case x and y are the same vector
+      AD<Base> xi = x[i];
+      //
+      // check if x[i] is a variable for this tape
+      bool var_x = (xi.tape_id_ == id_) & (xi.ad_type_ != dynamic_enum);
+      if( ! var_x )
+      {  // x[i] is a constant or dynamic parameter
+         y[i] = AD<Base>( a[i] ) * xi + AD<Base>( b[i] );
+      }
+      else
+      {  // t = a[i] * x[i]
+         bool   var_t   = ! IdenticalZero( a[i] );
+         Base   t_value = Base(0.0); // incase xi.value_ is nan
+         addr_t t_addr  = 0;
+         if( IdenticalOne( a[i] ) )
+         {  // t = 1 * variable
+            t_value = xi.value_;
+            t_addr  = xi.taddr_;
+         }
+         else if( var_t )
+         {  // t = parameter * variable
+            t_value  = a[i] * xi.value_;
+            addr_t p = Rec_.put_con_par( a[i] );
+            Rec_.PutArg(p, xi.taddr_);
+            t_addr   = Rec_.PutOp(MulpvOp);
+         }
+         //
+         // y[i] = t + b[i]
+         AD<Base> yi;
+         yi.value_ = t_value + b[i];
+         if( var_t )
+         {  if( IdenticalZero( b[i] ) )
+            {  // y[i] = variable + 0
+               yi.make_variable(id_, t_addr);
+            }
+            else
+            {  // y[i] = parameter + variable
+               addr_t p = Rec_.put_con_par( b[i] );
+               Rec_.PutArg(p, t_addr);
+               yi.make_variable(id_, Rec_.PutOp(AddpvOp) );
+            }
+         }
+         y[i] = yi;
+      }
+   }
+}
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
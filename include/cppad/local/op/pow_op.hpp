@@ -634,7 +634,7 @@ void reverse_powvp_op(
    const Base*   taylor      ,
    size_t        nc_partial  ,
    Base*         partial     ,
-   CppAD::vector<Base>& work )
+   std::vector<Base>& work   )
 {
    // check assumptions
    CPPAD_ASSERT_UNKNOWN( NumArg(PowvpOp) == 2 );
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_GET_DYN_PREVIOUS_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*!
 \file get_cexp_info.hpp
@@ -12,6 +12,7 @@ Create operator information tables
 # include <cppad/local/optimize/match_op.hpp>
 # include <cppad/local/optimize/usage.hpp>
 # include <cppad/local/optimize/hash_code.hpp>
+# include <cppad/local/optimize/match_table.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
@@ -173,8 +174,7 @@ void get_dyn_previous(
    // ----------------------------------------------------------------------
    // compute dyn_previous
    // ----------------------------------------------------------------------
-   sparse::list_setvec  hash_table_dyn;
-   hash_table_dyn.resize(CPPAD_HASH_TABLE_SIZE, num_dynamic_par);
+   match_table hash_table_dyn;
    //
    // Initialize in dyn_par_arg
    // (independent dynamic parameters do not have any arguments)
@@ -221,7 +221,7 @@ void get_dyn_previous(
       // temporaries used below and decaled here to reduce indentation level
       bool   match;
       size_t code;
-      size_t count;
+      size_t slot;
       //
       // check for a previous match for i_dyn
       if( par_usage[i_par] ) switch( op )
@@ -270,42 +270,34 @@ void get_dyn_previous(
                op_t, num_arg, arg_match.data()
             );
             //
-            // iterator for the set with this hash code
-            sparse::list_setvec_const_iterator itr(hash_table_dyn, code);
+            // first slot in the table that can have this hash code
+            slot = hash_table_dyn.first(code);
             //
             // check for a match
-            count = 0;
             match = false;
-            while( ! match && *itr != num_dynamic_par )
-            {  ++count;
-               //
-               // candidate for current dynamic parameter
-               size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
-               //
-               // argument offset for the candidate
-               addr_t k_arg   = dyn_arg_offset[k_dyn];
-               //
-               match  = op_t == dyn_par_op[k_dyn];
-               match &= arg_match[0] == dyn_par_arg[k_arg + 0];
+            while( ! match && ! hash_table_dyn.empty(slot) )
+            {  if( hash_table_dyn.same_code(slot, code) )
+               {  // candidate for current dynamic parameter
+                  size_t  k_dyn  = hash_table_dyn.index(slot);
+                  CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
+                  //
+                  // argument offset for the candidate
+                  addr_t k_arg   = dyn_arg_offset[k_dyn];
+                  //
+                  match  = op_t == dyn_par_op[k_dyn];
+                  match &= arg_match[0] == dyn_par_arg[k_arg + 0];
+               }
                if( ! match )
-                  ++itr;
+                  slot = hash_table_dyn.next(slot);
             }
             if( match )
-            {  size_t  k_dyn  = *itr;
+            {  size_t  k_dyn  = hash_table_dyn.index(slot);
                CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
                dyn_previous[i_dyn] = addr_t( k_dyn );
             }
             else
-            {  CPPAD_ASSERT_UNKNOWN( count < 11 );
-               if( count == 10 )
-               {  // restart list for this hash code
-                  hash_table_dyn.clear(code);
-               }
-               // Add this entry to hash table.
-               // Not using post_element becasue we need to iterate for
-               // this code before adding another element for this code.
-               hash_table_dyn.add_element(code, i_dyn);
+            {  // Add this entry to hash table.
+               hash_table_dyn.insert(code, i_dyn);
             }
          }
          break;
@@ -338,29 +330,28 @@ void get_dyn_previous(
                op_t, num_arg, arg_match.data()
             );
             //
-            // iterator for the set with this hash code
-            sparse::list_setvec_const_iterator itr(hash_table_dyn, code);
+            // first slot in the table that can have this hash code
+            slot = hash_table_dyn.first(code);
             //
             // check for a match
-            count = 0;
-            while( ! match && *itr != num_dynamic_par )
-            {  ++count;
-               //
-               // candidate for current dynamic parameter
-               size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
-               //
-               // argument offset for the candidate
-               addr_t k_arg   = dyn_arg_offset[k_dyn];
-               //
-               match  = op_t == dyn_par_op[k_dyn];
-               match &= arg_match[0] == dyn_par_arg[k_arg + 0];
-               match &= arg_match[1] == dyn_par_arg[k_arg + 1];
+            while( ! match && ! hash_table_dyn.empty(slot) )
+            {  if( hash_table_dyn.same_code(slot, code) )
+               {  // candidate for current dynamic parameter
+                  size_t  k_dyn  = hash_table_dyn.index(slot);
+                  CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
+                  //
+                  // argument offset for the candidate
+                  addr_t k_arg   = dyn_arg_offset[k_dyn];
+                  //
+                  match  = op_t == dyn_par_op[k_dyn];
+                  match &= arg_match[0] == dyn_par_arg[k_arg + 0];
+                  match &= arg_match[1] == dyn_par_arg[k_arg + 1];
+               }
                if( ! match )
-                  ++itr;
+                  slot = hash_table_dyn.next(slot);
             }
             if( match )
-            {  size_t  k_dyn  = *itr;
+            {  size_t  k_dyn  = hash_table_dyn.index(slot);
                CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
                dyn_previous[i_dyn] = addr_t( k_dyn );
             }
@@ -373,41 +364,35 @@ void get_dyn_previous(
                op_t, num_arg, arg_match.data()
             );
             //
-            // iterator for the set with this hash code
-            sparse::list_setvec_const_iterator itr(hash_table_dyn, code_swp);
+            // first slot in the table that can have this hash code
+            slot = hash_table_dyn.first(code_swp);
             //
             // check for a match
-            while( ! match && *itr != num_dynamic_par )
-            {  //
-               // candidate for current dynamic parameter
-               size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
-               //
-               // argument offset for the candidate
-               addr_t k_arg   = dyn_arg_offset[k_dyn];
-               //
-               match  = op_t == dyn_par_op[k_dyn];
-               match &= arg_match[0] == dyn_par_arg[k_arg + 0];
-               match &= arg_match[1] == dyn_par_arg[k_arg + 1];
+            while( ! match && ! hash_table_dyn.empty(slot) )
+            {  if( hash_table_dyn.same_code(slot, code_swp) )
+               {  // candidate for current dynamic parameter
+                  size_t  k_dyn  = hash_table_dyn.index(slot);
+                  CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
+                  //
+                  // argument offset for the candidate
+                  addr_t k_arg   = dyn_arg_offset[k_dyn];
+                  //
+                  match  = op_t == dyn_par_op[k_dyn];
+                  match &= arg_match[0] == dyn_par_arg[k_arg + 0];
+                  match &= arg_match[1] == dyn_par_arg[k_arg + 1];
+               }
                if( ! match )
-                  ++itr;
+                  slot = hash_table_dyn.next(slot);
             }
             if( match )
-            {  size_t  k_dyn  = *itr;
+            {  size_t  k_dyn  = hash_table_dyn.index(slot);
                CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
                dyn_previous[i_dyn] = addr_t( k_dyn );
             }
          }
          if( ! match )
-         {  CPPAD_ASSERT_UNKNOWN( count < 11 );
-            if( count == 10 )
-            {  // restart list for this hash code
-               hash_table_dyn.clear(code);
-            }
-            // Add the entry to hash table
-            // Not using post_element becasue we need to iterate for
-            // this code before adding another element for this code.
-            hash_table_dyn.add_element(code, i_dyn);
+         {  // Add the entry to hash table
+            hash_table_dyn.insert(code, i_dyn);
          }
 
          // --------------------------------------------------------------
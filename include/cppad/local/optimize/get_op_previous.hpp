@@ -2,11 +2,18 @@
 # define CPPAD_LOCAL_OPTIMIZE_GET_OP_PREVIOUS_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
+# include <algorithm>
+# include <thread>
+# include <vector>
 # include <cppad/local/optimize/match_op.hpp>
 # include <cppad/local/optimize/usage.hpp>
 
+/// Minimum number of operators that each thread hashes in get_op_previous.
+/// If there are fewer operators, the current thread does not use others.
+# define CPPAD_OPTIMIZE_HASH_MIN 1024
+
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
 /*
@@ -27,7 +34,8 @@ Syntax
 | |tab| *random_itr* ,
 | |tab| *cexp_set* ,
 | |tab| *op_previous* ,
-| |tab| *op_usage*
+| |tab| *op_usage* ,
+| |tab| *n_thread*
 | )
 
 Prototype
@@ -44,8 +52,8 @@ using AD<Base> and computations by this routine are done using type Base.
 
 collision_limit
 ***************
-is the maximum number of collisions (matches)
-allowed in the hash expression has table.
+is the maximum number of hash table entries that are checked
+while searching for a match for one operator.
 
 play
 ****
@@ -100,6 +108,24 @@ the i-th operator in the operation sequence not counting previous
 optimization.
 On output, it is the usage counting previous operator optimization.
 
+n_thread
+********
+is the number of threads (including the current thread) used to
+compute the hash codes for the operators.
+The hash code for an operator is computed using its original arguments
+and does not depend on the other operators; see
+:ref:`optimize_match_op@match_op_code` .
+The threads split the operators into contiguous blocks and each
+thread computes the hash codes for one block.
+The threads are created using ``std::thread`` and do not use
+:ref:`thread_alloc-name` .
+The current thread then searches for matches in operator order
+(this is the same as when *n_thread* is one),
+so *op_previous* and *op_usage* do not depend on *n_thread* .
+If the number of operators is less than *n_thread* times
+``CPPAD_OPTIMIZE_HASH_MIN`` , fewer threads are used.
+If only one thread is used, the hash codes are computed during the search.
+
 exceed_collision_limit
 **********************
 If the *collision_limit* is exceeded (is not exceeded),
@@ -107,6 +133,44 @@ the return value is true (false).
 
 {xrst_end optimize_get_op_previous}
 */
+/*!
+Compute the hash codes for a block of operators.
+
+\param begin
+is the index of the first operator in the block.
+
+\param end
+is one greater than the index of the last operator in the block.
+
+\param random_itr
+is a random iterator for the operation sequence.
+
+\param op_hash
+is a vector with size equal to the number of operators.
+Upon return, op_hash[i_op] is match_op_code for the i_op-th operator,
+for each operator in the block that can have a previous match.
+(The usage of an operator is not checked because it is only known
+when the operator is reached in the search.)
+The other elements of op_hash are not modified.
+*/
+template <class Addr>
+void get_op_previous_hash(
+   size_t                                      begin      ,
+   size_t                                      end        ,
+   const play::const_random_iterator<Addr>*    random_itr ,
+   pod_vector<size_t>*                         op_hash    )
+{  for(size_t i_op = begin; i_op < end; ++i_op)
+   {  OpCode        op;
+      const addr_t* arg;
+      size_t        i_var;
+      random_itr->op_info(i_op, op, arg, i_var);
+      // operators that are not checked for a match are skipped, except for
+      // BeginOp, ParOp, LdpOp, and LdvOp (their codes are not used)
+      size_t num_arg = NumArg(op);
+      if( 0 < num_arg && num_arg <= 3 && 0 < NumRes(op) )
+         (*op_hash)[i_op] = match_op_code(op, arg);
+   }
+}
 
 // BEGIN_PROTOTYPE
 template <class Addr, class Base>
@@ -116,7 +180,8 @@ bool get_op_previous(
    const play::const_random_iterator<Addr>&    random_itr          ,
    sparse::list_setvec&                        cexp_set            ,
    pod_vector<addr_t>&                         op_previous         ,
-   pod_vector<usage_t>&                        op_usage            )
+   pod_vector<usage_t>&                        op_usage            ,
+   size_t                                      n_thread            )
 // END_PROTOTYPE
 {  bool exceed_collision_limit = false;
    //
@@ -133,10 +198,35 @@ bool get_op_previous(
       size_t( (std::numeric_limits<addr_t>::max)() ) >= num_op
    );
    // ----------------------------------------------------------------------
+   // compute op_hash
+   // ----------------------------------------------------------------------
+   // n_use: number of threads that compute hash codes
+   size_t n_use = std::min(n_thread, num_op / CPPAD_OPTIMIZE_HASH_MIN);
+   pod_vector<size_t> op_hash;
+   if( n_use > 1 )
+   {  op_hash.resize(num_op);
+      //
+      // worker: threads for the blocks other than the first block
+      std::vector<std::thread> worker;
+      for(size_t thread = 1; thread < n_use; ++thread)
+      {  size_t begin = (thread * num_op) / n_use;
+         size_t end   = ( (thread + 1) * num_op ) / n_use;
+         worker.push_back( std::thread(
+            get_op_previous_hash<Addr>,
+            begin, end, &random_itr, &op_hash
+         ) );
+      }
+      // first block is done by the current thread
+      get_op_previous_hash<Addr>(
+         0, num_op / n_use, &random_itr, &op_hash
+      );
+      for(size_t thread = 1; thread < n_use; ++thread)
+         worker[thread - 1].join();
+   }
+   // ----------------------------------------------------------------------
    // compute op_previous
    // ----------------------------------------------------------------------
-   sparse::list_setvec  hash_table_op;
-   hash_table_op.resize(CPPAD_HASH_TABLE_SIZE, num_op);
+   match_table hash_table_op;
    //
    pod_vector<bool> work_bool;
    pod_vector<addr_t> work_addr_t;
@@ -232,6 +322,7 @@ bool get_op_previous(
             op_previous,
             i_op,
             hash_table_op,
+            op_hash,
             work_bool,
             work_addr_t
          );
@@ -252,17 +343,6 @@ bool get_op_previous(
          break;
       }
    }
-   /* ---------------------------------------------------------------------
-   // Print out hash code usage summary
-   CppAD::vector<size_t> count(collision_limit + 1);
-   for(size_t i = 0; i <= collision_limit; ++i)
-      count[i] = 0;
-   for(size_t code = 0; code < CPPAD_HASH_TABLE_SIZE; ++code)
-   {  size_t size = hash_table_op.number_elements(code);
-      ++count[size];
-   }
-   std::cout << "count = " << count << "\n";
-   --------------------------------------------------------------------- */
    return exceed_collision_limit;
 }
 
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_HASH_CODE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*!
 \file local/optimize/hash_code.hpp
@@ -13,6 +13,25 @@ CppAD hashing utility.
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
 /*!
+Mix the bits in a hash code so that every bit of the result
+depends on every bit of the input.
+
+\param code
+is the value that is mixed (only the low order 64 bits are used).
+
+\return
+is the mixed value (the low order bits of size_t on 32 bit systems).
+*/
+inline size_t optimize_hash_mix(unsigned long long code)
+{  // finalizer for the splitmix64 random number generator
+   code ^= code >> 30;
+   code *= 0xbf58476d1ce4e5b9ull;
+   code ^= code >> 27;
+   code *= 0x94d049bb133111ebull;
+   code ^= code >> 31;
+   return static_cast<size_t>(code);
+}
+/*!
 Specialized hash code for a CppAD operator and its arguments
 (used during optimization).
 
@@ -27,7 +46,8 @@ is a vector of length num_arg
 containing the corresponding argument indices for this operator.
 
 \return
-is a hash code that is between zero and CPPAD_HASH_TABLE_SIZE - 1.
+is a hash code that uses all the bits in a size_t.
+The low order bits are used to index a match_table.
 */
 
 inline size_t optimize_hash_code(
@@ -35,14 +55,12 @@ inline size_t optimize_hash_code(
    size_t        num_arg ,
    const addr_t* arg     )
 {  CPPAD_ASSERT_UNKNOWN( num_arg < 4 );
-   size_t prime = 1;
-   size_t sum   = prime * size_t(op);
+   unsigned long long code = static_cast<unsigned long long>(op);
    for(size_t i = 0; i < num_arg; i++)
-   {  prime    = prime + 2;  // 3, 5, 7 in that order
-      sum += prime * size_t(arg[i]);
+   {  code  = optimize_hash_mix(code);
+      code += static_cast<unsigned long long>( arg[i] );
    }
-   //
-   return sum % CPPAD_HASH_TABLE_SIZE;
+   return optimize_hash_mix(code);
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
@@ -2,9 +2,10 @@
 # define CPPAD_LOCAL_OPTIMIZE_MATCH_OP_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/optimize/hash_code.hpp>
+# include <cppad/local/optimize/match_table.hpp>
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize  {
 /*
@@ -24,7 +25,8 @@ Syntax
 | |tab| ``random_itr`` ,
 | |tab| ``op_previous`` ,
 | |tab| ``current`` ,
-| |tab| ``hash_tape_op`` ,
+| |tab| ``hash_table_op`` ,
+| |tab| ``op_hash`` ,
 | |tab| ``work_bool`` ,
 | |tab| ``work_addr_t``
 | )
@@ -45,8 +47,8 @@ for the current operator.
 
 collision_limit
 ***************
-is the maximum number of collisions (matches) allowed for one
-expression hash code value.
+is the maximum number of entries in *hash_table_op*
+that are checked while searching for a match for the current operator.
 
 random_itr
 **********
@@ -82,17 +84,35 @@ three arguments, but only one true argument (the others are always the same).
 
 hash_table_op
 *************
-is assumed to be initialized as a vector of empty sets before the
+is assumed to be empty before the
 first call to match_op (for a pass of the operation sequence).
+If *i_op* is an entry in this :ref:`optimize_match_table-name` ,
+*op_previous* [ *i_op* ] is zero and *i_op* does not match
+any other entry in the table.
+An entry for the current operator is added each time
+match_op is called and a match for the current operator is not found.
 
-| |tab| *hash_table_op* . ``n_set`` () == ``CPPAD_HASH_TABLE_SIZE``
-| |tab| *hash_table_op* . ``end`` ()   == *op_previous* . ``size`` ()
+op_hash
+*******
+If this vector is empty, it is not used.
+Otherwise, its size is the number of operators and
+*op_hash* [ *current* ] is the hash code for the current operator
+using its original arguments; see :ref:`optimize_match_op@match_op_code` .
+It is used when none of the variable arguments for the current operator
+has a previous match (so the hash code would be the same).
 
-If *i_op* is an element of the j-th set,
-then the operation *op_previous* [ *i_op* ] has hash code j,
-and does not match any other element of the j-th set.
-An entry to j-th set for the current operator is added each time
-match_op is called and a match for the current operator is not found.
+match_op_code
+*************
+The syntax
+
+| |tab| *code* = ``match_op_code`` ( *op* , *arg* )
+
+returns the hash code that match_op uses for an operator
+when none of its variable arguments has a previous match.
+Here *op* is an ``OpCode`` that can be passed to match_op
+and *arg* is a ``const addr_t*`` pointing to its arguments.
+It does not use :ref:`thread_alloc-name` ,
+so it can be used by more than one thread at the same time.
 
 work_bool
 *********
@@ -113,6 +133,20 @@ the return value is true (false).
 
 {xrst_end optimize_match_op}
 */
+// match_op_code
+inline size_t match_op_code(OpCode op, const addr_t* arg)
+{  size_t num_arg = NumArg(op);
+   CPPAD_ASSERT_UNKNOWN( 0 < num_arg && num_arg <= 3 );
+   addr_t arg_match[3];
+   for(size_t j = 0; j < num_arg; ++j)
+      arg_match[j] = arg[j];
+   // same order as for the commutative case in match_op
+   if( (op == AddvvOp) | (op == MulvvOp ) )
+   {  if( arg_match[1] < arg_match[0] )
+         std::swap( arg_match[0], arg_match[1] );
+   }
+   return optimize_hash_code(opcode_t(op), num_arg, arg_match);
+}
 // BEGIN_PROTOTYPE
 template <class Addr>
 bool match_op(
@@ -120,7 +154,8 @@ bool match_op(
    const play::const_random_iterator<Addr>&    random_itr      ,
    pod_vector<addr_t>&                         op_previous     ,
    size_t                                      current         ,
-   sparse::list_setvec&                        hash_table_op   ,
+   match_table&                                hash_table_op   ,
+   const pod_vector<size_t>&                   op_hash         ,
    pod_vector<bool>&                           work_bool       ,
    pod_vector<addr_t>&                         work_addr_t     )
 // END_PROTOTYPE
@@ -158,9 +193,6 @@ bool match_op(
 # endif
    // initialize return value
    bool exceed_collision_limit = false;
-   // num_op
-   size_t num_op = random_itr.num_op();
-   //
    // num_var
    size_t num_var = random_itr.num_var();
    //
@@ -176,13 +208,9 @@ bool match_op(
    }
    //
    CPPAD_ASSERT_UNKNOWN( var2previous_var.size() == num_var );
-   CPPAD_ASSERT_UNKNOWN( num_op == op_previous.size() );
+   CPPAD_ASSERT_UNKNOWN( random_itr.num_op() == op_previous.size() );
    CPPAD_ASSERT_UNKNOWN( op_previous[current] == 0 );
-   CPPAD_ASSERT_UNKNOWN(
-      hash_table_op.n_set() == CPPAD_HASH_TABLE_SIZE
-   );
-   CPPAD_ASSERT_UNKNOWN( hash_table_op.end() == num_op );
-   CPPAD_ASSERT_UNKNOWN( current < num_op );
+   CPPAD_ASSERT_UNKNOWN( current < random_itr.num_op() );
    //
    // op, arg, i_var
    OpCode        op;
@@ -203,6 +231,8 @@ bool match_op(
    // If j-th argument to this operator is a variable, and a previous
    // variable will be used in its place, use the previous variable for
    // hash coding and matching.
+   // replaced: is true if arg_match is different from the original arguments
+   bool replaced = false;
    addr_t arg_match[] = {
       // Invalid value that will not be used. This initialization avoid
       // a wraning on some compilers
@@ -216,28 +246,48 @@ bool match_op(
       CPPAD_ASSERT_UNKNOWN( num_arg == 2 );
       arg_match[0] = var2previous_var[ arg[0] ];
       arg_match[1] = var2previous_var[ arg[1] ];
+      replaced     = (arg_match[0] != arg[0]) | (arg_match[1] != arg[1]);
       if( arg_match[1] < arg_match[0] )
          std::swap( arg_match[0], arg_match[1] );
    }
    else for(size_t j = 0; j < num_arg; ++j)
    {  arg_match[j] = arg[j];
       if( variable[j] )
-         arg_match[j] = var2previous_var[ arg[j] ];
+      {  arg_match[j] = var2previous_var[ arg[j] ];
+         replaced    |= arg_match[j] != arg[j];
+      }
    }
-
    //
-   size_t code = optimize_hash_code(opcode_t(op), num_arg, arg_match);
+   // code
+   size_t code;
+   if( op_hash.size() == 0 || replaced )
+      code = optimize_hash_code(opcode_t(op), num_arg, arg_match);
+   else
+   {  code = op_hash[current];
+      CPPAD_ASSERT_UNKNOWN(
+         code == optimize_hash_code(opcode_t(op), num_arg, arg_match)
+      );
+   }
    //
-   // iterator for the set with this hash code
-   sparse::list_setvec_const_iterator itr(hash_table_op, code);
+   // first slot in the table that can have this hash code
+   size_t slot = hash_table_op.first(code);
    //
    // check for a match
    size_t count = 0;
-   while( *itr != num_op )
-   {  ++count;
+   while( ! hash_table_op.empty(slot) )
+   {  if( count == collision_limit )
+      {  // limit has been exceeded
+         exceed_collision_limit = true;
+         break;
+      }
+      ++count;
+      if( ! hash_table_op.same_code(slot, code) )
+      {  slot = hash_table_op.next(slot);
+         continue;
+      }
       //
       // candidate previous for current operator
-      size_t  candidate  = *itr;
+      size_t  candidate  = hash_table_op.index(slot);
       CPPAD_ASSERT_UNKNOWN( candidate < current );
       CPPAD_ASSERT_UNKNOWN( op_previous[candidate] == 0 );
       //
@@ -270,21 +320,10 @@ bool match_op(
          }
          return exceed_collision_limit;
       }
-      ++itr;
-   }
-
-   // see print (that is commented out) at bottom of get_op_previous.hpp
-   CPPAD_ASSERT_UNKNOWN( count <= collision_limit );
-   if( count == collision_limit )
-   {  // restart the list
-      hash_table_op.clear(code);
-      // limit has been exceeded
-      exceed_collision_limit = true;
+      slot = hash_table_op.next(slot);
    }
-   // No match was found. Add this operator to the set for this hash code
-   // Not using post_element becasue we need to iterate for
-   // this code before adding another element for this code.
-   hash_table_op.add_element(code, current);
+   // No match was found. Add this operator to the table
+   hash_table_op.insert(code, current);
    //
    return exceed_collision_limit;
 }
@@ -0,0 +1,186 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_MATCH_TABLE_HPP
+# define CPPAD_LOCAL_OPTIMIZE_MATCH_TABLE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <limits>
+# include <cppad/local/pod_vector.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_match_table dev}
+
+Hash Table Used to Find Matching Operators
+##########################################
+
+Syntax
+******
+| ``match_table`` *table*
+| *table* . ``clear`` ()
+| *n_entry* = *table* . ``size`` ()
+| *slot* = *table* . ``first`` ( *code* )
+| *slot* = *table* . ``next`` ( *slot* )
+| *empty* = *table* . ``empty`` ( *slot* )
+| *same* = *table* . ``same_code`` ( *slot* , *code* )
+| *index* = *table* . ``index`` ( *slot* )
+| *table* . ``insert`` ( *code* , *index* )
+
+Purpose
+*******
+This is an open addressing hash table (with linear probing)
+that maps a hash code to the index of an operator, or dynamic parameter,
+with that hash code.
+The number of slots in the table is a power of two and it doubles
+whenever more than half of the slots are in use.
+Hence the expected number of slots checked for each search is bounded
+by a constant that does not depend on the size of the operation sequence.
+Entries are never removed from the table (except by ``clear`` ).
+
+code
+****
+This ``size_t`` value is a hash code for an operator
+(see ``optimize_hash_code`` in ``local/optimize/hash_code.hpp`` ).
+The low order bits of *code* are used to choose the slots
+and the low order 32 bits are stored in the table.
+
+index
+*****
+This ``size_t`` value is the index of the operator,
+or dynamic parameter, corresponding to an entry in the table.
+It must be less than the maximum value for an ``addr_t`` .
+
+clear
+*****
+removes all the entries from the table.
+
+n_entry
+*******
+is the number of entries in the table.
+
+Search
+******
+The slots that can contain an entry with a specific *code* are
+*table* . ``first`` ( *code* ) ,
+followed by *table* . ``next`` ( *slot* ) , until a slot with
+*table* . ``empty`` ( *slot* ) true is found.
+For each non-empty slot in this sequence,
+*table* . ``same_code`` ( *slot* , *code* ) is false if the
+hash code for the entry in *slot* is different from *code* .
+(It may be true when the hash codes are different,
+but this is very unlikely).
+If it is true, *table* . ``index`` ( *slot* ) is the index for the entry
+that may match.
+
+insert
+******
+Adds an entry, with the specified *code* and *index* , to the table.
+This invalidates all the *slot* values obtained before the call.
+
+{xrst_end optimize_match_table}
+*/
+class match_table {
+private:
+   // number of entries in the table
+   size_t n_entry_;
+   //
+   // the number of slots in the table is mask_ + 1 (a power of two)
+   size_t mask_;
+   //
+   // low order 32 bits of the hash code for the entry in each slot
+   pod_vector<unsigned int> code_;
+   //
+   // index for the entry in each slot or empty_index if the slot is empty
+   pod_vector<addr_t> index_;
+   //
+   // value of index_ for a slot that is empty
+   static addr_t empty_index(void)
+   {  return std::numeric_limits<addr_t>::max(); }
+   //
+   // set the number of slots in the table and re-insert the entries
+   void rehash(size_t n_slot)
+   {  CPPAD_ASSERT_UNKNOWN( (n_slot & (n_slot - 1)) == 0 );
+      CPPAD_ASSERT_UNKNOWN( n_slot - 1 <=
+         size_t( std::numeric_limits<unsigned int>::max() )
+      );
+      pod_vector<unsigned int> old_code;
+      pod_vector<addr_t>       old_index;
+      old_code.swap(code_);
+      old_index.swap(index_);
+      //
+      mask_ = n_slot - 1;
+      code_.resize(n_slot);
+      index_.resize(n_slot);
+      for(size_t slot = 0; slot < n_slot; ++slot)
+         index_[slot] = empty_index();
+      for(size_t old_slot = 0; old_slot < old_index.size(); ++old_slot)
+      if( old_index[old_slot] != empty_index() )
+      {  size_t slot = size_t( old_code[old_slot] ) & mask_;
+         while( index_[slot] != empty_index() )
+            slot = (slot + 1) & mask_;
+         code_[slot]  = old_code[old_slot];
+         index_[slot] = old_index[old_slot];
+      }
+   }
+public:
+   // constructor
+   match_table(void) : n_entry_(0), mask_(0)
+   {  clear(); }
+   //
+   // clear
+   void clear(void)
+   {  n_entry_ = 0;
+      code_.clear();
+      index_.clear();
+      rehash(1024);
+   }
+   //
+   // size
+   size_t size(void) const
+   {  return n_entry_; }
+   //
+   // first
+   size_t first(size_t code) const
+   {  return code & mask_; }
+   //
+   // next
+   size_t next(size_t slot) const
+   {  return (slot + 1) & mask_; }
+   //
+   // empty
+   bool empty(size_t slot) const
+   {  return index_[slot] == empty_index(); }
+   //
+   // same_code
+   bool same_code(size_t slot, size_t code) const
+   {  CPPAD_ASSERT_UNKNOWN( ! empty(slot) );
+      return code_[slot] == static_cast<unsigned int>(code);
+   }
+   //
+   // index
+   size_t index(size_t slot) const
+   {  CPPAD_ASSERT_UNKNOWN( ! empty(slot) );
+      return size_t( index_[slot] );
+   }
+   //
+   // insert
+   void insert(size_t code, size_t index)
+   {  CPPAD_ASSERT_UNKNOWN( index < size_t( empty_index() ) );
+      //
+      // keep at least half of the slots empty
+      if( 2 * (n_entry_ + 1) > mask_ + 1 )
+         rehash( 2 * (mask_ + 1) );
+      //
+      size_t slot = first(code);
+      while( ! empty(slot) )
+         slot = next(slot);
+      code_[slot]  = static_cast<unsigned int>(code);
+      index_[slot] = addr_t( index );
+      ++n_entry_;
+   }
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -19,6 +19,7 @@
 # include <cppad/local/optimize/record_vp.hpp>
 # include <cppad/local/optimize/record_vv.hpp>
 # include <cppad/local/optimize/record_csum.hpp>
+# include <cppad/local/optimize/phase_timer.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize  {
@@ -96,11 +97,30 @@ collision_limit=value
 If this substring appears,
 where *value* is a sequence of decimal digits,
 the optimizer's hash code collision limit will be set to *value* .
-When the collision limit is exceeded, the expressions with that hash code
-are removed and a new lists of expressions with that has code is started.
-The larger *value* , the more identical expressions the optimizer
-can recognize, but the slower the optimizer may run.
-The default for *value* is ``10`` .
+The optimizer uses a hash table to find expressions that are identical.
+The collision limit is the maximum number of hash table entries
+that are checked while searching for a match for one expression.
+If the limit is reached, the search stops and no match is found
+for that expression.
+The hash table grows with the operation sequence,
+so the expected number of entries checked is small
+and does not depend on the size of the operation sequence.
+The default is no limit.
+
+print_timing
+============
+If this sub-string appears,
+the elapsed time for each phase of the optimizer is printed
+on standard output; see :ref:`optimize_phase_timer-name` .
+
+n_thread=value
+==============
+If this substring appears,
+where *value* is a sequence of decimal digits,
+it is the number of threads used to compute the hash codes
+for the operators; see
+:ref:`optimize_get_op_previous@n_thread` .
+The default for *value* is one.
 
 n
 *
@@ -140,7 +160,9 @@ Contents
    include/cppad/local/optimize/get_par_usage.hpp
    include/cppad/local/optimize/record_csum.hpp
    include/cppad/local/optimize/match_op.hpp
+   include/cppad/local/optimize/match_table.hpp
    include/cppad/local/optimize/get_op_previous.hpp
+   include/cppad/local/optimize/phase_timer.hpp
 }
 
 {xrst_end optimize_run}
@@ -160,16 +182,13 @@ bool optimize_run(
    // check that recorder is empty
    CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
    //
-   // get a random iterator for this player
-   play->template setup_random<Addr>();
-   local::play::const_random_iterator<Addr> random_itr =
-      play->template get_random<Addr>();
-
    bool conditional_skip    = true;
    bool compare_op          = true;
    bool print_for_op        = true;
    bool cumulative_sum_op   = true;
-   size_t collision_limit   = 10;
+   bool print_timing        = false;
+   size_t collision_limit   = std::numeric_limits<size_t>::max();
+   size_t n_thread          = 1;
    size_t index = 0;
    while( index < options.size() )
    {  while( index < options.size() && options[index] == ' ' )
@@ -186,6 +205,8 @@ bool optimize_run(
             print_for_op = false;
          else if( option == "no_cumulative_sum_op" )
             cumulative_sum_op = false;
+         else if( option == "print_timing" )
+            print_timing = true;
          else if( option.substr(0, 16)  == "collision_limit=" )
          {  std::string value = option.substr(16, option.size());
             bool value_ok = value.size() > 0;
@@ -203,12 +224,38 @@ bool optimize_run(
                CPPAD_ASSERT_KNOWN( false , option.c_str() );
             }
          }
+         else if( option.substr(0, 9)  == "n_thread=" )
+         {  std::string value = option.substr(9, option.size());
+            bool value_ok = value.size() > 0;
+            for(size_t i = 0; i < value.size(); ++i)
+            {  value_ok &= '0' <= value[i];
+               value_ok &= value[i] <= '9';
+            }
+            if( ! value_ok )
+            {  option += " value is not a sequence of decimal digits";
+               CPPAD_ASSERT_KNOWN( false , option.c_str() );
+            }
+            n_thread = size_t( std::atoi( value.c_str() ) );
+            if( n_thread < 1 )
+            {  option += " value must be greater than zero";
+               CPPAD_ASSERT_KNOWN( false , option.c_str() );
+            }
+         }
          else
          {  option += " is not a valid optimize option";
             CPPAD_ASSERT_KNOWN( false , option.c_str() );
          }
       }
    }
+   // timer
+   phase_timer timer(print_timing);
+   //
+   // get a random iterator for this player
+   play->template setup_random<Addr>();
+   local::play::const_random_iterator<Addr> random_itr =
+      play->template get_random<Addr>();
+   timer.end_phase("setup_random");
+   //
    // number of operators in the player
    const size_t num_op = play->num_op_rec();
    CPPAD_ASSERT_UNKNOWN(
@@ -260,6 +307,8 @@ bool optimize_run(
       vecad_used,
       op_usage
    );
+   timer.end_phase("get_op_usage");
+   //
    pod_vector<addr_t>        op_previous;
    exceed_collision_limit |= get_op_previous(
       collision_limit,
@@ -267,8 +316,11 @@ bool optimize_run(
       random_itr,
       cexp_set,
       op_previous,
-      op_usage
+      op_usage,
+      n_thread
    );
+   timer.end_phase("get_op_previous");
+   //
    size_t num_cexp = cexp2op.size();
    CPPAD_ASSERT_UNKNOWN( conditional_skip || num_cexp == 0 );
    vector<struct_cexp_info>  cexp_info; // struct_cexp_info not POD
@@ -290,6 +342,7 @@ bool optimize_run(
    // We no longer need cexp_set, and cexp2op, so free their memory
    cexp_set.resize(0, 0);
    cexp2op.clear();
+   timer.end_phase("get_cexp_info");
    // -----------------------------------------------------------------------
    // dynamic parameter information
    pod_vector<bool> par_usage;
@@ -300,6 +353,8 @@ bool optimize_run(
       vecad_used,
       par_usage
    );
+   timer.end_phase("get_par_usage");
+   //
    pod_vector<addr_t> dyn_previous;
    get_dyn_previous(
       play                ,
@@ -307,6 +362,7 @@ bool optimize_run(
       par_usage           ,
       dyn_previous
    );
+   timer.end_phase("get_dyn_previous");
    // -----------------------------------------------------------------------
    // conditional expression information
    //
@@ -538,6 +594,7 @@ bool optimize_run(
       ++i_dyn;
       i_arg += n_arg;
    }
+   timer.end_phase("record_dynamic");
    // -----------------------------------------------------------------------
    // There is an additional constant parameter for each cumulative summation
    // (that does not have a corresponding old parameter index).
@@ -1373,6 +1430,8 @@ bool optimize_run(
 # endif
       }
    }
+   timer.end_phase("record_variable");
+   //
    return exceed_collision_limit;
 }
 
@@ -0,0 +1,72 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_PHASE_TIMER_HPP
+# define CPPAD_LOCAL_OPTIMIZE_PHASE_TIMER_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <chrono>
+# include <iostream>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_phase_timer dev}
+
+Timing the Phases of the Optimizer
+##################################
+
+Syntax
+******
+| ``phase_timer`` *timer* ( *print* )
+| *timer* . ``end_phase`` ( *name* )
+
+print
+*****
+If this ``bool`` is true, the elapsed time for each phase of the
+optimizer is printed on standard output.
+Otherwise, *timer* does nothing.
+This corresponds to the optimize
+:ref:`optimize@options@print_timing` option.
+
+name
+****
+This ``const char*`` is the name of the phase that just ended.
+The time for this phase is from the construction of *timer* ,
+or the previous call to ``end_phase`` , to this call.
+
+Output
+******
+If *print* is true, each call to ``end_phase`` prints one line of the form
+
+   ``optimize:`` *name* ``=`` *seconds*
+
+{xrst_end optimize_phase_timer}
+*/
+class phase_timer {
+private:
+   // should the time for each phase be printed
+   const bool print_;
+   //
+   // time at which the current phase started
+   std::chrono::time_point<std::chrono::steady_clock> start_;
+public:
+   // constructor
+   phase_timer(bool print) : print_(print)
+   {  if( print_ )
+         start_ = std::chrono::steady_clock::now();
+   }
+   // end_phase
+   void end_phase(const char* name)
+   {  if( ! print_ )
+         return;
+      std::chrono::time_point<std::chrono::steady_clock> now;
+      now = std::chrono::steady_clock::now();
+      std::chrono::duration<double> difference = now - start_;
+      std::cout << "optimize: " << name << " = " << difference.count() << "\n";
+      start_ = now;
+   }
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
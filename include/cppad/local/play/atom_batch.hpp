@@ -0,0 +1,231 @@
+# ifndef CPPAD_LOCAL_PLAY_ATOM_BATCH_HPP
+# define CPPAD_LOCAL_PLAY_ATOM_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/pod_vector.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+/*!
+\file atom_batch.hpp
+Groups of atomic function calls that are evaluated together.
+*/
+
+/*!
+Information for one atomic function call in a recording.
+*/
+struct atom_batch_call {
+   /// index of this call in local::atomic_index
+   size_t atom_index;
+   /// call_id for this call
+   size_t call_id;
+   /// number of arguments for this call
+   size_t n;
+   /// number of results for this call
+   size_t m;
+   /// index in the argument vectors of the first argument for this call
+   size_t x_start;
+   /// index in the result vector of the first result for this call
+   size_t y_start;
+   /// index of the group for this call (num_group() if not in a group)
+   size_t group;
+};
+
+/*!
+The atomic function calls in a recording and the groups of calls
+that are evaluated by one forward_batch or reverse_batch call.
+
+All the calls in a group are for the same atomic function and have the
+same number of arguments and results. There is an anchor call for each
+group where all the calls in the group are evaluated. The other calls in
+the group are skipped when they are reached during a sweep.
+*/
+class atom_batch {
+private:
+   /// has this information been built for the current recording
+   bool built_;
+
+   /// information for each atomic function call, in recording order
+   pod_vector_maybe<atom_batch_call> call_;
+
+   /// for each argument: the variable or parameter index for the argument
+   pod_vector<size_t> x_index_;
+
+   /// for each argument: is the argument a variable
+   pod_vector<bool> x_is_var_;
+
+   /// for each result: the variable or parameter index for the result
+   pod_vector<size_t> y_index_;
+
+   /// for each result: is the result a variable
+   pod_vector<bool> y_is_var_;
+
+   /// for each group: call index of the anchor for this group
+   pod_vector<size_t> anchor_;
+
+   /// for each group g: members in member_[ start_[g] ], ...
+   /// member_[ start_[g+1] - 1 ] (size of start_ is num_group() + 1)
+   pod_vector<size_t> start_;
+
+   /// call indices for the members of the groups (in recording order)
+   pod_vector<size_t> member_;
+public:
+   /// default constructor
+   atom_batch(void)
+   : built_(false)
+   { }
+   /// assignment
+   void operator=(const atom_batch& other)
+   {  built_    = other.built_;
+      call_     = other.call_;
+      x_index_  = other.x_index_;
+      x_is_var_ = other.x_is_var_;
+      y_index_  = other.y_index_;
+      y_is_var_ = other.y_is_var_;
+      anchor_   = other.anchor_;
+      start_    = other.start_;
+      member_   = other.member_;
+   }
+   /// free all the memory for this information
+   void clear(void)
+   {  built_ = false;
+      call_.clear();
+      x_index_.clear();
+      x_is_var_.clear();
+      y_index_.clear();
+      y_is_var_.clear();
+      anchor_.clear();
+      start_.clear();
+      member_.clear();
+   }
+   /// has this information been built
+   bool built(void) const
+   {  return built_; }
+
+   /// is there at least one group
+   bool usable(void) const
+   {  return built_ && anchor_.size() > 0; }
+
+   /// number of atomic function calls
+   size_t num_call(void) const
+   {  return call_.size(); }
+
+   /// number of groups
+   size_t num_group(void) const
+   {  return anchor_.size(); }
+
+   /// information for a call
+   const atom_batch_call& call(size_t i_call) const
+   {  return call_[i_call]; }
+
+   /// variable or parameter index for an argument
+   size_t x_index(size_t i_x) const
+   {  return x_index_[i_x]; }
+
+   /// is an argument a variable
+   bool x_is_var(size_t i_x) const
+   {  return x_is_var_[i_x]; }
+
+   /// variable or parameter index for a result
+   size_t y_index(size_t i_y) const
+   {  return y_index_[i_y]; }
+
+   /// is a result a variable
+   bool y_is_var(size_t i_y) const
+   {  return y_is_var_[i_y]; }
+
+   /// call index for the anchor of a group
+   size_t anchor(size_t group) const
+   {  return anchor_[group]; }
+
+   /// number of calls in a group
+   size_t group_size(size_t group) const
+   {  return start_[group + 1] - start_[group]; }
+
+   /// call index for the k-th member of a group
+   size_t member(size_t group, size_t k) const
+   {  CPPAD_ASSERT_UNKNOWN( k < group_size(group) );
+      return member_[ start_[group] + k ];
+   }
+   /// amount of memory used by this information
+   size_t memory(void) const
+   {  return call_.size() * sizeof(atom_batch_call)
+         + ( x_index_.size() + y_index_.size() ) * sizeof(size_t)
+         + ( x_is_var_.size() + y_is_var_.size() ) * sizeof(bool)
+         + ( anchor_.size() + start_.size() + member_.size() )
+         * sizeof(size_t);
+   }
+   // ------------------------------------------------------------------------
+   // routines used to build this information
+   // ------------------------------------------------------------------------
+   /// start the information for the next call
+   void push_call(size_t atom_index, size_t call_id, size_t n, size_t m)
+   {  CPPAD_ASSERT_UNKNOWN( ! built_ );
+      atom_batch_call info;
+      info.atom_index = atom_index;
+      info.call_id    = call_id;
+      info.n          = n;
+      info.m          = m;
+      info.x_start    = x_index_.size();
+      info.y_start    = y_index_.size();
+      info.group      = 0;
+      call_.push_back(info);
+   }
+   /// next argument for the current call
+   void push_x(size_t index, bool is_var)
+   {  CPPAD_ASSERT_UNKNOWN( ! built_ );
+      x_index_.push_back(index);
+      x_is_var_.push_back(is_var);
+   }
+   /// next result for the current call
+   void push_y(size_t index, bool is_var)
+   {  CPPAD_ASSERT_UNKNOWN( ! built_ );
+      y_index_.push_back(index);
+      y_is_var_.push_back(is_var);
+   }
+   /// add a group with its members and anchor
+   void push_group(const pod_vector<size_t>& member, size_t anchor)
+   {  CPPAD_ASSERT_UNKNOWN( ! built_ );
+      CPPAD_ASSERT_UNKNOWN( member.size() > 1 );
+      if( start_.size() == 0 )
+         start_.push_back(0);
+      size_t group = anchor_.size();
+      for(size_t k = 0; k < member.size(); ++k)
+         member_.push_back( member[k] );
+      start_.push_back( member_.size() );
+      anchor_.push_back( anchor );
+      //
+      // group for the calls is finalized by finish
+      for(size_t k = 0; k < member.size(); ++k)
+         call_[ member[k] ].group = group + 1;
+   }
+   /*!
+   Mark this information as built.
+
+   \param usable
+   if false, no groups are used for this recording and
+   all the memory for this information is freed.
+   */
+   void finish(bool usable)
+   {  if( ! usable || anchor_.size() == 0 )
+         clear();
+      else
+      {  // convert group + 1 (0 for no group) to group (num_group for none)
+         size_t num_group = anchor_.size();
+         for(size_t i_call = 0; i_call < call_.size(); ++i_call)
+         {  if( call_[i_call].group == 0 )
+               call_[i_call].group = num_group;
+            else
+               --call_[i_call].group;
+         }
+      }
+      built_ = true;
+   }
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
@@ -0,0 +1,448 @@
+# ifndef CPPAD_LOCAL_PLAY_BINARY_CHECK_HPP
+# define CPPAD_LOCAL_PLAY_BINARY_CHECK_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cstring>
+# include <cppad/core/base_cond_exp.hpp>
+# include <cppad/local/op_code_var.hpp>
+# include <cppad/local/op_code_dyn.hpp>
+# include <cppad/local/play/recording.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+/*!
+\file binary_check.hpp
+Check that a recording read using the binary tape format can be used.
+*/
+
+/*!
+Check that a vector of bool read using the binary tape format
+only contains the values true and false.
+
+\param vec
+is the vector that was read. Its elements are checked as bytes
+because a bool with some other bit pattern has undefined behavior.
+
+\return
+is true if the bytes for every element of vec are the same as
+the bytes for true or the bytes for false.
+*/
+inline bool binary_check_bool(const pod_vector<bool>& vec)
+{  const bool value_true  = true;
+   const bool value_false = false;
+   for(size_t i = 0; i < vec.size(); ++i)
+   {  const bool* ptr = vec.data() + i;
+      bool ok = std::memcmp(ptr, &value_true, sizeof(bool)) == 0;
+      ok     |= std::memcmp(ptr, &value_false, sizeof(bool)) == 0;
+      if( ! ok )
+         return false;
+   }
+   return true;
+}
+
+/*!
+Check that every index in a recording is within the bounds of the vector
+it indexes; i.e., playing the recording back will not read or write
+outside of any of the vectors that the sweeps use.
+
+\param r
+is the recording read from the binary tape format.
+The values that are computed from other values
+(num_var_vecad_rec and dyn_ind2par_ind) are not used.
+
+\param num_par
+is the number of parameters in the recording
+(the size of all_par_vec).
+
+\param n_ind
+is the number of independent variables for the recording.
+
+\return
+is true if all the checks pass.
+Atomic and discrete function calls are not allowed in the binary
+tape format, so they cause a false return value.
+
+\par Checks
+<ul>
+<li> The operators are valid, BeginOp is the first operator,
+EndOp is the last operator, and the next n_ind operators are InvOp.
+<li> Variable arguments are less than the index of the first result
+for the operator that uses them (directed acyclic graph condition).
+<li> Parameter arguments are less than num_par.
+<li> VecAD offsets correspond to the beginning of a VecAD vector,
+load indices are less than num_var_load_rec,
+and text indices are less than the size of text_vec.
+<li> The variable number of arguments for CSumOp and CSkipOp
+are consistent and the operators that CSkipOp can skip are
+after the CSkipOp and before EndOp.
+<li> The arguments for all the operators use exactly arg_vec,
+the results use exactly num_var_rec variables,
+and num_var_load_rec is not more than the number of load operators.
+<li> The dynamic parameter operators, arguments, and the flags
+that identify dynamic parameters are consistent.
+</ul>
+*/
+inline bool binary_check_recording(
+   const recording& r       ,
+   size_t           num_par ,
+   size_t           n_ind   )
+{  //
+   // num_op, num_arg, num_text, num_vecad_ind
+   size_t num_op        = r.op_vec.size();
+   size_t num_arg       = r.arg_vec.size();
+   size_t num_text      = r.text_vec.size();
+   size_t num_vecad_ind = r.all_var_vecad_ind.size();
+   //
+   // text_vec must be '\0' terminated
+   if( 0 < num_text && r.text_vec[num_text - 1] != '\0' )
+      return false;
+   //
+   // vecad_start
+   // true for the offset of the first element of each VecAD vector
+   pod_vector<bool> vecad_start(num_vecad_ind);
+   for(size_t i = 0; i < num_vecad_ind; ++i)
+      vecad_start[i] = false;
+   size_t i_vecad = 0;
+   while( i_vecad < num_vecad_ind )
+   {  size_t length = size_t( r.all_var_vecad_ind[i_vecad] );
+      if( num_vecad_ind - i_vecad - 1 < length )
+         return false;
+      if( 0 < length )
+         vecad_start[i_vecad + 1] = true;
+      // the initial value for each element is a parameter
+      for(size_t k = 1; k <= length; ++k)
+      {  if( num_par <= size_t( r.all_var_vecad_ind[i_vecad + k] ) )
+            return false;
+      }
+      i_vecad += length + 1;
+   }
+   //
+   // first and last operator
+   if( num_op < 2 || num_par == 0 )
+      return false;
+   if( OpCode( r.op_vec[0] ) != BeginOp )
+      return false;
+   if( OpCode( r.op_vec[num_op - 1] ) != EndOp )
+      return false;
+   //
+   // n_var
+   // number of variables created before the current operator
+   size_t n_var = 0;
+   //
+   // i_arg
+   // index in arg_vec of the first argument for the current operator
+   size_t i_arg = 0;
+   //
+   // n_load
+   // number of VecAD load operators
+   size_t n_load = 0;
+   //
+   for(size_t i_op = 0; i_op < num_op; ++i_op)
+   {  //
+      // op
+      if( size_t( NumberOp ) <= size_t( r.op_vec[i_op] ) )
+         return false;
+      OpCode op = OpCode( r.op_vec[i_op] );
+      //
+      // BeginOp, InvOp, and EndOp are only allowed in their positions
+      if( (op == BeginOp) != (i_op == 0) )
+         return false;
+      if( (op == InvOp) != (0 < i_op && i_op <= n_ind) )
+         return false;
+      if( (op == EndOp) != (i_op + 1 == num_op) )
+         return false;
+      //
+      // n_op_arg
+      // number of arguments for this operator
+      size_t n_op_arg = NumArg(op);
+      if( op == CSumOp )
+      {  if( num_arg - i_arg < 5 )
+            return false;
+         n_op_arg = size_t( r.arg_vec[i_arg + 4] ) + 1;
+      }
+      if( op == CSkipOp )
+      {  if( num_arg - i_arg < 6 )
+            return false;
+         size_t n_true  = size_t( r.arg_vec[i_arg + 4] );
+         size_t n_false = size_t( r.arg_vec[i_arg + 5] );
+         if( num_arg < n_true || num_arg < n_false )
+            return false;
+         n_op_arg = 7 + n_true + n_false;
+      }
+      if( num_arg - i_arg < n_op_arg )
+         return false;
+      const addr_t* arg = r.arg_vec.data() + i_arg;
+      //
+      // is_var, is_par
+      // check a variable or parameter argument
+      auto is_var = [&](size_t j)
+      {  return size_t( arg[j] ) < n_var; };
+      auto is_par = [&](size_t j)
+      {  return size_t( arg[j] ) < num_par; };
+      auto is_var_or_par = [&](size_t j, bool var)
+      {  return var ? is_var(j) : is_par(j); };
+      //
+      // ok
+      bool ok = true;
+      switch( op )
+      {  // ---------------------------------------------------------------
+         // atomic and discrete functions are not in the binary format
+         case AFunOp:
+         case DisOp:
+         case FunapOp:
+         case FunavOp:
+         case FunrpOp:
+         case FunrvOp:
+         ok = false;
+         break;
+
+         // ---------------------------------------------------------------
+         // no arguments
+         case EndOp:
+         case InvOp:
+         break;
+
+         // ---------------------------------------------------------------
+         // one parameter argument
+         case BeginOp:
+         case ParOp:
+         ok = is_par(0);
+         break;
+
+         // ---------------------------------------------------------------
+         // one variable argument
+         case AbsOp:
+         case AcosOp:
+         case AcoshOp:
+         case AsinOp:
+         case AsinhOp:
+         case AtanOp:
+         case AtanhOp:
+         case CosOp:
+         case CoshOp:
+         case ExpOp:
+         case Expm1Op:
+         case LogOp:
+         case Log1pOp:
+         case NegOp:
+         case SignOp:
+         case SinOp:
+         case SinhOp:
+         case SqrtOp:
+         case TanOp:
+         case TanhOp:
+         ok = is_var(0);
+         break;
+
+         // variable followed by the parameters zero and one
+         case ErfOp:
+         case ErfcOp:
+         ok = is_var(0) && is_par(1) && is_par(2);
+         break;
+
+         // ---------------------------------------------------------------
+         // parameter, variable
+         case AddpvOp:
+         case DivpvOp:
+         case EqpvOp:
+         case LepvOp:
+         case LtpvOp:
+         case MulpvOp:
+         case NepvOp:
+         case PowpvOp:
+         case SubpvOp:
+         case ZmulpvOp:
+         ok = is_par(0) && is_var(1);
+         break;
+
+         // variable, parameter
+         case DivvpOp:
+         case LevpOp:
+         case LtvpOp:
+         case PowvpOp:
+         case SubvpOp:
+         case ZmulvpOp:
+         ok = is_var(0) && is_par(1);
+         break;
+
+         // variable, variable
+         case AddvvOp:
+         case DivvvOp:
+         case EqvvOp:
+         case LevvOp:
+         case LtvvOp:
+         case MulvvOp:
+         case NevvOp:
+         case PowvvOp:
+         case SubvvOp:
+         case ZmulvvOp:
+         ok = is_var(0) && is_var(1);
+         break;
+
+         // parameter, parameter
+         case EqppOp:
+         case LeppOp:
+         case LtppOp:
+         case NeppOp:
+         ok = is_par(0) && is_par(1);
+         break;
+
+         // ---------------------------------------------------------------
+         // VecAD load and store operators
+         case LdpOp:
+         case LdvOp:
+         case StppOp:
+         case StpvOp:
+         case StvpOp:
+         case StvvOp:
+         {  size_t offset = size_t( arg[0] );
+            ok = offset < num_vecad_ind && vecad_start[offset];
+            if( op == LdpOp || op == LdvOp )
+            {  ++n_load;
+               ok &= is_var_or_par(1, op == LdvOp);
+               ok &= size_t( arg[2] ) < r.num_var_load_rec;
+            }
+            else
+            {  ok &= is_var_or_par(1, op == StvpOp || op == StvvOp);
+               ok &= is_var_or_par(2, op == StpvOp || op == StvvOp);
+            }
+         }
+         break;
+
+         // ---------------------------------------------------------------
+         // CExpOp
+         case CExpOp:
+         ok  = size_t( arg[0] ) <= size_t( CompareNe );
+         ok &= size_t( arg[1] ) < 16;
+         for(size_t j = 2; ok && j < 6; ++j)
+            ok = is_var_or_par(j, ( size_t(arg[1]) >> (j - 2) ) & 1 );
+         break;
+
+         // ---------------------------------------------------------------
+         // PriOp
+         case PriOp:
+         ok  = size_t( arg[0] ) < 4;
+         ok &= is_var_or_par(1, size_t(arg[0]) & 1);
+         ok &= is_var_or_par(3, size_t(arg[0]) & 2);
+         ok &= size_t( arg[2] ) < num_text && size_t( arg[4] ) < num_text;
+         break;
+
+         // ---------------------------------------------------------------
+         // CSkipOp
+         case CSkipOp:
+         {  // the optimizer copies all four CExpOp flags to arg[1]
+            ok  = size_t( arg[0] ) <= size_t( CompareNe );
+            ok &= size_t( arg[1] ) < 16;
+            ok &= is_var_or_par(2, size_t(arg[1]) & 1);
+            ok &= is_var_or_par(3, size_t(arg[1]) & 2);
+            size_t n_skip = n_op_arg - 7;
+            ok &= size_t( arg[6 + n_skip] ) == n_skip;
+            // the operators that are skipped come after this operator
+            // and before EndOp
+            for(size_t j = 6; ok && j < 6 + n_skip; ++j)
+               ok = i_op < size_t( arg[j] ) && size_t( arg[j] ) + 1 < num_op;
+         }
+         break;
+
+         // ---------------------------------------------------------------
+         // CSumOp
+         case CSumOp:
+         {  size_t k   = size_t( arg[1] );
+            size_t ell = size_t( arg[2] );
+            size_t m   = size_t( arg[3] );
+            size_t n   = size_t( arg[4] );
+            ok  = 5 <= k && k <= ell && ell <= m && m <= n;
+            ok &= size_t( arg[n] ) == n;
+            ok &= is_par(0);
+            for(size_t j = 5; ok && j < ell; ++j)
+               ok = is_var(j);
+            for(size_t j = ell; ok && j < n; ++j)
+               ok = is_par(j);
+         }
+         break;
+
+         // ---------------------------------------------------------------
+         default:
+         ok = false;
+         break;
+      }
+      if( ! ok )
+         return false;
+      //
+      // n_var, i_arg
+      n_var += NumRes(op);
+      i_arg += n_op_arg;
+   }
+   if( n_var != r.num_var_rec || i_arg != num_arg )
+      return false;
+   if( n_load < r.num_var_load_rec )
+      return false;
+   // -----------------------------------------------------------------------
+   // dynamic parameters
+   // -----------------------------------------------------------------------
+   //
+   // num_dyn
+   size_t num_dyn = r.dyn_par_op.size();
+   if( r.dyn_par_is.size() != num_par || num_dyn < r.num_dynamic_ind )
+      return false;
+   if( ! binary_check_bool(r.dyn_par_is) )
+      return false;
+   //
+   // i_par, i_dyn, i_arg
+   size_t i_dyn = 0;
+   i_arg        = 0;
+   for(size_t i_par = 0; i_par < num_par; ++i_par)
+   {  if( ! r.dyn_par_is[i_par] )
+         continue;
+      if( i_dyn == num_dyn )
+         return false;
+      //
+      // op
+      if( size_t( number_dyn ) <= size_t( r.dyn_par_op[i_dyn] ) )
+         return false;
+      op_code_dyn op = op_code_dyn( r.dyn_par_op[i_dyn] );
+      //
+      // the independent dynamic parameters come first
+      if( (op == ind_dyn) != (i_dyn < r.num_dynamic_ind) )
+         return false;
+      //
+      // atomic and discrete functions are not in the binary format
+      if( op == atom_dyn || op == result_dyn || op == dis_dyn )
+         return false;
+      //
+      // n_arg
+      size_t n_arg = num_arg_dyn(op);
+      if( r.dyn_par_arg.size() - i_arg < n_arg )
+         return false;
+      const addr_t* arg = r.dyn_par_arg.data() + i_arg;
+      //
+      // non-parameter argument
+      size_t num_non_par = num_non_par_arg_dyn(op);
+      if( op == cond_exp_dyn )
+      {  CPPAD_ASSERT_UNKNOWN( num_non_par == 1 );
+         if( size_t( CompareNe ) < size_t( arg[0] ) )
+            return false;
+      }
+      //
+      // parameter arguments must come before this parameter
+      for(size_t j = num_non_par; j < n_arg; ++j)
+      {  if( i_par <= size_t( arg[j] ) )
+            return false;
+      }
+      //
+      // i_dyn, i_arg
+      ++i_dyn;
+      i_arg += n_arg;
+   }
+   if( i_dyn != num_dyn || i_arg != r.dyn_par_arg.size() )
+      return false;
+   //
+   return true;
+}
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
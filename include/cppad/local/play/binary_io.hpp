@@ -0,0 +1,126 @@
+# ifndef CPPAD_LOCAL_PLAY_BINARY_IO_HPP
+# define CPPAD_LOCAL_PLAY_BINARY_IO_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <istream>
+# include <ostream>
+# include <type_traits>
+# include <limits>
+# include <cppad/local/pod_vector.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+/*!
+\file binary_io.hpp
+Low level routines used to write and read the binary tape format.
+
+Every item in the format is a multiple of binary_align bytes long.
+Hence, if the file starts on an aligned address, so does every vector in it.
+*/
+
+/// alignment (in bytes) for each item in the binary tape format
+const size_t binary_align = 8;
+
+/// write a size_t value as a 64 bit unsigned integer
+inline void binary_write_size(std::ostream& os, size_t value)
+{  unsigned long long u = static_cast<unsigned long long>(value);
+   CPPAD_ASSERT_UNKNOWN( sizeof(u) == binary_align );
+   os.write( reinterpret_cast<const char*>(&u), sizeof(u) );
+}
+
+/// read a size_t value written by binary_write_size
+/// (returns false if it could not be read)
+inline bool binary_read_size(std::istream& is, size_t& value)
+{  unsigned long long u = 0;
+   is.read( reinterpret_cast<char*>(&u), sizeof(u) );
+   value = static_cast<size_t>(u);
+   return is.good() && static_cast<unsigned long long>(value) == u;
+}
+
+/*!
+write a vector of plain old data as its length followed by its elements
+(padded with zeros to a multiple of binary_align bytes).
+
+\param os
+stream the vector is written to.
+
+\param data
+pointer to the first element of the vector.
+
+\param size
+number of elements in the vector.
+*/
+template <class Type>
+void binary_write_vec(std::ostream& os, const Type* data, size_t size)
+{  binary_write_size(os, size);
+   size_t n_byte = size * sizeof(Type);
+   if( n_byte > 0 )
+      os.write( reinterpret_cast<const char*>(data), std::streamsize(n_byte) );
+   size_t n_pad = (binary_align - n_byte % binary_align) % binary_align;
+   const char zero[binary_align] = {0, 0, 0, 0, 0, 0, 0, 0};
+   os.write(zero, std::streamsize(n_pad) );
+}
+
+/*!
+number of bytes that remain to be read in a stream.
+
+\param is
+stream that is being read.
+
+\return
+is the number of bytes from the current position to the end of the stream.
+If the stream does not support positioning (e.g., a pipe),
+the maximum size_t value is returned.
+*/
+inline size_t binary_remaining(std::istream& is)
+{  std::istream::pos_type pos = is.tellg();
+   if( pos == std::istream::pos_type(-1) )
+      return std::numeric_limits<size_t>::max();
+   is.seekg(0, std::ios::end);
+   std::istream::pos_type end = is.tellg();
+   is.seekg(pos);
+   if( end == std::istream::pos_type(-1) || ! is.good() )
+      return std::numeric_limits<size_t>::max();
+   return size_t( end - pos );
+}
+
+/*!
+read a vector written by binary_write_vec.
+
+\param is
+stream the vector is read from.
+
+\param vec
+is a pod_vector or pod_vector_maybe with plain old data elements.
+The input size does not matter. Upon return it contains the vector.
+
+\return
+is false if the vector could not be read.
+This includes the case where the size of the vector is more than
+the number of bytes that remain in the stream; i.e., a corrupted size
+does not cause a large memory allocation.
+*/
+template <class Vector>
+bool binary_read_vec(std::istream& is, Vector& vec)
+{  typedef typename std::remove_reference<decltype( vec[0] )>::type Type;
+   size_t size;
+   if( ! binary_read_size(is, size) )
+      return false;
+   if( binary_remaining(is) / sizeof(Type) < size )
+      return false;
+   vec.resize(size);
+   size_t n_byte = size * sizeof(Type);
+   if( n_byte > 0 )
+      is.read( reinterpret_cast<char*>( vec.data() ), std::streamsize(n_byte) );
+   size_t n_pad = (binary_align - n_byte % binary_align) % binary_align;
+   char pad[binary_align];
+   is.read(pad, std::streamsize(n_pad) );
+   return is.good();
+}
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
@@ -0,0 +1,430 @@
+# ifndef CPPAD_LOCAL_PLAY_COMPACT_TAPE_HPP
+# define CPPAD_LOCAL_PLAY_COMPACT_TAPE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/op_code_var.hpp>
+# include <algorithm>
+# include <limits>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+/*!
+\file compact_tape.hpp
+Compact encoding of the operators and arguments in a recording.
+It is used by the binary tape format and for a player that stores its
+recording using this encoding (see player::compact_tape).
+
+\par Encoding
+The operators and their arguments are stored in one vector of bytes.
+For each operator, the op code is followed by its arguments.
+Each value is stored using a variable number of bytes where
+the low 7 bits of each byte hold data and the high bit is one if there
+are more bytes for the value.
+
+\par Arguments
+Let r be the index of the primary (last) result for an operator
+(the same as var_index for const_sequential_iterator::op_info)
+and a an argument for this operator.
+Variable arguments are usually close to r.
+If r - a is less than a, the argument is stored as 2 * (r - a) + 1.
+Otherwise it is stored as 2 * a .
+Hence both variable and parameter indices are usually stored in one or
+two bytes.
+
+\par Number of Arguments
+The number of arguments for an operator is NumArg(op) except for
+CSumOp and CSkipOp. For these operators the number of arguments is
+determined from the first arguments (in the same way as for
+const_sequential_iterator::correct_before_increment).
+*/
+
+/// write a value at the end of a compact byte vector
+inline void compact_put(pod_vector<unsigned char>& byte_vec, size_t value)
+{  while( value >= 128 )
+   {  byte_vec.push_back( (unsigned char)( (value & 127) | 128 ) );
+      value >>= 7;
+   }
+   byte_vec.push_back( (unsigned char)( value ) );
+}
+
+/// encoded value for argument a when the reference variable index is r
+inline size_t compact_arg_encode(size_t r, size_t a)
+{  if( a <= r && r - a < a )
+      return 2 * (r - a) + 1;
+   return 2 * a;
+}
+
+/*!
+Argument corresponding to an encoded value.
+
+\param r
+is the reference variable index; see compact_arg_encode.
+
+\param value
+is the encoded value for this argument.
+
+\param a [out]
+is the argument corresponding to value.
+
+\return
+is false if value does not correspond to an argument; i.e.,
+it is odd and (value >> 1) is greater than r,
+or the argument cannot be represented by addr_t.
+In this case, the value of a is not specified.
+*/
+inline bool compact_arg_decode(size_t r, size_t value, addr_t& a)
+{  size_t a_size_t = value >> 1;
+   if( value & 1 )
+   {  if( a_size_t > r )
+         return false;
+      a_size_t = r - a_size_t;
+   }
+   if( a_size_t > size_t( std::numeric_limits<addr_t>::max() ) )
+      return false;
+   a = addr_t( a_size_t );
+   return true;
+}
+
+/*!
+Number of arguments for an operator.
+
+\param op
+is the operator.
+
+\param arg
+is the arguments for this operator. Only the first arguments are used
+(the first five for CSumOp and the first six for CSkipOp).
+*/
+inline size_t compact_num_arg(OpCode op, const addr_t* arg)
+{  if( op == CSumOp )
+      return size_t( arg[4] ) + 1;
+   if( op == CSkipOp )
+      return 7 + size_t( arg[4] ) + size_t( arg[5] );
+   return NumArg(op);
+}
+
+/*!
+Encode the operators and arguments in a recording.
+
+\param num_var
+is the number of variables in the recording.
+
+\param op_vec
+is the vector of operators in the recording.
+
+\param arg_vec
+is the vector of arguments for all the operators.
+
+\param byte_vec
+The input size does not matter.
+Upon return it is the compact encoding of op_vec and arg_vec.
+*/
+inline void compact_encode(
+   size_t                      num_var  ,
+   const pod_vector<opcode_t>& op_vec   ,
+   const pod_vector<addr_t>&   arg_vec  ,
+   pod_vector<unsigned char>&  byte_vec )
+{  byte_vec.resize(0);
+   byte_vec.reserve( op_vec.size() + 2 * arg_vec.size() );
+   //
+   size_t i_arg     = 0;
+   size_t var_index = 0;
+   for(size_t i_op = 0; i_op < op_vec.size(); ++i_op)
+   {  OpCode op = OpCode( op_vec[i_op] );
+      // var_index is zero for BeginOp
+      if( i_op > 0 )
+         var_index += NumRes(op);
+      CPPAD_ASSERT_UNKNOWN( var_index < num_var || NumRes(op) == 0 );
+      compact_put(byte_vec, size_t(op) );
+      //
+      size_t n_arg = compact_num_arg(op, arg_vec.data() + i_arg);
+      CPPAD_ASSERT_UNKNOWN( i_arg + n_arg <= arg_vec.size() );
+      for(size_t k = 0; k < n_arg; ++k)
+      {  size_t a = size_t( arg_vec[i_arg + k] );
+         compact_put(byte_vec, compact_arg_encode(var_index, a) );
+      }
+      i_arg += n_arg;
+   }
+   CPPAD_ASSERT_UNKNOWN( i_arg == arg_vec.size() );
+}
+
+/*!
+Decode a compact encoding of the operators and arguments in a recording.
+
+\param num_var
+is the number of variables in the recording.
+
+\param num_par
+is the number of parameters in the recording.
+
+\param num_vecad_ind
+is the size of the VecAD index vector in the recording.
+
+\param num_text
+is the size of the text vector in the recording.
+
+\param byte_vec
+is the compact encoding of the recording; see compact_encode.
+
+\param op_vec
+The input size does not matter.
+Upon return it is the vector of operators in the recording.
+
+\param arg_vec
+The input size does not matter.
+Upon return it is the vector of arguments for all the operators.
+
+\return
+is false if byte_vec is not a valid encoding; e.g., if it was read from
+a corrupted file. This includes the case where an operator is not valid,
+a result index is not less than num_var,
+a relative argument is before the first variable,
+an argument cannot be represented by addr_t,
+or an argument is not less than every bound that it could correspond to.
+In this case, the values in op_vec and arg_vec are not specified.
+
+\par Bounds
+Each argument is a variable index, a parameter index, a VecAD offset,
+a text index, a load index, an operator index, an argument count,
+or a flag. The first four are less than num_var, num_par, num_vecad_ind,
+and num_text. The next three are less than byte_vec.size() because each
+operator and argument uses at least one byte. The flags are less than 16.
+The arguments are checked against their specific bound by
+binary_check_recording.
+*/
+inline bool compact_decode(
+   size_t                            num_var       ,
+   size_t                            num_par       ,
+   size_t                            num_vecad_ind ,
+   size_t                            num_text      ,
+   const pod_vector<unsigned char>&  byte_vec      ,
+   pod_vector<opcode_t>&             op_vec        ,
+   pod_vector<addr_t>&               arg_vec       )
+{  op_vec.resize(0);
+   arg_vec.resize(0);
+   //
+   // max_arg
+   // every argument is less than this value; see Bounds above
+   size_t max_arg = std::max(num_var, num_par);
+   max_arg        = std::max(max_arg, num_vecad_ind);
+   max_arg        = std::max(max_arg, num_text);
+   max_arg        = std::max(max_arg, byte_vec.size() );
+   max_arg        = std::max(max_arg, size_t(16) );
+   //
+   const unsigned char* ptr = byte_vec.data();
+   const unsigned char* end = byte_vec.data() + byte_vec.size();
+   //
+   // get: reads the next value and checks that it is in the encoding
+   // and can be represented by size_t
+   size_t value;
+   auto get = [&ptr, end, &value](void)
+   {  value     = 0;
+      for(size_t shift = 0; ptr < end; shift += 7)
+      {  if( shift >= 8 * sizeof(size_t) )
+            return false;
+         unsigned char byte = *ptr++;
+         value |= size_t( byte & 127 ) << shift;
+         if( (byte & 128) == 0 )
+            return true;
+      }
+      return false;
+   };
+   // get_arg: reads the next argument and checks that it is less than max_arg
+   size_t var_index = 0;
+   auto get_arg = [&get, &value, &var_index, max_arg, &arg_vec](void)
+   {  addr_t a;
+      if( ! get() || ! compact_arg_decode(var_index, value, a) )
+         return false;
+      if( size_t(a) >= max_arg )
+         return false;
+      arg_vec.push_back(a);
+      return true;
+   };
+   while( ptr < end )
+   {  if( ! get() || value >= size_t(NumberOp) )
+         return false;
+      OpCode op = OpCode(value);
+      if( op_vec.size() > 0 )
+         var_index += NumRes(op);
+      if( var_index >= num_var )
+         return false;
+      op_vec.push_back( opcode_t(op) );
+      //
+      size_t n_arg = NumArg(op);
+      if( op == CSumOp )
+         n_arg = 5;
+      else if( op == CSkipOp )
+         n_arg = 6;
+      size_t i_arg = arg_vec.size();
+      for(size_t k = 0; k < n_arg; ++k)
+      {  if( ! get_arg() )
+            return false;
+      }
+      size_t n_total = compact_num_arg(op, arg_vec.data() + i_arg);
+      for(size_t k = n_arg; k < n_total; ++k)
+      {  if( ! get_arg() )
+            return false;
+      }
+   }
+   return true;
+}
+
+/*!
+Constant sequential iterator for a compact encoding of a recording.
+
+\par
+Except for the constructor, the public API for this class is the same as
+for const_sequential_iterator with the following exceptions:
+It can only move forward; i.e., there is no operator-- .
+The arguments returned by op_info are a decoded copy and are only valid
+until the next increment of the iterator.
+*/
+class const_compact_iterator {
+private:
+   /// pointer to the next byte in the encoding
+   const unsigned char*      byte_;
+
+   /// pointer one past the last byte in the encoding
+   const unsigned char*      byte_end_;
+
+   /// number of variables in tape
+   size_t                    num_var_;
+
+   /// index of current operator
+   size_t                    op_index_;
+
+   /// index of last result for current operator
+   size_t                    var_index_;
+
+   /// value of current operator
+   OpCode                    op_;
+
+   /// decoded arguments for the current operator
+   pod_vector<addr_t>        arg_;
+
+   /// read the next value in the encoding
+   size_t get(void)
+   {  CPPAD_ASSERT_UNKNOWN( byte_ < byte_end_ );
+      size_t value = 0;
+      size_t shift = 0;
+      while( *byte_ & 128 )
+      {  value |= size_t( *byte_++ & 127 ) << shift;
+         shift += 7;
+      }
+      value |= size_t( *byte_++ ) << shift;
+      return value;
+   }
+
+   /// decode the arguments for the range [begin, end) in arg_
+   void get_arg(size_t begin, size_t end)
+   {  for(size_t k = begin; k < end; ++k)
+      {  size_t value = get();
+         size_t a     = value >> 1;
+         if( value & 1 )
+            a = var_index_ - a;
+         arg_[k] = addr_t( a );
+      }
+   }
+
+   /// decode the operator and arguments that start at byte_
+   void decode(void)
+   {  op_ = OpCode( get() );
+      //
+      // the reference index for the arguments is var_index_; see encode
+      if( op_index_ > 0 )
+         var_index_ += NumRes(op_);
+      //
+      // the first arguments determine the number for CSumOp and CSkipOp
+      size_t n_arg = NumArg(op_);
+      if( op_ == CSumOp )
+         n_arg = 5;
+      else if( op_ == CSkipOp )
+         n_arg = 6;
+      arg_.resize(n_arg);
+      get_arg(0, n_arg);
+      //
+      size_t n_total = compact_num_arg(op_, arg_.data() );
+      if( n_arg < n_total )
+      {  arg_.reserve(n_total);
+         arg_.resize(n_total);
+         get_arg(n_arg, n_total);
+      }
+   }
+public:
+   /*!
+   Create a compact iterator starting at the beginning of the tape.
+
+   \param num_var
+   is the number of variables in the tape.
+
+   \param byte_vec
+   is the compact encoding of the operators and arguments in the tape
+   (see compact_encode). It must not change while this iterator is used.
+   */
+   const_compact_iterator(
+      size_t                           num_var  ,
+      const pod_vector<unsigned char>& byte_vec )
+   :
+   byte_      ( byte_vec.data() )                   ,
+   byte_end_  ( byte_vec.data() + byte_vec.size() ) ,
+   num_var_   ( num_var )                           ,
+   op_index_  ( 0 )                                 ,
+   var_index_ ( 0 )                                 ,
+   op_        ( NumberOp )
+   {  decode();
+      CPPAD_ASSERT_UNKNOWN( op_ == BeginOp );
+      CPPAD_ASSERT_NARG_NRES(op_, 1, 1);
+   }
+   /*!
+   Advance iterator to next operator
+   */
+   const_compact_iterator& operator++(void)
+   {  ++op_index_;
+      decode();
+      return *this;
+   }
+   /*!
+   Correction applied before ++ operation when current operator
+   is CSumOp or CSkipOp (no correction is necessary for this iterator).
+   */
+   void correct_before_increment(void)
+   {  CPPAD_ASSERT_UNKNOWN( op_ == CSumOp || op_ == CSkipOp );
+      return;
+   }
+   /*!
+   \brief
+   Get information corresponding to current operator.
+
+   \param op [out]
+   op code for this operator.
+
+   \param arg [out]
+   pointer to the first arguement to this operator.
+   It is only valid until the next increment of this iterator.
+
+   \param var_index [out]
+   index of the last variable (primary variable) for this operator.
+   If there is no primary variable for this operator, var_index
+   is not sepcified and could have any value.
+   */
+   void op_info(
+      OpCode&        op         ,
+      const addr_t*& arg        ,
+      size_t&        var_index  ) const
+   {  op        = op_;
+      arg       = arg_.data();
+      CPPAD_ASSERT_UNKNOWN( var_index_ < num_var_ || NumRes(op) == 0 );
+      var_index = var_index_;
+   }
+   /// current operator index
+   size_t op_index(void)
+   {  return op_index_; }
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
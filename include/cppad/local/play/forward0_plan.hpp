@@ -0,0 +1,225 @@
+# ifndef CPPAD_LOCAL_PLAY_FORWARD0_PLAN_HPP
+# define CPPAD_LOCAL_PLAY_FORWARD0_PLAN_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/pod_vector.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+/*!
+\file forward0_plan.hpp
+Pre-decoded execution plan for zero order forward mode.
+*/
+
+/*!
+State that is shared by all the instructions in a forward0_plan.
+
+\tparam Base
+type used for the zero order forward mode calculations.
+*/
+template <class Base>
+struct forward0_state {
+   /// first argument for the BeginOp; i.e., arg_vec_.data() in player
+   const addr_t* arg;
+   /// number of parameters in the recording
+   size_t        num_par;
+   /// all the parameters in the recording
+   const Base*   parameter;
+   /// maximum number of orders that fit in taylor
+   size_t        J;
+   /// Taylor coefficients for all the variables
+   Base*         taylor;
+   /// if zero, comparison operators are not checked
+   size_t        compare_change_count;
+   /// number of comparisons that are different from when recorded
+   size_t        compare_change_number;
+   /// operator index for the compare_change_count comparison change
+   size_t        compare_change_op_index;
+};
+
+/*!
+One pre-decoded operator in a forward0_plan.
+
+\tparam Base
+type used for the zero order forward mode calculations.
+*/
+template <class Base>
+struct forward0_instruction {
+   /// function that executes this operator
+   void (*handler)(
+      const forward0_instruction& ins, forward0_state<Base>& state
+   );
+   /// index of this operator in the recording
+   addr_t op_index;
+   /// index of the primary result for this operator
+   addr_t i_var;
+   /// index in arg_vec_ of the first argument for this operator
+   addr_t i_arg;
+};
+
+/*!
+A flat array of handler pointers with resolved argument and result
+indices. It is built once per recording and used by sweep::forward0
+to avoid decoding each operator during every zero order forward sweep.
+
+\tparam Base
+type used for the zero order forward mode calculations.
+*/
+template <class Base>
+class forward0_plan {
+private:
+   /// has this plan been built for the current recording
+   bool built_;
+
+   /// can this recording be executed using this plan
+   bool usable_;
+
+   /// the instructions in the order they are executed
+   pod_vector_maybe< forward0_instruction<Base> > ins_vec_;
+
+   /// has the level schedule been built for this plan
+   bool level_built_;
+
+   /// instructions that compute variables sorted by level
+   pod_vector_maybe< forward0_instruction<Base> > level_ins_;
+
+   /// the instructions for level ell are level_ins_[ level_start_[ell] ] ,
+   /// ... , level_ins_[ level_start_[ell+1] - 1 ]
+   pod_vector<size_t> level_start_;
+
+   /// comparison instructions in the order they are executed
+   pod_vector_maybe< forward0_instruction<Base> > compare_ins_;
+public:
+   /// default constructor
+   forward0_plan(void)
+   : built_(false), usable_(false), level_built_(false)
+   { }
+   /// assignment (the instructions do not depend on where arg_vec_ is)
+   void operator=(const forward0_plan& plan)
+   {  built_       = plan.built_;
+      usable_      = plan.usable_;
+      ins_vec_     = plan.ins_vec_;
+      level_built_ = plan.level_built_;
+      level_ins_   = plan.level_ins_;
+      level_start_ = plan.level_start_;
+      compare_ins_ = plan.compare_ins_;
+   }
+   /// swap this plan with another plan
+   void swap(forward0_plan& other)
+   {  std::swap(built_,  other.built_);
+      std::swap(usable_, other.usable_);
+      ins_vec_.swap(other.ins_vec_);
+      std::swap(level_built_, other.level_built_);
+      level_ins_.swap(other.level_ins_);
+      level_start_.swap(other.level_start_);
+      compare_ins_.swap(other.compare_ins_);
+   }
+   /// free all the memory for this plan
+   void clear(void)
+   {  built_       = false;
+      usable_      = false;
+      level_built_ = false;
+      ins_vec_.clear();
+      level_ins_.clear();
+      level_start_.clear();
+      compare_ins_.clear();
+   }
+   /// has this plan been built
+   bool built(void) const
+   {  return built_; }
+
+   /// can this recording be executed using this plan
+   bool usable(void) const
+   {  return usable_; }
+
+   /// number of instructions in this plan
+   size_t size(void) const
+   {  return ins_vec_.size(); }
+
+   /// pointer to the first instruction in this plan
+   const forward0_instruction<Base>* data(void) const
+   {  return ins_vec_.data(); }
+
+   /// has the level schedule been built (see sweep::setup_forward0_level)
+   bool level_built(void) const
+   {  return level_built_; }
+
+   /// number of levels in the level schedule
+   size_t num_level(void) const
+   {  return level_start_.size() - 1; }
+
+   /// number of instructions at a level
+   size_t level_size(size_t ell) const
+   {  return level_start_[ell + 1] - level_start_[ell]; }
+
+   /// pointer to the first instruction at a level
+   const forward0_instruction<Base>* level_data(size_t ell) const
+   {  return level_ins_.data() + level_start_[ell]; }
+
+   /// number of comparison instructions
+   size_t num_compare(void) const
+   {  return compare_ins_.size(); }
+
+   /// pointer to the first comparison instruction
+   const forward0_instruction<Base>* compare_data(void) const
+   {  return compare_ins_.data(); }
+
+   /// amount of memory used by this plan
+   size_t memory(void) const
+   {  size_t n_ins = ins_vec_.size() + level_ins_.size() + compare_ins_.size();
+      return n_ins * sizeof( forward0_instruction<Base> )
+         + level_start_.size() * sizeof(size_t);
+   }
+
+   /// add an instruction to the end of this plan
+   void push_back(const forward0_instruction<Base>& ins)
+   {  CPPAD_ASSERT_UNKNOWN( ! built_ );
+      ins_vec_.push_back(ins);
+   }
+   /*!
+   Set the level schedule for this plan.
+
+   \param level_ins
+   instructions that compute variables sorted by level
+   (swapped with the schedule and empty upon return).
+
+   \param level_start
+   index in level_ins of the first instruction at each level
+   followed by the size of level_ins (empty upon return).
+
+   \param compare_ins
+   comparison instructions in the order they are executed
+   (empty upon return).
+   */
+   void set_level(
+      pod_vector_maybe< forward0_instruction<Base> >& level_ins    ,
+      pod_vector<size_t>&                             level_start  ,
+      pod_vector_maybe< forward0_instruction<Base> >& compare_ins  )
+   {  CPPAD_ASSERT_UNKNOWN( built_ && usable_ && ! level_built_ );
+      CPPAD_ASSERT_UNKNOWN( level_start.size() > 0 );
+      level_ins_.swap(level_ins);
+      level_start_.swap(level_start);
+      compare_ins_.swap(compare_ins);
+      level_built_ = true;
+   }
+   /*!
+   Mark this plan as built.
+
+   \param usable
+   if false, the recording contains an operator that does not have a handler
+   and the instructions in this plan are freed.
+   */
+   void finish(bool usable)
+   {  built_  = true;
+      usable_ = usable;
+      if( ! usable )
+         ins_vec_.clear();
+   }
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
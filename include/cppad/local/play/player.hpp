@@ -5,11 +5,19 @@
 // SPDX-FileContributor: 2003-22 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
+# include <memory>
 # include <cppad/local/play/addr_enum.hpp>
 # include <cppad/local/play/sequential_iterator.hpp>
 # include <cppad/local/play/subgraph_iterator.hpp>
 # include <cppad/local/play/random_setup.hpp>
+# include <cppad/local/play/forward0_plan.hpp>
+# include <cppad/local/play/atom_batch.hpp>
+# include <cppad/local/play/recording.hpp>
+# include <cppad/local/play/binary_io.hpp>
+# include <cppad/local/play/binary_check.hpp>
+# include <cppad/local/play/compact_tape.hpp>
 # include <cppad/local/atom_state.hpp>
+# include <cppad/local/hash_code.hpp>
 # include <cppad/local/is_pod.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
@@ -32,87 +40,102 @@ class player {
    template <class AnotherBase> friend class player;
 private:
    // ----------------------------------------------------------------------
-   // information that defines the recording
+   // The member variables below are shared pointers. Copies of a player
+   // share the same objects and an object is not changed while it may be
+   // shared. A player that needs to change an object first makes its own
+   // copy of it; see all_par_vec(), forward0_plan(), and atom_batch().
 
-   /// Number of independent dynamic parameters
-   size_t num_dynamic_ind_;
-
-   /// Number of variables in the recording.
-   size_t num_var_rec_;
-
-   /// number of vecad load opeations in the reconding
-   size_t num_var_load_rec_;
-
-   /// Number of VecAD vectors in the recording
-   size_t num_var_vecad_rec_;
-
-   /// The operators in the recording.
-   pod_vector<opcode_t> op_vec_;
-
-   /// The operation argument indices in the recording
-   pod_vector<addr_t> arg_vec_;
-
-   /// Character strings ('\\0' terminated) in the recording.
-   pod_vector<char> text_vec_;
-
-   /// The VecAD indices in the recording.
-   pod_vector<addr_t> all_var_vecad_ind_;
+   /// Information that defines the recording (not changed after creation)
+   std::shared_ptr<const play::recording> rec_;
 
    /// All of the parameters in the recording.
    /// Use pod_maybe because Base may not be plain old data.
-   pod_vector_maybe<Base> all_par_vec_;
-
-   /// Which elements of all_par_vec_ are dynamic parameters
-   /// (size equal number of parametrers)
-   pod_vector<bool> dyn_par_is_;
-
-   /// mapping from dynamic parameter index to parameter index
-   /// 1: size equal to number of dynamic parameters
-   /// 2: dyn_ind2par_ind_[j] < dyn_ind2par_ind_[j+1]
-   pod_vector<addr_t> dyn_ind2par_ind_;
-
-   /// operators for just the dynamic parameters
-   /// (size equal number of dynamic parameters)
-   pod_vector<opcode_t> dyn_par_op_;
-
-   /// arguments for the dynamic parameter operators
-   pod_vector<addr_t> dyn_par_arg_;
-
-   // ----------------------------------------------------------------------
-   // Information needed to use member functions that begin with random_
-   // and for using const_subgraph_iterator.
-
-   /// index in arg_vec_ corresonding to the first argument for each operator
-   pod_vector<unsigned char> op2arg_vec_;
+   /// This is separate from rec_ because new_dynamic changes its values.
+   std::shared_ptr< pod_vector_maybe<Base> > all_par_vec_;
+
+   /// Information needed to use member functions that begin with random_
+   /// and for using const_subgraph_iterator (null when not setup).
+   std::shared_ptr<const play::random_table> random_;
+
+   /// Pre-decoded zero order forward plan for this recording
+   /// (see sweep::setup_forward0_plan).
+   std::shared_ptr< play::forward0_plan<Base> > forward0_plan_;
+
+   /// Groups of atomic function calls that are evaluated together
+   /// (see sweep::setup_atom_batch).
+   std::shared_ptr<play::atom_batch> atom_batch_;
+
+   /// Set rec_ and random_ to copies of the specified objects
+   /// (used in parallel mode where the objects are not shared).
+   void copy_recording(
+      const std::shared_ptr<const play::recording>&    rec    ,
+      const std::shared_ptr<const play::random_table>& random )
+   {  std::shared_ptr<play::recording> new_rec =
+         std::make_shared<play::recording>();
+      *new_rec = *rec;
+      rec_     = new_rec;
+      //
+      random_ = nullptr;
+      if( random != nullptr )
+      {  std::shared_ptr<play::random_table> new_random =
+            std::make_shared<play::random_table>();
+         *new_random = *random;
+         random_     = new_random;
+      }
+   }
 
-   /*!
-   Index of the result variable for each operator. If the operator has
-   no results, this is not defined. The invalid index num_var_rec_ is used
-   when NDEBUG is not defined. If the operator has more than one result, this
-   is the primary result; i.e., the last result. Auxillary are only used by
-   the operator and not used by other operators.
-   */
-   pod_vector<unsigned char> op2var_vec_;
+   /// Check that the operators and arguments are not stored using the
+   /// compact encoding (they must be expanded for this operation).
+   void assert_not_compact(void) const
+   {  CPPAD_ASSERT_KNOWN( ! compact_tape(),
+         "This operation is not available for an ADFun object f\n"
+         "after f.compact_tape(true); use f.compact_tape(false) first."
+      );
+   }
 
-   /// Mapping from primary variable index to corresponding operator index.
-   /// This is used to traverse sub-graphs of the operation sequence.
-   /// This value is valid (invalid) for primary (auxillary) variables.
-   pod_vector<unsigned char> var2op_vec_;
+   /// Decode the compact encoding in rec_ (which must be compact).
+   /// The bounds checked by compact_decode are not used because
+   /// this encoding was created by compact_tape; e.g., the call_id for an
+   /// atomic function can have any value.
+   void decode_compact(
+      pod_vector<opcode_t>& op_vec  ,
+      pod_vector<addr_t>&   arg_vec ) const
+   {  CPPAD_ASSERT_UNKNOWN( compact_tape() );
+      const play::recording& r( *rec_ );
+      op_vec.resize(0);
+      arg_vec.resize(0);
+      op_vec.reserve(r.num_op_compact);
+      arg_vec.reserve(r.num_arg_compact);
+      //
+      play::const_compact_iterator itr(r.num_var_rec, r.compact_vec);
+      OpCode        op;
+      const addr_t* arg;
+      size_t        i_var;
+      for(size_t i_op = 0; i_op < r.num_op_compact; ++i_op)
+      {  if( i_op > 0 )
+            ++itr;
+         itr.op_info(op, arg, i_var);
+         op_vec.push_back( opcode_t(op) );
+         size_t n_arg = play::compact_num_arg(op, arg);
+         for(size_t k = 0; k < n_arg; ++k)
+            arg_vec.push_back( arg[k] );
+      }
+      CPPAD_ASSERT_UNKNOWN( op == EndOp );
+      CPPAD_ASSERT_UNKNOWN( arg_vec.size() == r.num_arg_compact );
+   }
 
 public:
    // =================================================================
-   /// default constructor
-   // set all scalars to zero to avoid valgraind warning when ani assignment
-   // occures before values get set.
+   /// default constructor (an empty recording)
    player(void) :
-   num_dynamic_ind_(0)  ,
-   num_var_rec_(0)      ,
-   num_var_load_rec_(0)  ,
-   num_var_vecad_rec_(0)
+   rec_( std::make_shared<play::recording>() )                  ,
+   all_par_vec_( std::make_shared< pod_vector_maybe<Base> >() ) ,
+   random_( nullptr )                                           ,
+   forward0_plan_( std::make_shared< play::forward0_plan<Base> >() ) ,
+   atom_batch_( std::make_shared<play::atom_batch>() )
    { }
    // move semantics constructor
-   // (none of the default constructor values matter to the destructor)
-   player(player& play)
+   player(player& play) : player()
    {  swap(play);  }
    // =================================================================
    /// destructor
@@ -124,9 +147,9 @@ public:
    {
       // required
       size_t required = 0;
-      required = std::max(required, num_var_rec_   );  // number variables
-      required = std::max(required, op_vec_.size()  ); // number operators
-      required = std::max(required, arg_vec_.size() ); // number arguments
+      required = std::max(required, rec_->num_var_rec   );  // number variables
+      required = std::max(required, num_op_rec()     );   // number operators
+      required = std::max(required, num_op_arg_rec() );   // number arguments
       //
       // unsigned short
       if( required <= std::numeric_limits<unsigned short>::max() )
@@ -149,7 +172,9 @@ public:
    \param rec
    the object that was used to record the operation sequence. After this
    operation, the state of the recording is no longer defined. For example,
-   the pod_vector member variables in this have been swapped with rec.
+   the pod_vector member variables in rec have been swapped with empty
+   vectors. A new recording is created for this player, so any other players
+   that were sharing the previous recording are not affected.
 
    \param n_ind
    the number of independent variables (only used for error checking
@@ -159,71 +184,109 @@ public:
    Use an assert to check that the length of the following vectors is
    less than the maximum possible value for addr_t; i.e., that an index
    in these vectors can be represented using the type addr_t:
-   op_vec_, all_var_vecad_ind_, arg_vec_, test_vec_, all_par_vec_, text_vec_,
-   dyn_par_arg_.
+   op_vec, all_var_vecad_ind, arg_vec, all_par_vec_, text_vec,
+   dyn_par_arg.
    */
    void get_recording(recorder<Base>& rec, size_t n_ind)
    {
 # ifndef NDEBUG
       size_t addr_t_max = size_t( std::numeric_limits<addr_t>::max() );
 # endif
+      // a new recording (the previous one may be shared with other players)
+      std::shared_ptr<play::recording> new_rec =
+         std::make_shared<play::recording>();
+      play::recording& r( *new_rec );
+
       // just set size_t values
-      num_dynamic_ind_    = rec.num_dynamic_ind_;
-      num_var_rec_        = rec.num_var_rec_;
-      num_var_load_rec_   = rec.num_var_load_rec_;
+      r.num_dynamic_ind    = rec.num_dynamic_ind_;
+      r.num_var_rec        = rec.num_var_rec_;
+      r.num_var_load_rec   = rec.num_var_load_rec_;
 
-      // op_vec_
-      op_vec_.swap(rec.op_vec_);
-      CPPAD_ASSERT_UNKNOWN(op_vec_.size() < addr_t_max );
+      // op_vec
+      r.op_vec.swap(rec.op_vec_);
+      CPPAD_ASSERT_UNKNOWN(r.op_vec.size() < addr_t_max );
 
-      // op_arg_vec_
-      arg_vec_.swap(rec.arg_vec_);
-      CPPAD_ASSERT_UNKNOWN(arg_vec_.size()    < addr_t_max );
+      // op_arg_vec
+      r.arg_vec.swap(rec.arg_vec_);
+      CPPAD_ASSERT_UNKNOWN(r.arg_vec.size()    < addr_t_max );
 
       // all_par_vec_
-      all_par_vec_.swap(rec.all_par_vec_);
-      CPPAD_ASSERT_UNKNOWN(all_par_vec_.size() < addr_t_max );
-
-      // dyn_par_is_, dyn_par_op_, dyn_par_arg_
-      dyn_par_is_.swap( rec.dyn_par_is_ );
-      dyn_par_op_.swap( rec.dyn_par_op_ );
-      dyn_par_arg_.swap( rec.dyn_par_arg_ );
-      CPPAD_ASSERT_UNKNOWN(dyn_par_arg_.size() < addr_t_max );
-
-      // text_rec_
-      text_vec_.swap(rec.text_vec_);
-      CPPAD_ASSERT_UNKNOWN(text_vec_.size() < addr_t_max );
-
-      // all_var_vecad_ind_
-      all_var_vecad_ind_.swap(rec.all_var_vecad_ind_);
-      CPPAD_ASSERT_UNKNOWN(all_var_vecad_ind_.size() < addr_t_max );
-
-      // num_var_vecad_rec_
-      num_var_vecad_rec_ = 0;
-      {  // all_var_vecad_ind_ contains size of each VecAD followed by
+      all_par_vec_ = std::make_shared< pod_vector_maybe<Base> >();
+      all_par_vec_->swap(rec.all_par_vec_);
+      CPPAD_ASSERT_UNKNOWN(all_par_vec_->size() < addr_t_max );
+
+      // dyn_par_is, dyn_par_op, dyn_par_arg
+      r.dyn_par_is.swap( rec.dyn_par_is_ );
+      r.dyn_par_op.swap( rec.dyn_par_op_ );
+      r.dyn_par_arg.swap( rec.dyn_par_arg_ );
+      CPPAD_ASSERT_UNKNOWN(r.dyn_par_arg.size() < addr_t_max );
+
+      // text_rec
+      r.text_vec.swap(rec.text_vec_);
+      CPPAD_ASSERT_UNKNOWN(r.text_vec.size() < addr_t_max );
+
+      // all_var_vecad_ind
+      r.all_var_vecad_ind.swap(rec.all_var_vecad_ind_);
+      CPPAD_ASSERT_UNKNOWN(r.all_var_vecad_ind.size() < addr_t_max );
+
+      // rec_, random_, forward0_plan_, atom_batch_
+      set_recording(new_rec, n_ind);
+   }
+   // ----------------------------------------------------------------------
+   /*!
+   Set the recording for this player.
+
+   \param new_rec
+   On input, the values in new_rec that are not computed from other values
+   have been set. Upon return, num_var_vecad_rec and dyn_ind2par_ind have
+   been set. The recording is not changed after this call.
+
+   \param n_ind
+   the number of independent variables (only used for error checking
+   when NDEBUG is not defined).
+
+   \par all_par_vec_
+   has been set to the parameters for this recording.
+   */
+   void set_recording(
+      std::shared_ptr<play::recording>& new_rec, size_t n_ind )
+   {  play::recording& r( *new_rec );
+
+      // num_var_vecad_rec
+      r.num_var_vecad_rec = 0;
+      {  // all_var_vecad_ind contains size of each VecAD followed by
          // the parameter indices used to inialize it.
          size_t i = 0;
-         while( i < all_var_vecad_ind_.size() )
-         {  num_var_vecad_rec_++;
-            i += size_t( all_var_vecad_ind_[i] ) + 1;
+         while( i < r.all_var_vecad_ind.size() )
+         {  r.num_var_vecad_rec++;
+            i += size_t( r.all_var_vecad_ind[i] ) + 1;
          }
-         CPPAD_ASSERT_UNKNOWN( i == all_var_vecad_ind_.size() );
+         CPPAD_ASSERT_UNKNOWN( i == r.all_var_vecad_ind.size() );
       }
 
       // mapping from dynamic parameter index to parameter index
-      dyn_ind2par_ind_.resize( dyn_par_op_.size() );
+      r.dyn_ind2par_ind.resize( r.dyn_par_op.size() );
       size_t i_dyn = 0;
-      for(size_t i_par = 0; i_par < all_par_vec_.size(); ++i_par)
-      {  if( dyn_par_is_[i_par] )
-         {  dyn_ind2par_ind_[i_dyn] = addr_t( i_par );
+      for(size_t i_par = 0; i_par < all_par_vec_->size(); ++i_par)
+      {  if( r.dyn_par_is[i_par] )
+         {  r.dyn_ind2par_ind[i_dyn] = addr_t( i_par );
             ++i_dyn;
          }
       }
-      CPPAD_ASSERT_UNKNOWN( i_dyn == dyn_ind2par_ind_.size() );
+      CPPAD_ASSERT_UNKNOWN( i_dyn == r.dyn_ind2par_ind.size() );
+
+      // the recording is not changed after this point
+      rec_ = new_rec;
 
       // random access information
       clear_random();
 
+      // zero order forward plan
+      forward0_plan_ = std::make_shared< play::forward0_plan<Base> >();
+
+      // groups of atomic function calls
+      atom_batch_ = std::make_shared<play::atom_batch>();
+
       // some checks
       check_inv_op(n_ind);
       check_variable_dag();
@@ -231,6 +294,131 @@ public:
    }
    // ----------------------------------------------------------------------
    /*!
+   Write this recording using the binary tape format.
+
+   \param os
+   is the stream that the recording is written to.
+   The size_t values and vectors that define the recording are written
+   using play::binary_write_size and play::binary_write_vec.
+   The values that are computed from other values are not written.
+
+   \param compact
+   If true, the operators and arguments are written as one vector
+   using play::compact_encode. Otherwise, op_vec and arg_vec are written.
+   This does not depend on whether this player is using compact storage;
+   see compact_tape.
+   */
+   void write_binary(std::ostream& os, bool compact) const
+   {  CPPAD_ASSERT_UNKNOWN( is_pod<Base>() );
+      const play::recording&        r( *rec_ );
+      const pod_vector_maybe<Base>& all_par_vec( *all_par_vec_ );
+      //
+      play::binary_write_size(os, size_t(compact) );
+      play::binary_write_size(os, r.num_dynamic_ind);
+      play::binary_write_size(os, r.num_var_rec);
+      play::binary_write_size(os, r.num_var_load_rec);
+      //
+      if( compact && compact_tape() )
+      {  play::binary_write_vec(os,
+            r.compact_vec.data(), r.compact_vec.size()
+         );
+      }
+      else if( compact )
+      {  pod_vector<unsigned char> byte_vec;
+         play::compact_encode(r.num_var_rec, r.op_vec, r.arg_vec, byte_vec);
+         play::binary_write_vec(os, byte_vec.data(), byte_vec.size() );
+      }
+      else if( compact_tape() )
+      {  pod_vector<opcode_t> op_vec;
+         pod_vector<addr_t>   arg_vec;
+         decode_compact(op_vec, arg_vec);
+         play::binary_write_vec(os, op_vec.data(),  op_vec.size() );
+         play::binary_write_vec(os, arg_vec.data(), arg_vec.size() );
+      }
+      else
+      {  play::binary_write_vec(os, r.op_vec.data(),  r.op_vec.size() );
+         play::binary_write_vec(os, r.arg_vec.data(), r.arg_vec.size() );
+      }
+      play::binary_write_vec(os, r.text_vec.data(), r.text_vec.size() );
+      play::binary_write_vec(os,
+         r.all_var_vecad_ind.data(), r.all_var_vecad_ind.size()
+      );
+      play::binary_write_vec(os, r.dyn_par_is.data(),  r.dyn_par_is.size() );
+      play::binary_write_vec(os, r.dyn_par_op.data(),  r.dyn_par_op.size() );
+      play::binary_write_vec(os, r.dyn_par_arg.data(), r.dyn_par_arg.size() );
+      play::binary_write_vec(os, all_par_vec.data(), all_par_vec.size() );
+   }
+   /*!
+   Read a recording written by write_binary.
+
+   \param is
+   is the stream that the recording is read from.
+
+   \param n_ind
+   the number of independent variables (only used for error checking
+   when NDEBUG is not defined).
+
+   \return
+   is false if an error occurred reading the recording.
+   In this case, this player is not changed.
+   */
+   bool read_binary(std::istream& is, size_t n_ind)
+   {  CPPAD_ASSERT_UNKNOWN( is_pod<Base>() );
+      std::shared_ptr<play::recording> new_rec =
+         std::make_shared<play::recording>();
+      std::shared_ptr< pod_vector_maybe<Base> > all_par_vec =
+         std::make_shared< pod_vector_maybe<Base> >();
+      play::recording& r( *new_rec );
+      //
+      bool ok = true;
+      size_t compact = 0;
+      ok &= play::binary_read_size(is, compact);
+      ok &= play::binary_read_size(is, r.num_dynamic_ind);
+      ok &= play::binary_read_size(is, r.num_var_rec);
+      ok &= play::binary_read_size(is, r.num_var_load_rec);
+      ok &= compact < 2;
+      //
+      // byte_vec
+      // the compact encoding is decoded after the sizes it uses are known
+      pod_vector<unsigned char> byte_vec;
+      if( ok && compact )
+         ok = play::binary_read_vec(is, byte_vec);
+      else
+      {  ok = ok && play::binary_read_vec(is, r.op_vec);
+         ok = ok && play::binary_read_vec(is, r.arg_vec);
+      }
+      ok = ok && play::binary_read_vec(is, r.text_vec);
+      ok = ok && play::binary_read_vec(is, r.all_var_vecad_ind);
+      ok = ok && play::binary_read_vec(is, r.dyn_par_is);
+      ok = ok && play::binary_read_vec(is, r.dyn_par_op);
+      ok = ok && play::binary_read_vec(is, r.dyn_par_arg);
+      ok = ok && play::binary_read_vec(is, *all_par_vec);
+      if( ok && compact )
+      {  ok = play::compact_decode(
+            r.num_var_rec,
+            all_par_vec->size(),
+            r.all_var_vecad_ind.size(),
+            r.text_vec.size(),
+            byte_vec,
+            r.op_vec,
+            r.arg_vec
+         );
+      }
+      //
+      // check every operator, argument, and dynamic parameter index
+      // against the sizes that were read (before set_recording uses them)
+      ok = ok && n_ind < r.num_var_rec;
+      ok = ok && play::binary_check_recording(r, all_par_vec->size(), n_ind);
+      if( ! ok )
+         return false;
+      //
+      // rec_, all_par_vec_, random_, forward0_plan_, atom_batch_
+      all_par_vec_ = all_par_vec;
+      set_recording(new_rec, n_ind);
+      return true;
+   }
+   // ----------------------------------------------------------------------
+   /*!
    Check that InvOp operators start with second operator and are contiguous,
    and there are n_ind of them.
    */
@@ -441,31 +629,31 @@ public:
 # else
    void check_dynamic_dag(void) const
    {  // number of dynamic parameters
-      size_t num_dyn = dyn_par_op_.size();
+      size_t num_dyn = rec_->dyn_par_op.size();
       //
       size_t i_arg = 0; // initialize dynamic parameter argument index
       for(size_t i_dyn = 0; i_dyn < num_dyn; ++i_dyn)
       {  // i_par is parameter index
-         addr_t i_par = dyn_ind2par_ind_[i_dyn];
-         CPPAD_ASSERT_UNKNOWN( dyn_par_is_[i_par] );
+         addr_t i_par = rec_->dyn_ind2par_ind[i_dyn];
+         CPPAD_ASSERT_UNKNOWN( rec_->dyn_par_is[i_par] );
          //
          // operator for this dynamic parameter
-         op_code_dyn op = op_code_dyn( dyn_par_op_[i_dyn] );
+         op_code_dyn op = op_code_dyn( rec_->dyn_par_op[i_dyn] );
          //
          // number of arguments for this dynamic parameter
          size_t n_arg       = num_arg_dyn(op);
          if( op == atom_dyn )
-         {  size_t n = size_t( dyn_par_arg_[i_arg + 2] );
-            size_t m = size_t( dyn_par_arg_[i_arg + 3] );
+         {  size_t n = size_t( rec_->dyn_par_arg[i_arg + 2] );
+            size_t m = size_t( rec_->dyn_par_arg[i_arg + 3] );
             n_arg    = 6 + n + m;
             CPPAD_ASSERT_UNKNOWN(
-               n_arg == size_t( dyn_par_arg_[i_arg + 5 + n + m] )
+               n_arg == size_t( rec_->dyn_par_arg[i_arg + 5 + n + m] )
             );
             for(size_t i = 5; i < n - 1; ++i)
-               CPPAD_ASSERT_UNKNOWN( dyn_par_arg_[i_arg + i] <  i_par );
+               CPPAD_ASSERT_UNKNOWN( rec_->dyn_par_arg[i_arg + i] <  i_par );
 # ifndef NDEBUG
             for(size_t i = 5+n; i < 5+n+m; ++i)
-            {  addr_t j_par = dyn_par_arg_[i_arg + i];
+            {  addr_t j_par = rec_->dyn_par_arg[i_arg + i];
                CPPAD_ASSERT_UNKNOWN( (j_par == 0) || (j_par >= i_par) );
             }
 # endif
@@ -473,7 +661,7 @@ public:
          else
          {  size_t num_non_par = num_non_par_arg_dyn(op);
             for(size_t i = num_non_par; i < n_arg; ++i)
-               CPPAD_ASSERT_UNKNOWN( dyn_par_arg_[i_arg + i] < i_par);
+               CPPAD_ASSERT_UNKNOWN( rec_->dyn_par_arg[i_arg + i] < i_par);
          }
          //
          // next dynamic parameter
@@ -488,59 +676,56 @@ public:
 
    \param play
    object that contains the operatoion sequence to copy.
+   The recording, parameters, random access tables, zero order forward
+   plan, and atomic function groups are shared; i.e., this is O(1)
+   and does not allocate memory.
+
+   \par Parallel Mode
+   Memory allocated by thread_alloc must be returned by the thread that
+   allocated it. If the copy is made in parallel mode, the other player
+   may belong to a different thread and be deleted first. In this case
+   the objects are copied (not shared) so this thread owns their memory.
    */
    void operator=(const player& play)
-   {
-      // size_t objects
-      num_dynamic_ind_    = play.num_dynamic_ind_;
-      num_var_rec_        = play.num_var_rec_;
-      num_var_load_rec_   = play.num_var_load_rec_;
-      num_var_vecad_rec_  = play.num_var_vecad_rec_;
-      //
-      // pod_vectors
-      op_vec_             = play.op_vec_;
-      arg_vec_            = play.arg_vec_;
-      text_vec_           = play.text_vec_;
-      all_var_vecad_ind_  = play.all_var_vecad_ind_;
-      dyn_par_is_         = play.dyn_par_is_;
-      dyn_ind2par_ind_    = play.dyn_ind2par_ind_;
-      dyn_par_op_         = play.dyn_par_op_;
-      dyn_par_arg_        = play.dyn_par_arg_;
-      op2arg_vec_         = play.op2arg_vec_;
-      op2var_vec_         = play.op2var_vec_;
-      var2op_vec_         = play.var2op_vec_;
-      //
-      // pod_maybe_vectors
-      all_par_vec_        = play.all_par_vec_;
+   {  if( thread_alloc::in_parallel() )
+      {  copy_recording(play.rec_, play.random_);
+         //
+         all_par_vec_ = std::make_shared< pod_vector_maybe<Base> >();
+         *all_par_vec_ = *play.all_par_vec_;
+         //
+         forward0_plan_ = std::make_shared< play::forward0_plan<Base> >();
+         *forward0_plan_ = *play.forward0_plan_;
+         //
+         atom_batch_ = std::make_shared<play::atom_batch>();
+         *atom_batch_ = *play.atom_batch_;
+         return;
+      }
+      rec_           = play.rec_;
+      all_par_vec_   = play.all_par_vec_;
+      random_        = play.random_;
+      forward0_plan_ = play.forward0_plan_;
+      atom_batch_    = play.atom_batch_;
    }
    // ===============================================================
    /// Create a player< AD<Base> > from this player<Base>
+   /// (the recording and random access tables are shared,
+   /// except in parallel mode; see operator=).
    player< AD<Base> > base2ad(void) const
    {  player< AD<Base> > play;
       //
-      // size_t objects
-      play.num_dynamic_ind_    = num_dynamic_ind_;
-      play.num_var_rec_        = num_var_rec_;
-      play.num_var_load_rec_   = num_var_load_rec_;
-      play.num_var_vecad_rec_  = num_var_vecad_rec_;
-      //
-      // pod_vectors
-      play.op_vec_             = op_vec_;
-      play.arg_vec_            = arg_vec_;
-      play.text_vec_           = text_vec_;
-      play.all_var_vecad_ind_  = all_var_vecad_ind_;
-      play.dyn_par_is_         = dyn_par_is_;
-      play.dyn_ind2par_ind_    = dyn_ind2par_ind_;
-      play.dyn_par_op_         = dyn_par_op_;
-      play.dyn_par_arg_        = dyn_par_arg_;
-      play.op2arg_vec_         = op2arg_vec_;
-      play.op2var_vec_         = op2var_vec_;
-      play.var2op_vec_         = var2op_vec_;
+      // rec_, random_
+      if( thread_alloc::in_parallel() )
+         play.copy_recording(rec_, random_);
+      else
+      {  play.rec_    = rec_;
+         play.random_ = random_;
+      }
       //
       // pod_maybe_vector< AD<Base> > = pod_maybe_vector<Base>
-      play.all_par_vec_.resize( all_par_vec_.size() );
-      for(size_t i = 0; i < all_par_vec_.size(); ++i)
-         play.all_par_vec_[i] = all_par_vec_[i];
+      const pod_vector_maybe<Base>& all_par_vec( *all_par_vec_ );
+      play.all_par_vec_->resize( all_par_vec.size() );
+      for(size_t i = 0; i < all_par_vec.size(); ++i)
+         (*play.all_par_vec_)[i] = all_par_vec[i];
       //
       return play;
    }
@@ -548,27 +733,11 @@ public:
    /// swap this recording with another recording
    /// (used for move semantics version of ADFun assignment operation)
    void swap(player& other)
-   {  // size_t objects
-      std::swap(num_dynamic_ind_,    other.num_dynamic_ind_);
-      std::swap(num_var_rec_,        other.num_var_rec_);
-      std::swap(num_var_load_rec_,   other.num_var_load_rec_);
-      std::swap(num_var_vecad_rec_,  other.num_var_vecad_rec_);
-      //
-      // pod_vectors
-      op_vec_.swap(             other.op_vec_);
-      arg_vec_.swap(            other.arg_vec_);
-      text_vec_.swap(           other.text_vec_);
-      all_var_vecad_ind_.swap(  other.all_var_vecad_ind_);
-      dyn_par_is_.swap(         other.dyn_par_is_);
-      dyn_ind2par_ind_.swap(    other.dyn_ind2par_ind_);
-      dyn_par_op_.swap(         other.dyn_par_op_);
-      dyn_par_arg_.swap(        other.dyn_par_arg_);
-      op2arg_vec_.swap(         other.op2arg_vec_);
-      op2var_vec_.swap(         other.op2var_vec_);
-      var2op_vec_.swap(         other.var2op_vec_);
-      //
-      // pod_maybe_vectors
-      all_par_vec_.swap(    other.all_par_vec_);
+   {  rec_.swap(           other.rec_);
+      all_par_vec_.swap(   other.all_par_vec_);
+      random_.swap(        other.random_);
+      forward0_plan_.swap( other.forward0_plan_);
+      atom_batch_.swap(    other.atom_batch_);
    }
    // move semantics assignment
    void operator=(player&& play)
@@ -578,47 +747,153 @@ public:
    // with random_(no work if already setup).
    template <class Addr>
    void setup_random(void)
-   {  play::random_setup(
-         num_var_rec_                               ,
-         op_vec_                                    ,
-         arg_vec_                                   ,
-         op2arg_vec_.pod_vector_ptr<Addr>()         ,
-         op2var_vec_.pod_vector_ptr<Addr>()         ,
-         var2op_vec_.pod_vector_ptr<Addr>()
+   {  assert_not_compact();
+      if( random_ != nullptr )
+      {  CPPAD_ASSERT_UNKNOWN(
+            random_->op2arg_vec.pod_vector_ptr<Addr>()->size() == num_op_rec()
+         );
+         return;
+      }
+      // new tables are created because random_ may be shared
+      std::shared_ptr<play::random_table> random =
+         std::make_shared<play::random_table>();
+      play::random_setup(
+         rec_->num_var_rec                          ,
+         rec_->op_vec                               ,
+         rec_->arg_vec                              ,
+         random->op2arg_vec.pod_vector_ptr<Addr>()  ,
+         random->op2var_vec.pod_vector_ptr<Addr>()  ,
+         random->var2op_vec.pod_vector_ptr<Addr>()
       );
+      random_ = random;
    }
    /// Free memory used for functions that begin with random_
    /// and random iterators and subgraph iterators
+   /// (the memory is not freed while other players share it).
    void clear_random(void)
-   {
-      op2arg_vec_.clear();
-      op2var_vec_.clear();
-      var2op_vec_.clear();
-      CPPAD_ASSERT_UNKNOWN( op2arg_vec_.size() == 0  );
-      CPPAD_ASSERT_UNKNOWN( op2var_vec_.size() == 0  );
-      CPPAD_ASSERT_UNKNOWN( var2op_vec_.size() == 0  );
+   {  random_ = nullptr; }
+   // =================================================================
+   /*!
+   Change the storage used for the operators and arguments.
+
+   \param compact
+   If true, the operators and arguments are stored using
+   play::compact_encode and op_vec, arg_vec are empty.
+   In this case, the only sequential iterator that can be used is
+   play::const_compact_iterator, and random access to the operators
+   (including the random access tables) is not available.
+   If false, they are stored in op_vec and arg_vec.
+
+   \par
+   A new recording is created for this player, so any other players
+   that were sharing the previous recording are not affected.
+   The random access tables, the zero order forward plan, and the atomic
+   function groups are freed; the plan and groups are not used
+   while the storage is compact.
+   */
+   void compact_tape(bool compact)
+   {  if( compact == compact_tape() || num_op_rec() == 0 )
+         return;
+      const play::recording& old_rec( *rec_ );
+      std::shared_ptr<play::recording> new_rec =
+         std::make_shared<play::recording>();
+      play::recording& r( *new_rec );
+      //
+      // values that do not depend on the storage
+      r.num_dynamic_ind   = old_rec.num_dynamic_ind;
+      r.num_var_rec       = old_rec.num_var_rec;
+      r.num_var_load_rec  = old_rec.num_var_load_rec;
+      r.num_var_vecad_rec = old_rec.num_var_vecad_rec;
+      r.text_vec          = old_rec.text_vec;
+      r.all_var_vecad_ind = old_rec.all_var_vecad_ind;
+      r.dyn_par_is        = old_rec.dyn_par_is;
+      r.dyn_ind2par_ind   = old_rec.dyn_ind2par_ind;
+      r.dyn_par_op        = old_rec.dyn_par_op;
+      r.dyn_par_arg       = old_rec.dyn_par_arg;
+      //
+      // op_vec, arg_vec, compact_vec
+      if( compact )
+      {  play::compact_encode(
+            old_rec.num_var_rec, old_rec.op_vec, old_rec.arg_vec,
+            r.compact_vec
+         );
+         r.num_op_compact  = old_rec.op_vec.size();
+         r.num_arg_compact = old_rec.arg_vec.size();
+      }
+      else
+         decode_compact(r.op_vec, r.arg_vec);
+      //
+      rec_           = new_rec;
+      random_        = nullptr;
+      forward0_plan_ = std::make_shared< play::forward0_plan<Base> >();
+      atom_batch_    = std::make_shared<play::atom_batch>();
    }
+   /// Are the operators and arguments stored using the compact encoding
+   bool compact_tape(void) const
+   {  return rec_->compact_vec.size() > 0; }
+   /// Compact encoding of the operators and arguments
+   /// (only defined when compact_tape() is true)
+   const pod_vector<unsigned char>& compact_vec(void) const
+   {  CPPAD_ASSERT_UNKNOWN( compact_tape() );
+      return rec_->compact_vec;
+   }
+   /// get non-const version of the zero order forward plan
+   /// (make a copy of the plan if it is shared with another player)
+   play::forward0_plan<Base>& forward0_plan(void)
+   {  if( forward0_plan_.use_count() > 1 )
+      {  std::shared_ptr< play::forward0_plan<Base> > plan =
+            std::make_shared< play::forward0_plan<Base> >();
+         *plan          = *forward0_plan_;
+         forward0_plan_ = plan;
+      }
+      return *forward0_plan_;
+   }
+   /// get const version of the zero order forward plan
+   const play::forward0_plan<Base>& forward0_plan(void) const
+   {  return *forward0_plan_; }
+   /// get non-const version of the atomic function groups
+   /// (make a copy of the groups if they are shared with another player)
+   play::atom_batch& atom_batch(void)
+   {  if( atom_batch_.use_count() > 1 )
+      {  std::shared_ptr<play::atom_batch> batch =
+            std::make_shared<play::atom_batch>();
+         *batch      = *atom_batch_;
+         atom_batch_ = batch;
+      }
+      return *atom_batch_;
+   }
+   /// get const version of the atomic function groups
+   const play::atom_batch& atom_batch(void) const
+   {  return *atom_batch_; }
    /// get non-const version of all_par_vec
+   /// (make a copy of the parameters if they are shared with another player)
    pod_vector_maybe<Base>& all_par_vec(void)
-   {  return all_par_vec_; }
-   /// get non-const version of all_par_vec
+   {  if( all_par_vec_.use_count() > 1 )
+      {  std::shared_ptr< pod_vector_maybe<Base> > all_par_vec =
+            std::make_shared< pod_vector_maybe<Base> >();
+         *all_par_vec = *all_par_vec_;
+         all_par_vec_ = all_par_vec;
+      }
+      return *all_par_vec_;
+   }
+   /// get const version of all_par_vec
    const pod_vector_maybe<Base>& all_par_vec(void) const
-   {  return all_par_vec_; }
+   {  return *all_par_vec_; }
    // ================================================================
    // const functions that retrieve infromation from this player
    // ================================================================
    /// const version of dynamic parameter flag
    const pod_vector<bool>& dyn_par_is(void) const
-   {  return dyn_par_is_; }
+   {  return rec_->dyn_par_is; }
    /// const version of dynamic parameter index to parameter index
    const pod_vector<addr_t>& dyn_ind2par_ind(void) const
-   {  return dyn_ind2par_ind_; }
+   {  return rec_->dyn_ind2par_ind; }
    /// const version of dynamic parameter operator
    const pod_vector<opcode_t>& dyn_par_op(void) const
-   {  return dyn_par_op_; }
+   {  return rec_->dyn_par_op; }
    /// const version of dynamic parameter arguments
    const pod_vector<addr_t>& dyn_par_arg(void) const
-   {  return dyn_par_arg_; }
+   {  return rec_->dyn_par_arg; }
    /*!
    \brief
    fetch an operator from the recording.
@@ -630,7 +905,9 @@ public:
    the index of the operator in recording
    */
    OpCode GetOp (size_t i) const
-   {  return OpCode(op_vec_[i]); }
+   {  assert_not_compact();
+      return OpCode(rec_->op_vec[i]);
+   }
 
    /*!
    \brief
@@ -643,7 +920,7 @@ public:
    the index of the VecAD index in recording
    */
    size_t GetVecInd (size_t i) const
-   {  return size_t( all_var_vecad_ind_[i] ); }
+   {  return size_t( rec_->all_var_vecad_ind[i] ); }
 
    /*!
    \brief
@@ -656,7 +933,7 @@ public:
    the index of the parameter in recording
    */
    Base GetPar(size_t i) const
-   {  return all_par_vec_[i]; }
+   {  return (*all_par_vec_)[i]; }
 
    /*!
    \brief
@@ -667,7 +944,7 @@ public:
 
    */
    const Base* GetPar(void) const
-   {  return all_par_vec_.data(); }
+   {  return all_par_vec_->data(); }
 
    /*!
    \brief
@@ -680,129 +957,169 @@ public:
    the index where the string begins.
    */
    const char *GetTxt(size_t i) const
-   {  CPPAD_ASSERT_UNKNOWN(i < text_vec_.size() );
-      return text_vec_.data() + i;
+   {  CPPAD_ASSERT_UNKNOWN(i < rec_->text_vec.size() );
+      return rec_->text_vec.data() + i;
    }
 
    /// Fetch number of independent dynamic parameters in the recording
    size_t num_dynamic_ind(void) const
-   {  return num_dynamic_ind_; }
+   {  return rec_->num_dynamic_ind; }
 
    /// Fetch number of dynamic parameters in the recording
    size_t num_dynamic_par(void) const
-   {  return dyn_par_op_.size(); }
+   {  return rec_->dyn_par_op.size(); }
 
    /// Fetch number of dynamic parameters operator arguments in the recording
    size_t num_dynamic_arg(void) const
-   {  return dyn_par_arg_.size(); }
+   {  return rec_->dyn_par_arg.size(); }
 
    /// Fetch number of variables in the recording.
    size_t num_var_rec(void) const
-   {  return num_var_rec_; }
+   {  return rec_->num_var_rec; }
 
    /// Fetch number of vecad load operations
    size_t num_var_load_rec(void) const
-   {  return num_var_load_rec_; }
+   {  return rec_->num_var_load_rec; }
 
    /// Fetch number of operators in the recording.
    size_t num_op_rec(void) const
-   {  return op_vec_.size(); }
+   {  if( compact_tape() )
+         return rec_->num_op_compact;
+      return rec_->op_vec.size();
+   }
 
    /// Fetch number of VecAD indices in the recording.
    size_t num_var_vecad_ind_rec(void) const
-   {  return all_var_vecad_ind_.size(); }
+   {  return rec_->all_var_vecad_ind.size(); }
 
    /// Fetch number of VecAD vectors in the recording
    size_t num_var_vecad_rec(void) const
-   {  return num_var_vecad_rec_; }
+   {  return rec_->num_var_vecad_rec; }
 
    /// Fetch number of argument indices in the recording.
    size_t num_op_arg_rec(void) const
-   {  return arg_vec_.size(); }
+   {  if( compact_tape() )
+         return rec_->num_arg_compact;
+      return rec_->arg_vec.size();
+   }
 
    /// Fetch number of parameters in the recording.
    size_t num_par_rec(void) const
-   {  return all_par_vec_.size(); }
+   {  return all_par_vec_->size(); }
 
    /// Fetch number of characters (representing strings) in the recording.
    size_t num_text_rec(void) const
-   {  return text_vec_.size(); }
+   {  return rec_->text_vec.size(); }
 
    /// A measure of amount of memory used to store
    /// the operation sequence, just lengths, not capacities.
    /// In user api as f.size_op_seq(); see the file fun_property.omh.
    size_t size_op_seq(void) const
    {  // check assumptions made by ad_fun<Base>::size_op_seq()
-      CPPAD_ASSERT_UNKNOWN( op_vec_.size() == num_op_rec() );
-      CPPAD_ASSERT_UNKNOWN( arg_vec_.size()    == num_op_arg_rec() );
-      CPPAD_ASSERT_UNKNOWN( all_par_vec_.size() == num_par_rec() );
-      CPPAD_ASSERT_UNKNOWN( text_vec_.size() == num_text_rec() );
-      CPPAD_ASSERT_UNKNOWN( all_var_vecad_ind_.size() == num_var_vecad_ind_rec() );
-      return op_vec_.size()        * sizeof(opcode_t)
-             + arg_vec_.size()       * sizeof(addr_t)
-             + all_par_vec_.size()   * sizeof(Base)
-             + dyn_par_is_.size()    * sizeof(bool)
-             + dyn_ind2par_ind_.size() * sizeof(addr_t)
-             + dyn_par_op_.size()    * sizeof(opcode_t)
-             + dyn_par_arg_.size()   * sizeof(addr_t)
-             + text_vec_.size()      * sizeof(char)
-             + all_var_vecad_ind_.size() * sizeof(addr_t)
+      CPPAD_ASSERT_UNKNOWN(
+         compact_tape() || rec_->op_vec.size() == num_op_rec()
+      );
+      CPPAD_ASSERT_UNKNOWN(
+         compact_tape() || rec_->arg_vec.size() == num_op_arg_rec()
+      );
+      CPPAD_ASSERT_UNKNOWN( all_par_vec_->size() == num_par_rec() );
+      CPPAD_ASSERT_UNKNOWN( rec_->text_vec.size() == num_text_rec() );
+      CPPAD_ASSERT_UNKNOWN( rec_->all_var_vecad_ind.size() == num_var_vecad_ind_rec() );
+      return rec_->op_vec.size()        * sizeof(opcode_t)
+             + rec_->arg_vec.size()       * sizeof(addr_t)
+             + rec_->compact_vec.size()   * sizeof(unsigned char)
+             + all_par_vec_->size()   * sizeof(Base)
+             + rec_->dyn_par_is.size()    * sizeof(bool)
+             + rec_->dyn_ind2par_ind.size() * sizeof(addr_t)
+             + rec_->dyn_par_op.size()    * sizeof(opcode_t)
+             + rec_->dyn_par_arg.size()   * sizeof(addr_t)
+             + rec_->text_vec.size()      * sizeof(char)
+             + rec_->all_var_vecad_ind.size() * sizeof(addr_t)
       ;
    }
+   /// Hash code for the operators, arguments, and VecAD vectors
+   /// (does not depend on the parameter values).
+   /// In user api as f.structure_hash(); see the file sparse_cache.hpp.
+   size_t structure_hash(void) const
+   {  assert_not_compact();
+      const play::recording& rec( *rec_ );
+      size_t code = rec.num_var_rec;
+      code = local_hash_combine(code, rec.num_var_vecad_rec);
+      for(size_t i = 0; i < rec.op_vec.size(); ++i)
+         code = local_hash_combine(code, size_t( rec.op_vec[i] ) );
+      for(size_t i = 0; i < rec.arg_vec.size(); ++i)
+         code = local_hash_combine(code, size_t( rec.arg_vec[i] ) );
+      for(size_t i = 0; i < rec.all_var_vecad_ind.size(); ++i)
+         code = local_hash_combine(code, size_t( rec.all_var_vecad_ind[i] ) );
+      return code;
+   }
+   /// Second hash code for the operators, arguments, and VecAD vectors
+   /// that is used to check for collisions of structure_hash codes.
+   size_t structure_check(void) const
+   {  assert_not_compact();
+      const play::recording& rec( *rec_ );
+      size_t code = rec.num_var_rec;
+      code = local_hash_mix(code, rec.num_var_vecad_rec);
+      for(size_t i = 0; i < rec.op_vec.size(); ++i)
+         code = local_hash_mix(code, size_t( rec.op_vec[i] ) );
+      for(size_t i = 0; i < rec.arg_vec.size(); ++i)
+         code = local_hash_mix(code, size_t( rec.arg_vec[i] ) );
+      for(size_t i = 0; i < rec.all_var_vecad_ind.size(); ++i)
+         code = local_hash_mix(code, size_t( rec.all_var_vecad_ind[i] ) );
+      return code;
+   }
    /// A measure of amount of memory used for random access routine
    /// In user api as f.size_random(); see the file fun_property.omh.
    size_t size_random(void) const
-   {
+   {  if( random_ == nullptr )
+         return 0;
+      const play::random_table& random( *random_ );
 # ifndef NDEBUG
-      if( op2arg_vec_.size() == 0 )
-      {  CPPAD_ASSERT_UNKNOWN( op2var_vec_.size() == 0 );
-         CPPAD_ASSERT_UNKNOWN( var2op_vec_.size() == 0 );
-      }
-      else
-      {  size_t size = 0;
-         switch( address_type() )
-         {  case play::unsigned_short_enum:
-            size = sizeof(unsigned short);
-            break;
-            //
-            case play::unsigned_int_enum:
-            size = sizeof(unsigned int);
-            break;
-            //
-            case play::size_t_enum:
-            size = sizeof(size_t);
-            break;
+      size_t size = 0;
+      switch( address_type() )
+      {  case play::unsigned_short_enum:
+         size = sizeof(unsigned short);
+         break;
+         //
+         case play::unsigned_int_enum:
+         size = sizeof(unsigned int);
+         break;
+         //
+         case play::size_t_enum:
+         size = sizeof(size_t);
+         break;
 
-            default:
-            CPPAD_ASSERT_UNKNOWN(false);
-            break;
-         }
-         CPPAD_ASSERT_UNKNOWN( op2arg_vec_.size()/size  == num_op_rec() );
-         CPPAD_ASSERT_UNKNOWN( op2var_vec_.size()/size  == num_op_rec() );
-         CPPAD_ASSERT_UNKNOWN( var2op_vec_.size()/size  == num_var_rec() );
+         default:
+         CPPAD_ASSERT_UNKNOWN(false);
+         break;
       }
+      CPPAD_ASSERT_UNKNOWN( random.op2arg_vec.size()/size  == num_op_rec() );
+      CPPAD_ASSERT_UNKNOWN( random.op2var_vec.size()/size  == num_op_rec() );
+      CPPAD_ASSERT_UNKNOWN( random.var2op_vec.size()/size  == num_var_rec() );
 # endif
       CPPAD_ASSERT_UNKNOWN( sizeof(unsigned char) == 1 );
-      return op2arg_vec_.size()
-             + op2var_vec_.size()
-             + var2op_vec_.size()
+      return random.op2arg_vec.size()
+             + random.op2var_vec.size()
+             + random.var2op_vec.size()
       ;
    }
    // -----------------------------------------------------------------------
    /// const sequential iterator begin
    play::const_sequential_iterator begin(void) const
-   {  size_t op_index = 0;
-      size_t num_var  = num_var_rec_;
+   {  assert_not_compact();
+      size_t op_index = 0;
+      size_t num_var  = rec_->num_var_rec;
       return play::const_sequential_iterator(
-         num_var, &op_vec_, &arg_vec_, op_index
+         num_var, &rec_->op_vec, &rec_->arg_vec, op_index
       );
    }
    /// const sequential iterator end
    play::const_sequential_iterator end(void) const
-   {  size_t op_index = op_vec_.size() - 1;
-      size_t num_var  = num_var_rec_;
+   {  assert_not_compact();
+      size_t op_index = rec_->op_vec.size() - 1;
+      size_t num_var  = rec_->num_var_rec;
       return play::const_sequential_iterator(
-         num_var, &op_vec_, &arg_vec_, op_index
+         num_var, &rec_->op_vec, &rec_->arg_vec, op_index
       );
    }
    // -----------------------------------------------------------------------
@@ -833,12 +1150,13 @@ public:
    /// const random iterator
    template <class Addr>
    play::const_random_iterator<Addr> get_random(void) const
-   {  return play::const_random_iterator<Addr>(
-         op_vec_,
-         arg_vec_,
-         op2arg_vec_.pod_vector_ptr<Addr>(),
-         op2var_vec_.pod_vector_ptr<Addr>(),
-         var2op_vec_.pod_vector_ptr<Addr>()
+   {  CPPAD_ASSERT_UNKNOWN( random_ != nullptr );
+      return play::const_random_iterator<Addr>(
+         rec_->op_vec,
+         rec_->arg_vec,
+         random_->op2arg_vec.pod_vector_ptr<Addr>(),
+         random_->op2var_vec.pod_vector_ptr<Addr>(),
+         random_->var2op_vec.pod_vector_ptr<Addr>()
       );
    }
 };
@@ -0,0 +1,116 @@
+# ifndef CPPAD_LOCAL_PLAY_RECORDING_HPP
+# define CPPAD_LOCAL_PLAY_RECORDING_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/op_code_var.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+/*!
+\file recording.hpp
+Parts of a player that are shared by copies of the player.
+*/
+
+/*!
+The information that defines a recording and does not depend on Base.
+
+A recording is not changed after it is created by player::get_recording.
+Hence it can be shared by all the copies of a player
+(including the player< AD<Base> > created by player::base2ad).
+*/
+struct recording {
+   /// Number of independent dynamic parameters
+   size_t num_dynamic_ind;
+
+   /// Number of variables in the recording.
+   size_t num_var_rec;
+
+   /// number of vecad load opeations in the reconding
+   size_t num_var_load_rec;
+
+   /// Number of VecAD vectors in the recording
+   size_t num_var_vecad_rec;
+
+   /// The operators in the recording.
+   pod_vector<opcode_t> op_vec;
+
+   /// The operation argument indices in the recording
+   pod_vector<addr_t> arg_vec;
+
+   /// Compact encoding of the operators and arguments; see compact_encode.
+   /// If this is not empty, op_vec and arg_vec are empty.
+   pod_vector<unsigned char> compact_vec;
+
+   /// Number of operators in compact_vec
+   size_t num_op_compact;
+
+   /// Number of arguments in compact_vec
+   size_t num_arg_compact;
+
+   /// Character strings ('\\0' terminated) in the recording.
+   pod_vector<char> text_vec;
+
+   /// The VecAD indices in the recording.
+   pod_vector<addr_t> all_var_vecad_ind;
+
+   /// Which parameters are dynamic parameters
+   /// (size equal number of parametrers)
+   pod_vector<bool> dyn_par_is;
+
+   /// mapping from dynamic parameter index to parameter index
+   /// 1: size equal to number of dynamic parameters
+   /// 2: dyn_ind2par_ind[j] < dyn_ind2par_ind[j+1]
+   pod_vector<addr_t> dyn_ind2par_ind;
+
+   /// operators for just the dynamic parameters
+   /// (size equal number of dynamic parameters)
+   pod_vector<opcode_t> dyn_par_op;
+
+   /// arguments for the dynamic parameter operators
+   pod_vector<addr_t> dyn_par_arg;
+
+   /// an empty recording
+   recording(void)
+   : num_dynamic_ind(0)
+   , num_var_rec(0)
+   , num_var_load_rec(0)
+   , num_var_vecad_rec(0)
+   , num_op_compact(0)
+   , num_arg_compact(0)
+   { }
+};
+
+/*!
+Information needed to use member functions that begin with random_
+and for using const_subgraph_iterator.
+
+These tables are not changed after they are created by
+player::setup_random. Hence they can be shared in the same way
+as a recording.
+*/
+struct random_table {
+   /// index in arg_vec corresonding to the first argument for each operator
+   pod_vector<unsigned char> op2arg_vec;
+
+   /*!
+   Index of the result variable for each operator. If the operator has
+   no results, this is not defined. The invalid index num_var_rec is used
+   when NDEBUG is not defined. If the operator has more than one result, this
+   is the primary result; i.e., the last result. Auxillary are only used by
+   the operator and not used by other operators.
+   */
+   pod_vector<unsigned char> op2var_vec;
+
+   /// Mapping from primary variable index to corresponding operator index.
+   /// This is used to traverse sub-graphs of the operation sequence.
+   /// This value is valid (invalid) for primary (auxillary) variables.
+   pod_vector<unsigned char> var2op_vec;
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
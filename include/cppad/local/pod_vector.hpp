@@ -211,6 +211,26 @@ public:
    }
    // ----------------------------------------------------------------------
    /*!
+   Increase the capacity of this vector
+   (existing elements and the size of the vector are preserved).
+
+   \param n
+   is the minimum capacity for this vector after the call.
+   If n <= capacity(), no memory is allocated.
+
+   - This is useful when the final size of a vector that is grown using
+   extend is known ahead of time.
+   */
+   void reserve(size_t n)
+   {  if( n * sizeof(Type) <= byte_capacity_ )
+         return;
+      size_t old_length = byte_length_;
+      extend( n - size() );
+      byte_length_      = old_length;
+      CPPAD_ASSERT_UNKNOWN( n <= capacity() );
+   }
+   // ----------------------------------------------------------------------
+   /*!
    resize the vector (existing elements preserved when n <= capacity() ).
 
    \param n
@@ -470,6 +490,26 @@ public:
    }
    // ----------------------------------------------------------------------
    /*!
+   Increase the capacity of this vector
+   (existing elements and the size of the vector are preserved).
+
+   \param n
+   is the minimum capacity for this vector after the call.
+   If n <= capacity(), no memory is allocated.
+
+   - This is useful when the final size of a vector that is grown using
+   extend is known ahead of time.
+   */
+   void reserve(size_t n)
+   {  if( n <= capacity_ )
+         return;
+      size_t old_length = length_;
+      extend( n - length_ );
+      length_           = old_length;
+      CPPAD_ASSERT_UNKNOWN( n <= capacity_ );
+   }
+   // ----------------------------------------------------------------------
+   /*!
    resize the vector (existing elements preserved when n <= capacity_).
 
    \param n
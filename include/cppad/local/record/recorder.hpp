@@ -188,6 +188,9 @@ public:
       VectorAD&                   ay
    );
 
+   // Reserve memory for the operators, arguments, and parameters
+   void reserve(size_t n_op, size_t n_arg, size_t n_par);
+
    // Reserve space for a specified number of arguments
    size_t ReserveArg(size_t n_arg);
 
@@ -252,6 +255,10 @@ public:
    size_t num_op_rec(void) const
    {  return  op_vec_.size(); }
 
+   /// Number of operator arguments currently stored in the recording.
+   size_t num_arg_rec(void) const
+   {  return  arg_vec_.size(); }
+
    /// current parameter vector
    const pod_vector_maybe<Base>& all_par_vec(void) const
    {  return all_par_vec_; }
@@ -760,6 +767,32 @@ void recorder<Base>::PutArg(addr_t arg0, addr_t arg1, addr_t arg2,
 }
 // --------------------------------------------------------------------------
 /*!
+Reserve memory for the recording (does not change what has been recorded).
+
+\param n_op
+minimum capacity for the vector of operators in the recording.
+
+\param n_arg
+minimum capacity for the vector of operator arguments in the recording.
+
+\param n_par
+minimum capacity for the vector of all parameters in the recording.
+
+\par
+If one of these values is less than or equal the corresponding current
+capacity, the corresponding vector is not changed.
+This avoids repeated reallocation and copying when the size of the recording
+is known ahead of time; e.g., when the same function is retaped.
+*/
+template <class Base>
+void recorder<Base>::reserve(size_t n_op, size_t n_arg, size_t n_par)
+{  op_vec_.reserve(n_op);
+   arg_vec_.reserve(n_arg);
+   all_par_vec_.reserve(n_par);
+   dyn_par_is_.reserve(n_par);
+}
+// --------------------------------------------------------------------------
+/*!
 Reserve space for arguments, but delay placing values there.
 
 \param n_arg
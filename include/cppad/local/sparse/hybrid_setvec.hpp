@@ -0,0 +1,1348 @@
+# ifndef CPPAD_LOCAL_SPARSE_HYBRID_SETVEC_HPP
+# define CPPAD_LOCAL_SPARSE_HYBRID_SETVEC_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/define.hpp>
+# include <cppad/local/pod_vector.hpp>
+# include <algorithm>
+# include <limits>
+# include <set>
+
+/*
+{xrst_begin hybrid_setvec dev}
+{xrst_spell
+   bitmap
+   bitmaps
+}
+
+Implement SetVector Using Sorted Vectors and Bitmaps
+####################################################
+
+Namespace
+*********
+This class is in the ``CppAD::local::sparse`` namespace.
+
+Public
+******
+The public member function for the ``hybrid_setvec`` class implement the
+:ref:`SetVector-name` concept.
+
+Representation
+**************
+All the sets are stored in one vector of ``size_t`` values.
+Let *n_pack* be the number of ``size_t`` values required to represent
+one bit for each possible element of a set; i.e.,
+*end* divided by ``std::numeric_limits<size_t>::digits``
+and rounded up.
+If the number of elements in a set is less than or equal *n_pack* ,
+the set is stored as a vector of its elements in increasing order.
+Otherwise it is stored as a bitmap using *n_pack* values.
+Thus the representation of a set depends only on its number of elements,
+and each set uses at most the memory for its elements and at most the
+memory for its bitmap.
+
+Sharing
+*******
+As with :ref:`list_setvec-name` ,
+a reference count is used so that a set that is equal to another set
+in the same vector (e.g., the result of an assignment or a union where
+one operand is a subset of the other) does not use more memory.
+
+{xrst_end hybrid_setvec}
+*/
+
+// BEGIN_CPPAD_LOCAL_SPARSE_NAMESPACE
+namespace CppAD { namespace local { namespace sparse {
+
+/*!
+\file hybrid_setvec.hpp
+Vector of sets of positive integers, each set is stored as either a
+size_t vector with the element values strictly increasing or as a bitmap.
+*/
+class hybrid_setvec_const_iterator;
+
+/*!
+Number of bits that are one in a size_t value.
+*/
+inline size_t hybrid_setvec_bit_count(size_t word)
+{  size_t count = 0;
+   while( word != 0 )
+   {  word &= word - 1;
+      ++count;
+   }
+   return count;
+}
+
+// =========================================================================
+/*!
+Vector of sets of positive integers, each set stored as a sorted vector
+or a bitmap depending on its number of elements.
+
+All the public members for this class are also in the
+sparse::pack_setvec and sparse::list_setvec classes.
+This defines the CppAD vector_of_sets concept.
+*/
+class hybrid_setvec {
+   friend class hybrid_setvec_const_iterator;
+private:
+   /// Number of bits (elements) per size_t value in a bitmap
+   const size_t n_bit_;
+
+   /// Possible elements in each set are 0, 1, ..., end_ - 1;
+   size_t end_;
+
+   /// Number of size_t values used to represent a set as a bitmap.
+   size_t n_pack_;
+
+   /// number of elements in data_ that have been allocated
+   /// and are no longer being used.
+   size_t data_not_used_;
+
+   /// The data for all the sets and posts.
+   pod_vector<size_t> data_;
+
+   /*!
+   Starting point for i-th set is start_[i].
+
+   \li
+   If the i-th set has no elements, start_[i] is zero.
+   Othersize the conditions below hold.
+
+   \li
+   data_[ start_[i] ] is the reference count for this set.
+
+   \li
+   data_[ start_[i] + 1 ] is the number of elements in this set.
+   We use length to denote this value below.
+
+   \li
+   If length <= n_pack_,
+   data_[ start_[i] + 2 + k ], for k = 0, ..., length-1,
+   are the elements in the set in increasing order and
+   data_[ start_[i] + 2 + length ] = end_ .
+
+   \li
+   If length > n_pack_,
+   data_[ start_[i] + 2 + k ], for k = 0, ..., n_pack_ - 1,
+   is the bitmap for the set; i.e., bit j of data_[ start_[i] + 2 + k ]
+   is one if and only if k * n_bit_ + j is in the set.
+   */
+   pod_vector<size_t> start_;
+
+   /*!
+   Vectors of elements that have not yet been added to corresponding sets.
+
+   \li
+   If all the post_element calls for the i-th set have been added,
+   post_[i] is zero. Otherwise the conditions below hold.
+
+   \li
+   data_[ post_[i] ]  the number of elements that have been posted,
+   but not yet added, to set i.
+
+   \li
+   data_[ post_[i] + 1 ] is the capacity for holding elements
+   which is greater than or equal the number of elements.
+
+   \li
+   data_[ post_[i] + 2 + k ], for k less than the number of elements,
+   are the elements that have been posted, but not yet added, to set i.
+   */
+   pod_vector<size_t> post_;
+
+   /// Work space used to hold the result of an operation before it is
+   /// stored in data_ (storing can change the memory used by data_).
+   pod_vector<size_t> temp_;
+   // -----------------------------------------------------------------
+   /*!
+   Is a set with this many elements stored as a bitmap.
+
+   \param length
+   is the number of elements in the set.
+   */
+   bool is_bitmap(size_t length) const
+   {  return length > n_pack_; }
+   // -----------------------------------------------------------------
+   /*!
+   Number of data_ entries used by a set with this many elements.
+
+   \param length
+   is the number of elements in the set (must be non-zero).
+   */
+   size_t set_size(size_t length) const
+   {  CPPAD_ASSERT_UNKNOWN( length > 0 );
+      if( is_bitmap(length) )
+         return n_pack_ + 2;
+      return length + 3;
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Counts references to a set.
+
+   \param i
+   is the index of the set that we are counting the references to.
+
+   \return
+   if the set is empty, the return value is zero.
+   Otherwise it is the number of sets that share the same vector.
+   */
+   size_t reference_count(size_t i) const
+   {  size_t start = start_[i];
+      if( start == 0 )
+         return 0;
+      return data_[start];
+   }
+   // -----------------------------------------------------------------
+   /*!
+   drop a set and its posts.
+
+   \param i
+   is the index of the set that will be dropped.
+
+   \par reference_count
+   if the set is non-empty,
+   the reference count corresponding to index will be decremented.
+
+   \par post_
+   Upon return post_[i] is zero.
+
+   \return
+   is the number of elements of data_ that will be lost when the set is
+   dropped.
+   */
+   size_t drop(size_t i)
+   {  size_t number_lost = 0;
+      //
+      // posts
+      size_t post = post_[i];
+      if( post != 0 )
+      {  number_lost += data_[post + 1] + 2;
+         post_[i]     = 0;
+      }
+      //
+      // empty set case
+      size_t start = start_[i];
+      if( start == 0 )
+         return number_lost;
+      //
+      // decrement reference counter
+      CPPAD_ASSERT_UNKNOWN( data_[start] > 0 );
+      data_[start]--;
+      //
+      // nothing else lost unless new reference count is zero
+      if( data_[start] == 0 )
+         number_lost += set_size( data_[start + 1] );
+      //
+      return number_lost;
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Checks data structure
+   (effectively const, but modifies and restores values)
+   */
+# ifdef NDEBUG
+   void check_data_structure(void)
+   {  return; }
+# else
+   void check_data_structure(void)
+   {  // number of sets
+      CPPAD_ASSERT_UNKNOWN( post_.size() == start_.size() );
+      size_t n_set = start_.size();
+      if( n_set == 0 )
+      {  CPPAD_ASSERT_UNKNOWN( end_ == 0 );
+         CPPAD_ASSERT_UNKNOWN( data_not_used_ == 0 );
+         CPPAD_ASSERT_UNKNOWN( data_.size() == 0 );
+         return;
+      }
+      // ------------------------------------------------------------------
+      // save the reference counters
+      pod_vector<size_t> ref_count(n_set);
+      for(size_t i = 0; i < n_set; i++)
+         ref_count[i] = reference_count(i);
+      //
+      // count the number of entries in data_ that are used by sets
+      size_t data_used_by_sets = 0;
+      for(size_t i = 0; i < n_set; i++)
+      {  size_t start = start_[i];
+         if( start > 0 )
+         {  size_t length = data_[start + 1];
+            CPPAD_ASSERT_UNKNOWN( data_[start] > 0 );
+            CPPAD_ASSERT_UNKNOWN( 0 < length && length <= end_ );
+            if( ! is_bitmap(length) )
+            {  CPPAD_ASSERT_UNKNOWN( data_[start + 2 + length] == end_ );
+               for(size_t k = 1; k < length; ++k)
+                  CPPAD_ASSERT_UNKNOWN(
+                     data_[start + 1 + k] < data_[start + 2 + k]
+                  );
+            }
+            else
+            {  size_t count = 0;
+               for(size_t k = 0; k < n_pack_; ++k)
+                  count += hybrid_setvec_bit_count( data_[start + 2 + k] );
+               CPPAD_ASSERT_UNKNOWN( count == length );
+            }
+            //
+            // decrement the reference counter
+            data_[start]--;
+            //
+            // count the entries when find last reference
+            if( data_[start] == 0 )
+            {  // restore reference count
+               data_[start] = ref_count[i];
+               //
+               data_used_by_sets += set_size(length);
+            }
+         }
+      }
+      // ------------------------------------------------------------------
+      // count the number of entries in data_ that are used by posts
+      size_t data_used_by_posts = 0;
+      for(size_t i = 0; i < n_set; i++)
+      {  size_t post = post_[i];
+         if( post > 0 )
+         {  CPPAD_ASSERT_UNKNOWN( data_[post] > 0 );
+            CPPAD_ASSERT_UNKNOWN( data_[post] <= data_[post + 1] );
+            //
+            size_t capacity     = data_[post + 1];
+            data_used_by_posts += capacity + 2;
+         }
+      }
+      // ------------------------------------------------------------------
+      size_t data_used = data_used_by_sets + data_used_by_posts;
+      CPPAD_ASSERT_UNKNOWN(
+         data_used + data_not_used_ == data_.size()
+      );
+      return;
+   }
+# endif
+   // -----------------------------------------------------------------
+   /*!
+   Does garbage collection when indicated.
+
+   This routine should be called when more entries are not being used.
+   If a significant propotion are not being used, the data structure
+   will be compacted.
+   Note that data_[0] never gets used.
+   */
+   void collect_garbage(void)
+   {  if( data_not_used_ < data_.size() / 2 +  100)
+         return;
+      check_data_structure();
+      //
+      // number of sets including empty ones
+      size_t n_set  = start_.size();
+      //
+      // use temporary to hold copy of data_ and start_
+      pod_vector<size_t> data_tmp(1); // data_tmp[0] will not be used
+      data_tmp.reserve( data_.size() - data_not_used_ + 1 );
+      //
+      for(size_t i = 0; i < n_set; i++)
+      {  size_t start = start_[i];
+         if( start != 0 )
+         {  // check if this set has already been copied
+            if( data_[start] == 0 )
+            {  // starting address in data_tmp has been stored here
+               start_[i] = data_[start + 1];
+            }
+            else
+            {  size_t length    = data_[start + 1];
+               size_t size      = set_size(length);
+               size_t tmp_start = data_tmp.extend(size);
+               for(size_t k = 0; k < size; ++k)
+                  data_tmp[tmp_start + k] = data_[start + k];
+               //
+               // flag that indicates this set already copied
+               data_[start] = 0;
+               //
+               // store the starting address here
+               data_[start + 1] = tmp_start;
+               start_[i]        = tmp_start;
+            }
+         }
+         size_t post = post_[i];
+         if( post != 0 )
+         {  size_t size     = data_[post + 1] + 2;
+            size_t tmp_post = data_tmp.extend(size);
+            for(size_t k = 0; k < size; ++k)
+               data_tmp[tmp_post + k] = data_[post + k];
+            post_[i] = tmp_post;
+         }
+      }
+      // swap the tmp and old data vectors
+      data_.swap(data_tmp);
+      //
+      // all of the elements, except the first, are used
+      data_not_used_ = 1;
+      check_data_structure();
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Convert temp_ from a sorted vector of elements to a bitmap.
+
+   \param length
+   is the number of elements in temp_.
+   */
+   void temp_array2bitmap(size_t length)
+   {  size_t n_array = temp_.size();
+      CPPAD_ASSERT_UNKNOWN( length <= n_array );
+      temp_.extend(n_pack_);
+      size_t* bitmap = temp_.data() + n_array;
+      for(size_t k = 0; k < n_pack_; ++k)
+         bitmap[k] = 0;
+      for(size_t k = 0; k < length; ++k)
+      {  size_t element = temp_[k];
+         size_t j       = element / n_bit_;
+         bitmap[j]     |= size_t(1) << (element - j * n_bit_);
+      }
+      for(size_t k = 0; k < n_pack_; ++k)
+         temp_[k] = bitmap[k];
+      temp_.resize(n_pack_);
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Store the set in temp_ as a set in this vector.
+
+   \param target
+   is the index of the set that is replaced by the set in temp_.
+
+   \param length
+   is the number of elements in the set.
+
+   \param bitmap
+   If true (false), temp_ is a bitmap (sorted vector of elements).
+   */
+   void store_temp(size_t target, size_t length, bool bitmap)
+   {  size_t number_lost = drop(target);
+      //
+      if( length == 0 )
+      {  start_[target] = 0;
+         data_not_used_ += number_lost;
+         collect_garbage();
+         return;
+      }
+      //
+      // change representation if necessary
+      if( is_bitmap(length) & (! bitmap) )
+      {  temp_array2bitmap(length);
+         bitmap = true;
+      }
+      //
+      // new version of target
+      size_t size       = set_size(length);
+      size_t start      = data_.extend(size);
+      start_[target]    = start;
+      data_[start]      = 1;      // reference count
+      data_[start + 1]  = length; // number of elements
+      size_t* set       = data_.data() + start + 2;
+      if( is_bitmap(length) )
+      {  CPPAD_ASSERT_UNKNOWN( bitmap );
+         for(size_t k = 0; k < n_pack_; ++k)
+            set[k] = temp_[k];
+      }
+      else if( ! bitmap )
+      {  for(size_t k = 0; k < length; ++k)
+            set[k] = temp_[k];
+         set[length] = end_;
+      }
+      else
+      {  // convert from a bitmap to a sorted vector
+         size_t index = 0;
+         for(size_t k = 0; k < n_pack_; ++k)
+         {  size_t word    = temp_[k];
+            size_t element = k * n_bit_;
+            while( word != 0 )
+            {  if( word & 1 )
+                  set[index++] = element;
+               word >>= 1;
+               ++element;
+            }
+         }
+         CPPAD_ASSERT_UNKNOWN( index == length );
+         set[length] = end_;
+      }
+      //
+      data_not_used_ += number_lost;
+      collect_garbage();
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Set temp_ to the bitmap for a set.
+
+   \param vec
+   is the vector of sets that contains the set.
+
+   \param start
+   is the start for the set in vec.data_ (must not be zero).
+
+   \param bitmap_or
+   if true, the bits for this set are or-ed with the current values
+   in temp_ (which must be a bitmap).
+   */
+   void temp_bitmap(
+      const hybrid_setvec& vec, size_t start, bool bitmap_or)
+   {  CPPAD_ASSERT_UNKNOWN( start != 0 );
+      CPPAD_ASSERT_UNKNOWN( n_pack_ == vec.n_pack_ );
+      if( ! bitmap_or )
+      {  temp_.resize(n_pack_);
+         for(size_t k = 0; k < n_pack_; ++k)
+            temp_[k] = 0;
+      }
+      CPPAD_ASSERT_UNKNOWN( temp_.size() == n_pack_ );
+      size_t*       bitmap = temp_.data();
+      size_t        length = vec.data_[start + 1];
+      const size_t* set    = vec.data_.data() + start + 2;
+      if( is_bitmap(length) )
+      {  for(size_t k = 0; k < n_pack_; ++k)
+            bitmap[k] |= set[k];
+      }
+      else
+      {  for(size_t k = 0; k < length; ++k)
+         {  size_t j = set[k] / n_bit_;
+            bitmap[j] |= size_t(1) << (set[k] - j * n_bit_);
+         }
+      }
+   }
+public:
+   /// declare a const iterator
+   typedef hybrid_setvec_const_iterator const_iterator;
+   // -----------------------------------------------------------------
+   /*!
+   Default constructor (no sets)
+   */
+   hybrid_setvec(void) :
+   n_bit_( std::numeric_limits<size_t>::digits ) ,
+   end_(0)            ,
+   n_pack_(0)         ,
+   data_not_used_(0)  ,
+   data_(0)           ,
+   start_(0)          ,
+   post_(0)           ,
+   temp_(0)
+   { }
+   // -----------------------------------------------------------------
+   /// Destructor
+   ~hybrid_setvec(void)
+   {  check_data_structure();
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Using copy constructor is a programing (not user) error
+
+   \param v
+   vector of sets that we are attempting to make a copy of.
+   */
+   hybrid_setvec(const hybrid_setvec& v) :
+   n_bit_( std::numeric_limits<size_t>::digits )
+   {  // Error: Probably a hybrid_setvec argument has been passed by value
+      CPPAD_ASSERT_UNKNOWN(false);
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Assignement operator.
+
+   \param other
+   this hybrid_setvec with be set to a deep copy of other.
+   */
+   void operator=(const hybrid_setvec& other)
+   {  end_           = other.end_;
+      n_pack_        = other.n_pack_;
+      data_not_used_ = other.data_not_used_;
+      data_          = other.data_;
+      start_         = other.start_;
+      post_          = other.post_;
+   }
+   // -----------------------------------------------------------------
+   /*!
+   swap (used by move semantics version of ADFun assignment operator)
+
+   \param other
+   this hybrid_setvec with be swapped with other.
+   */
+   void swap(hybrid_setvec& other)
+   {  // size_t objects
+      std::swap(end_             , other.end_);
+      std::swap(n_pack_          , other.n_pack_);
+      std::swap(data_not_used_   , other.data_not_used_);
+      //
+      // pod_vectors
+      data_.swap(       other.data_);
+      start_.swap(      other.start_);
+      post_.swap(       other.post_);
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Start a new vector of sets.
+
+   \param n_set
+   is the number of sets in this vector of sets.
+   \li
+   If n_set is zero, any memory currently allocated for this object
+   is freed.
+   \li
+   If n_set is non-zero, a vector of n_set sets is created and all
+   the sets are initilaized as empty.
+
+   \param end
+   is the maximum element plus one (the minimum element is 0).
+   If n_set is zero, end must also be zero.
+   */
+   void resize(size_t n_set, size_t end)
+   {  check_data_structure();
+      //
+      if( n_set == 0 )
+      {  CPPAD_ASSERT_UNKNOWN(end == 0 );
+         //
+         // restore object to start after constructor
+         // (no memory allocated for this object)
+         data_.clear();
+         start_.clear();
+         post_.clear();
+         temp_.clear();
+         data_not_used_  = 0;
+         end_            = 0;
+         n_pack_         = 0;
+         //
+         return;
+      }
+      end_    = end;
+      n_pack_ = 0;
+      if( end_ > 0 )
+         n_pack_ = 1 + (end_ - 1) / n_bit_;
+      //
+      start_.resize(n_set);
+      post_.resize(n_set);
+      for(size_t i = 0; i < n_set; i++)
+      {  start_[i] = 0;
+         post_[i]  = 0;
+      }
+      //
+      data_.resize(1);     // first element is not used
+      data_not_used_  = 1;
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Return number of elements in a set.
+
+   \param i
+   is the index of the set we are checking number of the elements of.
+   */
+   size_t number_elements(size_t i) const
+   {  CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+      //
+      size_t start = start_[i];
+      if( start == 0 )
+         return 0;
+      return data_[start + 1];
+   }
+   // ------------------------------------------------------------------
+   /*!
+   Post an element for delayed addition to a set.
+
+   \param i
+   is the index for this set in the vector of sets.
+
+   \param element
+   is the value of the element that we are posting.
+   The same element may be posted multiple times.
+
+   \par
+   It is faster to post multiple elements to set i and then call
+   process_post(i) then to add each element individually.
+   It is an error to call any member function,
+   that depends on the value of set i,
+   before processing the posts to set i.
+   */
+   void post_element(size_t i, size_t element)
+   {  CPPAD_ASSERT_UNKNOWN( i < start_.size() );
+      CPPAD_ASSERT_UNKNOWN( element < end_ );
+      //
+      size_t post = post_[i];
+      if( post == 0 )
+      {  // minimum capacity for an post vector
+         size_t min_capacity = 10;
+         size_t post_new = data_.extend(min_capacity + 2);
+         data_[post_new]     = 1;            // length
+         data_[post_new + 1] = min_capacity; // capacity
+         data_[post_new + 2] = element;
+         post_[i]            = post_new;
+         return;
+      }
+      size_t length   = data_[post];
+      size_t capacity = data_[post + 1];
+      if( length < capacity )
+      {  data_[post]              = length + 1;
+         data_[post + 2 + length] = element;
+         return;
+      }
+      size_t post_new = data_.extend( 2 * capacity + 2 );
+      data_[post_new]     = length + 1;
+      data_[post_new + 1] = 2 * capacity;
+      for(size_t k = 0; k < length; k++)
+         data_[post_new + 2 + k] = data_[post + 2 + k];
+      data_[post_new + 2 + length] = element;
+      post_[i] = post_new;
+      //
+      data_not_used_ += capacity + 2;
+      collect_garbage();
+   }
+   // -----------------------------------------------------------------
+   /*!
+   process post entries for a specific set.
+
+   \param i
+   index of the set for which we are processing the post entries.
+
+   \par post_
+   Upon call, post_[i] is location in data_ of the elements that get
+   added to the i-th set.  Upon return, post_[i] is zero.
+   */
+   void process_post(size_t i)
+   {  size_t post = post_[i];
+      if( post == 0 )
+         return;
+      //
+      // sort the elements that need to be processed
+      size_t  n_post     = data_[post];
+      size_t* first_post = data_.data() + post + 2;
+      size_t* last_post  = first_post + n_post;
+      std::sort(first_post, last_post);
+      //
+      size_t start  = start_[i];
+      size_t length = 0;
+      if( start != 0 )
+         length = data_[start + 1];
+      //
+      size_t result = 0;
+      bool   bitmap = is_bitmap(length);
+      if( bitmap )
+      {  // bitmap for result
+         temp_bitmap(*this, start, false);
+         for(size_t k = 0; k < n_post; ++k)
+         {  size_t element = data_[post + 2 + k];
+            size_t j       = element / n_bit_;
+            temp_[j]      |= size_t(1) << (element - j * n_bit_);
+         }
+         for(size_t k = 0; k < n_pack_; ++k)
+            result += hybrid_setvec_bit_count( temp_[k] );
+      }
+      else
+      {  // merge the set and the posts
+         temp_.resize(length + n_post);
+         size_t index_set  = 0;
+         size_t index_post = 0;
+         size_t value_set  = end_;
+         if( length > 0 )
+            value_set = data_[start + 2];
+         size_t value_post = data_[post + 2];
+         while( (value_set < end_) | (value_post < end_) )
+         {  size_t value = std::min(value_set, value_post);
+            temp_[result++] = value;
+            if( value_set == value )
+               value_set = data_[start + 2 + (++index_set)];
+            while( value_post == value )
+            {  if( ++index_post == n_post )
+                  value_post = end_;
+               else
+                  value_post = data_[post + 2 + index_post];
+            }
+         }
+         temp_.resize(result);
+      }
+      if( result == length )
+      {  // posts were a subset of the set
+         data_not_used_ += data_[post + 1] + 2;
+         post_[i]        = 0;
+         collect_garbage();
+         return;
+      }
+      // store_temp also drops the posts for this set
+      store_temp(i, result, bitmap);
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Add one element to a set.
+
+   \param i
+   is the index for this set in the vector of sets.
+
+   \param element
+   is the element we are adding to the set.
+   */
+   void add_element(size_t i, size_t element)
+   {  CPPAD_ASSERT_UNKNOWN( i   < start_.size() );
+      CPPAD_ASSERT_UNKNOWN( element < end_ );
+      //
+      // check if element is already in the set
+      if( is_element(i, element) )
+         return;
+      //
+      size_t start  = start_[i];
+      size_t length = 0;
+      if( start != 0 )
+         length = data_[start + 1];
+      //
+      bool bitmap = is_bitmap(length);
+      if( bitmap && data_[start] == 1 )
+      {  // this bitmap is not shared, so modify it in place
+         size_t j = element / n_bit_;
+         data_[start + 2 + j] |= size_t(1) << (element - j * n_bit_);
+         data_[start + 1]      = length + 1;
+         return;
+      }
+      if( bitmap )
+      {  temp_bitmap(*this, start, false);
+         size_t j  = element / n_bit_;
+         temp_[j] |= size_t(1) << (element - j * n_bit_);
+      }
+      else
+      {  temp_.resize(length + 1);
+         size_t index = 0;
+         for(size_t k = 0; k < length; ++k)
+         {  size_t value = data_[start + 2 + k];
+            if( index == k && element < value )
+               temp_[index++] = element;
+            temp_[index++] = value;
+         }
+         if( index == length )
+            temp_[index++] = element;
+         CPPAD_ASSERT_UNKNOWN( index == length + 1 );
+      }
+      store_temp(i, length + 1, bitmap);
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Check if an element is in a set.
+
+   \param i
+   is the index for this set in the vector of sets.
+
+   \param element
+   is the element we are checking to see if it is in the set.
+   */
+   bool is_element(size_t i, size_t element) const
+   {  CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+      CPPAD_ASSERT_UNKNOWN( element < end_ );
+      //
+      size_t start = start_[i];
+      if( start == 0 )
+         return false;
+      //
+      size_t length       = data_[start + 1];
+      const size_t* first = data_.data() + start + 2;
+      if( is_bitmap(length) )
+      {  size_t j = element / n_bit_;
+         return ( first[j] >> (element - j * n_bit_) ) & 1;
+      }
+      const size_t* last  = first + length;
+      if( length < 10 )
+      {  bool result = false;
+         while( last > first )
+            result |= *(--last) == element;
+         return result;
+      }
+      return std::binary_search(first, last, element);
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Assign the empty set to one of the sets.
+
+   \param target
+   is the index of the set we are setting to the empty set.
+
+   \par data_not_used_
+   increments this value by number of data_ elements that are lost
+   (unlinked) by this operation.
+   */
+   void clear(size_t target)
+   {  // number of data_ elements used for this set and its posts
+      size_t number_lost = drop( target );
+      //
+      // set target to empty set
+      start_[target] = 0;
+      //
+      // adjust data_not_used_
+      data_not_used_ += number_lost;
+      collect_garbage();
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Assign one set equal to another set.
+
+   \param this_target
+   is the index in this hybrid_setvec object of the set being assinged.
+
+   \param other_source
+   is the index in the other hybrid_setvec object of the
+   set that we are using as the value to assign to the target set.
+
+   \param other
+   is the other hybrid_setvec object (which may be the same as this
+   hybrid_setvec object). This must have the same value for end_.
+
+   \par data_not_used_
+   increments this value by number of elements lost.
+   */
+   void assignment(
+      size_t                  this_target  ,
+      size_t                  other_source ,
+      const hybrid_setvec&    other        )
+   {  CPPAD_ASSERT_UNKNOWN( other.post_[ other_source ] == 0 );
+      //
+      CPPAD_ASSERT_UNKNOWN( this_target  <   start_.size()        );
+      CPPAD_ASSERT_UNKNOWN( other_source <   other.start_.size()  );
+      CPPAD_ASSERT_UNKNOWN( end_        == other.end_   );
+      //
+      // check if we are assigning a set to itself
+      if( (this == &other) & (this_target == other_source) )
+         return;
+      //
+      // If this and other are the same, use another reference to same set
+      // (increment before drop in case the target shares this set)
+      size_t other_start = other.start_[other_source];
+      if( this == &other )
+      {  if( other_start != 0 )
+            data_[other_start]++;
+         size_t number_lost  = drop(this_target);
+         start_[this_target] = other_start;
+         data_not_used_     += number_lost;
+         collect_garbage();
+         return;
+      }
+      size_t number_lost  = drop(this_target);
+      start_[this_target] = 0;
+      if( other_start != 0 )
+      {  // make a copy of the other set in this hybrid_setvec
+         size_t length         = other.data_[other_start + 1];
+         size_t size           = set_size(length);
+         size_t this_start     = data_.extend(size);
+         start_[this_target]   = this_start;
+         data_[this_start]     = 1;      // reference count
+         for(size_t k = 1; k < size; ++k)
+            data_[this_start + k] = other.data_[other_start + k];
+      }
+      //
+      // adjust data_not_used_
+      data_not_used_ += number_lost;
+      collect_garbage();
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Assign a set equal to the union of two other sets.
+
+   \param this_target
+   is the index in this hybrid_setvec object of the set being assinged.
+
+   \param this_left
+   is the index in this hybrid_setvec object of the
+   left operand for the union operation.
+   It is OK for this_target and this_left to be the same value.
+
+   \param other_right
+   is the index in the other hybrid_setvec object of the
+   right operand for the union operation.
+   It is OK for this_target and other_right to be the same value.
+
+   \param other
+   is the other hybrid_setvec object (which may be the same as this
+   hybrid_setvec object).
+   */
+   void binary_union(
+      size_t                  this_target  ,
+      size_t                  this_left    ,
+      size_t                  other_right  ,
+      const hybrid_setvec&    other        )
+   {  CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+      CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+      //
+      CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+      CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+      CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+      CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+      //
+      size_t start_left  = start_[this_left];
+      size_t start_right = other.start_[other_right];
+      //
+      // case where right is empty or the same as left
+      bool same = (this == &other) & (start_left == start_right);
+      if( (start_right == 0) | same )
+      {  assignment(this_target, this_left, *this);
+         return;
+      }
+      // case where left is empty
+      if( start_left == 0 )
+      {  assignment(this_target, other_right, other);
+         return;
+      }
+      size_t length_left  = data_[start_left + 1];
+      size_t length_right = other.data_[start_right + 1];
+      //
+      // result
+      size_t result = 0;
+      bool   bitmap = is_bitmap(length_left) | is_bitmap(length_right);
+      if( bitmap )
+      {  temp_bitmap(*this, start_left, false);
+         temp_bitmap(other, start_right, true);
+         for(size_t k = 0; k < n_pack_; ++k)
+            result += hybrid_setvec_bit_count( temp_[k] );
+      }
+      else
+      {  temp_.resize(length_left + length_right);
+         const size_t* left  = data_.data() + start_left + 2;
+         const size_t* right = other.data_.data() + start_right + 2;
+         while( (*left < end_) | (*right < end_) )
+         {  size_t value = std::min(*left, *right);
+            temp_[result++] = value;
+            left  += size_t( *left  == value );
+            right += size_t( *right == value );
+         }
+         temp_.resize(result);
+      }
+      //
+      // case where right is a subset of left
+      if( result == length_left )
+      {  assignment(this_target, this_left, *this);
+         return;
+      }
+      // case where left is a subset of right
+      if( result == length_right )
+      {  assignment(this_target, other_right, other);
+         return;
+      }
+      store_temp(this_target, result, bitmap);
+   }
+   // -----------------------------------------------------------------
+   /*!
+   Assign a set equal to the intersection of two other sets.
+
+   \param this_target
+   is the index in this hybrid_setvec object of the set being assinged.
+
+   \param this_left
+   is the index in this hybrid_setvec object of the
+   left operand for the intersection operation.
+   It is OK for this_target and this_left to be the same value.
+
+   \param other_right
+   is the index in the other hybrid_setvec object of the
+   right operand for the intersection operation.
+   It is OK for this_target and other_right to be the same value.
+
+   \param other
+   is the other hybrid_setvec object (which may be the same as this
+   hybrid_setvec object).
+   */
+   void binary_intersection(
+      size_t                  this_target  ,
+      size_t                  this_left    ,
+      size_t                  other_right  ,
+      const hybrid_setvec&    other        )
+   {  CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+      CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+      //
+      CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+      CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+      CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+      CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+      //
+      size_t start_left  = start_[this_left];
+      size_t start_right = other.start_[other_right];
+      //
+      // case where left is empty or the same as right
+      bool same = (this == &other) & (start_left == start_right);
+      if( (start_left == 0) | same )
+      {  assignment(this_target, this_left, *this);
+         return;
+      }
+      // case where right is empty
+      if( start_right == 0 )
+      {  assignment(this_target, other_right, other);
+         return;
+      }
+      size_t length_left  = data_[start_left + 1];
+      size_t length_right = other.data_[start_right + 1];
+      const size_t* left  = data_.data() + start_left + 2;
+      const size_t* right = other.data_.data() + start_right + 2;
+      //
+      // result
+      size_t result = 0;
+      bool   bitmap = is_bitmap(length_left) & is_bitmap(length_right);
+      if( bitmap )
+      {  temp_.resize(n_pack_);
+         for(size_t k = 0; k < n_pack_; ++k)
+         {  temp_[k] = left[k] & right[k];
+            result  += hybrid_setvec_bit_count( temp_[k] );
+         }
+      }
+      else if( is_bitmap(length_left) | is_bitmap(length_right) )
+      {  // elements of the vector that are in the bitmap
+         const size_t* vec    = left;
+         const size_t* bits   = right;
+         size_t        length = length_left;
+         if( is_bitmap(length_left) )
+         {  vec    = right;
+            bits   = left;
+            length = length_right;
+         }
+         temp_.resize(length);
+         for(size_t k = 0; k < length; ++k)
+         {  size_t j = vec[k] / n_bit_;
+            if( ( bits[j] >> (vec[k] - j * n_bit_) ) & 1 )
+               temp_[result++] = vec[k];
+         }
+         temp_.resize(result);
+      }
+      else
+      {  temp_.resize( std::min(length_left, length_right) );
+         while( (*left < end_) & (*right < end_) )
+         {  if( *left == *right )
+            {  temp_[result++] = *left;
+               ++left;
+               ++right;
+            }
+            else if( *left < *right )
+               ++left;
+            else
+               ++right;
+         }
+         temp_.resize(result);
+      }
+      //
+      // case where left is a subset of right
+      if( result == length_left )
+      {  assignment(this_target, this_left, *this);
+         return;
+      }
+      // case where right is a subset of left
+      if( result == length_right )
+      {  assignment(this_target, other_right, other);
+         return;
+      }
+      store_temp(this_target, result, bitmap);
+   }
+   // -----------------------------------------------------------------
+   /*! Fetch n_set for vector of sets object.
+
+   \return
+   Number of from sets for this vector of sets object
+   */
+   size_t n_set(void) const
+   {  return start_.size(); }
+   // -----------------------------------------------------------------
+   /*! Fetch end for this vector of sets object.
+
+   \return
+   is the maximum element value plus one (the minimum element value is 0).
+   */
+   size_t end(void) const
+   {  return end_; }
+   // -----------------------------------------------------------------
+   /*! Amount of memory used by this vector of sets
+
+   \return
+   The amount of memory in units of type unsigned char memory.
+   */
+   size_t memory(void) const
+   {  return data_.capacity() * sizeof(size_t);
+   }
+   /*!
+   Print the vector of sets (used for debugging)
+   */
+   void print(void) const;
+};
+// =========================================================================
+/*!
+cons_iterator for one set of positive integers in a hybrid_setvec object.
+
+All the public member functions for this class are also in the
+sparse::pack_setvec_const_iterator and sparse::list_setvec_const_iterator classes.
+This defines the CppAD vector_of_sets iterator concept.
+*/
+class hybrid_setvec_const_iterator {
+private:
+   /// data for the entire vector of sets
+   const pod_vector<size_t>& data_;
+
+   /// Number of bits (elements) per size_t value in a bitmap
+   const size_t              n_bit_;
+
+   /// Possible elements in a list are 0, 1, ..., end_ - 1;
+   const size_t              end_;
+
+   /// index in data_ where the elements, or bitmap, for the set begin
+   size_t                    begin_;
+
+   /// is the set represented as a bitmap
+   bool                      bitmap_;
+
+   /// next element for a bitmap, next data_ index for a sorted vector
+   size_t                    next_;
+
+   /// current element, end_ for no more elements
+   size_t                    value_;
+
+   /// set value_ to the smallest element in a bitmap that is
+   /// greater than or equal next_
+   void bitmap_next(void)
+   {  size_t j = next_;
+      while( j < end_ )
+      {  size_t k    = j / n_bit_;
+         size_t word = data_[begin_ + k] >> (j - k * n_bit_);
+         if( word == 0 )
+            j = (k + 1) * n_bit_;
+         else
+         {  while( (word & 1) == 0 )
+            {  word >>= 1;
+               ++j;
+            }
+            CPPAD_ASSERT_UNKNOWN( j < end_ );
+            value_ = j;
+            next_  = j + 1;
+            return;
+         }
+      }
+      value_ = end_;
+   }
+public:
+   /// construct a const_iterator for a set in a hybrid_setvec object
+   hybrid_setvec_const_iterator (const hybrid_setvec& vec_set, size_t i)
+   :
+   data_( vec_set.data_ )   ,
+   n_bit_( vec_set.n_bit_ ) ,
+   end_ ( vec_set.end_ )
+   {  CPPAD_ASSERT_UNKNOWN( vec_set.post_[i] == 0 );
+      //
+      size_t start = vec_set.start_[i];
+      begin_       = start + 2;
+      bitmap_      = false;
+      next_        = 0;
+      value_       = end_;
+      if( start == 0 )
+         return;
+      //
+      size_t length = data_[start + 1];
+      bitmap_       = vec_set.is_bitmap(length);
+      if( bitmap_ )
+         bitmap_next();
+      else
+      {  next_  = begin_ + 1;
+         value_ = data_[begin_];
+         CPPAD_ASSERT_UNKNOWN( value_ < end_ );
+      }
+   }
+
+   /// advance to next element in this set
+   hybrid_setvec_const_iterator& operator++(void)
+   {  if( value_ == end_ )
+         return *this;
+      if( bitmap_ )
+         bitmap_next();
+      else
+         value_ = data_[next_++];
+      return *this;
+   }
+
+   /// obtain value of this element of the set of positive integers
+   /// (end_ for no such element)
+   size_t operator*(void)
+   {  return value_; }
+};
+// =========================================================================
+/*!
+Print the vector of sets (used for debugging)
+*/
+inline void hybrid_setvec::print(void) const
+{  std::cout << "hybrid_setvec:\n";
+   for(size_t i = 0; i < n_set(); i++)
+   {  std::cout << "set[" << i << "] = {";
+      const_iterator itr(*this, i);
+      while( *itr != end() )
+      {  std::cout << *itr;
+         if( *(++itr) != end() )
+            std::cout << ",";
+      }
+      std::cout << "}\n";
+   }
+   return;
+}
+
+/*!
+Copy a user vector of sets sparsity pattern to an internal hybrid_setvec
+object.
+
+\tparam SetVector
+is a simple vector with elements of type std::set<size_t>.
+
+\param internal
+The input value of sparisty does not matter.
+Upon return it contains the same sparsity pattern as user
+(or the transposed sparsity pattern).
+
+\param user
+sparsity pattern that we are placing internal.
+
+\param n_set
+number of sets (rows) in the internal sparsity pattern.
+
+\param end
+end of set value (number of columns) in the interanl sparsity pattern.
+
+\param transpose
+if true, the user sparsity patter is the transposed.
+
+\param error_msg
+is the error message to display if some values in the user sparstiy
+pattern are not valid.
+*/
+template<class SetVector>
+void sparsity_user2internal(
+   hybrid_setvec&          internal  ,
+   const SetVector&        user      ,
+   size_t                  n_set     ,
+   size_t                  end       ,
+   bool                    transpose ,
+   const char*             error_msg )
+{
+# ifndef NDEBUG
+   if( transpose )
+      CPPAD_ASSERT_KNOWN( end == size_t( user.size() ), error_msg);
+   if( ! transpose )
+      CPPAD_ASSERT_KNOWN( n_set == size_t( user.size() ), error_msg);
+# endif
+
+   // iterator for user set
+   std::set<size_t>::const_iterator itr;
+
+   // size of internal sparsity pattern
+   internal.resize(n_set, end);
+
+   if( transpose )
+   {  // transposed pattern case
+      for(size_t j = 0; j < end; j++)
+      {  itr = user[j].begin();
+         while(itr != user[j].end())
+         {  size_t i = *itr++;
+            CPPAD_ASSERT_KNOWN(i < n_set, error_msg);
+            internal.post_element(i, j);
+         }
+      }
+      for(size_t i = 0; i < n_set; i++)
+         internal.process_post(i);
+   }
+   else
+   {  for(size_t i = 0; i < n_set; i++)
+      {  itr = user[i].begin();
+         while(itr != user[i].end())
+         {  size_t j = *itr++;
+            CPPAD_ASSERT_KNOWN( j < end, error_msg);
+            internal.post_element(i, j);
+         }
+         internal.process_post(i);
+      }
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SPARSE_NAMESPACE
+# endif
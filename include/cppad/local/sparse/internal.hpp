@@ -10,6 +10,7 @@
 # include <cppad/local/sparse/pack_setvec.hpp>
 # include <cppad/local/sparse/list_setvec.hpp>
 # include <cppad/local/sparse/svec_setvec.hpp>
+# include <cppad/local/sparse/hybrid_setvec.hpp>
 
 // BEGIN_CPPAD_LOCAL_SPARSE_NAMESPACE
 namespace CppAD { namespace local { namespace sparse {
@@ -418,15 +418,17 @@ public:
       if( n_pack_ == 1 )
          return count;
       //
-      // count bits in other units
-      for(size_t bit = 0; bit < n_bit_; ++bit)
-      {  CPPAD_ASSERT_UNKNOWN( mask >= one_ );
-         size_t k = n_pack_;
-         while(--k)
-         {  if( data_[i * n_pack_ + k] & mask )
+      // count bits in the other units; i.e., all the units except the last
+      // (each of these units uses all n_bit_ bits)
+      for(size_t k = 0; k + 1 < n_pack_; ++k)
+      {  unit = data_[i * n_pack_ + k];
+         mask = one_;
+         for(size_t bit = 0; bit < n_bit_; ++bit)
+         {  CPPAD_ASSERT_UNKNOWN( mask >= one_ );
+            if( mask & unit )
                ++count;
+            mask = mask << 1;
          }
-         mask = mask << 1;
       }
       return count;
    }
@@ -562,11 +564,9 @@ public:
 {xrst_end pack_setvec_clear}
 */
    {  CPPAD_ASSERT_UNKNOWN( target < n_set_ );
-      size_t t = target * n_pack_;
-
-      size_t j = n_pack_;
-      while(j--)
-         data_[t++] = zero_;
+      Pack* t = data_.data() + target * n_pack_;
+      for(size_t j = 0; j < n_pack_; ++j)
+         t[j] = zero_;
    }
 /*
 -------------------------------------------------------------------------------
@@ -596,12 +596,10 @@ public:
    {  CPPAD_ASSERT_UNKNOWN( this_target  <   n_set_        );
       CPPAD_ASSERT_UNKNOWN( other_value  <   other.n_set_  );
       CPPAD_ASSERT_UNKNOWN( n_pack_      ==  other.n_pack_ );
-      size_t t = this_target * n_pack_;
-      size_t v = other_value * n_pack_;
-
-      size_t j = n_pack_;
-      while(j--)
-         data_[t++] = other.data_[v++];
+      Pack*       t = data_.data() + this_target * n_pack_;
+      const Pack* v = other.data_.data() + other_value * n_pack_;
+      for(size_t j = 0; j < n_pack_; ++j)
+         t[j] = v[j];
    }
 /*
 -------------------------------------------------------------------------------
@@ -634,13 +632,12 @@ public:
       CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
       CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
 
-      size_t t  = this_target * n_pack_;
-      size_t l  = this_left  * n_pack_;
-      size_t r  = other_right * n_pack_;
-
-      size_t j = n_pack_;
-      while(j--)
-         data_[t++] = ( data_[l++] | other.data_[r++] );
+      // indexed loop over the packs so that the compiler can vectorize it
+      Pack*       t = data_.data() + this_target * n_pack_;
+      const Pack* l = data_.data() + this_left   * n_pack_;
+      const Pack* r = other.data_.data() + other_right * n_pack_;
+      for(size_t j = 0; j < n_pack_; ++j)
+         t[j] = ( l[j] | r[j] );
    }
 /*
 -------------------------------------------------------------------------------
@@ -673,13 +670,71 @@ public:
       CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
       CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
 
-      size_t t  = this_target * n_pack_;
-      size_t l  = this_left  * n_pack_;
-      size_t r  = other_right * n_pack_;
+      Pack*       t = data_.data() + this_target * n_pack_;
+      const Pack* l = data_.data() + this_left   * n_pack_;
+      const Pack* r = other.data_.data() + other_right * n_pack_;
+      for(size_t j = 0; j < n_pack_; ++j)
+         t[j] = ( l[j] & r[j] );
+   }
+/*
+-------------------------------------------------------------------------------
+{xrst_begin pack_setvec_assign_pack_block dev}
+
+class pack_setvec: Assign a Block of Packs For Every Set
+########################################################
+
+Syntax
+******
+| *vec* . ``assign_pack_block`` ( *this_begin* , *other* , *other_begin* , *n_copy* )
 
-      size_t j = n_pack_;
-      while(j--)
-         data_[t++] = ( data_[l++] & other.data_[r++] );
+Prototype
+*********
+{xrst_spell_off}
+{xrst_code hpp} */
+public:
+   void assign_pack_block(
+      size_t                  this_begin   ,
+      const pack_setvec&      other        ,
+      size_t                  other_begin  ,
+      size_t                  n_copy       )
+/* {xrst_code}
+{xrst_spell_on}
+
+Purpose
+*******
+For each set index *i* , and for *j* less than *n_copy* ,
+the ( *this_begin* + *j* )-th *Pack* value for set *i* in *vec*
+is assigned the ( *other_begin* + *j* )-th *Pack* value for set *i*
+in *other* .
+Each *Pack* value contains ``std::numeric_limits<size_t>::digits``
+elements of a set.
+This is used to split the possible elements of a vector of sets into blocks
+that are processed independently and then combined.
+
+other
+*****
+The number of sets in *other* must be the same as in *vec* .
+
+n_copy
+******
+The values *this_begin* + *n_copy* and *other_begin* + *n_copy*
+must not be greater than the number of *Pack* values used to represent
+one set in *vec* and *other* respectively.
+If a block does not end at the last *Pack* value,
+it should contain a multiple of ``std::numeric_limits<size_t>::digits``
+elements.
+
+{xrst_end pack_setvec_assign_pack_block}
+*/
+   {  CPPAD_ASSERT_UNKNOWN( n_set_ == other.n_set_ );
+      CPPAD_ASSERT_UNKNOWN( this_begin  + n_copy <= n_pack_ );
+      CPPAD_ASSERT_UNKNOWN( other_begin + n_copy <= other.n_pack_ );
+      for(size_t i = 0; i < n_set_; ++i)
+      {  Pack*       t = data_.data() + i * n_pack_ + this_begin;
+         const Pack* v = other.data_.data() + i * other.n_pack_ + other_begin;
+         for(size_t j = 0; j < n_copy; ++j)
+            t[j] = v[j];
+      }
    }
 // ==========================================================================
 }; // END_CLASS_PACK_SETVEC
@@ -58,6 +58,16 @@ private:
    /// the previous init_rev
    pod_vector<bool> process_range_;
 
+   /// has set_rev_all been called since the constructor or resize
+   bool rev_all_set_;
+
+   /// operators in the subgraph for all the dependent variables
+   /// (size zero if the entire operation sequence is used)
+   pod_vector<addr_t> rev_all_op_;
+
+   /// result variables for the operators in rev_all_op_
+   pod_vector<addr_t> rev_all_var_;
+
 public:
    // -----------------------------------------------------------------------
    // const public functions
@@ -89,6 +99,15 @@ public:
    /// dependent variables that have been processed since previous init_rev
    const pod_vector<bool>& process_range(void) const
    {  return process_range_; }
+   /// has set_rev_all been called since the constructor or resize
+   bool rev_all_set(void) const
+   {  return rev_all_set_; }
+   /// operators in the subgraph for all the dependent variables
+   const pod_vector<addr_t>& rev_all_op(void) const
+   {  return rev_all_op_; }
+   /// result variables for the operators in rev_all_op
+   const pod_vector<addr_t>& rev_all_var(void) const
+   {  return rev_all_var_; }
 
    /// amount of memory corresonding to this object
    size_t memory(void) const
@@ -96,6 +115,8 @@ public:
       sum       += in_subgraph_.size()   * sizeof(addr_t);
       sum       += select_domain_.size() * sizeof(bool);
       sum       += process_range_.size() * sizeof(bool);
+      sum       += rev_all_op_.size()    * sizeof(addr_t);
+      sum       += rev_all_var_.size()   * sizeof(addr_t);
       return sum;
    }
 
@@ -105,6 +126,9 @@ public:
       in_subgraph_.clear();
       select_domain_.clear();
       process_range_.clear();
+      rev_all_set_ = false;
+      rev_all_op_.clear();
+      rev_all_var_.clear();
    }
    // -----------------------------------------------------------------------
    /*!
@@ -153,7 +177,7 @@ public:
 
    /// default constructor (all sizes are zero)
    subgraph_info(void)
-   : n_ind_(0), n_dep_(0), n_op_(0), n_var_(0)
+   : n_ind_(0), n_dep_(0), n_op_(0), n_var_(0), rev_all_set_(false)
    {  CPPAD_ASSERT_UNKNOWN( map_user_op_.size()   == 0 );
       CPPAD_ASSERT_UNKNOWN( in_subgraph_.size()   == 0 );
    }
@@ -168,6 +192,9 @@ public:
       in_subgraph_      = info.in_subgraph_;
       select_domain_    = info.select_domain_;
       process_range_    = info.process_range_;
+      rev_all_set_      = info.rev_all_set_;
+      rev_all_op_       = info.rev_all_op_;
+      rev_all_var_      = info.rev_all_var_;
       return;
    }
    // -----------------------------------------------------------------------
@@ -179,12 +206,15 @@ public:
       std::swap(n_dep_ , info.n_dep_);
       std::swap(n_op_  , info.n_op_);
       std::swap(n_var_ , info.n_var_);
+      std::swap(rev_all_set_ , info.rev_all_set_);
       //
       // pod_vectors
       map_user_op_.swap(   info.map_user_op_);
       in_subgraph_.swap(   info.in_subgraph_);
       select_domain_.swap( info.select_domain_);
       process_range_.swap( info.process_range_);
+      rev_all_op_.swap(    info.rev_all_op_);
+      rev_all_var_.swap(   info.rev_all_var_);
       //
       return;
    }
@@ -209,6 +239,8 @@ public:
 
    \par in_subgraph_
    is resized to zero.
+   \par rev_all_op_, rev_all_var_
+   are resized to zero and rev_all_set_ is set to false.
    */
    void resize(size_t n_ind, size_t n_dep, size_t n_op, size_t n_var)
    {  CPPAD_ASSERT_UNKNOWN(
@@ -230,6 +262,11 @@ public:
       // in_subgraph_
       in_subgraph_.resize(0);
       //
+      // rev_all_set_, rev_all_op_, rev_all_var_
+      rev_all_set_ = false;
+      rev_all_op_.resize(0);
+      rev_all_var_.resize(0);
+      //
       return;
    }
    // -----------------------------------------------------------------------
@@ -308,6 +345,13 @@ public:
       const BoolVector&    select_domain
    );
    // -----------------------------------------------------------------------
+   // see rev_all.hpp
+   template <class Base>
+   void set_rev_all(
+      const player<Base>*         play        ,
+      const pod_vector<size_t>&   dep_taddr
+   );
+   // -----------------------------------------------------------------------
    // see get_rev.hpp
    template <class Addr>
    void get_rev(
@@ -323,5 +367,6 @@ public:
 // routines that operate on in_subgraph
 # include <cppad/local/subgraph/init_rev.hpp>
 # include <cppad/local/subgraph/get_rev.hpp>
+# include <cppad/local/subgraph/rev_all.hpp>
 
 # endif
@@ -0,0 +1,190 @@
+# ifndef CPPAD_LOCAL_SUBGRAPH_REV_ALL_HPP
+# define CPPAD_LOCAL_SUBGRAPH_REV_ALL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/subgraph/info.hpp>
+
+// BEGIN_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
+namespace CppAD { namespace local { namespace subgraph {
+/*!
+\file rev_all.hpp
+Subgraph used by reverse mode for all the dependent variables.
+*/
+
+/*!
+Set the subgraph corresponding to all the dependent variables.
+
+\tparam Base
+this recording was made using ADFun<Base>
+
+\param play
+is a player for this ADFun<Base> object.
+
+\param dep_taddr
+is the vector mapping user dependent variable indices
+to the correpsonding variable in the recording.
+
+\par rev_all_set_
+is set to true.
+
+\par rev_all_op_
+If the recording has VecAD operations, or more than half of the
+operators are in the subgraph, this vector has size zero
+and reverse mode uses the entire operation sequence.
+Otherwise, it contains the operator indices, in increasing order,
+for the BeginOp, the operators that the dependent variables depend on,
+and the EndOp. If any result of an atomic function call is in the subgraph,
+all the operators for the call are in the subgraph.
+A reverse mode sweep over this subgraph only writes the partials for the
+results of these operators.
+
+\par rev_all_var_
+If rev_all_op_ has size zero, so does this vector.
+Otherwise, it contains the result variables for the operators in
+rev_all_op_ (not including the BeginOp).
+These are the partials that may be non-zero after a reverse mode sweep
+over the subgraph; i.e., the partials that need to be zeroed before
+the next sweep.
+*/
+template <class Base>
+void subgraph_info::set_rev_all(
+   const player<Base>*         play        ,
+   const pod_vector<size_t>&   dep_taddr   )
+{  CPPAD_ASSERT_UNKNOWN( n_op_  == play->num_op_rec() );
+   CPPAD_ASSERT_UNKNOWN( n_var_ == play->num_var_rec() );
+   CPPAD_ASSERT_UNKNOWN( n_dep_ == dep_taddr.size() );
+   //
+   // rev_all_set_, rev_all_op_, rev_all_var_
+   rev_all_set_ = true;
+   rev_all_op_.resize(0);
+   rev_all_var_.resize(0);
+   //
+   // A load operation depends on the previous store operations,
+   // which are not arguments to the load operation.
+   if( n_op_ == 0 || play->num_var_vecad_rec() > 0 )
+      return;
+   //
+   // in_rev
+   // is the corresponding variable connected to a dependent variable
+   pod_vector<bool> in_rev(n_var_);
+   for(size_t i_var = 0; i_var < n_var_; ++i_var)
+      in_rev[i_var] = false;
+   for(size_t i = 0; i < n_dep_; ++i)
+      in_rev[ dep_taddr[i] ] = true;
+   //
+   // call_var
+   // variables for the results of the current atomic function call
+   pod_vector<size_t> call_var;
+   //
+   // is_variable
+   // which arguments for the current operator are variables
+   pod_vector<bool> is_variable;
+   //
+   // call_end, call_in
+   // second AFunOp for the current atomic function call (zero if not in a
+   // call) and is a result for the current call connected to a dependent
+   size_t call_end = 0;
+   bool   call_in  = false;
+   //
+   // rev_all_op_
+   // the operators in decreasing order
+   play::const_sequential_iterator itr = play->end();
+   OpCode        op;
+   const addr_t* arg;
+   size_t        i_var;
+   itr.op_info(op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == EndOp );
+   rev_all_op_.push_back( addr_t( itr.op_index() ) );
+   while( op != BeginOp )
+   {  (--itr).op_info(op, arg, i_var);
+      size_t i_op = itr.op_index();
+      switch( op )
+      {  case BeginOp:
+         rev_all_op_.push_back( addr_t( i_op ) );
+         break;
+
+         case CSkipOp:
+         case CSumOp:
+         itr.correct_after_decrement(arg);
+         if( op == CSumOp && in_rev[i_var] )
+         {  rev_all_op_.push_back( addr_t( i_op ) );
+            rev_all_var_.push_back( addr_t( i_var ) );
+            arg_is_variable(op, arg, is_variable);
+            for(size_t j = 0; j < is_variable.size(); ++j)
+               if( is_variable[j] )
+                  in_rev[ arg[j] ] = true;
+         }
+         break;
+
+         case AFunOp:
+         if( call_end == 0 )
+         {  // second AFunOp for this call
+            call_end = i_op;
+            call_in  = false;
+            call_var.resize(0);
+         }
+         else
+         {  // first AFunOp for this call
+            if( call_in )
+            {  for(size_t j_op = call_end + 1; j_op > i_op; --j_op)
+                  rev_all_op_.push_back( addr_t(j_op - 1) );
+               for(size_t j = 0; j < call_var.size(); ++j)
+                  rev_all_var_.push_back( addr_t( call_var[j] ) );
+            }
+            call_end = 0;
+         }
+         break;
+
+         case FunrvOp:
+         call_var.push_back(i_var);
+         call_in |= in_rev[i_var];
+         break;
+
+         case FunavOp:
+         if( call_in )
+            in_rev[ arg[0] ] = true;
+         break;
+
+         case FunapOp:
+         case FunrpOp:
+         break;
+
+         default:
+         if( NumRes(op) > 0 && in_rev[i_var] )
+         {  rev_all_op_.push_back( addr_t( i_op ) );
+            for(size_t j = 0; j < NumRes(op); ++j)
+               rev_all_var_.push_back( addr_t( i_var - j ) );
+            arg_is_variable(op, arg, is_variable);
+            for(size_t j = 0; j < is_variable.size(); ++j)
+               if( is_variable[j] )
+                  in_rev[ arg[j] ] = true;
+         }
+         break;
+      }
+   }
+   CPPAD_ASSERT_UNKNOWN( call_end == 0 );
+   //
+   // use the entire operation sequence when it is not much larger
+   if( 2 * rev_all_op_.size() > n_op_ )
+   {  rev_all_op_.clear();
+      rev_all_var_.clear();
+      return;
+   }
+   //
+   // rev_all_op_
+   // the operators in increasing order
+   size_t n_sub = rev_all_op_.size();
+   for(size_t k = 0; k < n_sub / 2; ++k)
+      std::swap( rev_all_op_[k], rev_all_op_[n_sub - k - 1] );
+   CPPAD_ASSERT_UNKNOWN( rev_all_op_[0] == 0 );
+   CPPAD_ASSERT_UNKNOWN( size_t( rev_all_op_[n_sub - 1] ) == n_op_ - 1 );
+   //
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
+
+# endif
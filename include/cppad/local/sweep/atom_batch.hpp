@@ -0,0 +1,615 @@
+# ifndef CPPAD_LOCAL_SWEEP_ATOM_BATCH_HPP
+# define CPPAD_LOCAL_SWEEP_ATOM_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <map>
+# include <type_traits>
+# include <cppad/local/play/atom_batch.hpp>
+# include <cppad/local/sweep/call_atomic.hpp>
+
+// BEGIN_CPAPD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/atom_batch.hpp
+Evaluate groups of atomic function calls using one batched call.
+*/
+/*
+------------------------------------------------------------------------------
+{xrst_begin sweep_atom_batch dev}
+
+Groups of Atomic Function Calls Evaluated Together
+##################################################
+
+Syntax
+******
+| ``setup_atom_batch`` ( *play* , *not_used_rec_base* )
+| ``atom_batch_forward0`` ( *play* , *group* , *cache* , *J* , *taylor* )
+| ``atom_batch_reverse`` (
+| |tab| *play* , *group* , *cache* , *d* , *J* , *Taylor* , *K* , *Partial*
+| )
+
+Purpose
+*******
+The same :ref:`atomic_four-name` function is often called at many places
+in a recording.
+A group is a set of such calls that can be evaluated together using the
+:ref:`atomic_four_batch-name` callbacks.
+
+Groups
+******
+The calls in a group are for the same atomic_four function
+and have the same number of arguments and results.
+The group is evaluated at its anchor call
+(and the other calls in the group are skipped).
+A group is one of the following two cases:
+
+#. All the variable arguments, for all the calls in the group,
+   are computed before the first call in the group.
+   In this case the anchor is the first call in the group.
+#. None of the variable results, for all the calls in the group,
+   are used before the end of the last call in the group.
+   In this case the anchor is the last call in the group.
+
+In both cases, none of the arguments for a call in the group depend on
+the results for another call in the group.
+In the first case, for zero order forward mode, all the arguments are
+available at the anchor.
+For reverse mode, the partials for all the results are complete when the
+anchor is reached and the arguments have not yet been processed.
+In the second case, for zero order forward mode, the results are not used
+until after the anchor.
+For reverse mode, the partials for all the results are complete at the
+anchor and the arguments are processed after the anchor.
+
+setup_atom_batch
+****************
+The groups are determined by this routine and stored in
+*play* ``->atom_batch`` () .
+No work is done if this information has already been built for the
+recording in *play* .
+No groups are used (and no memory is kept) if one of the following holds:
+*Base* is not the same as *RecBase* ,
+the recording contains a conditional skip operator,
+or there are no groups with more than one call.
+
+atom_batch_forward0
+*******************
+Evaluates zero order forward mode for all the calls in a group
+and stores the results in *taylor* .
+
+atom_batch_reverse
+******************
+Evaluates reverse mode, for orders zero through *d* ,
+for all the calls in a group and adds the partials with respect to the
+arguments to *Partial* .
+
+group
+*****
+is the index of the group in *play* ``->atom_batch`` () .
+
+cache
+*****
+is the :ref:`atomic_ptr_cache-name` for the sweep.
+
+J, taylor, Taylor, K, Partial
+*****************************
+These have the same meaning as in the corresponding sweep;
+see :ref:`sweep_forward0-name` and :ref:`sweep_reverse-name` .
+
+{xrst_end sweep_atom_batch}
+------------------------------------------------------------------------------
+*/
+
+// atomic_four_forward_batch: Base is the same as RecBase
+template <class RecBase>
+bool atomic_four_forward_batch(
+   atomic_four<RecBase>*        afun        ,
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_y    ,
+   const vector<RecBase>&       taylor_x    ,
+   vector<RecBase>&             taylor_y    )
+{  size_t order_low = 0;
+   size_t order_up  = 0;
+   return afun->forward_batch(
+      call_id, select_y, order_low, order_up, taylor_x, taylor_y
+   );
+}
+// atomic_four_forward_batch: Base is not the same as RecBase
+template <class RecBase, class Base>
+bool atomic_four_forward_batch(
+   atomic_four<RecBase>*        afun        ,
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_y    ,
+   const vector<Base>&          taylor_x    ,
+   vector<Base>&                taylor_y    )
+{  return false; }
+//
+// atomic_four_reverse_batch: Base is the same as RecBase
+template <class RecBase>
+bool atomic_four_reverse_batch(
+   atomic_four<RecBase>*        afun        ,
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_x    ,
+   size_t                       order_up    ,
+   const vector<RecBase>&       taylor_x    ,
+   const vector<RecBase>&       taylor_y    ,
+   vector<RecBase>&             partial_x   ,
+   const vector<RecBase>&       partial_y   )
+{  return afun->reverse_batch(
+      call_id, select_x, order_up, taylor_x, taylor_y, partial_x, partial_y
+   );
+}
+// atomic_four_reverse_batch: Base is not the same as RecBase
+template <class RecBase, class Base>
+bool atomic_four_reverse_batch(
+   atomic_four<RecBase>*        afun        ,
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_x    ,
+   size_t                       order_up    ,
+   const vector<Base>&          taylor_x    ,
+   const vector<Base>&          taylor_y    ,
+   vector<Base>&                partial_x   ,
+   const vector<Base>&          partial_y   )
+{  return false; }
+// ---------------------------------------------------------------------------
+// setup_atom_batch
+template <class Base, class RecBase>
+void setup_atom_batch(player<Base>* play, const RecBase& not_used_rec_base)
+{  // (groups are not used when the recording is stored in compact form)
+   const player<Base>* const_play = play;
+   if( const_play->atom_batch().built() || const_play->compact_tape() )
+      return;
+   play::atom_batch& batch( play->atom_batch() );
+   //
+   // batched callbacks are only used when Base is the same as RecBase
+   bool usable = std::is_same<Base, RecBase>::value;
+   //
+   // num_op, num_var
+   size_t num_op  = play->num_op_rec();
+   size_t num_var = play->num_var_rec();
+   //
+   // first_use
+   // index of the first operator that uses each variable as an argument
+   // (only set for operators after the first atomic function call)
+   pod_vector<size_t> first_use;
+   //
+   // call_begin, call_end
+   // number of variables before each call and operator index for the
+   // AFunOp at the end of each call
+   pod_vector<size_t> call_begin, call_end;
+   //
+   // itr, op, arg, i_var
+   play::const_sequential_iterator itr = play->begin();
+   OpCode        op;
+   const addr_t* arg;
+   size_t        i_var;
+   itr.op_info(op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+   //
+   // n_var: number of variables before the current operator
+   size_t n_var = NumRes(BeginOp);
+   //
+   pod_vector<bool> is_variable;
+   bool in_call = false;
+   while( usable && op != EndOp )
+   {  (++itr).op_info(op, arg, i_var);
+      size_t i_op = itr.op_index();
+      switch( op )
+      {  case CSkipOp:
+         usable = false;
+         break;
+
+         case AFunOp:
+         if( ! in_call )
+         {  size_t atom_index = size_t( arg[0] );
+            size_t call_id    = size_t( arg[1] );
+            size_t atom_n     = size_t( arg[2] );
+            size_t atom_m     = size_t( arg[3] );
+            batch.push_call(atom_index, call_id, atom_n, atom_m);
+            call_begin.push_back(n_var);
+            if( first_use.size() == 0 )
+            {  first_use.resize(num_var);
+               for(size_t i = 0; i < num_var; ++i)
+                  first_use[i] = num_op;
+            }
+         }
+         else
+            call_end.push_back(i_op);
+         in_call = ! in_call;
+         break;
+
+         case FunapOp:
+         batch.push_x( size_t(arg[0]), false);
+         break;
+
+         case FunavOp:
+         batch.push_x( size_t(arg[0]), true);
+         break;
+
+         case FunrpOp:
+         batch.push_y( size_t(arg[0]), false);
+         break;
+
+         case FunrvOp:
+         batch.push_y( i_var, true);
+         break;
+
+         default:
+         break;
+      }
+      if( usable && first_use.size() > 0 )
+      {  arg_is_variable(op, arg, is_variable);
+         for(size_t j = 0; j < is_variable.size(); ++j) if( is_variable[j] )
+         {  size_t v = size_t( arg[j] );
+            if( first_use[v] == num_op )
+               first_use[v] = i_op;
+         }
+      }
+      n_var += NumRes(op);
+      if( op == CSumOp )
+         itr.correct_before_increment();
+   }
+   size_t num_call = batch.num_call();
+   if( ! usable || num_call < 2 )
+   {  batch.finish(false);
+      return;
+   }
+   CPPAD_ASSERT_UNKNOWN( call_end.size() == num_call );
+   //
+   // open_group
+   // information for the group that is being built for an atomic function
+   enum { undetermined_mode, first_mode, last_mode };
+   struct open_group {
+      size_t first;    // call index for first member
+      size_t last;     // call index for last member
+      size_t size;     // number of members
+      size_t mode;     // anchor at first member, last member, or undetermined
+      size_t min_use;  // first operator that uses a result of a member
+   };
+   std::map<size_t, open_group> open;
+   //
+   // next
+   // next member of the group for each call
+   pod_vector<size_t> next(num_call);
+   //
+   // close_group
+   pod_vector<size_t> member;
+   atomic_ptr_cache<RecBase> cache;
+   //
+   for(size_t i_call = 0; i_call < num_call; ++i_call)
+   {  const play::atom_batch_call& info( batch.call(i_call) );
+      next[i_call] = num_call;
+      //
+      // only atomic_four functions are grouped
+      size_t type  = 0;
+      void*  v_ptr = nullptr;
+      cache.get(info.atom_index, type, v_ptr);
+      if( type != 4 )
+         continue;
+      //
+      // max_x: maximum variable index for the arguments
+      size_t max_x = 0;
+      for(size_t j = 0; j < info.n; ++j)
+      {  if( batch.x_is_var(info.x_start + j) )
+            max_x = std::max(max_x, batch.x_index(info.x_start + j) );
+      }
+      //
+      // min_use: first operator that uses a result of this call
+      size_t min_use = num_op;
+      for(size_t i = 0; i < info.m; ++i)
+      {  if( batch.y_is_var(info.y_start + i) )
+         {  size_t v = batch.y_index(info.y_start + i);
+            min_use  = std::min(min_use, first_use[v] );
+         }
+      }
+      //
+      // join
+      typename std::map<size_t, open_group>::iterator itr_open =
+         open.find(info.atom_index);
+      bool   found = itr_open != open.end();
+      bool   join  = false;
+      size_t mode  = undetermined_mode;
+      if( found )
+      {  open_group& group( itr_open->second );
+         const play::atom_batch_call& first( batch.call(group.first) );
+         if( first.n == info.n && first.m == info.m )
+         {  bool at_first = max_x < call_begin[group.first];
+            bool at_last  = call_end[i_call] < group.min_use;
+            if( group.mode != last_mode && at_first )
+            {  join = true;
+               mode = first_mode;
+            }
+            else if( group.mode != first_mode && at_last )
+            {  join = true;
+               mode = last_mode;
+            }
+         }
+      }
+      if( join )
+      {  open_group& group( itr_open->second );
+         next[group.last] = i_call;
+         group.last       = i_call;
+         group.size      += 1;
+         group.mode       = mode;
+         group.min_use    = std::min(group.min_use, min_use);
+      }
+      else
+      {  if( found && itr_open->second.size > 1 )
+         {  // close the previous group for this atomic function
+            const open_group& group( itr_open->second );
+            member.resize(0);
+            for(size_t k = group.first; k < num_call; k = next[k])
+               member.push_back(k);
+            size_t anchor = group.first;
+            if( group.mode == last_mode )
+               anchor = group.last;
+            batch.push_group(member, anchor);
+         }
+         open_group group;
+         group.first   = i_call;
+         group.last    = i_call;
+         group.size    = 1;
+         group.mode    = undetermined_mode;
+         group.min_use = min_use;
+         open[info.atom_index] = group;
+      }
+   }
+   // close the groups that are still open
+   typename std::map<size_t, open_group>::iterator itr_open;
+   for(itr_open = open.begin(); itr_open != open.end(); ++itr_open)
+   {  const open_group& group( itr_open->second );
+      if( group.size > 1 )
+      {  member.resize(0);
+         for(size_t k = group.first; k < num_call; k = next[k])
+            member.push_back(k);
+         size_t anchor = group.first;
+         if( group.mode == last_mode )
+            anchor = group.last;
+         batch.push_group(member, anchor);
+      }
+   }
+   batch.finish(true);
+}
+// ---------------------------------------------------------------------------
+// atom_batch_forward0
+template <class Base, class RecBase>
+void atom_batch_forward0(
+   const player<Base>*          play        ,
+   size_t                       group       ,
+   atomic_ptr_cache<RecBase>&   cache       ,
+   size_t                       J           ,
+   Base*                        taylor      )
+{  const play::atom_batch& batch( play->atom_batch() );
+   const Base*             parameter( play->GetPar() );
+   //
+   // n_call, atom_index, n, m
+   size_t n_call = batch.group_size(group);
+   const play::atom_batch_call& info0( batch.call( batch.member(group, 0) ) );
+   size_t atom_index = info0.atom_index;
+   size_t n          = info0.n;
+   size_t m          = info0.m;
+   //
+   // call_id, select_y, taylor_x
+   vector<size_t> call_id(n_call);
+   vector<bool>   select_y(n_call * m);
+   vector<Base>   taylor_x(n_call * n), taylor_y(n_call * m);
+   for(size_t k = 0; k < n_call; ++k)
+   {  const play::atom_batch_call& info( batch.call( batch.member(group, k) ) );
+      CPPAD_ASSERT_UNKNOWN( info.atom_index == atom_index );
+      CPPAD_ASSERT_UNKNOWN( info.n == n && info.m == m );
+      call_id[k] = info.call_id;
+      for(size_t j = 0; j < n; ++j)
+      {  size_t index = batch.x_index(info.x_start + j);
+         if( batch.x_is_var(info.x_start + j) )
+            taylor_x[k * n + j] = taylor[ index * J + 0 ];
+         else
+            taylor_x[k * n + j] = parameter[index];
+      }
+      for(size_t i = 0; i < m; ++i)
+         select_y[k * m + i] = batch.y_is_var(info.y_start + i);
+   }
+   //
+   // try the batched callback
+   size_t type  = 0;
+   void*  v_ptr = nullptr;
+   cache.get(atom_index, type, v_ptr);
+   bool ok = false;
+   if( v_ptr != nullptr && type == 4 )
+   {  atomic_four<RecBase>* afun =
+         reinterpret_cast< atomic_four<RecBase>* >(v_ptr);
+      ok = atomic_four_forward_batch(
+         afun, call_id, select_y, taylor_x, taylor_y
+      );
+   }
+   if( ! ok )
+   {  // use the forward_ptr or forward callback for each call in the group
+      const pod_vector<bool>& dyn_par_is( play->dyn_par_is() );
+      const size_t   need_y    = size_t( variable_enum );
+      const size_t   order_low = 0;
+      const size_t   order_up  = 0;
+      vector<Base>         par_x(n), tx(n), ty(m);
+      vector<ad_type_enum> type_x(n);
+      vector<bool>         sy(m);
+      for(size_t k = 0; k < n_call; ++k)
+      {  const play::atom_batch_call& info(
+            batch.call( batch.member(group, k) )
+         );
+         for(size_t j = 0; j < n; ++j)
+         {  size_t index = batch.x_index(info.x_start + j);
+            tx[j]        = taylor_x[k * n + j];
+            if( batch.x_is_var(info.x_start + j) )
+            {  type_x[j] = variable_enum;
+               par_x[j]  = CppAD::numeric_limits<Base>::quiet_NaN();
+            }
+            else
+            {  if( dyn_par_is[index] )
+                  type_x[j] = dynamic_enum;
+               else
+                  type_x[j] = constant_enum;
+               par_x[j] = parameter[index];
+            }
+         }
+         for(size_t i = 0; i < m; ++i)
+            sy[i] = select_y[k * m + i];
+         bool ok_ptr = call_atomic_forward_ptr<Base, RecBase>(
+            cache, atom_index, info.call_id, sy, n, m,
+            taylor_x.data() + k * n, taylor_y.data() + k * m
+         );
+         if( ! ok_ptr )
+         {  call_atomic_forward<Base, RecBase>(
+               par_x, type_x, need_y, sy,
+               order_low, order_up, atom_index, info.call_id, tx, ty, &cache
+            );
+            for(size_t i = 0; i < m; ++i)
+               taylor_y[k * m + i] = ty[i];
+         }
+      }
+   }
+   // store the results
+   for(size_t k = 0; k < n_call; ++k)
+   {  const play::atom_batch_call& info( batch.call( batch.member(group, k) ) );
+      for(size_t i = 0; i < m; ++i)
+      {  if( select_y[k * m + i] )
+         {  size_t index = batch.y_index(info.y_start + i);
+            taylor[ index * J + 0 ] = taylor_y[k * m + i];
+         }
+      }
+   }
+}
+// ---------------------------------------------------------------------------
+// atom_batch_reverse
+template <class Base, class RecBase>
+void atom_batch_reverse(
+   const player<Base>*          play        ,
+   size_t                       group       ,
+   atomic_ptr_cache<RecBase>&   cache       ,
+   size_t                       d           ,
+   size_t                       J           ,
+   const Base*                  Taylor      ,
+   size_t                       K           ,
+   Base*                        Partial     )
+{  const play::atom_batch& batch( play->atom_batch() );
+   const Base*             parameter( play->GetPar() );
+   //
+   // q: number of orders for this calculation
+   size_t q = d + 1;
+   //
+   // n_call, atom_index, n, m
+   size_t n_call = batch.group_size(group);
+   const play::atom_batch_call& info0( batch.call( batch.member(group, 0) ) );
+   size_t atom_index = info0.atom_index;
+   size_t n          = info0.n;
+   size_t m          = info0.m;
+   //
+   // call_id, select_x, taylor_x, taylor_y, partial_y
+   vector<size_t> call_id(n_call);
+   vector<bool>   select_x(n_call * n);
+   vector<Base>   taylor_x(n_call * n * q), partial_x(n_call * n * q);
+   vector<Base>   taylor_y(n_call * m * q), partial_y(n_call * m * q);
+   for(size_t k = 0; k < n_call; ++k)
+   {  const play::atom_batch_call& info( batch.call( batch.member(group, k) ) );
+      CPPAD_ASSERT_UNKNOWN( info.atom_index == atom_index );
+      CPPAD_ASSERT_UNKNOWN( info.n == n && info.m == m );
+      call_id[k] = info.call_id;
+      for(size_t j = 0; j < n; ++j)
+      {  size_t index  = batch.x_index(info.x_start + j);
+         bool   is_var = batch.x_is_var(info.x_start + j);
+         size_t kj     = (k * n + j) * q;
+         select_x[k * n + j] = is_var;
+         for(size_t ell = 0; ell < q; ++ell)
+         {  if( is_var )
+               taylor_x[kj + ell] = Taylor[ index * J + ell ];
+            else if( ell == 0 )
+               taylor_x[kj + ell] = parameter[index];
+            else
+               taylor_x[kj + ell] = Base(0.);
+         }
+      }
+      for(size_t i = 0; i < m; ++i)
+      {  size_t index  = batch.y_index(info.y_start + i);
+         bool   is_var = batch.y_is_var(info.y_start + i);
+         size_t ki     = (k * m + i) * q;
+         for(size_t ell = 0; ell < q; ++ell)
+         {  if( is_var )
+            {  taylor_y[ki + ell]  = Taylor[ index * J + ell ];
+               partial_y[ki + ell] = Partial[ index * K + ell ];
+            }
+            else
+            {  taylor_y[ki + ell]  = Base(0.);
+               partial_y[ki + ell] = Base(0.);
+               if( ell == 0 )
+                  taylor_y[ki + ell] = parameter[index];
+            }
+         }
+      }
+   }
+   //
+   // try the batched callback
+   size_t type  = 0;
+   void*  v_ptr = nullptr;
+   cache.get(atom_index, type, v_ptr);
+   bool ok = false;
+   if( v_ptr != nullptr && type == 4 )
+   {  atomic_four<RecBase>* afun =
+         reinterpret_cast< atomic_four<RecBase>* >(v_ptr);
+      ok = atomic_four_reverse_batch(
+         afun, call_id, select_x, d, taylor_x, taylor_y, partial_x, partial_y
+      );
+   }
+   if( ! ok )
+   {  // use the reverse callback for each call in the group
+      const pod_vector<bool>& dyn_par_is( play->dyn_par_is() );
+      vector<Base>         par_x(n), tx(n * q), ty(m * q), px(n * q), py(m * q);
+      vector<ad_type_enum> type_x(n);
+      vector<bool>         sx(n);
+      for(size_t k = 0; k < n_call; ++k)
+      {  const play::atom_batch_call& info(
+            batch.call( batch.member(group, k) )
+         );
+         for(size_t j = 0; j < n; ++j)
+         {  size_t index = batch.x_index(info.x_start + j);
+            sx[j]        = select_x[k * n + j];
+            if( sx[j] )
+            {  type_x[j] = variable_enum;
+               par_x[j]  = CppAD::numeric_limits<Base>::quiet_NaN();
+            }
+            else
+            {  if( dyn_par_is[index] )
+                  type_x[j] = dynamic_enum;
+               else
+                  type_x[j] = constant_enum;
+               par_x[j] = parameter[index];
+            }
+            for(size_t ell = 0; ell < q; ++ell)
+               tx[j * q + ell] = taylor_x[(k * n + j) * q + ell];
+         }
+         for(size_t i = 0; i < m * q; ++i)
+         {  ty[i] = taylor_y[k * m * q + i];
+            py[i] = partial_y[k * m * q + i];
+         }
+         call_atomic_reverse<Base, RecBase>(
+            par_x, type_x, sx, d, atom_index, info.call_id, tx, ty, px, py
+         );
+         for(size_t j = 0; j < n * q; ++j)
+            partial_x[k * n * q + j] = px[j];
+      }
+   }
+   // add the partials with respect to the arguments
+   for(size_t k = 0; k < n_call; ++k)
+   {  const play::atom_batch_call& info( batch.call( batch.member(group, k) ) );
+      for(size_t j = 0; j < n; ++j)
+      {  if( select_x[k * n + j] )
+         {  size_t index = batch.x_index(info.x_start + j);
+            for(size_t ell = 0; ell < q; ++ell)
+               Partial[ index * K + ell ] += partial_x[(k * n + j) * q + ell];
+         }
+      }
+   }
+}
+
+} } } // END_CPAPD_LOCAL_SWEEP_NAMESPACE
+
+# endif
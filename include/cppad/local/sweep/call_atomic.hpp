@@ -13,6 +13,80 @@
 // BEGIN_CPAPD_LOCAL_SWEEP_NAMESPACE
 namespace CppAD { namespace local { namespace sweep {
 
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_ptr_cache dev}
+
+Cache of Atomic Function Object Pointers
+########################################
+
+Syntax
+******
+| ``atomic_ptr_cache`` < *RecBase* > *cache*
+| *cache* . ``get`` ( *atom_index* , *type* , *v_ptr* )
+
+Purpose
+*******
+A sweep can call the same atomic functions many times.
+This cache resolves each *atom_index* using :ref:`atomic_index-name`
+the first time it is used, so later calls do not need to
+look up the object.
+The cache is local to one sweep and atomic functions are not
+deleted during a sweep, hence the cached pointers remain valid.
+
+RecBase
+*******
+Is the base type corresponding to the atomic functions.
+
+atom_index
+**********
+is the index, in local::atomic_index, corresponding to an atomic function.
+
+type
+****
+is set to the type (2, 3, or 4) of the atomic function.
+
+v_ptr
+*****
+is set to the pointer to the atomic function object.
+If it is null, the atomic function has been deleted
+(and the pointer is not cached).
+
+{xrst_end atomic_ptr_cache}
+*/
+template <class RecBase>
+class atomic_ptr_cache {
+private:
+   // type_[atom_index] is zero if atom_index has not yet been resolved
+   vector<size_t> type_;
+   vector<void*>  v_ptr_;
+public:
+   void get(size_t atom_index, size_t& type, void*& v_ptr)
+   {  CPPAD_ASSERT_UNKNOWN( 0 < atom_index );
+      if( atom_index < type_.size() && type_[atom_index] != 0 )
+      {  type  = type_[atom_index];
+         v_ptr = v_ptr_[atom_index];
+         return;
+      }
+      bool         set_null = false;
+      std::string* name_ptr = nullptr;
+      type  = 0;
+      v_ptr = nullptr;
+      local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
+      if( v_ptr == nullptr )
+         return;
+      //
+      if( type_.size() <= atom_index )
+      {  size_t old_size = type_.size();
+         type_.resize(atom_index + 1);
+         v_ptr_.resize(atom_index + 1);
+         for(size_t i = old_size; i <= atom_index; ++i)
+            type_[i] = 0;
+      }
+      type_[atom_index]  = type;
+      v_ptr_[atom_index] = v_ptr;
+   }
+};
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_forward_callback dev}
@@ -80,6 +154,11 @@ taylor_y
 ********
 Taylor coefficient corresponding to y.
 
+cache
+*****
+If *cache* is not null, it is used to look up the atomic function object
+corresponding to *atom_index* ; see :ref:`atomic_ptr_cache-name` .
+
 {xrst_end atomic_forward_callback}
 */
 // BEGIN_FORWARD
@@ -94,14 +173,18 @@ void call_atomic_forward(
    size_t                       atom_index  ,
    size_t                       call_id     ,
    const vector<Base>&          taylor_x    ,
-   vector<Base>&                taylor_y    )
+   vector<Base>&                taylor_y    ,
+   atomic_ptr_cache<RecBase>*   cache = nullptr )
 // END_FORWARD
 {  CPPAD_ASSERT_UNKNOWN( 0 < atom_index );
    bool         set_null = false;
    size_t       type     = 0;          // set to avoid warning
    std::string* name_ptr = nullptr;
    void*        v_ptr    = nullptr; // set to avoid warning
-   local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
+   if( cache != nullptr )
+      cache->get(atom_index, type, v_ptr);
+   else
+      local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
 # ifndef NDEBUG
    bool ok = v_ptr != nullptr;
    if( ok )
@@ -173,6 +256,118 @@ void call_atomic_forward(
 }
 // ----------------------------------------------------------------------------
 /*
+{xrst_begin atomic_forward_ptr_callback dev}
+
+Zero Order Forward Pointer Callback to Atomic Functions
+#######################################################
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_FORWARD_PTR
+   // END_FORWARD_PTR
+}
+
+Base
+****
+Is the base type corresponding to the atomic function call.
+
+RecBase
+*******
+Is the base type corresponding to this atomic function call.
+
+cache
+*****
+is used to look up the atomic function object corresponding to
+*atom_index* ; see :ref:`atomic_ptr_cache-name` .
+
+atom_index
+**********
+is the index, in local::atomic_index, corresponding to this atomic function.
+
+call_id
+*******
+see the atomic_four :ref:`atomic_four_call@call_id` .
+
+select_y
+********
+specifies which components of taylor_y are necessary.
+
+n
+*
+is the number of arguments to this atomic function.
+
+m
+*
+is the number of results for this atomic function.
+
+taylor_x
+********
+zero order Taylor coefficients corresponding to x.
+
+taylor_y
+********
+zero order Taylor coefficients corresponding to y.
+
+ok
+**
+is true if the atomic function is an atomic_four function,
+*Base* is the same as *RecBase* , and its
+:ref:`atomic_four_forward_ptr-name` callback returned true.
+Otherwise, nothing is computed and the caller should use
+:ref:`atomic_forward_callback-name` .
+
+{xrst_end atomic_forward_ptr_callback}
+*/
+// Base is the same as RecBase
+template <class RecBase>
+bool atomic_four_forward_ptr(
+   atomic_four<RecBase>*        afun        ,
+   size_t                       call_id     ,
+   const vector<bool>&          select_y    ,
+   size_t                       n           ,
+   size_t                       m           ,
+   const RecBase*               taylor_x    ,
+   RecBase*                     taylor_y    )
+{  return afun->forward_ptr(call_id, select_y, n, m, taylor_x, taylor_y);
+}
+// Base is not the same as RecBase
+template <class RecBase, class Base>
+bool atomic_four_forward_ptr(
+   atomic_four<RecBase>*        afun        ,
+   size_t                       call_id     ,
+   const vector<bool>&          select_y    ,
+   size_t                       n           ,
+   size_t                       m           ,
+   const Base*                  taylor_x    ,
+   Base*                        taylor_y    )
+{  return false;
+}
+// BEGIN_FORWARD_PTR
+template <class Base, class RecBase>
+bool call_atomic_forward_ptr(
+   atomic_ptr_cache<RecBase>&   cache       ,
+   size_t                       atom_index  ,
+   size_t                       call_id     ,
+   const vector<bool>&          select_y    ,
+   size_t                       n           ,
+   size_t                       m           ,
+   const Base*                  taylor_x    ,
+   Base*                        taylor_y    )
+// END_FORWARD_PTR
+{  size_t type  = 0;       // set to avoid warning
+   void*  v_ptr = nullptr; // set to avoid warning
+   cache.get(atom_index, type, v_ptr);
+   if( v_ptr == nullptr || type != 4 )
+      return false;
+   atomic_four<RecBase>* afun =
+      reinterpret_cast< atomic_four<RecBase>* >(v_ptr);
+   return atomic_four_forward_ptr(
+      afun, call_id, select_y, n, m, taylor_x, taylor_y
+   );
+}
+// ----------------------------------------------------------------------------
+/*
 {xrst_begin atomic_reverse_callback dev}
 
 Reverse Mode callback to Atomic Functions
@@ -7,6 +7,8 @@
 
 # include <cppad/local/play/atom_op_info.hpp>
 # include <cppad/local/sweep/call_atomic.hpp>
+# include <cppad/local/sweep/atom_batch.hpp>
+# include <cppad/local/sweep/forward0_plan.hpp>
 
 // BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
 namespace CppAD { namespace local { namespace sweep {
@@ -160,11 +162,36 @@ not_used_rec_base
 *****************
 Specifies *RecBase* for this call.
 
+Plan
+****
+If *play* ``->forward0_plan`` () has been built and is usable,
+the operators are executed using the :ref:`sweep_forward0_plan-name`
+instead of decoding each operator in the recording.
+
+Compact
+*******
+If *play* ``->compact_tape`` () is true,
+the operators and arguments are decoded from the compact encoding
+using a ``play::const_compact_iterator`` .
+Otherwise they are read using a ``play::const_sequential_iterator`` .
+
 {xrst_end sweep_forward0}
 */
 
-template <class Addr, class Base, class RecBase>
-void forward0(
+/*!
+Zero order forward sweep using a specific type of sequential iterator.
+
+\tparam Iterator
+is either play::const_sequential_iterator or play::const_compact_iterator.
+
+\param itr
+is an iterator for play that is at the BeginOp.
+
+The other arguments are the same as for forward0.
+*/
+template <class Iterator, class Addr, class Base, class RecBase>
+void forward0_itr(
+   Iterator&                  itr,
    const local::player<Base>* play,
    std::ostream&              s_out,
    bool                       print,
@@ -232,6 +259,16 @@ void forward0(
    // information defined by atomic function operators
    size_t atom_index=0, atom_id=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
    enum_atom_state atom_state = start_atom; // proper initialization
+   //
+   // information used by the atomic function pointer interface
+   atomic_ptr_cache<RecBase> atom_cache; // resolved atomic function objects
+   bool   atom_x_view = false; // arguments so far are consecutive variables
+   bool   atom_y_view = false; // results so far are variables
+   size_t atom_x0     = 0;     // variable index for first argument
+   //
+   // groups of atomic function calls that are evaluated together
+   const play::atom_batch& atom_batch( play->atom_batch() );
+   size_t atom_i_call = 0;     // index of the current atomic function call
 
    // length of the parameter vector (used by CppAD assert macros)
    const size_t num_par = play->num_par_rec();
@@ -254,7 +291,6 @@ void forward0(
 # endif
 
    // skip the BeginOp at the beginning of the recording
-   play::const_sequential_iterator itr = play->begin();
    // op_info
    OpCode op;
    size_t i_var;
@@ -264,6 +300,26 @@ void forward0(
    //
 # if CPPAD_FORWARD0_TRACE
    std::cout << std::endl;
+# else
+   // use the pre-decoded plan when one is available for this recording
+   const play::forward0_plan<Base>& plan( play->forward0_plan() );
+   if( plan.usable() )
+   {  play::forward0_state<Base> state;
+      state.arg                     = arg;
+      state.num_par                 = num_par;
+      state.parameter               = parameter;
+      state.J                       = J;
+      state.taylor                  = taylor;
+      state.compare_change_count    = compare_change_count;
+      state.compare_change_number   = 0;
+      state.compare_change_op_index = 0;
+      //
+      forward0_plan_run(plan, state);
+      //
+      compare_change_number   = state.compare_change_number;
+      compare_change_op_index = state.compare_change_op_index;
+      return;
+   }
 # endif
    bool flag; // a temporary flag to use in switch cases
    bool more_operators = true;
@@ -821,12 +877,35 @@ void forward0(
 
          case AFunOp:
          // start or end an atomic function call
-         flag = atom_state == start_atom;
-         play::atom_op_info<RecBase>(
-            op, arg, atom_index, atom_id, atom_m, atom_n
-         );
+         // (atom_op_info is not used because atom_cache resolves the object)
+         CPPAD_ASSERT_NARG_NRES(op, 4, 0);
+         flag       = atom_state == start_atom;
+         atom_index = size_t( arg[0] );
+         atom_id    = size_t( arg[1] );
+         atom_n     = size_t( arg[2] );
+         atom_m     = size_t( arg[3] );
          if( flag )
-         {  atom_state = arg_atom;
+         {
+# if ! CPPAD_FORWARD0_TRACE
+            if( atom_batch.usable() )
+            {  size_t group = atom_batch.call(atom_i_call).group;
+               if( group < atom_batch.num_group() )
+               {  // this call is evaluated with the other calls in its group
+                  if( atom_batch.anchor(group) == atom_i_call )
+                     atom_batch_forward0<Base, RecBase>(
+                        play, group, atom_cache, J, taylor
+                     );
+                  ++atom_i_call;
+                  //
+                  // skip to the second AFunOp for this call
+                  for(size_t i = 0; i < atom_m + atom_n + 1; ++i)
+                     ++itr;
+                  break;
+               }
+               ++atom_i_call;
+            }
+# endif
+            atom_state = arg_atom;
             atom_i     = 0;
             atom_j     = 0;
             //
@@ -836,6 +915,10 @@ void forward0(
             atom_ty.resize(atom_m);
             atom_iy.resize(atom_m);
             atom_sy.resize(atom_m);
+            //
+            // views of taylor are only possible when J == 1
+            atom_x_view = J == 1 && atom_n > 0;
+            atom_y_view = J == 1 && atom_m > 0;
          }
          else
          {  CPPAD_ASSERT_UNKNOWN( atom_i == atom_m );
@@ -845,14 +928,35 @@ void forward0(
             for(size_t i = 0; i < atom_m; ++i)
                atom_sy[i] = atom_iy[i] != 0;
             //
-            // call atomic function for this operation
-            call_atomic_forward<Base, RecBase>(
-               atom_par_x, atom_type_x, need_y, atom_sy,
-               order_low, order_up, atom_index, atom_id, atom_tx, atom_ty
+            // try the pointer interface using views of taylor when possible
+            const Base* ptr_x = atom_tx.data();
+            if( atom_x_view )
+               ptr_x = taylor + atom_x0;
+            Base* ptr_y = atom_ty.data();
+            if( atom_y_view )
+               ptr_y = taylor + atom_iy[0];
+            flag = call_atomic_forward_ptr<Base, RecBase>(
+               atom_cache, atom_index, atom_id, atom_sy,
+               atom_n, atom_m, ptr_x, ptr_y
             );
-            for(size_t i = 0; i < atom_m; ++i)
-               if( atom_iy[i] > 0 )
-                  taylor[ atom_iy[i] * J + 0 ] = atom_ty[i];
+            if( ! flag )
+            {  // the arguments in the view have not been copied to atom_tx
+               if( atom_x_view )
+               {  for(size_t j = 0; j < atom_n; ++j)
+                     atom_tx[j] = taylor[ (atom_x0 + j) * J + 0 ];
+               }
+               // call atomic function for this operation
+               call_atomic_forward<Base, RecBase>(
+                  atom_par_x, atom_type_x, need_y, atom_sy,
+                  order_low, order_up, atom_index, atom_id, atom_tx, atom_ty,
+                  &atom_cache
+               );
+            }
+            if( ! (flag && atom_y_view) )
+            {  for(size_t i = 0; i < atom_m; ++i)
+                  if( atom_iy[i] > 0 )
+                     taylor[ atom_iy[i] * J + 0 ] = atom_ty[i];
+            }
 # if CPPAD_FORWARD0_TRACE
             atom_trace = true;
 # endif
@@ -867,6 +971,12 @@ void forward0(
          CPPAD_ASSERT_UNKNOWN( atom_j < atom_n );
          CPPAD_ASSERT_UNKNOWN( size_t( arg[0] ) < num_par );
          //
+         if( atom_x_view )
+         {  // copy the previous arguments that were in the view
+            for(size_t j = 0; j < atom_j; ++j)
+               atom_tx[j] = taylor[ (atom_x0 + j) * J + 0 ];
+            atom_x_view = false;
+         }
          if( dyn_par_is[ arg[0] ] )
             atom_type_x[atom_j] = dynamic_enum;
          else
@@ -887,9 +997,21 @@ void forward0(
          CPPAD_ASSERT_UNKNOWN( atom_i == 0 );
          CPPAD_ASSERT_UNKNOWN( atom_j < atom_n );
          //
+         if( atom_x_view )
+         {  if( atom_j == 0 )
+               atom_x0 = size_t(arg[0]);
+            else if( size_t(arg[0]) != atom_x0 + atom_j )
+            {  // copy the previous arguments that were in the view
+               for(size_t j = 0; j < atom_j; ++j)
+                  atom_tx[j] = taylor[ (atom_x0 + j) * J + 0 ];
+               atom_x_view = false;
+            }
+         }
          atom_type_x[atom_j] = variable_enum;
          atom_par_x[atom_j]  = CppAD::numeric_limits<Base>::quiet_NaN();
-         atom_tx[atom_j++]   = taylor[ size_t(arg[0]) * J + 0 ];
+         if( ! atom_x_view )
+            atom_tx[atom_j] = taylor[ size_t(arg[0]) * J + 0 ];
+         ++atom_j;
          //
          if( atom_j == atom_n )
             atom_state = ret_atom;
@@ -902,6 +1024,7 @@ void forward0(
          CPPAD_ASSERT_UNKNOWN( atom_i < atom_m );
          CPPAD_ASSERT_UNKNOWN( atom_j == atom_n );
          CPPAD_ASSERT_UNKNOWN( size_t( arg[0] ) < num_par );
+         atom_y_view       = false;
          atom_iy[atom_i++] = 0;
          if( atom_i == atom_m )
             atom_state = end_atom;
@@ -913,6 +1036,10 @@ void forward0(
          CPPAD_ASSERT_UNKNOWN( atom_state == ret_atom );
          CPPAD_ASSERT_UNKNOWN( atom_i < atom_m );
          CPPAD_ASSERT_UNKNOWN( atom_j == atom_n );
+         // results that are variables have consecutive indices
+         CPPAD_ASSERT_UNKNOWN(
+            ! atom_y_view || atom_i == 0 || i_var == atom_iy[0] + atom_i
+         );
          atom_iy[atom_i++] = i_var;
          if( atom_i == atom_m )
             atom_state = end_atom;
@@ -997,6 +1124,42 @@ void forward0(
    return;
 }
 
+/// zero order forward sweep; see sweep_forward0 above
+template <class Addr, class Base, class RecBase>
+void forward0(
+   const local::player<Base>* play,
+   std::ostream&              s_out,
+   bool                       print,
+   size_t                     n,
+   size_t                     numvar,
+   size_t                     J,
+   Base*                      taylor,
+   bool*                      cskip_op,
+   pod_vector<Addr>&          load_op2var,
+   size_t                     compare_change_count,
+   size_t&                    compare_change_number,
+   size_t&                    compare_change_op_index,
+   const RecBase&             not_used_rec_base
+)
+{  if( play->compact_tape() )
+   {  play::const_compact_iterator itr(
+         play->num_var_rec(), play->compact_vec()
+      );
+      forward0_itr(itr, play, s_out, print, n, numvar, J, taylor,
+         cskip_op, load_op2var, compare_change_count,
+         compare_change_number, compare_change_op_index, not_used_rec_base
+      );
+   }
+   else
+   {  play::const_sequential_iterator itr = play->begin();
+      forward0_itr(itr, play, s_out, print, n, numvar, J, taylor,
+         cskip_op, load_op2var, compare_change_count,
+         compare_change_number, compare_change_op_index, not_used_rec_base
+      );
+   }
+   return;
+}
+
 } } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
 
 // preprocessor symbols that are local to this file
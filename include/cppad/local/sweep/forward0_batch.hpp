@@ -0,0 +1,699 @@
+# ifndef CPPAD_LOCAL_SWEEP_FORWARD0_BATCH_HPP
+# define CPPAD_LOCAL_SWEEP_FORWARD0_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/play/atom_op_info.hpp>
+# include <cppad/local/sweep/call_atomic.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/forward0_batch.hpp
+Compute zero order forward mode values at multiple points.
+*/
+
+/*
+ ------------------------------------------------------------------------------
+{xrst_begin sweep_forward0_batch dev}
+{xrst_spell
+   numvar
+}
+Zero Order Forward Mode at Multiple Points
+##########################################
+
+Syntax
+******
+
+| ``forward0_batch`` (
+| |tab| *play* ,
+| |tab| *n_point* ,
+| |tab| *numvar* ,
+| |tab| *batch* ,
+| |tab| *not_used_rec_base*
+| )
+
+Purpose
+*******
+This is the same as :ref:`sweep_forward0-name` except that it evaluates
+the function at *n_point* points during one pass through the operation
+sequence. Each operator is decoded once and then applied to a contiguous
+lane of points. This amortizes the decoding over the points and enables
+the compiler to vectorize the inner loop over the points.
+
+Base
+****
+The type used during the forward mode computations; i.e., the corresponding
+recording of operations used the type ``AD`` < *Base* > .
+
+n_point
+*******
+is the number of points at which the function is evaluated.
+
+numvar
+******
+is the total number of variables on the tape.
+
+batch
+*****
+is a structure of arrays with *numvar* * *n_point* elements.
+For *i* = 1 , ... , *numvar* ``-1`` and *k* = 0 , ... , *n_point* ``-1``
+*batch* [% *i* % * % *n_point* % + % *k* %]
+is the value of the variable with index *i* at the *k*-th point.
+
+Input
+=====
+The values for the independent variables are inputs.
+
+Output
+======
+The values for the other variables are outputs.
+
+Comparisons
+***********
+Comparison operators are not checked; i.e., there is no
+:ref:`compare_change-name` information for this sweep.
+
+Conditional Skip
+****************
+Conditional skip operators are ignored; i.e., all the operators are
+evaluated for every point.
+
+Print
+*****
+Print operators do not generate any output during this sweep.
+
+not_used_rec_base
+*****************
+Specifies *RecBase* for this call.
+
+{xrst_end sweep_forward0_batch}
+*/
+
+/// apply a unary operator to each point: Op(i_z, i_x, J, taylor)
+template <class Base, void (*Op)(size_t, size_t, size_t, Base*)>
+inline void forward0_batch_unary(
+   size_t         n_point     ,
+   size_t         i_z         ,
+   const addr_t*  arg         ,
+   Base*          batch       )
+{  size_t i_x = size_t( arg[0] );
+   for(size_t k = 0; k < n_point; ++k)
+      Op(i_z, i_x, n_point, batch + k);
+}
+
+/// apply a binary operator to each point:
+/// Op(i_z, arg, parameter, J, taylor)
+template <class Base,
+   void (*Op)(size_t, const addr_t*, const Base*, size_t, Base*)
+>
+inline void forward0_batch_binary(
+   size_t         n_point     ,
+   size_t         i_z         ,
+   const addr_t*  arg         ,
+   const Base*    parameter   ,
+   Base*          batch       )
+{  for(size_t k = 0; k < n_point; ++k)
+      Op(i_z, arg, parameter, n_point, batch + k);
+}
+
+template <class Base, class RecBase>
+void forward0_batch(
+   const local::player<Base>* play,
+   size_t                     n_point,
+   size_t                     numvar,
+   Base*                      batch,
+   const RecBase&             not_used_rec_base
+)
+{  CPPAD_ASSERT_UNKNOWN( n_point >= 1 );
+   CPPAD_ASSERT_UNKNOWN( play->num_var_rec() == numvar );
+
+   // use p, q, r so other forward sweeps can use code defined here
+   size_t p = 0;
+   size_t q = 0;
+   size_t r = 1;
+
+   // VecAD information (a separate copy for each point)
+   size_t num_vecad_ind = play->num_var_vecad_ind_rec();
+   size_t num_load      = play->num_var_load_rec();
+   pod_vector<bool>   vec_ad2isvar;
+   pod_vector<size_t> vec_ad2index;
+   pod_vector<addr_t> load_op2var;
+   if( num_vecad_ind > 0 )
+   {  vec_ad2isvar.extend(num_vecad_ind * n_point);
+      vec_ad2index.extend(num_vecad_ind * n_point);
+      for(size_t k = 0; k < n_point; ++k)
+      {  for(size_t i = 0; i < num_vecad_ind; i++)
+         {  vec_ad2index[k * num_vecad_ind + i] = play->GetVecInd(i);
+            vec_ad2isvar[k * num_vecad_ind + i] = false;
+         }
+      }
+   }
+   if( num_load > 0 )
+      load_op2var.extend(num_load * n_point);
+
+   // information used by atomic function operators
+   const pod_vector<bool>& dyn_par_is( play->dyn_par_is() );
+   const size_t need_y    = size_t( variable_enum );
+   const size_t order_low = p;
+   const size_t order_up  = q;
+
+   // vectors used by atomic function operators
+   vector<Base>         atom_par_x;  // argument parameter values
+   vector<ad_type_enum> atom_type_x; // argument type
+   vector<size_t>       atom_ix;     // variable indices for argument vector
+   vector<Base>         atom_tx;     // argument vector values at one point
+   vector<Base>         atom_ty;     // result vector values at one point
+   vector<size_t>       atom_iy;     // variable indices for result vector
+   vector<bool>         atom_sy;     // select_y for this atomic function
+   //
+   // information defined by atomic function operators
+   size_t atom_index=0, atom_id=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
+   enum_atom_state atom_state = start_atom; // proper initialization
+
+   // length of the parameter vector (used by CppAD assert macros)
+   const size_t num_par = play->num_par_rec();
+
+   // pointer to the beginning of the parameter vector
+   CPPAD_ASSERT_UNKNOWN( num_par > 0 )
+   const Base* parameter = play->GetPar();
+
+   // skip the BeginOp at the beginning of the recording
+   play::const_sequential_iterator itr = play->begin();
+   // op_info
+   OpCode op;
+   size_t i_var;
+   const addr_t* arg;
+   itr.op_info(op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+   //
+   bool flag; // a temporary flag to use in switch cases
+   bool more_operators = true;
+   while(more_operators)
+   {
+      // next op
+      (++itr).op_info(op, arg, i_var);
+      CPPAD_ASSERT_UNKNOWN( itr.op_index() < play->num_op_rec() );
+
+      // action to take depends on the case
+      switch( op )
+      {
+         // -------------------------------------------------
+         // unary operators
+         case AbsOp:
+         forward0_batch_unary<Base, forward_abs_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case AcosOp:
+         forward0_batch_unary<Base, forward_acos_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case AcoshOp:
+         forward0_batch_unary<Base, forward_acosh_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case AsinOp:
+         forward0_batch_unary<Base, forward_asin_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case AsinhOp:
+         forward0_batch_unary<Base, forward_asinh_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case AtanOp:
+         forward0_batch_unary<Base, forward_atan_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case AtanhOp:
+         forward0_batch_unary<Base, forward_atanh_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case CosOp:
+         forward0_batch_unary<Base, forward_cos_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case CoshOp:
+         forward0_batch_unary<Base, forward_cosh_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case ExpOp:
+         forward0_batch_unary<Base, forward_exp_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case Expm1Op:
+         forward0_batch_unary<Base, forward_expm1_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case LogOp:
+         forward0_batch_unary<Base, forward_log_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case Log1pOp:
+         forward0_batch_unary<Base, forward_log1p_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case NegOp:
+         forward0_batch_unary<Base, forward_neg_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case SignOp:
+         forward0_batch_unary<Base, forward_sign_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case SinOp:
+         forward0_batch_unary<Base, forward_sin_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case SinhOp:
+         forward0_batch_unary<Base, forward_sinh_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case SqrtOp:
+         forward0_batch_unary<Base, forward_sqrt_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case TanOp:
+         forward0_batch_unary<Base, forward_tan_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+
+         case TanhOp:
+         forward0_batch_unary<Base, forward_tanh_op_0<Base> >(
+            n_point, i_var, arg, batch
+         );
+         break;
+         // -------------------------------------------------
+         // binary operators
+         case AddpvOp:
+         forward0_batch_binary<Base, forward_addpv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case AddvvOp:
+         forward0_batch_binary<Base, forward_addvv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case DivpvOp:
+         forward0_batch_binary<Base, forward_divpv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case DivvpOp:
+         forward0_batch_binary<Base, forward_divvp_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case DivvvOp:
+         forward0_batch_binary<Base, forward_divvv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case MulpvOp:
+         forward0_batch_binary<Base, forward_mulpv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case MulvvOp:
+         forward0_batch_binary<Base, forward_mulvv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case PowpvOp:
+         forward0_batch_binary<Base, forward_powpv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case PowvpOp:
+         forward0_batch_binary<Base, forward_powvp_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case PowvvOp:
+         forward0_batch_binary<Base, forward_powvv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case SubpvOp:
+         forward0_batch_binary<Base, forward_subpv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case SubvpOp:
+         forward0_batch_binary<Base, forward_subvp_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case SubvvOp:
+         forward0_batch_binary<Base, forward_subvv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case ZmulpvOp:
+         forward0_batch_binary<Base, forward_zmulpv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case ZmulvpOp:
+         forward0_batch_binary<Base, forward_zmulvp_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+
+         case ZmulvvOp:
+         forward0_batch_binary<Base, forward_zmulvv_op_0<Base> >(
+            n_point, i_var, arg, parameter, batch
+         );
+         break;
+         // -------------------------------------------------
+
+         case CExpOp:
+         for(size_t k = 0; k < n_point; ++k) forward_cond_op_0(
+            i_var, arg, num_par, parameter, n_point, batch + k
+         );
+         break;
+         // -------------------------------------------------
+
+         case CSkipOp:
+         // all operators are evaluated for every point
+         itr.correct_before_increment();
+         break;
+         // -------------------------------------------------
+
+         case CSumOp:
+         for(size_t k = 0; k < n_point; ++k) forward_csum_op(
+            0, 0, i_var, arg, num_par, parameter, n_point, batch + k
+         );
+         itr.correct_before_increment();
+         break;
+         // -------------------------------------------------
+
+         case DisOp:
+         for(size_t k = 0; k < n_point; ++k) forward_dis_op<RecBase>(
+            p, q, r, i_var, arg, n_point, batch + k
+         );
+         break;
+         // -------------------------------------------------
+
+         case EndOp:
+         CPPAD_ASSERT_NARG_NRES(op, 0, 0);
+         more_operators = false;
+         break;
+         // -------------------------------------------------
+
+         // comparisons are not checked by this sweep
+         case EqppOp:
+         case EqpvOp:
+         case EqvvOp:
+         case LeppOp:
+         case LepvOp:
+         case LevpOp:
+         case LevvOp:
+         case LtppOp:
+         case LtpvOp:
+         case LtvpOp:
+         case LtvvOp:
+         case NeppOp:
+         case NepvOp:
+         case NevvOp:
+         break;
+         // -------------------------------------------------
+
+         case ErfOp:
+         case ErfcOp:
+         for(size_t k = 0; k < n_point; ++k) forward_erf_op_0(
+            op, i_var, arg, parameter, n_point, batch + k
+         );
+         break;
+         // -------------------------------------------------
+
+         case InvOp:
+         CPPAD_ASSERT_NARG_NRES(op, 0, 1);
+         break;
+         // ---------------------------------------------------
+
+         case LdpOp:
+         for(size_t k = 0; k < n_point; ++k) forward_load_p_op_0(
+            play,
+            i_var,
+            arg,
+            parameter,
+            n_point,
+            batch + k,
+            vec_ad2isvar.data() + k * num_vecad_ind,
+            vec_ad2index.data() + k * num_vecad_ind,
+            load_op2var.data()  + k * num_load
+         );
+         break;
+         // -------------------------------------------------
+
+         case LdvOp:
+         for(size_t k = 0; k < n_point; ++k) forward_load_v_op_0(
+            play,
+            i_var,
+            arg,
+            parameter,
+            n_point,
+            batch + k,
+            vec_ad2isvar.data() + k * num_vecad_ind,
+            vec_ad2index.data() + k * num_vecad_ind,
+            load_op2var.data()  + k * num_load
+         );
+         break;
+         // -------------------------------------------------
+
+         case ParOp:
+         for(size_t k = 0; k < n_point; ++k) forward_par_op_0(
+            i_var, arg, num_par, parameter, n_point, batch + k
+         );
+         break;
+         // -------------------------------------------------
+
+         case PriOp:
+         // print operators do not generate output during this sweep
+         break;
+         // -------------------------------------------------
+
+         case StppOp:
+         for(size_t k = 0; k < n_point; ++k) forward_store_pp_op_0(
+            i_var,
+            arg,
+            num_par,
+            parameter,
+            n_point,
+            batch + k,
+            vec_ad2isvar.data() + k * num_vecad_ind,
+            vec_ad2index.data() + k * num_vecad_ind
+         );
+         break;
+         // -------------------------------------------------
+
+         case StpvOp:
+         for(size_t k = 0; k < n_point; ++k) forward_store_pv_op_0(
+            i_var,
+            arg,
+            num_par,
+            parameter,
+            n_point,
+            batch + k,
+            vec_ad2isvar.data() + k * num_vecad_ind,
+            vec_ad2index.data() + k * num_vecad_ind
+         );
+         break;
+         // -------------------------------------------------
+
+         case StvpOp:
+         for(size_t k = 0; k < n_point; ++k) forward_store_vp_op_0(
+            i_var,
+            arg,
+            num_par,
+            n_point,
+            batch + k,
+            vec_ad2isvar.data() + k * num_vecad_ind,
+            vec_ad2index.data() + k * num_vecad_ind
+         );
+         break;
+         // -------------------------------------------------
+
+         case StvvOp:
+         for(size_t k = 0; k < n_point; ++k) forward_store_vv_op_0(
+            i_var,
+            arg,
+            num_par,
+            n_point,
+            batch + k,
+            vec_ad2isvar.data() + k * num_vecad_ind,
+            vec_ad2index.data() + k * num_vecad_ind
+         );
+         break;
+         // -------------------------------------------------
+
+         case AFunOp:
+         // start or end an atomic function call
+         flag = atom_state == start_atom;
+         play::atom_op_info<RecBase>(
+            op, arg, atom_index, atom_id, atom_m, atom_n
+         );
+         if( flag )
+         {  atom_state = arg_atom;
+            atom_i     = 0;
+            atom_j     = 0;
+            //
+            atom_par_x.resize(atom_n);
+            atom_type_x.resize(atom_n);
+            atom_ix.resize(atom_n);
+            atom_tx.resize(atom_n);
+            atom_ty.resize(atom_m);
+            atom_iy.resize(atom_m);
+            atom_sy.resize(atom_m);
+         }
+         else
+         {  CPPAD_ASSERT_UNKNOWN( atom_i == atom_m );
+            CPPAD_ASSERT_UNKNOWN( atom_j == atom_n );
+            atom_state = start_atom;
+            //
+            for(size_t i = 0; i < atom_m; ++i)
+               atom_sy[i] = atom_iy[i] != 0;
+            //
+            // call atomic function once for each point
+            for(size_t k = 0; k < n_point; ++k)
+            {  for(size_t j = 0; j < atom_n; ++j)
+               {  if( atom_type_x[j] == variable_enum )
+                     atom_tx[j] = batch[ atom_ix[j] * n_point + k ];
+                  else
+                     atom_tx[j] = atom_par_x[j];
+               }
+               call_atomic_forward<Base, RecBase>(
+                  atom_par_x, atom_type_x, need_y, atom_sy,
+                  order_low, order_up, atom_index, atom_id, atom_tx, atom_ty
+               );
+               for(size_t i = 0; i < atom_m; ++i)
+                  if( atom_iy[i] > 0 )
+                     batch[ atom_iy[i] * n_point + k ] = atom_ty[i];
+            }
+         }
+         break;
+
+         case FunapOp:
+         // parameter argument for an atomic function
+         CPPAD_ASSERT_UNKNOWN( NumArg(op) == 1 );
+         CPPAD_ASSERT_UNKNOWN( atom_state == arg_atom );
+         CPPAD_ASSERT_UNKNOWN( atom_i == 0 );
+         CPPAD_ASSERT_UNKNOWN( atom_j < atom_n );
+         CPPAD_ASSERT_UNKNOWN( size_t( arg[0] ) < num_par );
+         //
+         if( dyn_par_is[ arg[0] ] )
+            atom_type_x[atom_j] = dynamic_enum;
+         else
+            atom_type_x[atom_j] = constant_enum;
+         atom_ix[atom_j]      = 0;
+         atom_par_x[atom_j++] = parameter[ arg[0] ];
+         //
+         if( atom_j == atom_n )
+            atom_state = ret_atom;
+         break;
+
+         case FunavOp:
+         // variable argument for an atomic function
+         CPPAD_ASSERT_UNKNOWN( NumArg(op) == 1 );
+         CPPAD_ASSERT_UNKNOWN( atom_state == arg_atom );
+         CPPAD_ASSERT_UNKNOWN( atom_i == 0 );
+         CPPAD_ASSERT_UNKNOWN( atom_j < atom_n );
+         //
+         atom_type_x[atom_j]  = variable_enum;
+         atom_ix[atom_j]      = size_t( arg[0] );
+         atom_par_x[atom_j++] = CppAD::numeric_limits<Base>::quiet_NaN();
+         //
+         if( atom_j == atom_n )
+            atom_state = ret_atom;
+         break;
+
+         case FunrpOp:
+         // parameter result for an atomic function
+         CPPAD_ASSERT_NARG_NRES(op, 1, 0);
+         CPPAD_ASSERT_UNKNOWN( atom_state == ret_atom );
+         CPPAD_ASSERT_UNKNOWN( atom_i < atom_m );
+         CPPAD_ASSERT_UNKNOWN( atom_j == atom_n );
+         CPPAD_ASSERT_UNKNOWN( size_t( arg[0] ) < num_par );
+         atom_iy[atom_i++] = 0;
+         if( atom_i == atom_m )
+            atom_state = end_atom;
+         break;
+
+         case FunrvOp:
+         // variable result for an atomic function
+         CPPAD_ASSERT_NARG_NRES(op, 0, 1);
+         CPPAD_ASSERT_UNKNOWN( atom_state == ret_atom );
+         CPPAD_ASSERT_UNKNOWN( atom_i < atom_m );
+         CPPAD_ASSERT_UNKNOWN( atom_j == atom_n );
+         atom_iy[atom_i++] = i_var;
+         if( atom_i == atom_m )
+            atom_state = end_atom;
+         break;
+         // -------------------------------------------------
+
+         default:
+         CPPAD_ASSERT_UNKNOWN(false);
+      }
+   }
+   CPPAD_ASSERT_UNKNOWN( atom_state == start_atom );
+
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
@@ -0,0 +1,373 @@
+# ifndef CPPAD_LOCAL_SWEEP_FORWARD0_LEVEL_HPP
+# define CPPAD_LOCAL_SWEEP_FORWARD0_LEVEL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <cppad/local/sweep/forward0_plan.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/forward0_level.hpp
+Level scheduled execution of the zero order forward plan using threads.
+*/
+
+/// Minimum number of instructions that each thread executes for a level.
+/// Levels with fewer instructions are executed by the current thread.
+# define CPPAD_FORWARD0_LEVEL_MIN 512
+
+/*
+------------------------------------------------------------------------------
+{xrst_begin sweep_forward0_level dev}
+
+Level Scheduled Zero Order Forward Plan
+#######################################
+
+Syntax
+******
+| ``setup_forward0_level`` ( *play* )
+| ``forward0_level_run`` ( *plan* , *state* , *n_thread* )
+
+Purpose
+*******
+The instructions in a :ref:`sweep_forward0_plan-name` are executed
+in the order of the recording.
+The level of an instruction is one plus the maximum level of the
+instructions that compute its variable arguments
+(the independent variables have level zero).
+The instructions at the same level do not depend on each other and
+can be executed at the same time.
+
+play
+****
+This is a ``player`` < *Base* > object and its ``forward0_plan`` ()
+must be built.
+If the plan is usable, its level schedule is built by this call
+(no work is done if the schedule is already built).
+
+Comparisons
+***********
+The comparison instructions do not compute variables and are not
+included in the levels.
+They are executed, in the order of the recording,
+after all the levels have been executed.
+Hence the compare change information is the same as for
+:ref:`forward0_plan_run<sweep_forward0_plan-name>` .
+
+plan
+****
+This is the usable ``play::forward0_plan`` < *Base* > that is executed.
+Its level schedule must be built.
+
+state
+*****
+This is a ``play::forward0_state`` < *Base* > object.
+Its ``compare_change_number`` and ``compare_change_op_index`` are
+outputs with the same meaning as in ``forward0`` .
+
+n_thread
+********
+is the number of threads (including the current thread) used to execute
+each level.
+A level is split into contiguous blocks of instructions, one for each
+thread, and the threads wait for each other at the end of the level.
+Levels with less than ``CPPAD_FORWARD0_LEVEL_MIN`` instructions per
+thread use fewer threads.
+The threads are created using ``std::thread`` and do not use
+:ref:`thread_alloc-name` .
+
+{xrst_end sweep_forward0_level}
+*/
+
+/*!
+Build the level schedule for the zero order forward plan of a player
+(if not already built).
+
+\param play
+The plan play->forward0_plan() must be built.
+If it is usable, its level schedule is built.
+*/
+template <class Base>
+void setup_forward0_level(player<Base>* play)
+{  // check using the const version so a shared plan is not copied
+   const player<Base>* const_play = play;
+   const play::forward0_plan<Base>& const_plan( const_play->forward0_plan() );
+   CPPAD_ASSERT_UNKNOWN( const_plan.built() );
+   if( ! const_plan.usable() || const_plan.level_built() )
+      return;
+   play::forward0_plan<Base>& plan( play->forward0_plan() );
+   //
+   // arg_begin
+   play::const_sequential_iterator itr = play->begin();
+   OpCode        op;
+   size_t        i_var;
+   const addr_t* arg_begin;
+   itr.op_info(op, arg_begin, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+   //
+   // n_ins, ins
+   size_t n_ins = plan.size();
+   const play::forward0_instruction<Base>* ins = plan.data();
+   //
+   // var_level
+   // level for each variable (zero for the independent variables)
+   pod_vector<size_t> var_level( play->num_var_rec() );
+   for(size_t i = 0; i < var_level.size(); ++i)
+      var_level[i] = 0;
+   //
+   // ins_level, level_count, n_compare
+   // level for each instruction (zero for comparisons) and
+   // number of instructions at each level
+   pod_vector<size_t> ins_level(n_ins), level_count;
+   pod_vector<bool>   is_variable;
+   level_count.push_back(0);
+   size_t n_compare = 0;
+   for(size_t k = 0; k < n_ins; ++k)
+   {  op                = play->GetOp( size_t(ins[k].op_index) );
+      const addr_t* arg = arg_begin + ins[k].i_arg;
+      arg_is_variable(op, arg, is_variable);
+      size_t level = 1;
+      for(size_t j = 0; j < is_variable.size(); ++j) if( is_variable[j] )
+         level = std::max(level, var_level[ size_t(arg[j]) ] + 1);
+      //
+      size_t n_res = NumRes(op);
+      if( n_res == 0 )
+      {  // comparison operators are executed after the levels
+         ins_level[k] = 0;
+         ++n_compare;
+      }
+      else
+      {  ins_level[k] = level;
+         for(size_t i = 0; i < n_res; ++i)
+            var_level[ size_t(ins[k].i_var) - i ] = level;
+         if( level_count.size() <= level )
+            level_count.push_back(0);
+         ++level_count[level];
+      }
+   }
+   //
+   // level_start
+   size_t num_level = level_count.size() - 1;
+   pod_vector<size_t> level_start(num_level + 1);
+   level_start[0] = 0;
+   for(size_t ell = 0; ell < num_level; ++ell)
+      level_start[ell + 1] = level_start[ell] + level_count[ell + 1];
+   CPPAD_ASSERT_UNKNOWN( level_start[num_level] + n_compare == n_ins );
+   //
+   // level_ins, compare_ins
+   // (the instructions in a level are in the order of the recording)
+   pod_vector_maybe< play::forward0_instruction<Base> > level_ins(
+      n_ins - n_compare
+   );
+   pod_vector_maybe< play::forward0_instruction<Base> > compare_ins(
+      n_compare
+   );
+   pod_vector<size_t> next;
+   next = level_start;
+   size_t i_compare = 0;
+   for(size_t k = 0; k < n_ins; ++k)
+   {  if( ins_level[k] == 0 )
+         compare_ins[i_compare++] = ins[k];
+      else
+         level_ins[ next[ ins_level[k] - 1 ]++ ] = ins[k];
+   }
+   plan.set_level(level_ins, level_start, compare_ins);
+   return;
+}
+
+/*!
+Information shared by the threads that execute a level schedule.
+
+\tparam Base
+type used for the zero order forward mode calculations.
+*/
+template <class Base>
+struct forward0_level_team {
+   /// protects the other fields in this structure
+   std::mutex                              mutex;
+   /// used to signal the other threads that a level is ready
+   std::condition_variable                 start;
+   /// used to signal the current thread that a level is done
+   std::condition_variable                 done;
+   /// incremented each time the other threads are signaled
+   size_t                                  generation;
+   /// number of other threads that are still working on this level
+   size_t                                  n_busy;
+   /// have all the levels been executed
+   bool                                    finished;
+   /// first instruction in the level that is being executed
+   const play::forward0_instruction<Base>* ins;
+   /// number of instructions in the level that is being executed
+   size_t                                  n_ins;
+   /// number of threads that are used for the level
+   size_t                                  n_use;
+   /// state for the instructions (the threads do not change it)
+   play::forward0_state<Base>              state;
+};
+
+/*!
+Execute a block of instructions from one level.
+
+\param ins
+is the first instruction in the level.
+
+\param n_ins
+is the number of instructions in the level.
+
+\param n_use
+is the number of threads that are used for the level.
+
+\param thread
+is the index of the thread (and block) that is executed.
+
+\param state
+is the state for the instructions.
+*/
+template <class Base>
+void forward0_level_block(
+   const play::forward0_instruction<Base>* ins    ,
+   size_t                                  n_ins  ,
+   size_t                                  n_use  ,
+   size_t                                  thread ,
+   play::forward0_state<Base>&             state  )
+{  const play::forward0_instruction<Base>* ins_begin =
+      ins + (thread * n_ins) / n_use;
+   const play::forward0_instruction<Base>* ins_end   =
+      ins + ( (thread + 1) * n_ins ) / n_use;
+   while( ins_begin != ins_end )
+   {  ins_begin->handler(*ins_begin, state);
+      ++ins_begin;
+   }
+}
+
+/*!
+Loop executed by the threads, other than the current thread,
+for a level schedule.
+
+\param team
+is the information shared by the threads.
+
+\param thread
+is the index of this thread (greater than zero).
+*/
+template <class Base>
+void forward0_level_worker(forward0_level_team<Base>* team, size_t thread)
+{  // state: this thread's copy of the state
+   std::unique_lock<std::mutex> lock(team->mutex);
+   play::forward0_state<Base> state = team->state;
+   //
+   size_t generation = 0;
+   while( true )
+   {  while( team->generation == generation )
+         team->start.wait(lock);
+      generation = team->generation;
+      if( team->finished )
+         return;
+      //
+      const play::forward0_instruction<Base>* ins = team->ins;
+      size_t n_ins = team->n_ins;
+      size_t n_use = team->n_use;
+      lock.unlock();
+      if( thread < n_use )
+         forward0_level_block(ins, n_ins, n_use, thread, state);
+      lock.lock();
+      if( --team->n_busy == 0 )
+         team->done.notify_one();
+   }
+}
+
+/*!
+Execute the level schedule for a zero order forward plan.
+
+\param plan
+is a usable plan for the recording and its level schedule is built.
+
+\param state
+is the state shared by the instructions in the plan.
+
+\param n_thread
+is the number of threads used to execute each level.
+*/
+template <class Base>
+void forward0_level_run(
+   const play::forward0_plan<Base>& plan     ,
+   play::forward0_state<Base>&      state    ,
+   size_t                           n_thread )
+{  CPPAD_ASSERT_UNKNOWN( plan.built() && plan.usable() );
+   CPPAD_ASSERT_UNKNOWN( plan.level_built() );
+   size_t num_level = plan.num_level();
+   //
+   // n_team: maximum number of threads used by any level
+   size_t n_team = 1;
+   for(size_t ell = 0; ell < num_level; ++ell)
+   {  size_t n_use = plan.level_size(ell) / CPPAD_FORWARD0_LEVEL_MIN;
+      n_team = std::max(n_team, std::min(n_thread, n_use) );
+   }
+   //
+   // team, worker
+   forward0_level_team<Base> team;
+   team.generation = 0;
+   team.n_busy     = 0;
+   team.finished   = false;
+   team.ins        = nullptr;
+   team.n_ins      = 0;
+   team.n_use      = 0;
+   team.state      = state;
+   std::vector<std::thread> worker;
+   for(size_t thread = 1; thread < n_team; ++thread) worker.push_back(
+      std::thread( forward0_level_worker<Base>, &team, thread )
+   );
+   //
+   // execute the levels
+   for(size_t ell = 0; ell < num_level; ++ell)
+   {  const play::forward0_instruction<Base>* ins = plan.level_data(ell);
+      size_t n_ins = plan.level_size(ell);
+      size_t n_use = std::min(n_team, n_ins / CPPAD_FORWARD0_LEVEL_MIN);
+      if( n_use <= 1 )
+         forward0_level_block(ins, n_ins, 1, 0, state);
+      else
+      {  {  std::lock_guard<std::mutex> guard(team.mutex);
+            team.ins    = ins;
+            team.n_ins  = n_ins;
+            team.n_use  = n_use;
+            team.n_busy = n_team - 1;
+            ++team.generation;
+         }
+         team.start.notify_all();
+         forward0_level_block(ins, n_ins, n_use, 0, state);
+         //
+         std::unique_lock<std::mutex> lock(team.mutex);
+         while( team.n_busy > 0 )
+            team.done.wait(lock);
+      }
+   }
+   //
+   // stop the other threads
+   if( n_team > 1 )
+   {  {  std::lock_guard<std::mutex> guard(team.mutex);
+         team.finished = true;
+         ++team.generation;
+      }
+      team.start.notify_all();
+      for(size_t thread = 1; thread < n_team; ++thread)
+         worker[thread - 1].join();
+   }
+   //
+   // execute the comparisons in the order of the recording
+   const play::forward0_instruction<Base>* ins     = plan.compare_data();
+   const play::forward0_instruction<Base>* ins_end = ins + plan.num_compare();
+   while( ins != ins_end )
+   {  ins->handler(*ins, state);
+      ++ins;
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
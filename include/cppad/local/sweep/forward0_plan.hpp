@@ -0,0 +1,469 @@
+# ifndef CPPAD_LOCAL_SWEEP_FORWARD0_PLAN_HPP
+# define CPPAD_LOCAL_SWEEP_FORWARD0_PLAN_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/play/forward0_plan.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/forward0_plan.hpp
+Handlers and setup for the pre-decoded zero order forward plan.
+*/
+
+/*
+------------------------------------------------------------------------------
+{xrst_begin sweep_forward0_plan dev}
+
+Pre-decoded Zero Order Forward Plan
+###################################
+
+Syntax
+******
+| ``setup_forward0_plan`` ( *play* )
+| ``forward0_plan_run`` ( *plan* , *state* )
+
+Purpose
+*******
+The :ref:`sweep_forward0-name` routine decodes every operator,
+using a switch on its op code, each time it is called.
+A plan is a flat array of handler pointers and resolved operator, argument,
+and result indices that is built once per recording.
+If the plan for a recording is usable, ``forward0`` executes the plan
+instead of decoding the operation sequence.
+
+play
+****
+This is a ``player`` < *Base* > object and its ``forward0_plan`` ()
+is built by this call (no work is done if it is already built).
+The plan is cleared whenever a new recording is stored in *play* .
+
+Usable
+******
+The plan is not usable (and no memory is kept for it) when the recording
+contains any of the following operators:
+atomic function calls, VecAD loads and stores,
+conditional skips, discrete functions, and print operations.
+
+plan
+****
+This is the ``play::forward0_plan`` < *Base* > that is executed.
+
+state
+*****
+This is a ``play::forward0_state`` < *Base* > object.
+Its ``compare_change_number`` and ``compare_change_op_index`` are
+outputs with the same meaning as in ``forward0`` .
+
+{xrst_end sweep_forward0_plan}
+*/
+
+/// handler for unary operators: forward_*_op_0(i_z, i_x, J, taylor)
+template <class Base, void (*Op)(size_t, size_t, size_t, Base*)>
+void forward0_plan_unary(
+   const play::forward0_instruction<Base>& ins   ,
+   play::forward0_state<Base>&             state )
+{  const addr_t* arg = state.arg + ins.i_arg;
+   Op( size_t(ins.i_var), size_t(arg[0]), state.J, state.taylor );
+}
+
+/// handler for binary operators:
+/// forward_*_op_0(i_z, arg, parameter, J, taylor)
+template <class Base,
+   void (*Op)(size_t, const addr_t*, const Base*, size_t, Base*)
+>
+void forward0_plan_binary(
+   const play::forward0_instruction<Base>& ins   ,
+   play::forward0_state<Base>&             state )
+{  const addr_t* arg = state.arg + ins.i_arg;
+   Op( size_t(ins.i_var), arg, state.parameter, state.J, state.taylor );
+}
+
+/// handler for operators that check the number of parameters:
+/// forward_*_op_0(i_z, arg, num_par, parameter, J, taylor)
+template <class Base,
+   void (*Op)(size_t, const addr_t*, size_t, const Base*, size_t, Base*)
+>
+void forward0_plan_num_par(
+   const play::forward0_instruction<Base>& ins   ,
+   play::forward0_state<Base>&             state )
+{  const addr_t* arg = state.arg + ins.i_arg;
+   Op( size_t(ins.i_var),
+      arg, state.num_par, state.parameter, state.J, state.taylor
+   );
+}
+
+/// handler for the cumulative summation operator
+template <class Base>
+void forward0_plan_csum(
+   const play::forward0_instruction<Base>& ins   ,
+   play::forward0_state<Base>&             state )
+{  const addr_t* arg = state.arg + ins.i_arg;
+   forward_csum_op(
+      0, 0, size_t(ins.i_var),
+      arg, state.num_par, state.parameter, state.J, state.taylor
+   );
+}
+
+/// handler for the error function operators
+template <class Base, OpCode op>
+void forward0_plan_erf(
+   const play::forward0_instruction<Base>& ins   ,
+   play::forward0_state<Base>&             state )
+{  const addr_t* arg = state.arg + ins.i_arg;
+   forward_erf_op_0(
+      op, size_t(ins.i_var), arg, state.parameter, state.J, state.taylor
+   );
+}
+
+/// handler for comparison operators with a variable argument:
+/// forward_*_op_0(count, arg, parameter, J, taylor)
+template <class Base,
+   void (*Op)(size_t&, const addr_t*, const Base*, size_t, Base*)
+>
+void forward0_plan_compare(
+   const play::forward0_instruction<Base>& ins   ,
+   play::forward0_state<Base>&             state )
+{  if( state.compare_change_count )
+   {  const addr_t* arg = state.arg + ins.i_arg;
+      Op(state.compare_change_number,
+         arg, state.parameter, state.J, state.taylor
+      );
+      if( state.compare_change_count == state.compare_change_number )
+         state.compare_change_op_index = size_t( ins.op_index );
+   }
+}
+
+/// handler for comparison operators with two parameter arguments:
+/// forward_*_op_0(count, arg, parameter)
+template <class Base,
+   void (*Op)(size_t&, const addr_t*, const Base*)
+>
+void forward0_plan_compare_pp(
+   const play::forward0_instruction<Base>& ins   ,
+   play::forward0_state<Base>&             state )
+{  if( state.compare_change_count )
+   {  const addr_t* arg = state.arg + ins.i_arg;
+      Op(state.compare_change_number, arg, state.parameter);
+      if( state.compare_change_count == state.compare_change_number )
+         state.compare_change_op_index = size_t( ins.op_index );
+   }
+}
+
+/*!
+Build the zero order forward plan for a player (if not already built).
+
+\param play
+The plan play->forward0_plan() is built for the recording in play.
+*/
+template <class Base>
+void setup_forward0_plan(player<Base>* play)
+{  // check using the const version so a shared plan is not copied
+   // (a plan is not used when the recording is stored in compact form)
+   const player<Base>* const_play = play;
+   if( const_play->forward0_plan().built() || const_play->compact_tape() )
+      return;
+   play::forward0_plan<Base>& plan( play->forward0_plan() );
+   //
+   // handler type
+   typedef void (*handler_t)(
+      const play::forward0_instruction<Base>& ins   ,
+      play::forward0_state<Base>&             state
+   );
+   //
+   // BeginOp
+   play::const_sequential_iterator itr = play->begin();
+   OpCode        op;
+   size_t        i_var;
+   const addr_t* arg;
+   itr.op_info(op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+   const addr_t* arg_begin = arg;
+   //
+   bool usable         = true;
+   bool more_operators = true;
+   while( more_operators && usable )
+   {  (++itr).op_info(op, arg, i_var);
+      handler_t handler = nullptr;
+      switch( op )
+      {  // --------------------------------------------------------------
+         // operators that are not executed
+         case EndOp:
+         more_operators = false;
+         break;
+
+         case InvOp:
+         break;
+         // --------------------------------------------------------------
+         // unary operators
+         case AbsOp:
+         handler = forward0_plan_unary<Base, forward_abs_op_0<Base> >;
+         break;
+
+         case AcosOp:
+         handler = forward0_plan_unary<Base, forward_acos_op_0<Base> >;
+         break;
+
+         case AcoshOp:
+         handler = forward0_plan_unary<Base, forward_acosh_op_0<Base> >;
+         break;
+
+         case AsinOp:
+         handler = forward0_plan_unary<Base, forward_asin_op_0<Base> >;
+         break;
+
+         case AsinhOp:
+         handler = forward0_plan_unary<Base, forward_asinh_op_0<Base> >;
+         break;
+
+         case AtanOp:
+         handler = forward0_plan_unary<Base, forward_atan_op_0<Base> >;
+         break;
+
+         case AtanhOp:
+         handler = forward0_plan_unary<Base, forward_atanh_op_0<Base> >;
+         break;
+
+         case CosOp:
+         handler = forward0_plan_unary<Base, forward_cos_op_0<Base> >;
+         break;
+
+         case CoshOp:
+         handler = forward0_plan_unary<Base, forward_cosh_op_0<Base> >;
+         break;
+
+         case ExpOp:
+         handler = forward0_plan_unary<Base, forward_exp_op_0<Base> >;
+         break;
+
+         case Expm1Op:
+         handler = forward0_plan_unary<Base, forward_expm1_op_0<Base> >;
+         break;
+
+         case LogOp:
+         handler = forward0_plan_unary<Base, forward_log_op_0<Base> >;
+         break;
+
+         case Log1pOp:
+         handler = forward0_plan_unary<Base, forward_log1p_op_0<Base> >;
+         break;
+
+         case NegOp:
+         handler = forward0_plan_unary<Base, forward_neg_op_0<Base> >;
+         break;
+
+         case SignOp:
+         handler = forward0_plan_unary<Base, forward_sign_op_0<Base> >;
+         break;
+
+         case SinOp:
+         handler = forward0_plan_unary<Base, forward_sin_op_0<Base> >;
+         break;
+
+         case SinhOp:
+         handler = forward0_plan_unary<Base, forward_sinh_op_0<Base> >;
+         break;
+
+         case SqrtOp:
+         handler = forward0_plan_unary<Base, forward_sqrt_op_0<Base> >;
+         break;
+
+         case TanOp:
+         handler = forward0_plan_unary<Base, forward_tan_op_0<Base> >;
+         break;
+
+         case TanhOp:
+         handler = forward0_plan_unary<Base, forward_tanh_op_0<Base> >;
+         break;
+         // --------------------------------------------------------------
+         // binary operators
+         case AddpvOp:
+         handler = forward0_plan_binary<Base, forward_addpv_op_0<Base> >;
+         break;
+
+         case AddvvOp:
+         handler = forward0_plan_binary<Base, forward_addvv_op_0<Base> >;
+         break;
+
+         case DivpvOp:
+         handler = forward0_plan_binary<Base, forward_divpv_op_0<Base> >;
+         break;
+
+         case DivvpOp:
+         handler = forward0_plan_binary<Base, forward_divvp_op_0<Base> >;
+         break;
+
+         case DivvvOp:
+         handler = forward0_plan_binary<Base, forward_divvv_op_0<Base> >;
+         break;
+
+         case MulpvOp:
+         handler = forward0_plan_binary<Base, forward_mulpv_op_0<Base> >;
+         break;
+
+         case MulvvOp:
+         handler = forward0_plan_binary<Base, forward_mulvv_op_0<Base> >;
+         break;
+
+         case PowpvOp:
+         handler = forward0_plan_binary<Base, forward_powpv_op_0<Base> >;
+         break;
+
+         case PowvpOp:
+         handler = forward0_plan_binary<Base, forward_powvp_op_0<Base> >;
+         break;
+
+         case PowvvOp:
+         handler = forward0_plan_binary<Base, forward_powvv_op_0<Base> >;
+         break;
+
+         case SubpvOp:
+         handler = forward0_plan_binary<Base, forward_subpv_op_0<Base> >;
+         break;
+
+         case SubvpOp:
+         handler = forward0_plan_binary<Base, forward_subvp_op_0<Base> >;
+         break;
+
+         case SubvvOp:
+         handler = forward0_plan_binary<Base, forward_subvv_op_0<Base> >;
+         break;
+
+         case ZmulpvOp:
+         handler = forward0_plan_binary<Base, forward_zmulpv_op_0<Base> >;
+         break;
+
+         case ZmulvpOp:
+         handler = forward0_plan_binary<Base, forward_zmulvp_op_0<Base> >;
+         break;
+
+         case ZmulvvOp:
+         handler = forward0_plan_binary<Base, forward_zmulvv_op_0<Base> >;
+         break;
+         // --------------------------------------------------------------
+         // operators that use the number of parameters
+         case CExpOp:
+         handler = forward0_plan_num_par<Base, forward_cond_op_0<Base> >;
+         break;
+
+         case ParOp:
+         handler = forward0_plan_num_par<Base, forward_par_op_0<Base> >;
+         break;
+
+         case CSumOp:
+         handler = forward0_plan_csum<Base>;
+         itr.correct_before_increment();
+         break;
+
+         case ErfOp:
+         handler = forward0_plan_erf<Base, ErfOp>;
+         break;
+
+         case ErfcOp:
+         handler = forward0_plan_erf<Base, ErfcOp>;
+         break;
+         // --------------------------------------------------------------
+         // comparison operators
+         case EqppOp:
+         handler = forward0_plan_compare_pp<Base, forward_eqpp_op_0<Base> >;
+         break;
+
+         case EqpvOp:
+         handler = forward0_plan_compare<Base, forward_eqpv_op_0<Base> >;
+         break;
+
+         case EqvvOp:
+         handler = forward0_plan_compare<Base, forward_eqvv_op_0<Base> >;
+         break;
+
+         case LeppOp:
+         handler = forward0_plan_compare_pp<Base, forward_lepp_op_0<Base> >;
+         break;
+
+         case LepvOp:
+         handler = forward0_plan_compare<Base, forward_lepv_op_0<Base> >;
+         break;
+
+         case LevpOp:
+         handler = forward0_plan_compare<Base, forward_levp_op_0<Base> >;
+         break;
+
+         case LevvOp:
+         handler = forward0_plan_compare<Base, forward_levv_op_0<Base> >;
+         break;
+
+         case LtppOp:
+         handler = forward0_plan_compare_pp<Base, forward_ltpp_op_0<Base> >;
+         break;
+
+         case LtpvOp:
+         handler = forward0_plan_compare<Base, forward_ltpv_op_0<Base> >;
+         break;
+
+         case LtvpOp:
+         handler = forward0_plan_compare<Base, forward_ltvp_op_0<Base> >;
+         break;
+
+         case LtvvOp:
+         handler = forward0_plan_compare<Base, forward_ltvv_op_0<Base> >;
+         break;
+
+         case NeppOp:
+         handler = forward0_plan_compare_pp<Base, forward_nepp_op_0<Base> >;
+         break;
+
+         case NepvOp:
+         handler = forward0_plan_compare<Base, forward_nepv_op_0<Base> >;
+         break;
+
+         case NevvOp:
+         handler = forward0_plan_compare<Base, forward_nevv_op_0<Base> >;
+         break;
+         // --------------------------------------------------------------
+         // operators that require the general forward0 sweep
+         default:
+         usable = false;
+         break;
+      }
+      if( handler != nullptr )
+      {  play::forward0_instruction<Base> ins;
+         ins.handler  = handler;
+         ins.op_index = addr_t( itr.op_index() );
+         ins.i_var    = addr_t( i_var );
+         ins.i_arg    = addr_t( arg - arg_begin );
+         plan.push_back(ins);
+      }
+   }
+   plan.finish(usable);
+   return;
+}
+
+/*!
+Execute a zero order forward plan.
+
+\param plan
+is a usable plan for the recording.
+
+\param state
+is the state shared by the instructions in the plan.
+*/
+template <class Base>
+void forward0_plan_run(
+   const play::forward0_plan<Base>& plan  ,
+   play::forward0_state<Base>&      state )
+{  CPPAD_ASSERT_UNKNOWN( plan.built() && plan.usable() );
+   const play::forward0_instruction<Base>* ins     = plan.data();
+   const play::forward0_instruction<Base>* ins_end = ins + plan.size();
+   while( ins != ins_end )
+   {  ins->handler(*ins, state);
+      ++ins;
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
@@ -6,7 +6,9 @@
 // ----------------------------------------------------------------------------
 
 
+# include <type_traits>
 # include <cppad/local/play/atom_op_info.hpp>
+# include <cppad/local/sweep/atom_batch.hpp>
 
 // BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
 namespace CppAD { namespace local { namespace sweep {
@@ -203,10 +205,20 @@ void reverse(
    // information defined by atomic forward
    size_t atom_index=0, atom_old=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
    enum_atom_state atom_state = end_atom; // proper initialization
+   //
+   // groups of atomic function calls that are evaluated together
+   // (only used when iterating over the entire recording)
+   const play::atom_batch& atom_batch( play->atom_batch() );
+   bool atom_batch_ok = atom_batch.usable() &&
+      std::is_same<Iterator, play::const_sequential_iterator>::value;
+   size_t atom_i_call = atom_batch.num_call(); // index of current call + 1
+   atomic_ptr_cache<RecBase> atom_cache;      // resolved atomic objects
 
    // A vector with unspecified contents declared here so that operator
-   // routines do not need to re-allocate it
-   vector<Base> work;
+   // routines do not need to re-allocate it. This uses the system allocator
+   // (not thread_alloc) so that sweeps, for a recording without atomic
+   // functions, can be run by threads that thread_alloc does not know about.
+   std::vector<Base> work;
 
    // temporary indices
    size_t j, ell;
@@ -656,6 +668,23 @@ void reverse(
          play::atom_op_info<RecBase>(
             op, arg, atom_index, atom_old, atom_m, atom_n
          );
+         if( flag && atom_batch_ok )
+         {  CPPAD_ASSERT_UNKNOWN( atom_i_call > 0 );
+            --atom_i_call;
+            size_t group = atom_batch.call(atom_i_call).group;
+            if( group < atom_batch.num_group() )
+            {  // this call is evaluated with the other calls in its group
+               if( atom_batch.anchor(group) == atom_i_call )
+                  atom_batch_reverse<Base, RecBase>(
+                     play, group, atom_cache, d, J, Taylor, K, Partial
+                  );
+               //
+               // skip to the first AFunOp for this call
+               for(size_t i = 0; i < atom_m + atom_n + 1; ++i)
+                  --play_itr;
+               break;
+            }
+         }
          if( flag )
          {  atom_state = ret_atom;
             atom_i     = atom_m;
@@ -16,6 +16,7 @@ Implementation
 **************
 {xrst_spell_off}
 {xrst_code cpp} */
+# include <cppad/example/base_simd_pack.hpp>
 # include <cppad/cppad.hpp>
 # include <cppad/speed/det_by_minor.hpp>
 # include <cppad/speed/uniform_01.hpp>
@@ -27,17 +28,21 @@ extern std::map<std::string, bool> global_option;
 extern size_t global_cppad_thread_alloc_inuse;
 
 namespace {
-   // typedefs
-   typedef CppAD::AD<double>       a_double;
-   typedef CppAD::vector<a_double> a_vector;
+   // number of matrices evaluated by each sweep when simd option is present
+   const size_t n_lane = 4;
+   typedef CppAD::simd_pack<double, n_lane> simd_double;
    //
    // setup
+   template <class Base>
    void setup(
       // inputs
       size_t size             ,
       // outputs
-      CppAD::ADFun<double>& f )
-   {
+      CppAD::ADFun<Base>&   f )
+   {  // typedefs
+      typedef CppAD::AD<Base>         a_double;
+      typedef CppAD::vector<a_double> a_vector;
+      //
       // object for computing determinant
       CppAD::det_by_minor<a_double>   a_det(size);
       //
@@ -86,7 +91,7 @@ bool link_det_minor(
 
    // --------------------------------------------------------------------
    // check global options
-   const char* valid[] = { "memory", "onetape", "optimize"};
+   const char* valid[] = { "memory", "onetape", "optimize", "simd"};
    size_t n_valid = sizeof(valid) / sizeof(valid[0]);
    typedef std::map<std::string, bool>::iterator iterator;
    //
@@ -104,6 +109,9 @@ bool link_det_minor(
    // AD function mapping matrix to determinant
    static CppAD::ADFun<double> static_f;
    //
+   // AD function mapping n_lane matrices to their determinants
+   static CppAD::ADFun<simd_double> static_f_simd;
+   //
    // size corresponding to static_f
    static size_t static_size = 0;
    //
@@ -116,10 +124,16 @@ bool link_det_minor(
    //
    // onetape
    bool onetape = global_option["onetape"];
+   //
+   // simd
+   bool simd = global_option["simd"];
    // -----------------------------------------------------------------------
    if( job == "setup" )
    {  if( onetape )
-      {  setup(size, static_f);
+      {  if( simd )
+            setup(size, static_f_simd);
+         else
+            setup(size, static_f);
          static_size = size;
       }
       else
@@ -128,12 +142,42 @@ bool link_det_minor(
       return true;
    }
    if( job ==  "teardown" )
-   {  static_f = CppAD::ADFun<double>();
+   {  static_f      = CppAD::ADFun<double>();
+      static_f_simd = CppAD::ADFun<simd_double>();
       return true;
    }
    // -----------------------------------------------------------------------
    CPPAD_ASSERT_UNKNOWN( job == "run" );
-   while(repeat--)
+   if( simd )
+   {  // each sweep evaluates the gradient for n_lane matrices
+      CppAD::vector<simd_double> x(nx), w_simd(1), g_simd(nx);
+      w_simd[0] = w[0];
+      size_t n_sweep = (repeat + n_lane - 1) / n_lane;
+      while(n_sweep--)
+      {  if( onetape )
+         {  // use if before assert to avoid warning
+            if( size != static_size )
+            {  CPPAD_ASSERT_UNKNOWN( size == static_size );
+            }
+         }
+         else
+         {  setup(size, static_f_simd);
+         }
+         // get next n_lane matrices
+         for(size_t k = 0; k < n_lane; ++k)
+         {  CppAD::uniform_01(nx, matrix);
+            for(size_t j = 0; j < nx; ++j)
+               x[j][k] = matrix[j];
+         }
+         // evaluate the gradients
+         static_f_simd.Forward(0, x);
+         g_simd = static_f_simd.Reverse(1, w_simd);
+      }
+      // gradient corresponding to the last matrix
+      for(size_t j = 0; j < nx; ++j)
+         gradient[j] = g_simd[j][n_lane - 1];
+   }
+   else while(repeat--)
    {  if( onetape )
       {  // use if before assert to avoid warning
          if( size != static_size )
@@ -54,6 +54,7 @@
    optionlist
    retaped
    revsparsity
+   simd
    subgraphs
    subsparsity
    underbar
@@ -233,6 +234,16 @@ test is implemented for this option.
 In addition, the CppAD :ref:`sparse_hessian<link_sparse_hessian-name>`
 test is implemented for this option when ``hes2jac`` is present.
 
+simd
+====
+If this option is present,
+:ref:`speed_cppad-name` will use the
+:ref:`simd_pack<base_simd_pack.hpp-name>` type for *Base*
+so that each sweep of the operation sequence computes the results
+for four repetitions of the test.
+So far, CppAD has only implemented
+the :ref:`det_minor<link_det_minor-name>` test for this option.
+
 Sparsity Options
 ****************
 The following options only apply to the
@@ -395,6 +406,7 @@ namespace {
       "atomic",
       "hes2jac",
       "subgraph",
+      "simd",
       "boolsparsity",
       "revsparsity",
       "subsparsity",
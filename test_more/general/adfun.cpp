@@ -34,11 +34,11 @@ bool adfun_empty(void)
    size_t inuse_3  = CppAD::thread_alloc::inuse(thread);
    ok &= inuse_1 < inuse_3;
    //
-   // assigning to an empty function uses assignment to pod_vectors
-   // which just changes their lenght to zero
+   // assigning an empty function to g shares the empty operation sequence
+   // in f (hence frees the operation sequence that was in g)
    g = f;
    size_t inuse_4  = CppAD::thread_alloc::inuse(thread);
-   ok &= inuse_3 == inuse_4;
+   ok &= inuse_4 < inuse_3;
    //
    // assigning to a temporary empty function to g
    // uses move semantics (hence frees all memory in g)
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check f.checkpoint_reverse for many combinations of the number of steps
+and the number of stored states, including the bound on the number of
+forward evaluations.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(double)      d_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>) ad_vector;
+   // -----------------------------------------------------------------------
+   // one step: y = [ x_0 * x_1 / 2, x_0 + cos(x_1) / 2, x_2 * p_0 ]
+   void step(const ad_vector& ax, const ad_vector& ap, ad_vector& ay)
+   {  ay[0] = ax[0] * ax[1] / 2.0;
+      ay[1] = ax[0] + cos( ax[1] ) / 2.0;
+      ay[2] = ax[2] * ap[0];
+   }
+   // -----------------------------------------------------------------------
+   // binomial coefficient (s+t)! / (s! t!)
+   size_t beta(size_t s, size_t t)
+   {  size_t result = 1;
+      for(size_t i = 1; i <= s; ++i)
+         result = result * (t + i) / i;
+      return result;
+   }
+}
+
+bool checkpoint_reverse(void)
+{  bool ok = true;
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+   //
+   // f: one step
+   size_t n = 3;
+   ad_vector ax(n), ap(1), ay(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = 0.5;
+   ap[0] = 1.0;
+   CppAD::Independent(ax, ap);
+   step(ax, ap, ay);
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // dynamic parameter value used for every step
+   d_vector p(1);
+   p[0] = 0.9;
+   f.new_dynamic(p);
+   //
+   d_vector x(n), w(n), y(n), dw(n);
+   x[0] = 0.3;
+   x[1] = 0.7;
+   x[2] = 1.1;
+   w[0] = 1.0;
+   w[1] = -2.0;
+   w[2] = 3.0;
+   for(size_t n_step = 1; n_step <= 25; ++n_step)
+   {  //
+      // g: all the steps
+      CppAD::Independent(ax, ap);
+      ad_vector az = ax;
+      for(size_t k = 0; k < n_step; ++k)
+      {  step(az, ap, ay);
+         az = ay;
+      }
+      CppAD::ADFun<double> g(ax, az);
+      g.new_dynamic(p);
+      d_vector y_check  = g.Forward(0, x);
+      d_vector dw_check = g.Reverse(1, w);
+      //
+      for(size_t n_store = 0; n_store <= 5; ++n_store)
+      {  size_t n_forward = f.checkpoint_reverse(
+            n_step, n_store, x, w, y, dw
+         );
+         for(size_t i = 0; i < n; ++i)
+         {  ok &= CppAD::NearEqual(y[i], y_check[i], eps99, eps99);
+            ok &= CppAD::NearEqual(dw[i], dw_check[i], eps99, eps99);
+         }
+         if( n_store == 0 )
+            ok &= n_forward == n_step * (n_step - 1) / 2;
+         else
+         {  size_t t = 0;
+            while( beta(n_store, t) < n_step )
+               ++t;
+            ok &= n_forward <= t * n_step;
+         }
+      }
+   }
+   // all the steps but one can be stored
+   size_t n_step = 10;
+   size_t n_forward = f.checkpoint_reverse(n_step, n_step - 1, x, w, y, dw);
+   ok &= n_forward == n_step - 1;
+   //
+   return ok;
+}
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that the cppad.parallel coloring methods give the same derivative
+values as the cppad coloring methods for sparse_jac and sparse_hes.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(size_t)                   s_vector;
+   typedef CPPAD_TESTVECTOR(bool)                     b_vector;
+   typedef CPPAD_TESTVECTOR(double)                   d_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>)               ad_vector;
+   typedef CppAD::sparse_rc<s_vector>                 sparsity;
+   typedef CppAD::sparse_rcv<s_vector, d_vector>      sparse_matrix;
+   //
+   const char* parallel_coloring[] = {
+      "cppad.parallel",
+      "cppad.parallel.largest_first",
+      "cppad.parallel.smallest_last",
+      "cppad.parallel.incidence_degree"
+   };
+   const size_t n_parallel_coloring = 4;
+   // -----------------------------------------------------------------------
+   bool same_value(const sparse_matrix& subset1, const sparse_matrix& subset2)
+   {  bool ok = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      ok &= subset1.nnz() == subset2.nnz();
+      for(size_t k = 0; k < subset1.nnz(); ++k)
+      {  double v1 = subset1.val()[k];
+         double v2 = subset2.val()[k];
+         ok &= CppAD::NearEqual(v1, v2, eps99, eps99);
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // check sparse_jac_for and sparse_jac_rev
+   bool check_jac(CppAD::ADFun<double>& f, const d_vector& x, size_t max_color)
+   {  bool ok = true;
+      size_t n = f.Domain();
+      //
+      // pattern
+      sparsity pattern_in(n, n, n);
+      for(size_t j = 0; j < n; ++j)
+         pattern_in.set(j, j, j);
+      bool transpose     = false;
+      bool dependency    = false;
+      bool internal_bool = false;
+      sparsity pattern;
+      f.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern
+      );
+      //
+      // subset: every other element of the sparsity pattern
+      s_vector row_major = pattern.row_major();
+      size_t nnz = (pattern.nnz() + 1) / 2;
+      sparsity subset_pattern(pattern.nr(), pattern.nc(), nnz);
+      for(size_t k = 0; k < nnz; ++k)
+      {  size_t ell = row_major[2 * k];
+         subset_pattern.set(k, pattern.row()[ell], pattern.col()[ell]);
+      }
+      //
+      // cppad coloring
+      size_t group_max = 1;
+      sparse_matrix for_check(subset_pattern), rev_check(subset_pattern);
+      CppAD::sparse_jac_work work;
+      f.sparse_jac_for(group_max, x, for_check, pattern, "cppad", work);
+      work.clear();
+      f.sparse_jac_rev(x, rev_check, pattern, "cppad", work);
+      //
+      for(size_t i_color = 0; i_color < n_parallel_coloring; ++i_color)
+      {  std::string coloring = parallel_coloring[i_color];
+         for(size_t n_thread = 1; n_thread <= 4; n_thread += 3)
+         {  sparse_matrix subset(subset_pattern);
+            //
+            work.clear();
+            size_t n_color = f.sparse_jac_for(
+               group_max, x, subset, pattern, coloring, work, n_thread
+            );
+            ok &= same_value(subset, for_check);
+            ok &= n_color <= max_color;
+            //
+            work.clear();
+            n_color = f.sparse_jac_rev(
+               x, subset, pattern, coloring, work, n_thread
+            );
+            ok &= same_value(subset, rev_check);
+            ok &= n_color <= max_color;
+         }
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // check sparse_hes
+   bool check_hes(CppAD::ADFun<double>& f, const d_vector& x, size_t max_color)
+   {  bool ok = true;
+      size_t n = f.Domain();
+      size_t m = f.Range();
+      //
+      // w
+      d_vector w(m);
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      //
+      // pattern
+      sparsity pattern_in(n, n, n);
+      for(size_t j = 0; j < n; ++j)
+         pattern_in.set(j, j, j);
+      bool transpose     = false;
+      bool dependency    = false;
+      bool internal_bool = false;
+      f.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_in
+      );
+      b_vector select_range(m);
+      for(size_t i = 0; i < m; ++i)
+         select_range[i] = true;
+      sparsity pattern;
+      f.rev_hes_sparsity(select_range, transpose, internal_bool, pattern);
+      //
+      // cppad coloring
+      sparse_matrix check(pattern);
+      CppAD::sparse_hes_work work;
+      f.sparse_hes(x, w, check, pattern, "cppad.symmetric", work);
+      //
+      for(size_t i_color = 0; i_color < n_parallel_coloring; ++i_color)
+      {  std::string coloring = parallel_coloring[i_color];
+         for(size_t n_thread = 1; n_thread <= 4; n_thread += 3)
+         {  sparse_matrix subset(pattern);
+            work.clear();
+            size_t n_sweep = f.sparse_hes(
+               x, w, subset, pattern, coloring, work, n_thread
+            );
+            ok &= same_value(subset, check);
+            ok &= n_sweep <= max_color;
+         }
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // y_i = x_{i-1} * x_i * x_{i+1}; i.e., a tridiagonal Jacobian
+   bool tridiagonal(void)
+   {  bool ok = true;
+      size_t n = 300;
+      ad_vector ax(n), ay(n);
+      d_vector  x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j + 1) / double(n);
+      CppAD::Independent(ax);
+      for(size_t i = 0; i < n; ++i)
+      {  ay[i] = ax[i];
+         if( 0 < i )
+            ay[i] *= ax[i-1];
+         if( i + 1 < n )
+            ay[i] *= ax[i+1];
+      }
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // each row (column) has at most 4 neighbors for the Jacobian
+      // and at most 12 neighbors for the Hessian (pentadiagonal).
+      ok &= check_jac(f, x, 5);
+      ok &= check_hes(f, x, 13);
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // an irregular sparsity pattern
+   bool irregular(void)
+   {  bool ok = true;
+      size_t n = 200, m = 150;
+      ad_vector ax(n), ay(m);
+      d_vector  x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j + 1) / double(n);
+      CppAD::Independent(ax);
+      for(size_t i = 0; i < m; ++i)
+      {  size_t j0 = (7 * i) % n;
+         size_t j1 = (13 * i + 5) % n;
+         size_t j2 = (i * i) % n;
+         ay[i] = sin( ax[j0] ) * ax[j1] + exp( ax[j2] ) * ax[j0];
+      }
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      ok &= check_jac(f, x, n);
+      ok &= check_hes(f, x, n);
+      return ok;
+   }
+}
+
+bool color_parallel(void)
+{  bool ok = true;
+   ok &= tridiagonal();
+   ok &= irregular();
+   return ok;
+}
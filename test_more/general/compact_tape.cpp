@@ -0,0 +1,449 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check the compact encoding for the binary tape format, and for storing
+the operation sequence in memory, using operators
+that have a variable number of arguments (CSumOp and CSkipOp),
+VecAD operators, atomic functions,
+and enough variables so that some arguments require more than one byte.
+*/
+# include <cppad/cppad.hpp>
+# include <sstream>
+
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(double)      d_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>) ad_vector;
+   // -----------------------------------------------------------------------
+   // write f to a binary stream and return the number of bytes written
+   size_t write(
+      const CppAD::ADFun<double>& f, bool compact, std::stringstream& ss)
+   {  f.to_binary(ss, compact);
+      return size_t( ss.tellp() );
+   }
+   // -----------------------------------------------------------------------
+   bool check_round_trip(void)
+   {  bool ok = true;
+      //
+      // f(x; p)
+      size_t n = 3, m = 4, n_sum = 300;
+      ad_vector ax(n), ap(1), ay(m);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1);
+      ap[0] = 2.0;
+      CppAD::Independent(ax, ap);
+      //
+      // a long cumulative summation with variables far from their use
+      ad_vector au(n_sum);
+      for(size_t k = 0; k < n_sum; ++k)
+         au[k] = ax[k % n] * double(k + 1);
+      AD<double> asum = 0.0;
+      for(size_t k = 0; k < n_sum; ++k)
+         asum += au[n_sum - k - 1] - ap[0];
+      ay[0] = asum;
+      //
+      // conditional expressions that lead to conditional skip operators
+      AD<double> aleft  = sin( ax[0] ) + ax[1];
+      AD<double> aright = cos( ax[1] ) * ax[2];
+      ay[1] = CondExpLt(ax[0], ax[1], aleft, aright);
+      //
+      // VecAD operators
+      CppAD::VecAD<double> av(2);
+      av[ AD<double>(0) ] = ax[1];
+      av[ AD<double>(1) ] = ax[1] * ax[2];
+      ay[2] = av[ ax[0] - 1.0 ];
+      //
+      // a constant parameter
+      ay[3] = 5.0;
+      //
+      CppAD::ADFun<double> f(ax, ay);
+      f.optimize();
+      //
+      // write using both encodings
+      std::stringstream ss_full(
+         std::ios::in | std::ios::out | std::ios::binary
+      );
+      std::stringstream ss_compact(
+         std::ios::in | std::ios::out | std::ios::binary
+      );
+      size_t n_full    = write(f, false, ss_full);
+      size_t n_compact = write(f, true,  ss_compact);
+      ok &= n_compact < n_full;
+      //
+      // read back both encodings
+      CppAD::ADFun<double> g_full, g_compact;
+      g_full.from_binary(ss_full);
+      g_compact.from_binary(ss_compact);
+      ok &= g_compact.size_op()     == f.size_op();
+      ok &= g_compact.size_op_arg() == f.size_op_arg();
+      ok &= g_compact.size_var()    == f.size_var();
+      ok &= g_compact.size_par()    == f.size_par();
+      //
+      // writing the compact result gives the same bytes
+      std::stringstream ss_check(
+         std::ios::in | std::ios::out | std::ios::binary
+      );
+      write(g_compact, true, ss_check);
+      ok &= ss_check.str() == ss_compact.str();
+      //
+      // writing using the compact storage in memory gives the same bytes
+      g_compact.compact_tape(true);
+      for(size_t compact = 0; compact < 2; ++compact)
+      {  std::stringstream ss_storage(
+            std::ios::in | std::ios::out | std::ios::binary
+         );
+         write(g_compact, compact != 0, ss_storage);
+         if( compact )
+            ok &= ss_storage.str() == ss_compact.str();
+         else
+            ok &= ss_storage.str() == ss_full.str();
+      }
+      g_compact.compact_tape(false);
+      //
+      // check forward and reverse on both sides of the conditional
+      d_vector p(1), x(n), y_f(m), y_g(m), w(m), dw_f(n), dw_g(n);
+      p[0] = 3.0;
+      f.new_dynamic(p);
+      g_compact.new_dynamic(p);
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      for(size_t icase = 0; icase < 2; ++icase)
+      {  x[0] = 1.0 + double(icase);
+         x[1] = 1.5;
+         x[2] = 0.5;
+         y_f  = f.Forward(0, x);
+         y_g  = g_compact.Forward(0, x);
+         for(size_t i = 0; i < m; ++i)
+            ok &= y_f[i] == y_g[i];
+         dw_f = f.Reverse(1, w);
+         dw_g = g_compact.Reverse(1, w);
+         for(size_t j = 0; j < n; ++j)
+            ok &= dw_f[j] == dw_g[j];
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // zero order forward using the compact storage in memory
+   bool check_storage(void)
+   {  bool ok = true;
+      //
+      // atom_sum: an atomic function
+      CppAD::vector< AD<double> > aw(2);
+      aw[0] = 1.0;
+      aw[1] = 2.0;
+      CppAD::Independent(aw);
+      CppAD::vector< AD<double> > az(1);
+      az[0] = aw[0] + 2.0 * aw[1];
+      CppAD::ADFun<double> h(aw, az);
+      bool internal_bool    = false;
+      bool use_hes_sparsity = false;
+      bool use_base2ad      = true;
+      bool use_in_parallel  = false;
+      CppAD::chkpoint_two<double> atom_sum(h, "atom_sum",
+         internal_bool, use_hes_sparsity, use_base2ad, use_in_parallel
+      );
+      //
+      // f(x; p)
+      size_t n = 3, m = 5, n_sum = 300;
+      ad_vector ax(n), ap(1), ay(m);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1);
+      ap[0] = 2.0;
+      CppAD::Independent(ax, ap);
+      //
+      // a long cumulative summation with variables far from their use
+      // (few parameters so most of the operation sequence is operators
+      // and arguments)
+      ad_vector au(n_sum);
+      au[0] = ax[0];
+      for(size_t k = 1; k < n_sum; ++k)
+         au[k] = au[k-1] * ax[k % n];
+      AD<double> asum = 0.0;
+      for(size_t k = 0; k < n_sum; ++k)
+         asum += au[n_sum - k - 1] - ap[0];
+      ay[0] = asum;
+      //
+      // conditional expressions that lead to conditional skip operators
+      AD<double> aleft  = sin( ax[0] ) + ax[1];
+      AD<double> aright = cos( ax[1] ) * ax[2];
+      ay[1] = CondExpLt(ax[0], ax[1], aleft, aright);
+      //
+      // VecAD operators
+      CppAD::VecAD<double> av(2);
+      av[ AD<double>(0) ] = ax[1];
+      av[ AD<double>(1) ] = ax[1] * ax[2];
+      ay[2] = av[ ax[0] - 1.0 ];
+      //
+      // atomic function with a variable and a dynamic parameter argument
+      CppAD::vector< AD<double> > aw_x(2), az_x(1);
+      aw_x[0] = au[0];
+      aw_x[1] = ap[0];
+      atom_sum(aw_x, az_x);
+      ay[3] = az_x[0];
+      //
+      // a comparison operator
+      ay[4] = 1.0;
+      if( ax[2] < ax[0] + ax[1] )
+         ay[4] = ax[2];
+      //
+      CppAD::ADFun<double> f(ax, ay);
+      f.optimize();
+      size_t size_normal = f.size_op_seq();
+      //
+      // g: a copy of f that uses the compact storage (f is not affected)
+      CppAD::ADFun<double> g;
+      g = f;
+      g.compact_tape(true);
+      ok &= g.compact_tape();
+      ok &= ! f.compact_tape();
+      ok &= f.size_op_seq() == size_normal;
+      ok &= 2 * g.size_op_seq() < size_normal;
+      ok &= g.size_op()     == f.size_op();
+      ok &= g.size_op_arg() == f.size_op_arg();
+      //
+      // ag: a copy of g that uses the compact storage
+      CppAD::ADFun< AD<double>, double > ag = g.base2ad();
+      ok &= ag.compact_tape();
+      //
+      // check zero order forward on both sides of the conditional
+      // and the comparison
+      d_vector p(1), x(n), y_f(m), y_g(m);
+      for(size_t icase = 0; icase < 2; ++icase)
+      {  p[0] = 3.0 + double(icase);
+         f.new_dynamic(p);
+         g.new_dynamic(p);
+         x[0] = 1.0 + double(icase);
+         x[1] = 1.5;
+         x[2] = 5.0 - 4.5 * double(icase);
+         y_f  = f.Forward(0, x);
+         y_g  = g.Forward(0, x);
+         for(size_t i = 0; i < m; ++i)
+            ok &= y_f[i] == y_g[i];
+         ok &= f.compare_change_number() == g.compare_change_number();
+         ok &= g.compare_change_number() == icase;
+         //
+         // ag does not use the dynamic parameter values from g
+         ad_vector aap(1), aax(n), aay(m);
+         aap[0] = p[0];
+         for(size_t j = 0; j < n; ++j)
+            aax[j] = x[j];
+         ag.new_dynamic(aap);
+         aay = ag.Forward(0, aax);
+         for(size_t i = 0; i < m; ++i)
+            ok &= Value( aay[i] ) == y_f[i];
+      }
+      //
+      // change back to normal storage and check first order derivatives
+      g.compact_tape(false);
+      ok &= ! g.compact_tape();
+      ok &= g.size_op_seq() == size_normal;
+      d_vector w(m), dw_f(n), dw_g(n);
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      y_f  = f.Forward(0, x);
+      dw_f = f.Reverse(1, w);
+      dw_g = g.Reverse(1, w);
+      for(size_t j = 0; j < n; ++j)
+         ok &= dw_f[j] == dw_g[j];
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // y_0 = x_0 + call_id
+   class atomic_call_id : public CppAD::atomic_four<double> {
+   public:
+      atomic_call_id(void) : CppAD::atomic_four<double>("atomic_call_id")
+      { }
+   private:
+      bool for_type(
+         size_t                                     call_id     ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         CppAD::vector<CppAD::ad_type_enum>&        type_y      ) override
+      {  type_y[0] = type_x[0];
+         return true;
+      }
+      bool forward(
+         size_t                                     call_id     ,
+         const CppAD::vector<bool>&                 select_y    ,
+         size_t                                     order_low   ,
+         size_t                                     order_up    ,
+         const CppAD::vector<double>&               tx          ,
+         CppAD::vector<double>&                     ty          ) override
+      {  if( order_up > 0 )
+            return false;
+         ty[0] = tx[0] + double(call_id);
+         return true;
+      }
+   };
+   // an atomic function call_id is not bounded by the size of the tape
+   bool check_call_id(void)
+   {  bool ok = true;
+      atomic_call_id afun;
+      size_t call_id = 1000000;
+      //
+      ad_vector ax(1), ay(1), au(1), av(1);
+      ax[0] = 1.0;
+      CppAD::Independent(ax);
+      au[0] = ax[0];
+      afun(call_id, au, av);
+      ay[0] = av[0] * ax[0];
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      d_vector x(1), y(1);
+      x[0] = 2.0;
+      double check = x[0] * ( x[0] + double(call_id) );
+      f.compact_tape(true);
+      y   = f.Forward(0, x);
+      ok &= y[0] == check;
+      f.compact_tape(false);
+      y   = f.Forward(0, x);
+      ok &= y[0] == check;
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // errors detected while decoding are reported by the error handler
+   // (unknown errors are internal errors and not reported by from_binary)
+   bool unknown_error = false;
+   void error_handler(
+      bool known       ,
+      int  line        ,
+      const char *file ,
+      const char *exp  ,
+      const char *msg  )
+   {  if( ! known )
+         unknown_error = true;
+      throw std::string( msg );
+   }
+   //
+   bool check_truncated(void)
+   {  bool ok = true;
+      //
+      ad_vector ax(2), ay(1);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      CppAD::Independent(ax);
+      ay[0] = ax[0] * ax[1] + exp( ax[0] );
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      std::stringstream ss(
+         std::ios::in | std::ios::out | std::ios::binary
+      );
+      f.to_binary(ss, true);
+      std::string bytes = ss.str();
+      //
+      // remove the end of the file
+      std::stringstream ss_truncated(
+         bytes.substr(0, bytes.size() - 16),
+         std::ios::in | std::ios::binary
+      );
+      CppAD::ErrorHandler local_handler(error_handler);
+      CppAD::ADFun<double> g;
+      try
+      {  g.from_binary(ss_truncated);
+         ok = false;
+      }
+      catch(const std::string& msg)
+      {  ok &= msg.find("f.from_binary(is)") != std::string::npos;
+      }
+      ok &= g.size_var() == 0;
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // Change each four byte word in a binary tape. Either from_binary
+   // reports an error or the result can be evaluated without accessing
+   // memory outside of its vectors (checked by the sweeps in debug mode).
+   bool check_corrupt(void)
+   {  bool ok = true;
+      //
+      // f(x; p)
+      size_t n = 3, m = 3;
+      ad_vector ax(n), ap(1), ay(m);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1);
+      ap[0] = 2.0;
+      CppAD::Independent(ax, ap);
+      AD<double> asum = ap[0];
+      for(size_t j = 0; j < n; ++j)
+         asum += ax[j] - exp( ap[0] );
+      ay[0] = asum;
+      ay[1] = CondExpLt(ax[0], ax[1], sin( ax[0] ), cos( ax[2] ) );
+      CppAD::VecAD<double> av(2);
+      av[ AD<double>(0) ] = ax[1];
+      av[ AD<double>(1) ] = ax[1] * ax[2];
+      ay[2] = av[ ax[0] - 1.0 ];
+      CppAD::ADFun<double> f(ax, ay);
+      f.optimize();
+      //
+      CppAD::ErrorHandler local_handler(error_handler);
+      d_vector x(n), dx(n), w(m), y(m), dw(n);
+      for(size_t j = 0; j < n; ++j)
+      {  x[j]  = double(j) / 2.0;
+         dx[j] = 1.0;
+      }
+      for(size_t i = 0; i < m; ++i)
+         w[i] = 1.0;
+      for(size_t compact = 0; compact < 2; ++compact)
+      {  std::stringstream ss(
+            std::ios::in | std::ios::out | std::ios::binary
+         );
+         f.to_binary(ss, compact != 0);
+         std::string bytes = ss.str();
+         //
+         // start after the magic string
+         size_t n_error = 0;
+         for(size_t i_byte = 8; i_byte + 4 <= bytes.size(); i_byte += 4)
+         {  for(size_t i_case = 0; i_case < 2; ++i_case)
+            {  std::string corrupt = bytes;
+               for(size_t k = 0; k < 4; ++k)
+               {  if( i_case == 0 )
+                     corrupt[i_byte + k] = char(0xff);
+                  else
+                     corrupt[i_byte + k] = char( corrupt[i_byte + k] + 1 );
+               }
+               std::stringstream ss_corrupt(
+                  corrupt, std::ios::in | std::ios::binary
+               );
+               CppAD::ADFun<double> g;
+               try
+               {  g.from_binary(ss_corrupt);
+               }
+               catch(const std::string& msg)
+               {  ok &= msg.find("f.from_binary(is)") != std::string::npos;
+                  ok &= g.size_var() == 0;
+                  ++n_error;
+                  continue;
+               }
+               ok &= g.Domain() == n && g.Range() == m;
+# ifndef NDEBUG
+               // a changed parameter value can result in a known error;
+               // e.g., a VecAD index that is out of range or a nan.
+               // These values are only checked when NDEBUG is not defined.
+               try
+               {  y  = g.Forward(0, x);
+                  y  = g.Forward(1, dx);
+                  dw = g.Reverse(1, w);
+               }
+               catch(const std::string& msg)
+               { }
+# endif
+            }
+         }
+         // most of the changes are detected
+         ok &= 2 * n_error > bytes.size() / 4;
+      }
+      ok &= ! unknown_error;
+      return ok;
+   }
+}
+
+bool compact_tape(void)
+{  bool ok = true;
+   ok &= check_round_trip();
+   ok &= check_storage();
+   ok &= check_call_id();
+   ok &= check_truncated();
+   ok &= check_corrupt();
+   return ok;
+}
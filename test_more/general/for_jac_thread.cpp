@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that for_jac_sparsity with more than one thread gives the same results
+as with one thread, including the patterns stored for rev_hes_sparsity.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(size_t)      s_vector;
+   typedef CPPAD_TESTVECTOR(bool)        b_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>) ad_vector;
+   typedef CppAD::sparse_rc<s_vector>    sparsity;
+   // -----------------------------------------------------------------------
+   bool same_pattern(const sparsity& pattern1, const sparsity& pattern2)
+   {  bool ok = true;
+      ok &= pattern1.nr()  == pattern2.nr();
+      ok &= pattern1.nc()  == pattern2.nc();
+      ok &= pattern1.nnz() == pattern2.nnz();
+      if( ! ok )
+         return ok;
+      s_vector order1 = pattern1.row_major();
+      s_vector order2 = pattern2.row_major();
+      for(size_t k = 0; k < pattern1.nnz(); ++k)
+      {  ok &= pattern1.row()[ order1[k] ] == pattern2.row()[ order2[k] ];
+         ok &= pattern1.col()[ order1[k] ] == pattern2.col()[ order2[k] ];
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // compare for_jac_sparsity for n_thread = 1 and for n_thread > 1
+   bool check_thread(CppAD::ADFun<double>& f, const sparsity& pattern_in)
+   {  bool ok = true;
+      bool internal_bool = true;
+      size_t m = f.Range();
+      //
+      b_vector select_range(m);
+      for(size_t i = 0; i < m; ++i)
+         select_range[i] = true;
+      //
+      for(size_t icase = 0; icase < 4; ++icase)
+      {  bool transpose  = icase % 2 == 1;
+         bool dependency = icase / 2 == 1;
+         sparsity pattern_t = pattern_in;
+         if( transpose )
+         {  s_vector col_major = pattern_in.col_major();
+            pattern_t.resize(
+               pattern_in.nc(), pattern_in.nr(), pattern_in.nnz()
+            );
+            for(size_t k = 0; k < pattern_in.nnz(); ++k)
+            {  size_t r = pattern_in.row()[ col_major[k] ];
+               size_t c = pattern_in.col()[ col_major[k] ];
+               pattern_t.set(k, c, r);
+            }
+         }
+         //
+         // one thread
+         sparsity jac1, hes1;
+         f.for_jac_sparsity(
+            pattern_t, transpose, dependency, internal_bool, jac1
+         );
+         f.rev_hes_sparsity(select_range, transpose, internal_bool, hes1);
+         //
+         // several threads
+         for(size_t n_thread = 2; n_thread <= 5; n_thread += 3)
+         {  sparsity jac2, hes2;
+            f.for_jac_sparsity(
+               pattern_t, transpose, dependency, internal_bool, jac2, n_thread
+            );
+            f.rev_hes_sparsity(
+               select_range, transpose, internal_bool, hes2
+            );
+            ok &= same_pattern(jac1, jac2);
+            ok &= same_pattern(hes1, hes2);
+         }
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool thread_operators(void)
+   {  bool ok = true;
+      //
+      // n: more than four Pack values per set
+      size_t n = 300, m = 100;
+      ad_vector ax(n), ay(m);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1) / double(n);
+      CppAD::Independent(ax);
+      for(size_t i = 0; i < m; ++i)
+      {  size_t j0 = (7 * i) % n;
+         size_t j1 = (13 * i + 5) % n;
+         size_t j2 = (i + 200) % n;
+         ay[i]  = pow(ax[j0], 2.0) * sin( ax[j1] );
+         ay[i] += CppAD::CondExpLt(ax[j0], ax[j1], exp(ax[j2]), ax[j0]);
+         ay[i] += ax[j2] + ax[j0] - ax[j1] + ax[i];
+      }
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // pattern_in: identity matrix
+      sparsity pattern_in(n, n, n);
+      for(size_t j = 0; j < n; ++j)
+         pattern_in.set(j, j, j);
+      ok &= check_thread(f, pattern_in);
+      //
+      // pattern_in: number of columns is not a multiple of the Pack size
+      size_t ell = 150;
+      pattern_in.resize(n, ell, n);
+      for(size_t j = 0; j < n; ++j)
+         pattern_in.set(j, j, j % ell);
+      ok &= check_thread(f, pattern_in);
+      //
+      // optimized version has conditional skip and cumulative sum operators
+      f.optimize();
+      ok &= check_thread(f, pattern_in);
+      //
+      return ok;
+   }
+}
+
+bool for_jac_thread(void)
+{  bool ok = true;
+   ok &= thread_operators();
+   return ok;
+}
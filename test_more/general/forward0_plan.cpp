@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that zero order forward using the pre-decoded plan gives the same
+results as the general zero order forward sweep.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   // -----------------------------------------------------------------------
+   // f(x) uses operators that have a handler in the plan
+   template <class Vector>
+   Vector fun(const Vector& x)
+   {  using std::sin;  using std::cos;  using std::exp;  using std::sqrt;
+      using std::pow;  using std::tanh; using std::atan; using std::fabs;
+      Vector y(6);
+      y[0] = x[0] * x[1] + sin( x[0] ) - exp( x[1] ) / x[2];
+      y[1] = CppAD::CondExpLt(x[0], x[1], cos(x[2]), sqrt(x[2]) );
+      y[2] = pow(x[0], x[2]) + pow(x[1], 2.0) + pow(2.0, x[0]);
+      y[3] = tanh( x[1] ) - atan( x[0] ) + fabs( x[2] - 5.0 );
+      y[4] = 3.0;
+      y[5] = CppAD::azmul(x[0], x[1]) + x[0] + x[1] + x[2];
+      return y;
+   }
+   // -----------------------------------------------------------------------
+   // check that Forward(0, x) agrees with fun(x)
+   bool check_values(
+      CppAD::ADFun<double>& f, const CPPAD_TESTVECTOR(double)& x )
+   {  bool ok  = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      CPPAD_TESTVECTOR(double) y     = f.Forward(0, x);
+      CPPAD_TESTVECTOR(double) check = fun(x);
+      for(size_t i = 0; i < size_t( y.size() ); ++i)
+         ok &= CppAD::NearEqual(y[i], check[i], eps99, eps99);
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool plan_values(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      size_t n = 3;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n);
+      CPPAD_TESTVECTOR(double)        x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j + 1) / 2.0;
+      CppAD::Independent(ax);
+      CPPAD_TESTVECTOR( AD<double> ) ay = fun(ax);
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // first call builds the plan, second call uses it
+      ok &= check_values(f, x);
+      x[0] = 2.0;
+      ok &= check_values(f, x);
+      //
+      // optimized recording contains cumulative summation operators
+      // (conditional skip operators are not used by the plan)
+      f.optimize("no_conditional_skip");
+      x[1] = 0.25;
+      ok &= check_values(f, x);
+      x[1] = 3.0;
+      ok &= check_values(f, x);
+      //
+      // a copy of f uses the plan for f
+      CppAD::ADFun<double> g;
+      g = f;
+      x[2] = 4.0;
+      ok &= check_values(g, x);
+      //
+      // first order forward after the plan is used
+      CPPAD_TESTVECTOR(double) dx(n), dy;
+      for(size_t j = 0; j < n; ++j)
+         dx[j] = 0.0;
+      dx[1] = 1.0;
+      dy = g.Forward(1, dx);
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      ok &= CppAD::NearEqual(dy[4], 0.0, eps99, eps99);
+      ok &= CppAD::NearEqual(dy[5], 1.0 + x[0], eps99, eps99);
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool plan_compare(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      size_t n = 2;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(1);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      CppAD::Independent(ax);
+      AD<double> two = 2.0, three = 3.0;
+      if( ax[0] < ax[1] )
+         ay[0] = ax[0];
+      else
+         ay[0] = ax[1];
+      if( ax[0] <= 1.5 )
+         ay[0] += 1.0;
+      if( ax[1] == 2.0 )
+         ay[0] += 1.0;
+      if( two < three )
+         ay[0] += 1.0;
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // no comparison changes
+      CPPAD_TESTVECTOR(double) x(n), y(1);
+      x[0] = 0.5;
+      x[1] = 2.0;
+      y    = f.Forward(0, x);
+      ok  &= f.compare_change_number() == 0;
+      ok  &= f.compare_change_op_index() == 0;
+      ok  &= y[0] == 0.5 + 3.0;
+      //
+      // all three variable comparisons change
+      x[0] = 5.0;
+      x[1] = 4.0;
+      size_t op_index[3];
+      for(size_t count = 1; count <= 3; ++count)
+      {  f.compare_change_count(count);
+         y    = f.Forward(0, x);
+         ok  &= f.compare_change_number() == 3;
+         op_index[count - 1] = f.compare_change_op_index();
+      }
+      ok &= 0 < op_index[0];
+      ok &= op_index[0] < op_index[1];
+      ok &= op_index[1] < op_index[2];
+      ok &= op_index[2] < f.size_op();
+      //
+      // a copy of f gives the same result
+      CppAD::ADFun<double> g;
+      g = f;
+      g.compare_change_count(2);
+      y    = g.Forward(0, x);
+      ok  &= g.compare_change_number() == 3;
+      ok  &= g.compare_change_op_index() == op_index[1];
+      //
+      // do not count comparisons
+      f.compare_change_count(0);
+      y    = f.Forward(0, x);
+      ok  &= f.compare_change_number() == 0;
+      ok  &= f.compare_change_op_index() == 0;
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // recording that contains operators without a handler in the plan
+   bool plan_not_usable(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      size_t n = 2;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(2);
+      ax[0] = 0.0;
+      ax[1] = 1.0;
+      CppAD::Independent(ax);
+      CppAD::VecAD<double> av(2);
+      AD<double> zero = 0.0, one = 1.0;
+      av[zero] = ax[0];
+      av[one]  = ax[1];
+      ay[0] = av[ ax[0] ] * 2.0;
+      ay[1] = ax[0] + ax[1];
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      CPPAD_TESTVECTOR(double) x(n), y(2);
+      x[0] = 1.0;
+      x[1] = 3.0;
+      y    = f.Forward(0, x);
+      ok  &= y[0] == 6.0;
+      ok  &= y[1] == 4.0;
+      //
+      return ok;
+   }
+}
+
+bool forward0_plan(void)
+{  bool ok = true;
+   ok &= plan_values();
+   ok &= plan_compare();
+   ok &= plan_not_usable();
+   return ok;
+}
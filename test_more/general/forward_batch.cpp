@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that forward_batch gives the same results as Forward(0, x)
+at each of the points.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   double my_floor(const double& x)
+   {  return std::floor(x); }
+   CPPAD_DISCRETE_FUNCTION(double, my_floor)
+   // -----------------------------------------------------------------------
+   bool check_batch(
+      CppAD::ADFun<double>& f, size_t n_point, size_t n, size_t m)
+   {  bool ok = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      //
+      CPPAD_TESTVECTOR(double) x(n * n_point), y;
+      for(size_t j = 0; j < n; ++j)
+         for(size_t k = 0; k < n_point; ++k)
+            x[j * n_point + k] = double(j + 1) + double(k) / 3.0;
+      f.forward_batch(n_point, x, y);
+      ok &= size_t( y.size() ) == m * n_point;
+      //
+      CPPAD_TESTVECTOR(double) xk(n), yk(m);
+      for(size_t k = 0; k < n_point; ++k)
+      {  for(size_t j = 0; j < n; ++j)
+            xk[j] = x[j * n_point + k];
+         yk = f.Forward(0, xk);
+         for(size_t i = 0; i < m; ++i)
+            ok &= CppAD::NearEqual(yk[i], y[i * n_point + k], eps99, eps99);
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool batch_vecad(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      size_t n = 2, m = 3;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      CppAD::Independent(ax);
+      CppAD::VecAD<double> av(3);
+      AD<double> zero = 0.0, one = 1.0, two = 2.0;
+      av[zero] = ax[0];
+      av[one]  = 5.0;
+      av[two]  = ax[1] * ax[1];
+      // index depends on the point
+      AD<double> index = my_floor( ax[0] ) - 1.0;
+      ay[0] = av[index];
+      ay[1] = av[one] * ax[1];
+      av[zero] = ax[1];
+      ay[2] = av[zero] + av[two];
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // my_floor(x[0]) - 1 is 0, 1, and 2 at the first 9 points
+      ok &= check_batch(f, 9, n, m);
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool batch_optimize(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      size_t n = 3, m = 2;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j);
+      CppAD::Independent(ax);
+      AD<double> sum = ax[0] + ax[1] - ax[2] + 4.0;
+      ay[0] = CppAD::CondExpLt(ax[0], ax[2], log(sum), cos(sum) );
+      ay[1] = erf( ax[1] ) + pow(ax[0], ax[1]) + CppAD::azmul(ax[0], ax[2]);
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // contains conditional skip and cumulative summation operators
+      f.optimize();
+      ok &= check_batch(f, 7, n, m);
+      //
+      // more points than are evaluated during one sweep
+      ok &= check_batch(f, 150, n, m);
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool batch_atomic(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // g(u) = [ u_0 * u_1 , sin(u_0) ]
+      CPPAD_TESTVECTOR( AD<double> ) au(2), av(2);
+      au[0] = 1.0;
+      au[1] = 2.0;
+      CppAD::Independent(au);
+      av[0] = au[0] * au[1];
+      av[1] = sin( au[0] );
+      CppAD::ADFun<double> g(au, av);
+      bool internal_bool    = false;
+      bool use_hes_sparsity = false;
+      bool use_base2ad      = false;
+      bool use_in_parallel  = false;
+      CppAD::chkpoint_two<double> chk_g(g, "g",
+         internal_bool, use_hes_sparsity, use_base2ad, use_in_parallel
+      );
+      //
+      // f(x) = g( x_0, 3 ) + x_1
+      size_t n = 2, m = 2;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      CppAD::Independent(ax);
+      au[0] = ax[0];
+      au[1] = 3.0;
+      chk_g(au, av);
+      ay[0] = av[0] + ax[1];
+      ay[1] = av[1] + ax[1];
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      ok &= check_batch(f, 5, n, m);
+      return ok;
+   }
+}
+
+bool forward_batch(void)
+{  bool ok = true;
+   ok &= batch_vecad();
+   ok &= batch_optimize();
+   ok &= batch_atomic();
+   return ok;
+}
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that forward_level gives the same results as Forward(0, x).
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   // -----------------------------------------------------------------------
+   // residuals for one block of the arguments
+   template <class Vector>
+   void residual(size_t k, const Vector& x, Vector& y)
+   {  typedef typename Vector::value_type Scalar;
+      using std::sin;  using std::exp;  using std::pow;
+      using std::tanh; using std::erf;  using std::log;
+      const Scalar& x0 = x[3 * k + 0];
+      const Scalar& x1 = x[3 * k + 1];
+      const Scalar& x2 = x[3 * k + 2];
+      y[3 * k + 0] = x0 * x1 + sin( x0 ) - exp( x1 ) / x2;
+      y[3 * k + 1] = CppAD::CondExpLt(x0, x1, pow(x0, x2), tanh(x2) );
+      y[3 * k + 2] = erf( x1 ) + CppAD::azmul(x0, x2) + log( x0 + x1 + x2 );
+   }
+   // -----------------------------------------------------------------------
+   // check that forward_level agrees with Forward(0, x)
+   bool check_level(
+      CppAD::ADFun<double>& f, const CPPAD_TESTVECTOR(double)& x )
+   {  bool ok = true;
+      size_t m = f.Range();
+      CPPAD_TESTVECTOR(double) check = f.Forward(0, x);
+      size_t number   = f.compare_change_number();
+      size_t op_index = f.compare_change_op_index();
+      //
+      size_t thread_list[] = {1, 2, 3, 8};
+      for(size_t i_list = 0; i_list < 4; ++i_list)
+      {  size_t n_thread = thread_list[i_list];
+         CPPAD_TESTVECTOR(double) y = f.forward_level(n_thread, x);
+         for(size_t i = 0; i < m; ++i)
+            ok &= y[i] == check[i];
+         ok &= f.size_order() == 1;
+         ok &= f.compare_change_number()   == number;
+         ok &= f.compare_change_op_index() == op_index;
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool level_wide(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      size_t n_block = 1000;
+      size_t n       = 3 * n_block;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+      CPPAD_TESTVECTOR(double)        x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j % 7 + 1) / 3.0;
+      CppAD::Independent(ax);
+      for(size_t k = 0; k < n_block; ++k)
+         residual(k, ax, ay);
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      ok &= check_level(f, x);
+      //
+      // optimized recording contains cumulative summation operators
+      f.optimize("no_conditional_skip");
+      for(size_t j = 0; j < n; ++j)
+         x[j] = double(j % 5 + 2) / 4.0;
+      ok &= check_level(f, x);
+      //
+      // a copy of f shares the plan for f
+      CppAD::ADFun<double> g;
+      g = f;
+      x[0] = 3.0;
+      ok &= check_level(g, x);
+      //
+      // reverse mode after forward_level
+      CPPAD_TESTVECTOR(double) w(n), dw_level, dw;
+      for(size_t i = 0; i < n; ++i)
+         w[i] = double(i % 3);
+      g.forward_level(4, x);
+      dw_level = g.Reverse(1, w);
+      g.Forward(0, x);
+      dw = g.Reverse(1, w);
+      for(size_t j = 0; j < n; ++j)
+         ok &= dw_level[j] == dw[j];
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool level_compare(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // comparison operators in many levels
+      size_t n = 2000;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+      CPPAD_TESTVECTOR(double)        x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j);
+      CppAD::Independent(ax);
+      for(size_t j = 0; j < n; ++j)
+      {  AD<double> sum = ax[j] + ax[(j + 1) % n];
+         if( sum < double(n) )
+            ay[j] = sum * sum;
+         else
+            ay[j] = sum;
+      }
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // no comparison changes
+      ok &= check_level(f, x);
+      //
+      // several comparison changes
+      for(size_t j = 0; j < n; ++j)
+         x[j] = double(n - j);
+      ok &= check_level(f, x);
+      f.compare_change_count(3);
+      ok &= check_level(f, x);
+      ok &= f.compare_change_number() > 3;
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool level_vecad(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // the plan is not usable so only one thread is used
+      size_t n = 2;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+      CPPAD_TESTVECTOR(double)        x(n);
+      ax[0] = x[0] = 0.0;
+      ax[1] = x[1] = 2.0;
+      CppAD::Independent(ax);
+      CppAD::VecAD<double> av(2);
+      AD<double> zero = 0.0, one = 1.0;
+      av[zero] = ax[1];
+      av[one]  = ax[1] * ax[1];
+      ay[0]    = av[ ax[0] ];
+      ay[1]    = exp( ax[1] );
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      ok &= check_level(f, x);
+      x[0] = 1.0;
+      ok &= check_level(f, x);
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool level_base2ad(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // f(x)
+      size_t n_block = 500;
+      size_t n       = 3 * n_block;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+      CPPAD_TESTVECTOR(double)        x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j % 7 + 1) / 3.0;
+      CppAD::Independent(ax);
+      for(size_t k = 0; k < n_block; ++k)
+         residual(k, ax, ay);
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // af: the AD<double> operations must be recorded by this thread
+      CppAD::ADFun< AD<double>, double > af = f.base2ad();
+      CppAD::Independent(ax);
+      ay = af.forward_level(4, ax);
+      CppAD::ADFun<double> g(ax, ay);
+      //
+      // g(x) = f(x)
+      CPPAD_TESTVECTOR(double) y_f = f.Forward(0, x);
+      CPPAD_TESTVECTOR(double) y_g = g.Forward(0, x);
+      for(size_t i = 0; i < n; ++i)
+         ok &= y_f[i] == y_g[i];
+      //
+      // g(x) = f(x) at a different argument
+      for(size_t j = 0; j < n; ++j)
+         x[j] = double(j % 5 + 2) / 4.0;
+      y_f = f.Forward(0, x);
+      y_g = g.Forward(0, x);
+      for(size_t i = 0; i < n; ++i)
+         ok &= y_f[i] == y_g[i];
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool level_cond_exp(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // conditional expressions with operands that are results of
+      // several levels of other operators
+      size_t n = 1000;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+      CPPAD_TESTVECTOR(double)        x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j % 7 + 1) / 3.0;
+      CppAD::Independent(ax);
+      for(size_t j = 0; j < n; ++j)
+      {  const AD<double>& ax0 = ax[j];
+         const AD<double>& ax1 = ax[(j + 1) % n];
+         AD<double> aleft  = sin( ax0 * ax1 ) + ax1;
+         AD<double> aright = cos( ax0 + ax1 ) * ax0;
+         ay[j] = CppAD::CondExpLt(ax0, ax1, aleft, aright);
+      }
+      CppAD::ADFun<double> f(ax, ay);
+      f.Forward(0, x);
+      //
+      // The Taylor coefficients for f correspond to the previous argument,
+      // so an operand that has not yet been computed gives a wrong result.
+      for(size_t j = 0; j < n; ++j)
+         x[j] = double(j % 5 + 2) / 4.0;
+      CPPAD_TESTVECTOR(double) y = f.forward_level(4, x);
+      CPPAD_TESTVECTOR(double) check = f.Forward(0, x);
+      for(size_t i = 0; i < n; ++i)
+         ok &= y[i] == check[i];
+      return ok;
+   }
+}
+
+bool forward_level(void)
+{  bool ok = true;
+   ok &= level_wide();
+   ok &= level_compare();
+   ok &= level_vecad();
+   ok &= level_base2ad();
+   ok &= level_cond_exp();
+   return ok;
+}
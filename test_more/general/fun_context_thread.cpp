@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that several threads can use one ADFun object at the same time,
+each with its own fun_context, and get the same results as f.Forward
+and f.Reverse. Also check the nan detection for Reverse with a context.
+*/
+# include <cppad/cppad.hpp>
+# include <thread>
+
+namespace {
+   typedef CPPAD_TESTVECTOR(double) d_vector;
+   //
+   // number of threads
+   const size_t n_thread_ = 4;
+   //
+   // in_parallel_
+   bool in_parallel_ = false;
+   //
+   // thread_num_
+   thread_local size_t thread_num_ = 0;
+   //
+   // used to inform CppAD when we are in parallel execution mode
+   bool in_parallel(void)
+   {  return in_parallel_; }
+   //
+   // used to inform CppAD of current thread number
+   size_t thread_number(void)
+   {  return thread_num_; }
+   //
+   // x_, y_, dw_: input and results for each thread
+   d_vector x_[n_thread_], y_[n_thread_], dw_[n_thread_];
+   //
+   // function that does the work for one thread
+   void worker(const CppAD::ADFun<double>* f, size_t thread, size_t n_rep)
+   {  thread_num_ = thread;
+      size_t n    = f->Domain();
+      size_t m    = f->Range();
+      //
+      // context is only used by this thread
+      CppAD::fun_context<double> context;
+      d_vector dx(n), w(m);
+      for(size_t j = 0; j < n; ++j)
+         dx[j] = 1.0;
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      for(size_t rep = 0; rep < n_rep; ++rep)
+      {  y_[thread]  = f->Forward(0, x_[thread], context);
+         f->Forward(1, dx, context);
+         dw_[thread] = f->Reverse(2, w, context);
+      }
+   }
+   // -----------------------------------------------------------------------
+   bool check_thread(const CppAD::ADFun<double>& f)
+   {  bool ok = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      size_t n = f.Domain();
+      size_t m = f.Range();
+      //
+      // f_order
+      size_t f_order = f.size_order();
+      //
+      // x_
+      for(size_t thread = 0; thread < n_thread_; ++thread)
+      {  x_[thread].resize(n);
+         for(size_t j = 0; j < n; ++j)
+            x_[thread][j] = double(j + thread + 1) / double(n);
+      }
+      //
+      // run the workers in parallel mode
+      CppAD::thread_alloc::parallel_setup(
+         n_thread_, in_parallel, thread_number
+      );
+      CppAD::parallel_ad<double>();
+      in_parallel_ = true;
+      std::thread* thread_obj[n_thread_];
+      size_t n_rep = 20;
+      for(size_t thread = 1; thread < n_thread_; ++thread)
+         thread_obj[thread] = new std::thread(worker, &f, thread, n_rep);
+      worker(&f, 0, n_rep);
+      for(size_t thread = 1; thread < n_thread_; ++thread)
+      {  thread_obj[thread]->join();
+         delete thread_obj[thread];
+      }
+      in_parallel_ = false;
+      CppAD::thread_alloc::parallel_setup(1, nullptr, nullptr);
+      for(size_t thread = 1; thread < n_thread_; ++thread)
+         CppAD::thread_alloc::free_available(thread);
+      //
+      // check results using a copy of f
+      CppAD::ADFun<double> g;
+      g = f;
+      d_vector dx(n), w(m), y(m), dw(2 * n);
+      for(size_t j = 0; j < n; ++j)
+         dx[j] = 1.0;
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      for(size_t thread = 0; thread < n_thread_; ++thread)
+      {  y  = g.Forward(0, x_[thread]);
+         g.Forward(1, dx);
+         dw = g.Reverse(2, w);
+         for(size_t i = 0; i < m; ++i)
+            ok &= CppAD::NearEqual(y[i], y_[thread][i], eps99, eps99);
+         for(size_t k = 0; k < 2 * n; ++k)
+            ok &= CppAD::NearEqual(dw[k], dw_[thread][k], eps99, eps99);
+      }
+      //
+      // the Taylor coefficients in f are not affected
+      ok &= f.size_order() == f_order;
+      //
+      // free memory allocated by the other threads
+      for(size_t thread = 0; thread < n_thread_; ++thread)
+      {  x_[thread].clear();
+         y_[thread].clear();
+         dw_[thread].clear();
+      }
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+# ifndef NDEBUG
+   // errors detected by Reverse(q, w, context) are reported by error_handler
+   void error_handler(
+      bool known       ,
+      int  line        ,
+      const char *file ,
+      const char *exp  ,
+      const char *msg  )
+   {  throw std::string( msg ); }
+# endif
+   //
+   bool check_nan(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // f(x) = azmul(x_0, log(x_1))
+      CPPAD_TESTVECTOR( AD<double> ) ax(2), ay(1);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      CppAD::Independent(ax);
+      ay[0] = CppAD::azmul( ax[0], log( ax[1] ) );
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // The Taylor coefficient for log(x_1) is nan, f(x) = 0, and the
+      // partial w.r.t. x_0 is nan. This is not an error.
+      CppAD::fun_context<double> context;
+      d_vector x(2), w(1), dw(2);
+      x[0] = 0.0;
+      x[1] = -1.0;
+      w[0] = 1.0;
+      d_vector y = f.Forward(0, x, context);
+      ok &= y[0] == 0.0;
+      dw = f.Reverse(1, w, context);
+      ok &= std::isnan( dw[0] );
+      ok &= dw[1] == 0.0;
+# ifndef NDEBUG
+      // A nan in w results in a nan in dw and none of the
+      // Taylor coefficients are nan. This is an error.
+      x[1] = 2.0;
+      f.Forward(0, x, context);
+      w[0] = std::numeric_limits<double>::quiet_NaN();
+      CppAD::ErrorHandler local_handler(error_handler);
+      try
+      {  dw = f.Reverse(1, w, context);
+         ok = false;
+      }
+      catch(const std::string& msg)
+      {  ok &= msg.find("none of its Taylor coefficients") != std::string::npos;
+      }
+      //
+      // the partials are zeroed by the next call
+      w[0] = 1.0;
+      dw   = f.Reverse(1, w, context);
+      ok  &= dw[0] == std::log( x[1] );
+      ok  &= dw[1] == 0.0;
+# endif
+      return ok;
+   }
+}
+
+bool fun_context_thread(void)
+{  bool ok = true;
+   using CppAD::AD;
+   //
+   size_t n = 5, m = 20;
+   CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1) / double(n);
+   CppAD::Independent(ax);
+   CppAD::VecAD<double> av(n);
+   for(size_t j = 0; j < n; ++j)
+      av[ AD<double>(j) ] = ax[j];
+   for(size_t i = 0; i < m; ++i)
+   {  size_t j0 = i % n;
+      size_t j1 = (i + 2) % n;
+      AD<double> index = double( (i + 3) % n );
+      ay[i] = exp( ax[j0] ) * cos( ax[j1] );
+      ay[i] += CppAD::CondExpLt(ax[j0], ax[j1], log(ax[j1]), ax[j0]);
+      ay[i] += av[index] * ax[j1];
+   }
+   CppAD::ADFun<double> f(ax, ay);
+   ok &= check_thread(f);
+   //
+   // optimized version has conditional skip operators
+   f.optimize();
+   ok &= check_thread(f);
+   //
+   // g: most of the operators are not connected to the dependent variables
+   CPPAD_TESTVECTOR( AD<double> ) az(1);
+   CppAD::Independent(ax);
+   AD<double> asum = 0.0;
+   for(size_t k = 0; k < 100; ++k)
+      asum += sin( asum ) * ax[k % n];
+   az[0] = exp( ax[0] ) * cos( ax[1] );
+   CppAD::ADFun<double> g(ax, az);
+   //
+   // g.Reverse determines the subgraph used by g.Reverse(q, w, context)
+   CPPAD_TESTVECTOR(double) x(n), w(1);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j + 1) / double(n);
+   w[0] = 1.0;
+   g.Forward(0, x);
+   g.Reverse(1, w);
+   ok &= check_thread(g);
+   //
+   ok &= check_nan();
+   //
+   return ok;
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that a fun_partition gives the same results as the original function.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   // -----------------------------------------------------------------------
+   // check forward and reverse mode for a partition of f
+   bool check_partition(
+      CppAD::ADFun<double>&           f        ,
+      CppAD::fun_partition<double>&   part     ,
+      const CPPAD_TESTVECTOR(double)& x        ,
+      size_t                          n_thread )
+   {  bool ok = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      size_t n = f.Domain();
+      size_t m = f.Range();
+      //
+      // zero order
+      CPPAD_TESTVECTOR(double) y = part.Forward(0, x, n_thread);
+      CPPAD_TESTVECTOR(double) check = f.Forward(0, x);
+      for(size_t i = 0; i < m; ++i)
+         ok &= CppAD::NearEqual(y[i], check[i], eps99, eps99);
+      //
+      // first order
+      CPPAD_TESTVECTOR(double) dx(n);
+      for(size_t j = 0; j < n; ++j)
+         dx[j] = double(j % 3) - 1.0;
+      y     = part.Forward(1, dx, n_thread);
+      check = f.Forward(1, dx);
+      for(size_t i = 0; i < m; ++i)
+         ok &= CppAD::NearEqual(y[i], check[i], eps99, eps99);
+      //
+      // second order reverse using a weight for each order
+      CPPAD_TESTVECTOR(double) w(2 * m);
+      for(size_t i = 0; i < 2 * m; ++i)
+         w[i] = double(i % 5) - 2.0;
+      y     = part.Reverse(2, w, n_thread);
+      check = f.Reverse(2, w);
+      for(size_t j = 0; j < 2 * n; ++j)
+         ok &= CppAD::NearEqual(y[j], check[j], eps99, eps99);
+      //
+      // all orders at once
+      CPPAD_TESTVECTOR(double) xq(2 * n);
+      for(size_t j = 0; j < n; ++j)
+      {  xq[2 * j + 0] = x[j];
+         xq[2 * j + 1] = dx[j];
+      }
+      y     = part.Forward(1, xq, n_thread);
+      check = f.Forward(1, xq);
+      for(size_t i = 0; i < 2 * m; ++i)
+         ok &= CppAD::NearEqual(y[i], check[i], eps99, eps99);
+      //
+      // first order reverse
+      w.resize(m);
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      y     = part.Reverse(1, w, n_thread);
+      check = f.Reverse(1, w);
+      for(size_t j = 0; j < n; ++j)
+         ok &= CppAD::NearEqual(y[j], check[j], eps99, eps99);
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool partition_separable(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // f(x) has blocks of dependent variables of different sizes;
+      // some dependent variables are parameters and some are the same
+      size_t n = 40;
+      size_t m = n + 3;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m), ap(1);
+      CPPAD_TESTVECTOR(double)        x(n), p(1);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j % 7 + 1) / 4.0;
+      ap[0] = p[0] = 2.0;
+      CppAD::Independent(ax, ap);
+      for(size_t i = 0; i < n; ++i)
+      {  AD<double> sum = ax[i];
+         for(size_t k = 0; k < i % 9; ++k)
+            sum = sin( sum ) + ax[(i + k) % n] * ap[0];
+         ay[i] = sum;
+      }
+      ay[n]     = 3.0;
+      ay[n + 1] = ay[0];
+      ay[n + 2] = ap[0] * ap[0];
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      size_t part_list[] = {1, 2, 5, m};
+      for(size_t i_list = 0; i_list < 4; ++i_list)
+      {  size_t n_part = part_list[i_list];
+         CppAD::fun_partition<double> part = f.partition(n_part);
+         ok &= part.size() == n_part;
+         //
+         // the partitions are contiguous and cover the dependent variables
+         size_t i_dep = 0;
+         for(size_t k = 0; k < n_part; ++k)
+         {  const CppAD::vector<size_t>& index( part.dep_index(k) );
+            ok &= 0 < index.size();
+            for(size_t i = 0; i < index.size(); ++i)
+               ok &= index[i] == i_dep++;
+            ok &= part.fun(k).size_dyn_ind() == f.size_dyn_ind();
+         }
+         ok &= i_dep == m;
+         //
+         // different number of threads
+         for(size_t n_thread = 1; n_thread < 5; ++n_thread)
+            ok &= check_partition(f, part, x, n_thread);
+         //
+         // new value for the dynamic parameter
+         p[0] = 0.5;
+         f.new_dynamic(p);
+         part.new_dynamic(p);
+         ok &= check_partition(f, part, x, 3);
+         p[0] = 2.0;
+         f.new_dynamic(p);
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool partition_serial(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // a VecAD operation requires only one thread to be used
+      size_t n = 3;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+      CPPAD_TESTVECTOR(double)        x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j) / 2.0;
+      CppAD::Independent(ax);
+      CppAD::VecAD<double> av(2);
+      AD<double> zero(0.0), one(1.0);
+      av[zero] = ax[1];
+      av[one]  = ax[2] * ax[2];
+      ay[0]    = av[ CppAD::CondExpLt(ax[0], one, zero, one) ];
+      ay[1]    = exp( ax[1] );
+      ay[2]    = ax[0] * ax[2];
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      CppAD::fun_partition<double> part = f.partition(n);
+      ok &= check_partition(f, part, x, n);
+      x[0] = 3.0;
+      ok &= check_partition(f, part, x, n);
+      return ok;
+   }
+}
+
+bool fun_partition(void)
+{  bool ok = true;
+   ok &= partition_separable();
+   ok &= partition_serial();
+   return ok;
+}
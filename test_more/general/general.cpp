@@ -73,8 +73,11 @@ extern bool base_adolc(void);
 extern bool base_alloc_test(void);
 extern bool bool_sparsity(void);
 extern bool check_simple_vector(void);
+extern bool checkpoint_reverse(void);
 extern bool chkpoint_one(void);
 extern bool chkpoint_two(void);
+extern bool color_parallel(void);
+extern bool compact_tape(void);
 extern bool compare_change(void);
 extern bool cond_exp_rev(void);
 extern bool copy(void);
@@ -87,10 +90,17 @@ extern bool eigen_mat_inv(void);
 extern bool erf(void);
 extern bool expm1(void);
 extern bool fabs(void);
+extern bool for_jac_thread(void);
 extern bool for_sparse_hes(void);
 extern bool for_sparse_jac(void);
+extern bool forward0_plan(void);
+extern bool forward_batch(void);
+extern bool fun_context_thread(void);
+extern bool fun_partition(void);
 extern bool forward_dir(void);
+extern bool forward_level(void);
 extern bool forward_order(void);
+extern bool gradient(void);
 extern bool hes_sparsity(void);
 extern bool ipopt_solve(void);
 extern bool jacobian(void);
@@ -98,6 +108,7 @@ extern bool json_graph(void);
 extern bool log(void);
 extern bool log10(void);
 extern bool log1p(void);
+extern bool mul_add_vec(void);
 extern bool mul_cond_rev(void);
 extern bool mul_cskip(void);
 extern bool mul_level(void);
@@ -111,7 +122,10 @@ extern bool parameter(void);
 extern bool print_for(void);
 extern bool rev_sparse_jac(void);
 extern bool reverse(void);
+extern bool shared_player(void);
+extern bool sparse_cache(void);
 extern bool sparse_hessian(void);
+extern bool sparse_jac_thread(void);
 extern bool sparse_jac_work(void);
 extern bool sparse_jacobian(void);
 extern bool sparse_sub_hes(void);
@@ -195,8 +209,11 @@ int main(void)
    Run( base2ad,         "base2ad"        );
    Run( bool_sparsity,   "bool_sparsity"  );
    Run( check_simple_vector, "check_simple_vector" );
+   Run( checkpoint_reverse,  "checkpoint_reverse"  );
    Run( chkpoint_one,    "chkpoint_one"   );
    Run( chkpoint_two,    "chkpoint_two"   );
+   Run( color_parallel,  "color_parallel" );
+   Run( compact_tape,    "compact_tape"   );
    Run( compare_change,  "compare_change" );
    Run( cond_exp_rev,    "cond_exp_rev"   );
    Run( copy,            "copy"           );
@@ -207,16 +224,24 @@ int main(void)
    Run( erf,             "erf"            );
    Run( expm1,           "expm1"          );
    Run( fabs,            "fabs"           );
+   Run( for_jac_thread,  "for_jac_thread" );
    Run( for_sparse_hes,  "for_sparse_hes" );
    Run( for_sparse_jac,  "for_sparse_jac" );
+   Run( forward0_plan,   "forward0_plan"  );
+   Run( forward_batch,   "forward_batch"  );
+   Run( fun_context_thread, "fun_context_thread");
+   Run( fun_partition,   "fun_partition"  );
    Run( forward_dir,     "forward_dir"    );
+   Run( forward_level,   "forward_level"  );
    Run( forward_order,   "forward_order"  );
+   Run( gradient,        "gradient"       );
    Run( hes_sparsity,    "hes_sparsity"   );
    Run( jacobian,        "jacobian"       );
    Run( json_graph,      "json_graph"     );
    Run( log,             "log"            );
    Run( log10,           "log10"          );
    Run( log1p,           "log1p"          );
+   Run( mul_add_vec,     "mul_add_vec"    );
    Run( mul_cond_rev,    "mul_cond_rev"   );
    Run( mul_cskip,       "Mul_cskip"      );
    Run( mul_level,       "mul_level"      );
@@ -230,7 +255,10 @@ int main(void)
    Run( print_for,       "print_for"      );
    Run( rev_sparse_jac,  "rev_sparse_jac" );
    Run( reverse,         "reverse"        );
+   Run( shared_player,   "shared_player"  );
+   Run( sparse_cache,    "sparse_cache"   );
    Run( sparse_hessian,  "sparse_hessian" );
+   Run( sparse_jac_thread, "sparse_jac_thread");
    Run( sparse_jac_work, "sparse_jac_work");
    Run( sparse_jacobian, "sparse_jacobian");
    Run( sparse_sub_hes,  "sparse_sub_hes" );
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that f.gradient(x, w, y, dw) gives the same results as
+f.Forward(0, x) followed by f.Reverse(1, w) for operation sequences with
+conditional skips, VecAD operations, an atomic function, and a variable
+that is used for more than one dependent variable.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(double)      d_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>) ad_vector;
+   // -----------------------------------------------------------------------
+   // g(u) = [ u_0 * u_1 , u_0 + u_1 ]
+   void g_algo(const ad_vector& au, ad_vector& av)
+   {  av[0] = au[0] * au[1];
+      av[1] = au[0] + au[1];
+   }
+   // -----------------------------------------------------------------------
+   bool check_gradient(
+      CppAD::ADFun<double>& f, const d_vector& x, const d_vector& w)
+   {  bool ok    = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      size_t n   = f.Domain();
+      size_t m   = f.Range();
+      //
+      d_vector y(m), dw(n), y_check(m), dw_check(n);
+      f.gradient(x, w, y, dw);
+      ok &= f.size_order() == 1;
+      //
+      y_check  = f.Forward(0, x);
+      dw_check = f.Reverse(1, w);
+      for(size_t i = 0; i < m; ++i)
+         ok &= CppAD::NearEqual(y[i], y_check[i], eps99, eps99);
+      for(size_t j = 0; j < n; ++j)
+         ok &= CppAD::NearEqual(dw[j], dw_check[j], eps99, eps99);
+      return ok;
+   }
+}
+
+bool gradient(void)
+{  bool ok = true;
+   //
+   // atomic function
+   size_t n = 3, m = 4;
+   ad_vector au(2), av(2);
+   au[0] = 1.0;
+   au[1] = 2.0;
+   CppAD::Independent(au);
+   g_algo(au, av);
+   CppAD::ADFun<double> g_fun(au, av);
+   bool internal_bool = false;
+   bool use_hes_sparsity = false;
+   bool use_base2ad      = false;
+   bool use_in_parallel  = false;
+   CppAD::chkpoint_two<double> g_afun(g_fun, "g",
+      internal_bool, use_hes_sparsity, use_base2ad, use_in_parallel
+   );
+   //
+   // f(x)
+   ad_vector ax(n), ay(m);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1);
+   CppAD::Independent(ax);
+   //
+   // conditional expression
+   AD<double> aleft  = exp( ax[0] ) * ax[1];
+   AD<double> aright = sin( ax[1] ) / ax[2];
+   ay[0] = CondExpLt(ax[0], ax[1], aleft, aright);
+   //
+   // VecAD
+   CppAD::VecAD<double> avec(2);
+   avec[ AD<double>(0) ] = ax[0] * ax[2];
+   avec[ AD<double>(1) ] = ax[1] * ax[2];
+   ay[1] = avec[ ax[2] - 2.0 ];
+   //
+   // atomic function
+   au[0] = ax[0];
+   au[1] = ax[2];
+   g_afun(au, av);
+   ay[2] = av[0] + av[1];
+   //
+   // same variable as ay[0]
+   ay[3] = ay[0];
+   //
+   CppAD::ADFun<double> f(ax, ay);
+   f.optimize();
+   //
+   d_vector x(n), w(m);
+   for(size_t i = 0; i < m; ++i)
+      w[i] = double(i + 1);
+   //
+   // both cases for the conditional expression and for the VecAD index
+   for(size_t icase = 0; icase < 2; ++icase)
+   {  x[0] = 1.0 + double(icase);
+      x[1] = 1.5;
+      x[2] = 2.0 + double(icase);
+      ok  &= check_gradient(f, x, w);
+   }
+   //
+   // the Taylor coefficient capacity is more than two orders
+   d_vector x1(n);
+   for(size_t j = 0; j < n; ++j)
+      x1[j] = 1.0;
+   f.Forward(0, x);
+   f.Forward(1, x1);
+   f.Forward(2, x1);
+   ok &= check_gradient(f, x, w);
+   //
+   // the Taylor coefficients have more than one direction
+   f.Forward(0, x);
+   size_t r = 2;
+   d_vector xq(n * r);
+   for(size_t j = 0; j < n * r; ++j)
+      xq[j] = 1.0;
+   f.Forward(1, r, xq);
+   ok &= check_gradient(f, x, w);
+   //
+   return ok;
+}
@@ -1,8 +1,9 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/cppad.hpp>
+# include <sstream>
 
 namespace { // BEGIN_EMPTY_NAMESPACE
 // ---------------------------------------------------------------------------
@@ -2620,6 +2621,62 @@ bool unary(bool p_first)
    //
    return ok;
 }
+// ---------------------------------------------------------------------------
+// Test reading a graph, that is larger than the lexer chunk size, from a stream
+bool stream_input(void)
+{  bool ok   = true;
+   using CppAD::AD;
+   //
+   size_t np = 1;
+   size_t nx = 3;
+   size_t ny = 2;
+   CPPAD_TESTVECTOR(double)       p(np),  x(nx);
+   CPPAD_TESTVECTOR( AD<double> ) ap(np), ax(nx), ay(ny);
+   p[0]  = 0.5;
+   ap[0] = p[0];
+   for(size_t j = 0; j < nx; ++j)
+   {  x[j]  = double(j + 1) / double(nx + 1);
+      ax[j] = x[j];
+   }
+   CppAD::Independent(ax, ap);
+   //
+   // f(x, p) = [ sum_k p_0 * sin( x_{k % nx} + k ) , prod_k x_{k % nx} ]
+   size_t n_term = 20000;
+   ay[0] = 0.0;
+   ay[1] = 1.0;
+   for(size_t k = 0; k < n_term; ++k)
+   {  ay[0] += ap[0] * sin( ax[k % nx] + double(k) );
+      if( k < 10 )
+         ay[1] *= ax[k % nx];
+   }
+   CppAD::ADFun<double> f(ax, ay);
+   f.function_name_set("stream_input");
+   //
+   // json: the graph must be larger than several chunks
+   std::string json = f.to_json();
+   ok &= json.size() > 4 * 65536;
+   //
+   // g: read the graph from a stream
+   std::istringstream is(json);
+   CppAD::ADFun<double> g;
+   g.from_json(is);
+   ok &= g.function_name_get() == "stream_input";
+   ok &= g.size_var() == f.size_var();
+   //
+   // check function values
+   f.new_dynamic(p);
+   g.new_dynamic(p);
+   CPPAD_TESTVECTOR(double) yf = f.Forward(0, x);
+   CPPAD_TESTVECTOR(double) yg = g.Forward(0, x);
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   for(size_t i = 0; i < ny; ++i)
+      ok &= CppAD::NearEqual( yf[i], yg[i], eps99, eps99 );
+   //
+   // the stream and string graphs are the same
+   ok &= g.to_json() == json;
+   //
+   return ok;
+}
 
 // ---------------------------------------------------------------------------
 } // END_EMPTY_NAMESPACE
@@ -2662,6 +2719,7 @@ bool json_graph(void)
    ok     &= cumulative_sum();
    ok     &= unary(true);
    ok     &= unary(false);
+   ok     &= stream_input();
    //
    return ok;
 }
@@ -227,6 +227,151 @@ bool test_post(void)
    return ok;
 }
 
+// number of elements in sets that use more than one size_t value as a bitmap
+template<class SetVector>
+bool test_number_elements(void)
+{  bool ok = true;
+   //
+   // end: three full size_t values and part of a fourth
+   size_t n_bit = size_t( std::numeric_limits<size_t>::digits );
+   size_t n_set = 4;
+   size_t end   = 3 * n_bit + 5;
+   SetVector vec_set;
+   vec_set.resize(n_set, end);
+   //
+   // set 0: elements in every size_t value, including the first and last
+   // bit of the first value and the last element
+   size_t element_0[] = {
+      0, 1, n_bit - 1, n_bit, 2 * n_bit - 1, 2 * n_bit, 2 * n_bit + 2, end - 1
+   };
+   size_t n_element_0 = sizeof(element_0) / sizeof(element_0[0]);
+   for(size_t k = 0; k < n_element_0; ++k)
+      vec_set.add_element(0, element_0[k]);
+   ok &= vec_set.number_elements(0) == n_element_0;
+   //
+   // set 1: elements only in the first size_t value
+   vec_set.add_element(1, 0);
+   vec_set.add_element(1, n_bit - 1);
+   ok &= vec_set.number_elements(1) == 2;
+   //
+   // set 2: elements only in the last size_t value
+   vec_set.add_element(2, 3 * n_bit);
+   vec_set.add_element(2, end - 1);
+   ok &= vec_set.number_elements(2) == 2;
+   //
+   // set 3: empty
+   ok &= vec_set.number_elements(3) == 0;
+   //
+   return ok;
+}
+
+// compare random operations with the same operations using std::set
+template<class SetVector>
+bool test_random(void)
+{  bool ok = true;
+   //
+   // end: more than two size_t values per set as a bitmap
+   size_t n_set = 20;
+   size_t end   = 150;
+   SetVector vec_set, other;
+   vec_set.resize(n_set, end);
+   other.resize(n_set, end);
+   std::vector< std::set<size_t> > check_vec(n_set), check_other(n_set);
+   //
+   // random number generator (the same sequence on all systems)
+   size_t seed = 123;
+   size_t state = seed;
+   auto next = [&state](size_t limit)
+   {  state = (state * 1103515245 + 12345) % 2147483648;
+      return (state / 65536) % limit;
+   };
+   for(size_t count = 0; count < 5000; ++count)
+   {  size_t target = next(n_set);
+      size_t left   = next(n_set);
+      size_t right  = next(n_set);
+      size_t choice = next(7);
+      // the left and right sets are dense more often than not
+      size_t limit  = end;
+      if( next(2) == 0 )
+         limit = 10;
+      switch( choice )
+      {  case 0:
+         {  size_t element = next(limit);
+            vec_set.add_element(target, element);
+            check_vec[target].insert(element);
+         }
+         break;
+
+         case 1:
+         {  size_t n_post = next(2 * end);
+            for(size_t k = 0; k < n_post; ++k)
+            {  size_t element = next(limit);
+               vec_set.post_element(target, element);
+               check_vec[target].insert(element);
+            }
+            vec_set.process_post(target);
+         }
+         break;
+
+         case 2:
+         vec_set.binary_union(target, left, right, vec_set);
+         {  std::set<size_t> result = check_vec[left];
+            result.insert( check_vec[right].begin(), check_vec[right].end() );
+            check_vec[target] = result;
+         }
+         break;
+
+         case 3:
+         vec_set.binary_union(target, left, right, other);
+         {  std::set<size_t> result = check_vec[left];
+            result.insert(
+               check_other[right].begin(), check_other[right].end()
+            );
+            check_vec[target] = result;
+         }
+         break;
+
+         case 4:
+         vec_set.binary_intersection(target, left, right, vec_set);
+         {  std::set<size_t> result;
+            for(size_t element : check_vec[left])
+               if( check_vec[right].find(element) != check_vec[right].end() )
+                  result.insert(element);
+            check_vec[target] = result;
+         }
+         break;
+
+         case 5:
+         other.assignment(target, left, vec_set);
+         check_other[target] = check_vec[left];
+         break;
+
+         case 6:
+         if( next(4) == 0 )
+         {  vec_set.clear(target);
+            check_vec[target].clear();
+         }
+         else
+         {  vec_set.assignment(target, left, vec_set);
+            check_vec[target] = check_vec[left];
+         }
+         break;
+      }
+      // check all the sets
+      for(size_t i = 0; i < n_set; ++i)
+      {  ok &= vec_set.number_elements(i) == check_vec[i].size();
+         typename SetVector::const_iterator itr(vec_set, i);
+         for(size_t element : check_vec[i])
+         {  ok &= vec_set.is_element(i, element);
+            ok &= *itr == element;
+            ++itr;
+         }
+         ok &= *itr == end;
+      }
+   }
+   return ok;
+}
+
 } // END empty namespace
 
 bool vector_set(void)
@@ -235,22 +380,35 @@ bool vector_set(void)
    ok     &= test_no_other<CppAD::local::sparse::pack_setvec>();
    ok     &= test_no_other<CppAD::local::sparse::list_setvec>();
    ok     &= test_no_other<CppAD::local::sparse::svec_setvec>();
+   ok     &= test_no_other<CppAD::local::sparse::hybrid_setvec>();
    //
    ok     &= test_yes_other<CppAD::local::sparse::pack_setvec>();
    ok     &= test_yes_other<CppAD::local::sparse::list_setvec>();
    ok     &= test_yes_other<CppAD::local::sparse::svec_setvec>();
+   ok     &= test_yes_other<CppAD::local::sparse::hybrid_setvec>();
    //
    ok     &= test_intersection<CppAD::local::sparse::pack_setvec>();
    ok     &= test_intersection<CppAD::local::sparse::list_setvec>();
    ok     &= test_intersection<CppAD::local::sparse::svec_setvec>();
+   ok     &= test_intersection<CppAD::local::sparse::hybrid_setvec>();
    //
    ok     &= test_post<CppAD::local::sparse::pack_setvec>();
    ok     &= test_post<CppAD::local::sparse::list_setvec>();
+   ok     &= test_post<CppAD::local::sparse::hybrid_setvec>();
 # ifndef _MSC_VER
    // 2DO: this test generates an assert error when using MSC compiler
    // need to track this down even though svec_setvec not currently being used
    ok     &= test_post<CppAD::local::sparse::svec_setvec>();
 # endif
+   //
+   ok     &= test_number_elements<CppAD::local::sparse::pack_setvec>();
+   ok     &= test_number_elements<CppAD::local::sparse::list_setvec>();
+   ok     &= test_number_elements<CppAD::local::sparse::svec_setvec>();
+   ok     &= test_number_elements<CppAD::local::sparse::hybrid_setvec>();
+   //
+   ok     &= test_random<CppAD::local::sparse::pack_setvec>();
+   ok     &= test_random<CppAD::local::sparse::list_setvec>();
+   ok     &= test_random<CppAD::local::sparse::hybrid_setvec>();
    //
    return ok;
 }
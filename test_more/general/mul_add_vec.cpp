@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that mul_add_vec records the same operation sequence as the
+AD multiply and add operators.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(double)      d_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>) ad_vector;
+   // -----------------------------------------------------------------------
+   // record y = a * x + b where the first half of x are variables and
+   // the second half are dynamic parameters
+   void record(
+      CppAD::ADFun<double>& f       ,
+      bool                  use_vec ,
+      const d_vector&       a       ,
+      const d_vector&       b       )
+   {  size_t n = a.size();
+      size_t n_var = n / 2;
+      ad_vector ax(n_var), ap(n - n_var), az(n);
+      for(size_t j = 0; j < n_var; ++j)
+         ax[j] = double(j + 1);
+      for(size_t j = n_var; j < n; ++j)
+         ap[j - n_var] = double(j + 1);
+      CppAD::Independent(ax, ap);
+      for(size_t j = 0; j < n; ++j)
+      {  if( j < n_var )
+            az[j] = ax[j];
+         else
+            az[j] = ap[j - n_var];
+      }
+      if( use_vec )
+      {  // y and x are the same vector
+         CppAD::mul_add_vec(a, az, b, az);
+      }
+      else
+      {  for(size_t i = 0; i < n; ++i)
+            az[i] = a[i] * az[i] + b[i];
+      }
+      f.Dependent(ax, az);
+   }
+   // -----------------------------------------------------------------------
+   bool check_record(void)
+   {  bool ok = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      //
+      // multipliers and values added include zero and one
+      size_t n = 8;
+      d_vector a(n), b(n);
+      for(size_t i = 0; i < n; ++i)
+      {  a[i] = double(i % 4) - 1.0;
+         b[i] = double(i % 3);
+      }
+      CppAD::ADFun<double> f, g;
+      record(f, false, a, b);
+      record(g, true, a, b);
+      //
+      ok &= f.size_op()     == g.size_op();
+      ok &= f.size_op_arg() == g.size_op_arg();
+      ok &= f.size_var()    == g.size_var();
+      ok &= f.size_dyn_par() == g.size_dyn_par();
+      //
+      size_t n_var = n / 2;
+      d_vector x(n_var), p(n - n_var), y_f(n), y_g(n);
+      for(size_t j = 0; j < n_var; ++j)
+         x[j] = double(j) / 3.0;
+      for(size_t j = n_var; j < n; ++j)
+         p[j - n_var] = double(j) / 5.0;
+      f.new_dynamic(p);
+      g.new_dynamic(p);
+      y_f = f.Forward(0, x);
+      y_g = g.Forward(0, x);
+      for(size_t i = 0; i < n; ++i)
+         ok &= CppAD::NearEqual(y_f[i], y_g[i], eps99, eps99);
+      //
+      d_vector w(n), dw_f(n_var), dw_g(n_var);
+      for(size_t i = 0; i < n; ++i)
+         w[i] = double(i + 1);
+      dw_f = f.Reverse(1, w);
+      dw_g = g.Reverse(1, w);
+      for(size_t j = 0; j < n_var; ++j)
+         ok &= CppAD::NearEqual(dw_f[j], dw_g[j], eps99, eps99);
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool check_no_recording(void)
+   {  bool ok = true;
+      size_t n = 3;
+      d_vector a(n), b(n);
+      ad_vector ax(n), ay(n);
+      for(size_t i = 0; i < n; ++i)
+      {  a[i]  = double(i) + 2.0;
+         b[i]  = double(i) - 1.0;
+         ax[i] = double(i) / 2.0;
+      }
+      CppAD::mul_add_vec(a, ax, b, ay);
+      for(size_t i = 0; i < n; ++i)
+      {  ok &= CppAD::Constant( ay[i] );
+         ok &= Value( ay[i] ) == a[i] * Value( ax[i] ) + b[i];
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool check_zero_times_nan(void)
+   {  bool ok = true;
+      double nan = std::numeric_limits<double>::quiet_NaN();
+      size_t n = 1;
+      d_vector a(n), b(n);
+      ad_vector ax(n), ay(n);
+      a[0]  = 0.0;
+      b[0]  = 3.0;
+      ax[0] = nan;
+      CppAD::Independent(ax);
+      CppAD::mul_add_vec(a, ax, b, ay);
+      ok &= CppAD::Constant( ay[0] );
+      ok &= Value( ay[0] ) == 3.0;
+      CppAD::ADFun<double> f(ax, ay);
+      return ok;
+   }
+}
+
+bool mul_add_vec(void)
+{  bool ok = true;
+   ok &= check_record();
+   ok &= check_no_recording();
+   ok &= check_zero_times_nan();
+   return ok;
+}
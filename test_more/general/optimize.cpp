@@ -2335,6 +2335,71 @@ namespace {
       return ok;
    }
 
+   // -----------------------------------------------------------------------
+   // Test case with enough distinct expressions to grow the hash table
+   // (that starts with 1024 slots) several times during one pass,
+   // and enough operators to use more than one thread for the hash codes.
+   template <class Vector>
+   void duplicate_rehash_fun(size_t n_term, const Vector& x, Vector& y)
+   {  typedef typename Vector::value_type Scalar;
+      Scalar t = x[0];
+      Scalar sum(0);
+      for(size_t k = 0; k < n_term; ++k)
+      {  // t * x[1] is a new expression, x[1] * t is a duplicate of it
+         Scalar d = x[1] * t;
+         t        = t * x[1];
+         sum     += t + d;
+      }
+      y[0] = sum;
+   }
+   bool duplicate_rehash(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      using CppAD::vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // number of terms in the summation
+      size_t n_term = 3000;
+      //
+      // check using one thread and using four threads to compute hash codes
+      for(size_t n_thread = 1; n_thread <= 4; n_thread += 3)
+      {  //
+         // f
+         size_t n = 2, m = 1;
+         vector< AD<double> > ax(n), ay(m);
+         ax[0] = 0.5;
+         ax[1] = 1.0;
+         CppAD::Independent(ax);
+         duplicate_rehash_fun(n_term, ax, ay);
+         CppAD::ADFun<double> f(ax, ay);
+         //
+         // Each term has a multiply, its duplicate, and two additions
+         // (the first addition to the sum is not recorded).
+         ok &= f.size_var() == 1 + n + 4 * n_term - 1;
+         //
+         // optimize
+         std::string options = "no_cumulative_sum_op";
+         if( ! conditional_skip_ )
+            options += " no_conditional_skip";
+         options += " n_thread=" + CppAD::to_string(n_thread);
+         f.optimize(options);
+         ok &= ! f.exceed_collision_limit();
+         //
+         // each duplicate multiply has been removed
+         ok &= f.size_var() == 1 + n + 3 * n_term - 1;
+         //
+         // check result
+         vector<double> x(n), y(m), check(m);
+         x[0] = 0.25;
+         x[1] = 1.001;
+         y    = f.Forward(0, x);
+         duplicate_rehash_fun(n_term, x, check);
+         ok  &= NearEqual(y[0], check[0], eps99, eps99);
+      }
+      //
+      return ok;
+   }
    // -----------------------------------------------------------------------
    // Test case with print operator in optimized f
    bool check_print_for(void)
@@ -2510,6 +2575,7 @@ bool optimize(void)
       ok     &= depend_three();
       ok     &= depend_four();
       // check removal of duplicate expressions
+      ok     &= duplicate_rehash();
       ok     &= duplicate_one();
       ok     &= duplicate_two();
       ok     &= duplicate_three();
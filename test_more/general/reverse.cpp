@@ -485,7 +485,257 @@ bool duplicate_dependent_var(void)
    return ok;
 }
 
+// ----------------------------------------------------------------------------
+// check repeated calls to Reverse that reuse the partial derivative workspace
+bool repeated_reverse(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+   // f(x) = [ y_0, y_1 ] = [ x_0 * x_1 , exp(y_0) ]
+   // y_0 comes before the last variable on the tape
+   size_t nx = 2;
+   size_t ny = 2;
+   CPPAD_TESTVECTOR( AD<double> ) ax(nx), ay(ny);
+   ax[0] = 1.0;
+   ax[1] = 2.0;
+   CppAD::Independent(ax);
+   ay[0] = ax[0] * ax[1];
+   ay[1] = exp( ay[0] );
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // g(x) = f_0 (x)
+   CppAD::ADFun<double> g;
+   CPPAD_TESTVECTOR( AD<double> ) az(1);
+   CppAD::Independent(ax);
+   az[0] = ax[0] * ax[1];
+   g.Dependent(ax, az);
+   //
+   CPPAD_TESTVECTOR(double) x0(nx), x1(nx), w(ny), dw(nx), dw2(nx * 2);
+   x0[0] = 0.5;
+   x0[1] = 1.5;
+   x1[0] = 1.0;
+   x1[1] = 0.0;
+   f.Forward(0, x0);
+   double y0 = x0[0] * x0[1];
+   //
+   // derivative of y_1, then y_0, then y_1 again
+   for(size_t icase = 0; icase < 3; ++icase)
+   {  size_t ell = (icase + 1) % 2;
+      w[0]  = double(ell == 0);
+      w[1]  = double(ell == 1);
+      dw    = f.Reverse(1, w);
+      double scale = 1.0;
+      if( ell == 1 )
+         scale = std::exp(y0);
+      ok &= NearEqual(dw[0], scale * x0[1], eps99, eps99);
+      ok &= NearEqual(dw[1], scale * x0[0], eps99, eps99);
+   }
+   //
+   // second order reverse for y_0, then first order again
+   f.Forward(1, x1);
+   w[0] = 1.0;
+   w[1] = 0.0;
+   dw2  = f.Reverse(2, w);
+   ok &= NearEqual(dw2[0 * 2 + 0], x0[1], eps99, eps99);
+   ok &= NearEqual(dw2[0 * 2 + 1], 0.0,   eps99, eps99);
+   ok &= NearEqual(dw2[1 * 2 + 0], x0[0], eps99, eps99);
+   ok &= NearEqual(dw2[1 * 2 + 1], 1.0,   eps99, eps99);
+   dw   = f.Reverse(1, w);
+   ok &= NearEqual(dw[0], x0[1], eps99, eps99);
+   ok &= NearEqual(dw[1], x0[0], eps99, eps99);
+   //
+   // copy f to g, which has a different tape
+   g = f;
+   w[0] = 0.0;
+   w[1] = 1.0;
+   dw   = g.Reverse(1, w);
+   ok &= NearEqual(dw[0], std::exp(y0) * x0[1], eps99, eps99);
+   ok &= NearEqual(dw[1], std::exp(y0) * x0[0], eps99, eps99);
+   //
+   return ok;
+}
+
 } // End empty namespace
+// ---------------------------------------------------------------------------
+// Reverse mode when most of the operations are not connected to the
+// dependent variables. In this case only the connected operations are
+// used by the sweep and only their partials are cleared after the sweep.
+namespace {
+   typedef CPPAD_TESTVECTOR(double)               d_vector;
+   typedef CPPAD_TESTVECTOR( CppAD::AD<double> )  ad_vector;
+   //
+   // g(u) = u_0 * u_1
+   void g_algo(const ad_vector& au, ad_vector& av)
+   {  av[0] = au[0] * au[1]; }
+   //
+   // f(x) = [ g(x_0, x_1) * CondExpLt(x_0, x_1, sin(x_0), cos(x_1)) , x_2 ]
+   // If n_unused is non-zero, f has that many operations that do not
+   // affect its value.
+   CppAD::ADFun<double> record_subgraph(
+      CppAD::chkpoint_two<double>& g_check, size_t n_unused)
+   {  using CppAD::AD;
+      ad_vector ax(3), au(2), av(1), ay(2);
+      for(size_t j = 0; j < 3; ++j)
+         ax[j] = double(j + 1);
+      CppAD::Independent(ax);
+      AD<double> az = ax[2];
+      for(size_t k = 0; k < n_unused; ++k)
+         az = sin(az) + ax[0];
+      au[0] = ax[0];
+      au[1] = ax[1];
+      g_check(au, av);
+      ay[0] = av[0] * CondExpLt(ax[0], ax[1], sin(ax[0]), cos(ax[1]));
+      ay[1] = ax[2];
+      return CppAD::ADFun<double>(ax, ay);
+   }
+   //
+   // check f.Reverse(q, w) == g.Reverse(q, w)
+   bool check_reverse(
+      CppAD::ADFun<double>& f, CppAD::ADFun<double>& g,
+      size_t q, const d_vector& w)
+   {  bool ok = true;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      d_vector dw_f = f.Reverse(q, w);
+      d_vector dw_g = g.Reverse(q, w);
+      for(size_t k = 0; k < dw_g.size(); ++k)
+         ok &= CppAD::NearEqual(dw_f[k], dw_g[k], eps99, eps99);
+      return ok;
+   }
+   //
+   bool reverse_subgraph(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // g_check
+      ad_vector au(2), av(1);
+      au[0] = 1.0;
+      au[1] = 2.0;
+      CppAD::Independent(au);
+      g_algo(au, av);
+      CppAD::ADFun<double> g_fun(au, av);
+      bool internal_bool    = false;
+      bool use_hes_sparsity = true;
+      bool use_base2ad      = false;
+      bool use_in_parallel  = false;
+      CppAD::chkpoint_two<double> g_check(g_fun, "g_check",
+         internal_bool, use_hes_sparsity, use_base2ad, use_in_parallel
+      );
+      //
+      // f, f_check
+      CppAD::ADFun<double> f       = record_subgraph(g_check, 100);
+      CppAD::ADFun<double> f_check = record_subgraph(g_check, 0);
+      //
+      // both cases for the conditional expression
+      d_vector x(3), dx(3), w(2);
+      for(size_t icase = 0; icase < 2; ++icase)
+      {  x[0]  = 0.5 + double(icase);
+         x[1]  = 1.0;
+         x[2]  = 2.0;
+         f.Forward(0, x);
+         f_check.Forward(0, x);
+         //
+         // first order, for each component of f and then both
+         for(size_t i = 0; i < 3; ++i)
+         {  w[0] = double(i != 1);
+            w[1] = double(i != 0);
+            ok  &= check_reverse(f, f_check, 1, w);
+         }
+         d_vector dw = f.Reverse(1, w);
+         double sx0 = std::sin(x[0]);
+         double cx1 = std::cos(x[1]);
+         if( x[0] < x[1] )
+         {  ok &= NearEqual(dw[0],
+               x[1] * sx0 + x[0] * x[1] * std::cos(x[0]), eps99, eps99
+            );
+            ok &= NearEqual(dw[1], x[0] * sx0, eps99, eps99);
+         }
+         else
+         {  ok &= NearEqual(dw[0], x[1] * cx1, eps99, eps99);
+            ok &= NearEqual(dw[1],
+               x[0] * cx1 - x[0] * x[1] * std::sin(x[1]), eps99, eps99
+            );
+         }
+         ok &= NearEqual(dw[2], 1.0, eps99, eps99);
+         //
+         // second order, then first order again
+         for(size_t j = 0; j < 3; ++j)
+            dx[j] = double(j + 1);
+         f.Forward(1, dx);
+         f_check.Forward(1, dx);
+         ok &= check_reverse(f, f_check, 2, w);
+         ok &= check_reverse(f, f_check, 1, w);
+      }
+      // -----------------------------------------------------------------------
+      // A cumulative summation in the subgraph
+      // node_1 : x[0]
+      // node_2 : x[1]
+      // node_3 : x[2]
+      // node_4 : x[0] + x[1] + x[2]
+      // node_5 : node_4 * x[0]
+      // node_6 : sin( x[2] ) (not used)
+      // ...
+      // y[0]   = node_5
+      std::string json =
+         "{\n"
+         "   'function_name'  : 'reverse_subgraph',\n"
+         "   'op_define_vec'  : [ 3, [\n"
+         "       { 'op_code':1, 'name':'mul', 'n_arg':2 } ,\n"
+         "       { 'op_code':2, 'name':'sum' } ,\n"
+         "       { 'op_code':3, 'name':'sin', 'n_arg':1 } ]\n"
+         "   ],\n"
+         "   'n_dynamic_ind'  : 0,\n"
+         "   'n_variable_ind' : 3,\n"
+         "   'constant_vec'   : [ 0, [ ] ],\n"
+         "   'op_usage_vec'   : [ 12, [\n"
+         "       [ 2, 1, 3, [1, 2, 3] ] ,\n"
+         "       [ 1, 4, 1 ] ,\n"
+         "       [ 3, 3 ] ,\n";
+      for(size_t k = 6; k < 15; ++k)
+      {  json += "       [ 3, " + CppAD::to_string(k) + " ]";
+         if( k + 1 < 15 )
+            json += " ,";
+         json += "\n";
+      }
+      json +=
+         "   ]],\n"
+         "   'dependent_vec' : [ 1, [5] ] \n"
+         "}\n";
+      for(size_t i = 0; i < json.size(); ++i)
+         if( json[i] == '\'' ) json[i] = '"';
+      CppAD::ADFun<double> h;
+      h.from_json(json);
+      //
+      // derivative of h(x) = (x_0 + x_1 + x_2) * x_0
+      x[0] = 0.5;
+      x[1] = 1.5;
+      x[2] = 2.5;
+      h.Forward(0, x);
+      d_vector v(1), dv(3), dv2(6);
+      v[0] = 1.0;
+      for(size_t irepeat = 0; irepeat < 2; ++irepeat)
+      {  dv = h.Reverse(1, v);
+         ok &= NearEqual(dv[0], 2.0 * x[0] + x[1] + x[2], eps99, eps99);
+         ok &= NearEqual(dv[1], x[0], eps99, eps99);
+         ok &= NearEqual(dv[2], x[0], eps99, eps99);
+      }
+      //
+      // second order partials in the direction dx = (1, 0, 0)
+      dx[0] = 1.0;
+      dx[1] = 0.0;
+      dx[2] = 0.0;
+      h.Forward(1, dx);
+      dv2 = h.Reverse(2, v);
+      ok &= NearEqual(dv2[0 * 2 + 1], 2.0, eps99, eps99);
+      ok &= NearEqual(dv2[1 * 2 + 1], 1.0, eps99, eps99);
+      ok &= NearEqual(dv2[2 * 2 + 1], 1.0, eps99, eps99);
+      //
+      return ok;
+   }
+}
 
 # include <vector>
 # include <valarray>
@@ -494,6 +744,8 @@ bool reverse(void)
    ok &= reverse_one();
    ok &= reverse_mul();
    ok &= duplicate_dependent_var();
+   ok &= repeated_reverse();
+   ok &= reverse_subgraph();
 
    ok &= reverse_any_cases< CppAD::vector  <double> >();
    ok &= reverse_any_cases< std::vector    <double> >();
@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that copies of an ADFun object share the operation sequence and that
+changing the dynamic parameters, or optimizing, one copy does not affect
+the other copies. Also check copies made by other threads in parallel mode,
+where the original is deleted before the copies.
+*/
+# include <cppad/cppad.hpp>
+# include <thread>
+# include <atomic>
+
+namespace {
+   typedef CPPAD_TESTVECTOR(double)                d_vector;
+   typedef CPPAD_TESTVECTOR( CppAD::AD<double> )   ad_vector;
+   //
+   // f(x; p) = sum_k p_0 * sin( x_{k % n} ) + CondExpLt(x_0, x_1, x_0, x_1)
+   void record(CppAD::ADFun<double>& f, size_t n_term)
+   {  using CppAD::AD;
+      size_t n = 2, m = 2;
+      ad_vector ax(n), ay(m), ap(1);
+      ap[0] = 1.0;
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1);
+      CppAD::Independent(ax, ap);
+      ay[0] = 0.0;
+      for(size_t k = 0; k < n_term; ++k)
+         ay[0] += ap[0] * sin( ax[k % n] + double(k) );
+      // this variable is not used and is removed by the optimizer
+      AD<double> not_used = exp( ax[0] );
+      ay[1] = CppAD::CondExpLt(ax[0], ax[1], ax[0], ax[1]) + not_used * 0.0;
+      f.Dependent(ax, ay);
+   }
+   // value of f(x; p)
+   d_vector check_value(const d_vector& x, double p, size_t n_term)
+   {  d_vector y(2);
+      y[0] = 0.0;
+      for(size_t k = 0; k < n_term; ++k)
+         y[0] += p * std::sin( x[k % 2] + double(k) );
+      y[1] = std::min(x[0], x[1]);
+      return y;
+   }
+   // -----------------------------------------------------------------------
+   // number of threads
+   const size_t n_thread_ = 4;
+   //
+   // in_parallel_
+   bool in_parallel_ = false;
+   //
+   // thread_num_
+   thread_local size_t thread_num_ = 0;
+   //
+   // used to inform CppAD when we are in parallel execution mode
+   bool in_parallel(void)
+   {  return in_parallel_; }
+   //
+   // used to inform CppAD of current thread number
+   size_t thread_number(void)
+   {  return thread_num_; }
+   //
+   // n_copy_: number of worker threads that have copied f_
+   std::atomic<size_t> n_copy_(0);
+   //
+   // f_deleted_: has the master thread deleted f_
+   std::atomic<bool> f_deleted_(false);
+   //
+   // f_: the function that is copied by the worker threads
+   CppAD::ADFun<double>* f_ = nullptr;
+   //
+   // y_, ay_: results for each worker thread
+   double y_[n_thread_], ay_[n_thread_];
+   //
+   // a worker thread copies f_ and uses the copies after f_ is deleted
+   void worker(size_t thread)
+   {  thread_num_ = thread;
+      using CppAD::AD;
+      {  // g, af: the memory for these copies is owned by this thread
+         CppAD::ADFun<double> g;
+         g = *f_;
+         CppAD::ADFun< AD<double>, double > af = f_->base2ad();
+         ++n_copy_;
+         while( ! f_deleted_ )
+            std::this_thread::yield();
+         //
+         d_vector x(2), p(1), y;
+         x[0] = double(thread + 1) / 4.0;
+         x[1] = 1.5;
+         p[0] = 2.0;
+         g.new_dynamic(p);
+         y = g.Forward(0, x);
+         y_[thread] = y[0];
+         //
+         ad_vector ax(2), ay;
+         ax[0] = x[0];
+         ax[1] = x[1];
+         ay = af.Forward(0, ax);
+         ay_[thread] = Value( ay[0] );
+      }
+      // g and af have been deleted by this thread
+   }
+   //
+   bool check_thread(size_t n_term)
+   {  bool ok = true;
+      using CppAD::NearEqual;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // f_
+      f_ = new CppAD::ADFun<double>;
+      record(*f_, n_term);
+      //
+      // run the workers in parallel mode
+      CppAD::thread_alloc::parallel_setup(
+         n_thread_, in_parallel, thread_number
+      );
+      CppAD::parallel_ad<double>();
+      in_parallel_ = true;
+      n_copy_      = 0;
+      f_deleted_   = false;
+      std::thread* thread_obj[n_thread_];
+      for(size_t thread = 1; thread < n_thread_; ++thread)
+         thread_obj[thread] = new std::thread(worker, thread);
+      //
+      // the master thread deletes f_ after it is copied and before the
+      // copies are deleted
+      while( n_copy_ < n_thread_ - 1 )
+         std::this_thread::yield();
+      delete f_;
+      f_         = nullptr;
+      f_deleted_ = true;
+      for(size_t thread = 1; thread < n_thread_; ++thread)
+      {  thread_obj[thread]->join();
+         delete thread_obj[thread];
+      }
+      in_parallel_ = false;
+      CppAD::thread_alloc::parallel_setup(1, nullptr, nullptr);
+      for(size_t thread = 1; thread < n_thread_; ++thread)
+      {  ok &= CppAD::thread_alloc::inuse(thread) == 0;
+         CppAD::thread_alloc::free_available(thread);
+      }
+      //
+      // check the results
+      d_vector x(2);
+      for(size_t thread = 1; thread < n_thread_; ++thread)
+      {  x[0] = double(thread + 1) / 4.0;
+         x[1] = 1.5;
+         ok  &= NearEqual(
+            y_[thread], check_value(x, 2.0, n_term)[0], eps99, eps99
+         );
+         ok  &= NearEqual(
+            ay_[thread], check_value(x, 1.0, n_term)[0], eps99, eps99
+         );
+      }
+      return ok;
+   }
+}
+
+bool shared_player(void)
+{  bool ok = true;
+   using CppAD::thread_alloc;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // f
+   size_t n_term = 500;
+   CppAD::ADFun<double> f;
+   record(f, n_term);
+   f.capacity_order(0);
+   //
+   // g: copying f does not copy the operation sequence
+   size_t thread = thread_alloc::thread_num();
+   size_t inuse_before = thread_alloc::inuse(thread);
+   CppAD::ADFun<double> g;
+   g = f;
+   size_t inuse_after  = thread_alloc::inuse(thread);
+   ok &= inuse_after - inuse_before < f.size_op_seq() / 2;
+   ok &= g.size_op_seq() == f.size_op_seq();
+   //
+   // x, p
+   d_vector x(2), p(1), y;
+   x[0] = 0.5;
+   x[1] = 1.5;
+   p[0] = 1.0;
+   //
+   // g.new_dynamic does not affect f
+   d_vector q(1);
+   q[0] = 3.0;
+   g.new_dynamic(q);
+   y = g.Forward(0, x);
+   d_vector check = check_value(x, q[0], n_term);
+   for(size_t i = 0; i < 2; ++i)
+      ok &= NearEqual(y[i], check[i], eps99, eps99);
+   y     = f.Forward(0, x);
+   check = check_value(x, p[0], n_term);
+   for(size_t i = 0; i < 2; ++i)
+      ok &= NearEqual(y[i], check[i], eps99, eps99);
+   //
+   // h: a copy of f after its zero order forward plan was built
+   CppAD::ADFun<double> h;
+   h = f;
+   //
+   // g.optimize does not affect f or h
+   size_t size_var = f.size_var();
+   g.optimize();
+   ok &= g.size_var() < size_var;
+   ok &= f.size_var() == size_var;
+   ok &= h.size_var() == size_var;
+   y     = g.Forward(0, x);
+   check = check_value(x, q[0], n_term);
+   for(size_t i = 0; i < 2; ++i)
+      ok &= NearEqual(y[i], check[i], eps99, eps99);
+   y     = h.Forward(0, x);
+   check = check_value(x, p[0], n_term);
+   for(size_t i = 0; i < 2; ++i)
+      ok &= NearEqual(y[i], check[i], eps99, eps99);
+   //
+   // recording a new function in f does not affect h
+   record(f, 3);
+   ok &= f.size_var() < size_var;
+   ok &= h.size_var() == size_var;
+   y     = h.Forward(0, x);
+   for(size_t i = 0; i < 2; ++i)
+      ok &= NearEqual(y[i], check[i], eps99, eps99);
+   //
+   // af: base2ad shares the operation sequence with h
+   CppAD::ADFun< CppAD::AD<double>, double > af = h.base2ad();
+   ad_vector ax(2), ay;
+   ax[0] = x[0];
+   ax[1] = x[1];
+   ay = af.Forward(0, ax);
+   for(size_t i = 0; i < 2; ++i)
+      ok &= NearEqual(Value(ay[i]), check[i], eps99, eps99);
+   //
+   // copies made by other threads in parallel mode
+   ok &= check_thread(n_term);
+   //
+   return ok;
+}
@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check the process wide sparse cache: a retape of the same structure uses
+the cache, a different structure does not, and the least recently used
+entries are removed when the maximum number of entries is reached.
+Also check that the cache is not used when the sparsity pattern for an
+atomic function depends on the value of its parameter arguments.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR(size_t)                   s_vector;
+   typedef CPPAD_TESTVECTOR(double)                   d_vector;
+   typedef CPPAD_TESTVECTOR(AD<double>)               ad_vector;
+   typedef CppAD::sparse_rcv<s_vector, d_vector>      sparse_matrix;
+   // -----------------------------------------------------------------------
+   // record f(x) where the structure depends on product and the
+   // values recorded depend on x_rec (which must not be zero or one)
+   CppAD::ADFun<double> record(bool product, double x_rec)
+   {  size_t n = 3, m = 2;
+      ad_vector ax(n), ay(m);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x_rec + double(j);
+      CppAD::Independent(ax);
+      if( product )
+         ay[0] = ax[0] * ax[1];
+      else
+         ay[0] = ax[0] + ax[1];
+      ay[1] = sin( ax[2] ) * x_rec;
+      return CppAD::ADFun<double>(ax, ay);
+   }
+   // -----------------------------------------------------------------------
+   // check the Jacobian for f(x) recorded by record(product, x_rec)
+   bool check_jac(
+      bool product, double x_rec, const d_vector& x, const sparse_matrix& jac)
+   {  bool ok = true;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // Jacobian in row major order
+      d_vector check(4);
+      if( product )
+      {  check[0] = x[1];
+         check[1] = x[0];
+      }
+      else
+      {  check[0] = 1.0;
+         check[1] = 1.0;
+      }
+      check[2] = cos( x[2] ) * x_rec;
+      //
+      ok &= jac.nnz() == 3;
+      if( ! ok )
+         return ok;
+      s_vector row(3), col(3);
+      row[0] = 0; col[0] = 0;
+      row[1] = 0; col[1] = 1;
+      row[2] = 1; col[2] = 2;
+      for(size_t k = 0; k < 3; ++k)
+      {  ok &= jac.row()[k] == row[k];
+         ok &= jac.col()[k] == col[k];
+         ok &= CppAD::NearEqual(jac.val()[k], check[k], eps99, eps99);
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // y_0 = u_0 * u_1 * u_2
+   // where the sparsity pattern is empty when u_0 is a constant equal to zero
+   class atomic_prod : public CppAD::atomic_three<double> {
+   public:
+      atomic_prod(void) : CppAD::atomic_three<double>("atomic_prod")
+      { }
+   private:
+      bool for_type(
+         const CppAD::vector<double>&               parameter_x ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         CppAD::vector<CppAD::ad_type_enum>&        type_y      ) override
+      {  type_y[0] = CppAD::constant_enum;
+         for(size_t j = 0; j < type_x.size(); ++j)
+            type_y[0] = std::max(type_y[0], type_x[j]);
+         return true;
+      }
+      bool forward(
+         const CppAD::vector<double>&               parameter_x ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         size_t                                     need_y      ,
+         size_t                                     order_low   ,
+         size_t                                     order_up    ,
+         const CppAD::vector<double>&               tx          ,
+         CppAD::vector<double>&                     ty          ) override
+      {  size_t q = order_up + 1;
+         if( order_up > 1 )
+            return false;
+         if( order_low == 0 )
+            ty[0] = tx[0 * q] * tx[1 * q] * tx[2 * q];
+         if( order_up == 1 )
+         {  ty[1]  = tx[0 * q + 1] * tx[1 * q] * tx[2 * q];
+            ty[1] += tx[0 * q] * tx[1 * q + 1] * tx[2 * q];
+            ty[1] += tx[0 * q] * tx[1 * q] * tx[2 * q + 1];
+         }
+         return true;
+      }
+      bool jac_sparsity(
+         const CppAD::vector<double>&               parameter_x ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         bool                                       dependency  ,
+         const CppAD::vector<bool>&                 select_x    ,
+         const CppAD::vector<bool>&                 select_y    ,
+         CppAD::sparse_rc< CppAD::vector<size_t> >& pattern_out ) override
+      {  size_t n = select_x.size();
+         size_t m = select_y.size();
+         bool zero = type_x[0] == CppAD::constant_enum;
+         zero     &= parameter_x[0] == 0.0 && ! dependency;
+         size_t nnz = 0;
+         for(size_t j = 0; j < n; ++j)
+            if( select_y[0] && select_x[j] && ! zero )
+               ++nnz;
+         pattern_out.resize(m, n, nnz);
+         size_t k = 0;
+         for(size_t j = 0; j < n; ++j)
+            if( select_y[0] && select_x[j] && ! zero )
+               pattern_out.set(k++, 0, j);
+         return true;
+      }
+   };
+   // -----------------------------------------------------------------------
+   // f(x) = [ p * x_0 * x_1 , x_0 ] where p is a constant parameter
+   CppAD::ADFun<double> record_atomic(atomic_prod& prod, double p)
+   {  ad_vector ax(2), au(3), av(1), ay(2);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      CppAD::Independent(ax);
+      au[0] = p;
+      au[1] = ax[0];
+      au[2] = ax[1];
+      prod(au, av);
+      ay[0] = av[0];
+      ay[1] = ax[0];
+      return CppAD::ADFun<double>(ax, ay);
+   }
+   // -----------------------------------------------------------------------
+   bool check_atomic(void)
+   {  bool ok = true;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      std::string coloring = "cppad";
+      atomic_prod prod;
+      //
+      // f_zero, f_two: same structure and different sparsity patterns
+      CppAD::ADFun<double> f_zero = record_atomic(prod, 0.0);
+      CppAD::ADFun<double> f_two  = record_atomic(prod, 2.0);
+      ok &= f_zero.structure_hash() == f_two.structure_hash();
+      //
+      d_vector x(2);
+      x[0] = 3.0;
+      x[1] = 4.0;
+      sparse_matrix jac;
+      CppAD::sparse_cache_clear();
+      f_zero.sparse_jac_cache(x, jac, coloring);
+      ok &= jac.nnz() == 1;
+      f_two.sparse_jac_cache(x, jac, coloring);
+      ok &= jac.nnz() == 3;
+      if( jac.nnz() == 3 )
+      {  ok &= CppAD::NearEqual(jac.val()[0], 2.0 * x[1], eps99, eps99);
+         ok &= CppAD::NearEqual(jac.val()[1], 2.0 * x[0], eps99, eps99);
+         ok &= CppAD::NearEqual(jac.val()[2], 1.0, eps99, eps99);
+      }
+      //
+      // nothing was stored in the cache
+      ok &= CppAD::sparse_cache_size() == 0;
+      ok &= CppAD::sparse_cache_hit() == 0;
+      return ok;
+   }
+}
+
+bool sparse_cache(void)
+{  bool ok = true;
+   std::string coloring     = "cppad";
+   std::string hes_coloring = "cppad.symmetric";
+   //
+   CppAD::sparse_cache_clear();
+   ok &= CppAD::sparse_cache_size() == 0;
+   ok &= CppAD::sparse_cache_hit() == 0;
+   //
+   // x
+   d_vector x(3);
+   for(size_t j = 0; j < 3; ++j)
+      x[j] = 0.5 + double(j);
+   //
+   // f_first: first use of the structure is not a hit
+   sparse_matrix jac;
+   CppAD::ADFun<double> f_first = record(true, 2.0);
+   f_first.sparse_jac_cache(x, jac, coloring);
+   ok &= CppAD::sparse_cache_size() == 1;
+   ok &= CppAD::sparse_cache_hit() == 0;
+   ok &= check_jac(true, 2.0, x, jac);
+   //
+   // f_retape: retape of the same structure is a hit
+   CppAD::ADFun<double> f_retape = record(true, 3.0);
+   ok &= f_retape.structure_hash() == f_first.structure_hash();
+   f_retape.sparse_jac_cache(x, jac, coloring);
+   ok &= CppAD::sparse_cache_size() == 1;
+   ok &= CppAD::sparse_cache_hit() == 1;
+   ok &= check_jac(true, 3.0, x, jac);
+   //
+   // g: a different structure is not a hit
+   CppAD::ADFun<double> g = record(false, 2.0);
+   ok &= g.structure_hash() != f_retape.structure_hash();
+   g.sparse_jac_cache(x, jac, coloring);
+   ok &= CppAD::sparse_cache_size() == 2;
+   ok &= CppAD::sparse_cache_hit() == 1;
+   ok &= check_jac(false, 2.0, x, jac);
+   //
+   // The Hessian for f_retape is a different entry
+   d_vector w(2);
+   w[0] = 1.0;
+   w[1] = 1.0;
+   sparse_matrix hes;
+   f_retape.sparse_hes_cache(x, w, hes, hes_coloring);
+   ok &= CppAD::sparse_cache_size() == 3;
+   ok &= CppAD::sparse_cache_hit() == 1;
+   f_first.sparse_hes_cache(x, w, hes, hes_coloring);
+   ok &= CppAD::sparse_cache_size() == 3;
+   ok &= CppAD::sparse_cache_hit() == 2;
+   //
+   // Reduce the maximum number of entries. The Jacobian for the f structure
+   // is the least recently used entry, so it is removed.
+   CppAD::sparse_cache_max(2);
+   ok &= CppAD::sparse_cache_size() == 2;
+   //
+   // The Jacobian for g is still in the cache
+   g.sparse_jac_cache(x, jac, coloring);
+   ok &= CppAD::sparse_cache_hit() == 3;
+   ok &= check_jac(false, 2.0, x, jac);
+   //
+   // The Jacobian for f is not in the cache. Adding it removes
+   // the least recently used entry, which is the Hessian for f.
+   f_first.sparse_jac_cache(x, jac, coloring);
+   ok &= CppAD::sparse_cache_size() == 2;
+   ok &= CppAD::sparse_cache_hit() == 3;
+   ok &= check_jac(true, 2.0, x, jac);
+   f_first.sparse_hes_cache(x, w, hes, hes_coloring);
+   ok &= CppAD::sparse_cache_size() == 2;
+   ok &= CppAD::sparse_cache_hit() == 3;
+   //
+   // The Jacobian for f is now in the cache
+   f_retape.sparse_jac_cache(x, jac, coloring);
+   ok &= CppAD::sparse_cache_hit() == 4;
+   ok &= check_jac(true, 3.0, x, jac);
+   //
+   // restore the default maximum and free the memory in the cache
+   CppAD::sparse_cache_max(100);
+   CppAD::sparse_cache_clear();
+   ok &= CppAD::sparse_cache_size() == 0;
+   //
+   ok &= check_atomic();
+   //
+   return ok;
+}
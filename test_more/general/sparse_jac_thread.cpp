@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Check that sparse_jac_rev with more than one thread gives the same results
+as with one thread.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+   typedef CPPAD_TESTVECTOR(size_t)                   s_vector;
+   typedef CPPAD_TESTVECTOR(double)                   d_vector;
+   typedef CppAD::sparse_rc<s_vector>                 sparsity;
+   typedef CppAD::sparse_rcv<s_vector, d_vector>      sparse_matrix;
+   // -----------------------------------------------------------------------
+   // compare sparse_jac_rev for n_thread = 1 and for n_thread > 1
+   bool check_thread(CppAD::ADFun<double>& f, const d_vector& x)
+   {  bool ok = true;
+      double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+      size_t n = f.Domain();
+      //
+      // pattern
+      sparsity pattern_in(n, n, n);
+      for(size_t j = 0; j < n; ++j)
+         pattern_in.set(j, j, j);
+      bool transpose     = false;
+      bool dependency    = false;
+      bool internal_bool = false;
+      sparsity pattern;
+      f.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern
+      );
+      //
+      // subset1, subset2
+      sparse_matrix subset1(pattern), subset2(pattern);
+      //
+      // one thread
+      std::string coloring = "cppad";
+      CppAD::sparse_jac_work work1;
+      size_t n_color1 = f.sparse_jac_rev(
+         x, subset1, pattern, coloring, work1
+      );
+      //
+      // several threads, using work twice
+      CppAD::sparse_jac_work work2;
+      size_t n_thread = 4;
+      for(size_t rep = 0; rep < 2; ++rep)
+      {  size_t n_color2 = f.sparse_jac_rev(
+            x, subset2, pattern, coloring, work2, n_thread
+         );
+         ok &= n_color1 == n_color2;
+         for(size_t k = 0; k < pattern.nnz(); ++k)
+         {  double v1 = subset1.val()[k];
+            double v2 = subset2.val()[k];
+            ok &= CppAD::NearEqual(v1, v2, eps99, eps99);
+         }
+      }
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool thread_operators(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      size_t n = 10, m = 40;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+      d_vector x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j + 1) / double(n);
+      CppAD::Independent(ax);
+      CppAD::VecAD<double> av(n);
+      for(size_t j = 0; j < n; ++j)
+         av[ AD<double>(j) ] = ax[j];
+      for(size_t i = 0; i < m; ++i)
+      {  size_t j0 = i % n;
+         size_t j1 = (i + 3) % n;
+         AD<double> index = double( (i + 5) % n );
+         ay[i] = pow(ax[j0], 2.0) * sin( ax[j1] );
+         ay[i] += CppAD::CondExpLt(ax[j0], ax[j1], exp(ax[j1]), ax[j0]);
+         ay[i] += av[index] * ax[j1];
+      }
+      CppAD::ADFun<double> f(ax, ay);
+      ok &= check_thread(f, x);
+      //
+      // optimized version has conditional skip operators
+      f.optimize();
+      ok &= check_thread(f, x);
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   bool thread_atomic(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      //
+      // g(u) = [ u_0 * u_1 ]
+      CPPAD_TESTVECTOR( AD<double> ) au(2), av(1);
+      au[0] = 1.0;
+      au[1] = 2.0;
+      CppAD::Independent(au);
+      av[0] = au[0] * au[1];
+      CppAD::ADFun<double> g(au, av);
+      CppAD::chkpoint_two<double> chk_g(g, "g",
+         false, false, false, false
+      );
+      //
+      // f(x) uses the atomic function, so only one thread is used
+      size_t n = 4, m = 4;
+      CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m);
+      d_vector x(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x[j] = double(j + 1);
+      CppAD::Independent(ax);
+      for(size_t i = 0; i < m; ++i)
+      {  au[0] = ax[i];
+         au[1] = ax[ (i + 1) % n ];
+         chk_g(au, av);
+         ay[i] = av[0];
+      }
+      CppAD::ADFun<double> f(ax, ay);
+      ok &= check_thread(f, x);
+      //
+      return ok;
+   }
+}
+
+bool sparse_jac_thread(void)
+{  bool ok = true;
+   ok &= thread_operators();
+   ok &= thread_atomic();
+   return ok;
+}
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-23 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/cppad.hpp>
 # include <cppad/utility/link_dll_lib.hpp>
@@ -602,6 +602,207 @@ bool discrete_case(void)
    return ok;
 }
 // ---------------------------------------------------------------------------
+bool derivative_cases(void)
+{  // ok
+   bool ok = true;
+   //
+   // AD, NearEqual
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   //
+   // eps99
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // function_name
+   std::string function_name = "test_to_csrc";
+   //
+   // np, nx, ap, ax
+   size_t np = 1;
+   size_t nx = 2;
+   CPPAD_TESTVECTOR( AD<double> ) ap(np), ax(nx);
+   ap[0] = 0.25;
+   ax[0] = 0.5;
+   ax[1] = 2.0;
+   CppAD::Independent(ax, ap);
+   //
+   // ny, ay
+   size_t ny = 30;
+   CPPAD_TESTVECTOR( AD<double> ) ay(ny);
+   //
+   // binary operators
+   ay[0] = ax[0] + ax[1]; // add
+   ay[1] = ax[0] / ax[1]; // div
+   ay[2] = ax[0] * ax[1]; // mul
+   ay[3] = ax[0] - ax[1]; // sub
+   //
+   // unary functions
+   ay[4]  = abs(   ax[0] );
+   ay[5]  = acos(  ax[0] ); // ax[0] < 1
+   ay[6]  = acosh( ax[1] ); // ax[1] > 1
+   ay[7]  = asin(  ax[0] ); // ax[0] < 1
+   ay[8]  = asinh( ax[0] );
+   ay[9]  = atan(  ax[0] );
+   ay[10] = atanh( ax[0] );
+   ay[11] = cos(   ax[0] );
+   ay[12] = cosh(  ax[0] );
+   ay[13] = erf(   ax[0] );
+   ay[14] = erfc(  ax[0] );
+   ay[15] = exp(   ax[0] );
+   ay[16] = expm1( ax[0] );
+   ay[17] = log1p( ax[0] );
+   ay[18] = log(   ax[0] );
+   ay[19] = sign(  ax[0] );
+   ay[20] = sin(   ax[0] );
+   ay[21] = sinh(  ax[0] );
+   ay[22] = sqrt(  ax[0] );
+   ay[23] = tan(   ax[0] );
+   ay[24] = tanh(  ax[0] );
+   //
+   // binary functions
+   ay[25] = azmul( ax[0], ax[1] );
+   ay[26] = pow(   ax[0], ax[1] ); // ax[0] > 0
+   //
+   // constant function
+   ay[27] = 3.0;
+   //
+   // dynamic parameter
+   ay[28] = ap[0] * exp( ap[0] );
+   //
+   // composition of functions
+   ay[29] = ap[0] * sin( ax[0] * ax[1] ) / ( ax[0] + ap[0] );
+   //
+   // f
+   CppAD::ADFun<double> f(ax, ay);
+   f.function_name_set(function_name);
+   //
+   // g
+   // function with the dynamic parameters moved to the independent
+   // variables so that derivatives with respect to u = [p, x] can be checked
+   CPPAD_TESTVECTOR( AD<double> ) au(np + nx);
+   au[0] = ap[0];
+   au[1] = ax[0];
+   au[2] = ax[1];
+   CppAD::Independent(au);
+   CPPAD_TESTVECTOR( AD<double> ) aq(np), az(nx);
+   aq[0] = au[0];
+   az[0] = au[1];
+   az[1] = au[2];
+   CppAD::ADFun< AD<double>, double > af = f.base2ad();
+   af.new_dynamic(aq);
+   CPPAD_TESTVECTOR( AD<double> ) av = af.Forward(0, az);
+   CppAD::ADFun<double> g(au, av);
+   //
+   // dll_file
+   std::string dll_file = dll_file_name();
+   //
+   // csrc_files
+   CppAD::vector<std::string> csrc_files(1);
+   std::string type = "double";
+   std::stringstream ss;
+   f.to_csrc(ss, type);
+   csrc_files[0] = create_csrc_file(0, ss.str() );
+   //
+   // create dll_lib
+   std::map< std::string, std::string > options;
+   std::string err_msg = CppAD::create_dll_lib(dll_file, csrc_files, options);
+   if( err_msg != "" )
+   {  std::cout << err_msg << "\n";
+      ok = false;
+      return ok;
+   }
+   //
+   // dll_linker
+   CppAD::link_dll_lib dll_linker(dll_file, err_msg);
+   if( err_msg != "" )
+   {  std::cout << "dll_linker ctor error: " << err_msg << "\n";
+      ok = false;
+      return ok;
+   }
+   //
+   // jit_double
+   using CppAD::jit_double;
+   //
+   // forward_one, reverse_one, jacobian
+   jit_double forward_one = nullptr, reverse_one = nullptr, jacobian = nullptr;
+   {  std::string complete_name = "cppad_jit_" + function_name;
+      forward_one = reinterpret_cast<jit_double>(
+            dll_linker(complete_name + "_forward_one", err_msg)
+      );
+      ok &= err_msg == "";
+      reverse_one = reinterpret_cast<jit_double>(
+            dll_linker(complete_name + "_reverse_one", err_msg)
+      );
+      ok &= err_msg == "";
+      jacobian = reinterpret_cast<jit_double>(
+            dll_linker(complete_name + "_jacobian", err_msg)
+      );
+      ok &= err_msg == "";
+      if( ! ok )
+      {  std::cout << "dll_linker fun_ptr error: " << err_msg << "\n";
+         return ok;
+      }
+   }
+   //
+   // nu, u
+   size_t nu = np + nx;
+   CppAD::vector<double> u(nu);
+   u[0] = 0.3;
+   u[1] = 0.4;
+   u[2] = 1.5;
+   //
+   // ok
+   // first order forward mode
+   CppAD::vector<double> udu(2 * nu), du(nu), ydy(2 * ny);
+   for(size_t j = 0; j < nu; ++j)
+   {  du[j]       = double(j + 1);
+      udu[j]      = u[j];
+      udu[nu + j] = du[j];
+   }
+   size_t compare_change = 0;
+   int flag = forward_one(
+      2 * nu, udu.data(), 2 * ny, ydy.data(), &compare_change
+   );
+   ok &= flag == 0;
+   ok &= compare_change == 0;
+   CppAD::vector<double> y  = g.Forward(0, u);
+   CppAD::vector<double> dy = g.Forward(1, du);
+   for(size_t i = 0; i < ny; ++i)
+   {  ok &= NearEqual( ydy[i],      y[i],  eps99, eps99);
+      ok &= NearEqual( ydy[ny + i], dy[i], eps99, eps99);
+   }
+   //
+   // ok
+   // first order reverse mode
+   CppAD::vector<double> uw(nu + ny), w(ny), dw(nu);
+   for(size_t j = 0; j < nu; ++j)
+      uw[j] = u[j];
+   for(size_t i = 0; i < ny; ++i)
+      uw[nu + i] = w[i] = double(i % 3) + 1.0;
+   flag = reverse_one(nu + ny, uw.data(), nu, dw.data(), &compare_change);
+   ok &= flag == 0;
+   CppAD::vector<double> check = g.Reverse(1, w);
+   for(size_t j = 0; j < nu; ++j)
+      ok &= NearEqual( dw[j], check[j], eps99, eps99);
+   //
+   // ok
+   // Jacobian
+   CppAD::vector<double> jac(ny * nu);
+   flag = jacobian(nu, u.data(), ny * nu, jac.data(), &compare_change);
+   ok &= flag == 0;
+   check = g.Jacobian(u);
+   for(size_t k = 0; k < ny * nu; ++k)
+      ok &= NearEqual( jac[k], check[k], eps99, eps99);
+   //
+   // ok
+   // wrong sizes
+   flag = forward_one(nu, udu.data(), 2 * ny, ydy.data(), &compare_change);
+   ok &= flag == 1;
+   flag = reverse_one(nu + ny, uw.data(), ny, dw.data(), &compare_change);
+   ok &= flag == 2;
+   //
+   return ok;
+}
+// ---------------------------------------------------------------------------
 } // END_EMPTY_NAMESPACE
 // ---------------------------------------------------------------------------
 bool to_csrc(void)
@@ -610,5 +811,6 @@ bool to_csrc(void)
    ok     &= compare_cases();
    ok     &= atomic_case();
    ok     &= discrete_case();
+   ok     &= derivative_cases();
    return ok;
 }